@@ -13,6 +13,22 @@
 #include "vec4.h"
 #include "util.h"
 
+#ifdef CGLM_SSE_FP
+#  include "simd/sse2/box.h"
+#endif
+
+#ifdef CGLM_AVX_FP
+#  include "simd/avx/box.h"
+#endif
+
+#ifdef CGLM_AVX512_FP
+#  include "simd/avx512/box.h"
+#endif
+
+#ifdef CGLM_NEON_FP
+#  include "simd/neon/box.h"
+#endif
+
 /*!
  * @brief apply transform to Axis-Aligned Bounding Box
  *
@@ -150,6 +166,62 @@ glm_aabb_frustum(vec3 box[2], vec4 planes[6]) {
   return true;
 }
 
+/*!
+ * @brief check many AABBs against frustum planes at once
+ *
+ * boxes are given as structure of arrays, min[0] is the stream of min x
+ * values, max[2] the stream of max z values and so on. Each stream must hold
+ * count floats, no alignment is required.
+ *
+ * bit (i & 31) of visible[i >> 5] is set when box i intersects the frustum,
+ * so visible must hold (count + 31) / 32 words. The result is identical to
+ * calling glm_aabb_frustum for each box, but there is no early-out; every box
+ * is tested against all six planes without branches, 4, 8 or 16 at a time
+ * depending on the SIMD extension available.
+ *
+ * @param[in]  min     min corner streams, x y z
+ * @param[in]  max     max corner streams, x y z
+ * @param[in]  count   number of boxes
+ * @param[in]  planes  frustum planes
+ * @param[out] visible visibility bitmask
+ */
+CGLM_INLINE
+void
+glm_aabb_frustum_soa(float    *min[3],
+                     float    *max[3],
+                     size_t    count,
+                     vec4      planes[6],
+                     uint32_t * __restrict visible) {
+  vec3   box[2];
+  size_t i;
+
+#if defined(__AVX512F__)
+  i = glm_aabb_frustum_soa_avx512(min, max, count, planes, visible);
+#elif defined(__AVX__)
+  i = glm_aabb_frustum_soa_avx(min, max, count, planes, visible);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_aabb_frustum_soa_sse2(min, max, count, planes, visible);
+#elif defined(CGLM_NEON_FP)
+  i = glm_aabb_frustum_soa_neon(min, max, count, planes, visible);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    if ((i & 31) == 0)
+      visible[i >> 5] = 0;
+
+    box[0][0] = min[0][i];
+    box[0][1] = min[1][i];
+    box[0][2] = min[2][i];
+    box[1][0] = max[0][i];
+    box[1][1] = max[1][i];
+    box[1][2] = max[2][i];
+
+    visible[i >> 5] |= (uint32_t)glm_aabb_frustum(box, planes) << (i & 31);
+  }
+}
+
 /*!
  * @brief invalidate AABB min and max values
  *
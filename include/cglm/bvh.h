@@ -0,0 +1,420 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ Bounding volume hierarchy over a triangle list for ray queries, e.g. mouse
+ picking. cglm does not allocate, the caller provides the arrays of glm_bvh:
+
+   nodes   2 * count - 1 nodes
+   index   count entries
+   tri[9]  count floats each
+
+ Macros:
+   GLM_BVH_LEAF_MAX
+   GLM_BVH_BINS
+   GLM_BVH_DEPTH
+
+ Types:
+   typedef struct glm_bvh_node glm_bvh_node;
+   typedef struct glm_bvh      glm_bvh;
+
+ Functions:
+   CGLM_INLINE size_t glm_bvh_build(glm_bvh *bvh, vec3 *verts, size_t count);
+   CGLM_INLINE float  glm_bvh_node_ray(glm_bvh_node *node,
+                                       vec3          origin,
+                                       vec3          inv_dir,
+                                       float         d);
+   CGLM_INLINE bool   glm_bvh_ray(glm_bvh *bvh,
+                                  vec3     origin,
+                                  vec3     direction,
+                                  float   *d,
+                                  size_t  *tri);
+ */
+
+#ifndef cglm_bvh_h
+#define cglm_bvh_h
+
+#include "common.h"
+#include "vec3.h"
+#include "util.h"
+#include "ray.h"
+
+/* leaves hold up to one AVX batch of glm_ray_triangle_soa */
+#ifndef GLM_BVH_LEAF_MAX
+#  define GLM_BVH_LEAF_MAX 8
+#endif
+
+/* SAH candidates per axis */
+#ifndef GLM_BVH_BINS
+#  define GLM_BVH_BINS 16
+#endif
+
+/* nodes deeper than this become leaves, bounds the traversal stack */
+#ifndef GLM_BVH_DEPTH
+#  define GLM_BVH_DEPTH 64
+#endif
+
+/*!
+ * @brief flattened node, 32 bytes. The first child of an inner node follows
+ *        it in the array, so a depth first walk reads nodes in order.
+ */
+typedef struct glm_bvh_node {
+  vec3     min;
+  uint32_t first; /* leaf: first triangle slot, inner: index of second child */
+  vec3     max;
+  uint32_t count; /* leaf: number of triangles, inner: 0                     */
+} glm_bvh_node;
+
+typedef struct glm_bvh {
+  glm_bvh_node *nodes;      /* node 0 is the root                            */
+  uint32_t     *index;      /* triangle of verts stored in each slot         */
+  float        *tri[9];     /* triangles in slot order, glm_ray_triangle_soa */
+  size_t        node_count;
+} glm_bvh;
+
+/*!
+ * @brief builds a BVH with the binned surface area heuristic
+ *
+ * triangles are reordered so each leaf is a contiguous run of slots which is
+ * tested with glm_ray_triangle_soa, index maps slots back to triangles. The
+ * tri arrays hold triangle bounds while building, no other memory is used.
+ *
+ * @param[in, out] bvh   bvh with its arrays set, see top of file
+ * @param[in]      verts triangle list, 3 vertices per triangle
+ * @param[in]      count number of triangles
+ * @returns number of nodes used
+ */
+CGLM_INLINE
+size_t
+glm_bvh_build(glm_bvh *bvh, vec3 *verts, size_t count) {
+  struct { uint32_t begin, end, parent, depth; } stack[GLM_BVH_DEPTH], job;
+  struct { vec3 min, max; uint32_t count; } bins[3][GLM_BVH_BINS];
+  float         rarea[GLM_BVH_BINS], rcount[GLM_BVH_BINS];
+  vec3          cmin, cmax, scale, bmin, bmax, ext, sz;
+  glm_bvh_node *node;
+  float       **tri, c, cost, best, area, tmp;
+  uint32_t     *index, top, n, i, j, mid, ui;
+  int           k, b, axis, split;
+
+  tri   = bvh->tri;
+  index = bvh->index;
+  bvh->node_count = 0;
+
+  if (count == 0)
+    return 0;
+
+  for (i = 0; i < count; i++) {
+    index[i] = i;
+    for (k = 0; k < 3; k++) {
+      tri[k][i]     = glm_min(glm_min(verts[i * 3][k], verts[i * 3 + 1][k]),
+                              verts[i * 3 + 2][k]);
+      tri[k + 3][i] = glm_max(glm_max(verts[i * 3][k], verts[i * 3 + 1][k]),
+                              verts[i * 3 + 2][k]);
+    }
+  }
+
+  top = 0;
+  stack[top].begin  = 0;
+  stack[top].end    = (uint32_t)count;
+  stack[top].parent = UINT32_MAX;
+  stack[top].depth  = 0;
+  top++;
+
+  while (top) {
+    job  = stack[--top];
+    n    = job.end - job.begin;
+    node = &bvh->nodes[bvh->node_count];
+
+    /* first children follow their parent, second ones are linked here */
+    if (job.parent != UINT32_MAX)
+      bvh->nodes[job.parent].first = (uint32_t)bvh->node_count;
+    bvh->node_count++;
+
+    /* node bounds and bounds of the centers, kept doubled (min + max) */
+    glm_vec3_broadcast(FLT_MAX,  node->min);
+    glm_vec3_broadcast(-FLT_MAX, node->max);
+    glm_vec3_broadcast(FLT_MAX,  cmin);
+    glm_vec3_broadcast(-FLT_MAX, cmax);
+
+    for (i = job.begin; i < job.end; i++) {
+      for (k = 0; k < 3; k++) {
+        c            = tri[k][i] + tri[k + 3][i];
+        node->min[k] = glm_min(node->min[k], tri[k][i]);
+        node->max[k] = glm_max(node->max[k], tri[k + 3][i]);
+        cmin[k]      = glm_min(cmin[k], c);
+        cmax[k]      = glm_max(cmax[k], c);
+      }
+    }
+
+    node->first = job.begin;
+    node->count = n;
+
+    if (n <= 2 || job.depth + 1 >= GLM_BVH_DEPTH)
+      continue;
+
+    for (k = 0; k < 3; k++) {
+      for (b = 0; b < GLM_BVH_BINS; b++) {
+        bins[k][b].count = 0;
+        glm_vec3_broadcast(FLT_MAX,  bins[k][b].min);
+        glm_vec3_broadcast(-FLT_MAX, bins[k][b].max);
+      }
+
+      ext[k]   = cmax[k] - cmin[k];
+      scale[k] = ext[k] > 0.0f ? GLM_BVH_BINS * 0.99999f / ext[k] : 0.0f;
+    }
+
+    for (i = job.begin; i < job.end; i++) {
+      for (k = 0; k < 3; k++) {
+        b = (int)((tri[k][i] + tri[k + 3][i] - cmin[k]) * scale[k]);
+        b = b < GLM_BVH_BINS ? b : GLM_BVH_BINS - 1;
+
+        bins[k][b].count++;
+        for (j = 0; j < 3; j++) {
+          bins[k][b].min[j] = glm_min(bins[k][b].min[j], tri[j][i]);
+          bins[k][b].max[j] = glm_max(bins[k][b].max[j], tri[j + 3][i]);
+        }
+      }
+    }
+
+    /* SAH, one node visit costs as much as a batch of 4 triangle tests */
+    glm_vec3_sub(node->max, node->min, sz);
+    area  = sz[0] * sz[1] + sz[1] * sz[2] + sz[2] * sz[0];
+    best  = FLT_MAX;
+    axis  = -1;
+    split = 0;
+
+    for (k = 0; k < 3; k++) {
+      if (ext[k] <= 0.0f)
+        continue;
+
+      glm_vec3_broadcast(FLT_MAX,  bmin);
+      glm_vec3_broadcast(-FLT_MAX, bmax);
+      for (ui = 0, b = GLM_BVH_BINS - 1; b > 0; b--) {
+        ui += bins[k][b].count;
+        glm_vec3_minv(bmin, bins[k][b].min, bmin);
+        glm_vec3_maxv(bmax, bins[k][b].max, bmax);
+        glm_vec3_sub(bmax, bmin, sz);
+        rarea[b]  = ui ? sz[0] * sz[1] + sz[1] * sz[2] + sz[2] * sz[0] : 0.0f;
+        rcount[b] = (float)ui;
+      }
+
+      glm_vec3_broadcast(FLT_MAX,  bmin);
+      glm_vec3_broadcast(-FLT_MAX, bmax);
+      for (ui = 0, b = 0; b < GLM_BVH_BINS - 1; b++) {
+        ui += bins[k][b].count;
+        glm_vec3_minv(bmin, bins[k][b].min, bmin);
+        glm_vec3_maxv(bmax, bins[k][b].max, bmax);
+        if (!ui || !rcount[b + 1])
+          continue;
+
+        glm_vec3_sub(bmax, bmin, sz);
+        cost = (sz[0] * sz[1] + sz[1] * sz[2] + sz[2] * sz[0]) * (float)ui
+             + rarea[b + 1] * rcount[b + 1];
+        if (cost < best) {
+          best  = cost;
+          axis  = k;
+          split = b;
+        }
+      }
+    }
+
+    /* small runs stay leaves unless splitting is cheaper */
+    if (n <= GLM_BVH_LEAF_MAX
+        && (axis < 0 || best >= ((float)n - 4.0f) * area))
+      continue;
+
+    mid = job.begin;
+    if (axis >= 0) {
+      i = job.begin;
+      j = job.end;
+      while (i < j) {
+        b = (int)((tri[axis][i] + tri[axis + 3][i] - cmin[axis])
+                  * scale[axis]);
+        if (b <= split) {
+          i++;
+          continue;
+        }
+
+        j--;
+        ui = index[i]; index[i] = index[j]; index[j] = ui;
+        for (k = 0; k < 6; k++) {
+          tmp = tri[k][i]; tri[k][i] = tri[k][j]; tri[k][j] = tmp;
+        }
+      }
+      mid = i;
+    }
+
+    /* all centers equal, or rounding put everything on one side */
+    if (mid == job.begin || mid == job.end)
+      mid = job.begin + n / 2;
+
+    node->count = 0;
+
+    stack[top].begin  = mid;
+    stack[top].end    = job.end;
+    stack[top].parent = (uint32_t)bvh->node_count - 1;
+    stack[top].depth  = job.depth + 1;
+    top++;
+
+    stack[top].begin  = job.begin;
+    stack[top].end    = mid;
+    stack[top].parent = UINT32_MAX;
+    stack[top].depth  = job.depth + 1;
+    top++;
+  }
+
+  /* bounds are no longer needed, store the triangles in slot order */
+  for (i = 0; i < count; i++) {
+    ui = index[i] * 3;
+    for (k = 0; k < 3; k++) {
+      tri[k][i]     = verts[ui][k];
+      tri[k + 3][i] = verts[ui + 1][k] - verts[ui][k];
+      tri[k + 6][i] = verts[ui + 2][k] - verts[ui][k];
+    }
+  }
+
+  return bvh->node_count;
+}
+
+/*!
+ * @brief distance where a ray enters the box of a node
+ *
+ * @param[in] node    bvh node
+ * @param[in] origin  origin of ray
+ * @param[in] inv_dir 1 / direction of ray, per component
+ * @param[in] d       farthest distance to accept
+ * @returns distance, 0 if origin is inside, FLT_MAX if box is missed
+ */
+CGLM_INLINE
+float
+glm_bvh_node_ray(glm_bvh_node *node, vec3 origin, vec3 inv_dir, float d) {
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  __m128 o, inv, t0, t1;
+  float  lo, hi;
+
+  o   = glmm_load3(origin);
+  inv = glmm_load3(inv_dir);
+  t0  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node->min), o), inv);
+  t1  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node->max), o), inv);
+
+  /* lane 3 is first / count of the node, z is repeated there */
+  lo = glmm_hmax(glmm_shuff1(_mm_min_ps(t0, t1), 2, 2, 1, 0));
+  hi = glmm_hmin(glmm_shuff1(_mm_max_ps(t0, t1), 2, 2, 1, 0));
+  lo = glm_max(lo, 0.0f);
+  hi = glm_min(hi, d);
+#else
+  float t0, t1, lo, hi;
+  int   k;
+
+  lo = 0.0f;
+  hi = d;
+
+  for (k = 0; k < 3; k++) {
+    t0 = (node->min[k] - origin[k]) * inv_dir[k];
+    t1 = (node->max[k] - origin[k]) * inv_dir[k];
+    lo = glm_max(lo, glm_min(t0, t1));
+    hi = glm_min(hi, glm_max(t0, t1));
+  }
+#endif
+
+  return lo <= hi ? lo : FLT_MAX;
+}
+
+/*!
+ * @brief nearest triangle hit by a ray
+ *
+ * children are visited near to far and skipped once they start farther than
+ * the nearest hit so far.
+ *
+ * @param[in]      bvh       bvh built with glm_bvh_build
+ * @param[in]      origin    origin of ray
+ * @param[in]      direction direction of ray
+ * @param[in, out] d         in: farthest distance to accept (e.g. FLT_MAX),
+ *                           out: distance to nearest intersection
+ * @param[out]     tri       triangle of verts that was hit
+ * @return whether there is intersection closer than d
+ */
+CGLM_INLINE
+bool
+glm_bvh_ray(glm_bvh *bvh,
+            vec3     origin,
+            vec3     direction,
+            float   *d,
+            size_t  *tri) {
+  float        *t[9], dist[GLM_BVH_DEPTH], best, da, db;
+  glm_bvh_node *nodes, *node;
+  uint32_t      stack[GLM_BVH_DEPTH], top, i, a, b;
+  vec3          inv;
+  size_t        hit = 0;
+  bool          found;
+  int           k;
+
+  if (bvh->node_count == 0)
+    return false;
+
+  nodes = bvh->nodes;
+  best  = *d;
+  found = false;
+  top   = 0;
+  i     = 0;
+
+  glm_vec3_div(GLM_VEC3_ONE, direction, inv);
+
+  if (glm_bvh_node_ray(&nodes[0], origin, inv, best) == FLT_MAX)
+    return false;
+
+  for (;;) {
+    node = &nodes[i];
+
+    if (node->count) {
+      for (k = 0; k < 9; k++)
+        t[k] = bvh->tri[k] + node->first;
+
+      if (glm_ray_triangle_soa(origin, direction, t, node->count,
+                               &best, &hit)) {
+        *tri  = bvh->index[node->first + hit];
+        found = true;
+      }
+    } else {
+      a  = i + 1;
+      b  = node->first;
+      da = glm_bvh_node_ray(&nodes[a], origin, inv, best);
+      db = glm_bvh_node_ray(&nodes[b], origin, inv, best);
+
+      if (db < da) {
+        i = a; a = b; b = i;
+        glm_swapf(&da, &db);
+      }
+
+      if (da != FLT_MAX) {
+        if (db != FLT_MAX) {
+          dist[top]    = db;
+          stack[top++] = b;
+        }
+
+        i = a;
+        continue;
+      }
+    }
+
+    /* pop, skipping nodes behind the nearest hit */
+    while (top && dist[top - 1] > best)
+      top--;
+
+    if (!top)
+      break;
+
+    i = stack[--top];
+  }
+
+  if (found)
+    *d = best;
+
+  return found;
+}
+
+#endif /* cglm_bvh_h */
@@ -36,6 +36,14 @@ CGLM_EXPORT
 bool
 glmc_aabb_frustum(vec3 box[2], vec4 planes[6]);
 
+CGLM_EXPORT
+void
+glmc_aabb_frustum_soa(float    *min[3],
+                      float    *max[3],
+                      size_t    count,
+                      vec4      planes[6],
+                      uint32_t * __restrict visible);
+
 CGLM_EXPORT
 void
 glmc_aabb_invalidate(vec3 box[2]);
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglmc_bvh_h
+#define cglmc_bvh_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../cglm.h"
+
+CGLM_EXPORT
+size_t
+glmc_bvh_build(glm_bvh *bvh, vec3 *verts, size_t count);
+
+CGLM_EXPORT
+float
+glmc_bvh_node_ray(glm_bvh_node *node, vec3 origin, vec3 inv_dir, float d);
+
+CGLM_EXPORT
+bool
+glmc_bvh_ray(glm_bvh *bvh,
+             vec3     origin,
+             vec3     direction,
+             float   *d,
+             size_t  *tri);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* cglmc_bvh_h */
@@ -35,6 +35,28 @@ glmc_frustum_corners_at(vec4  corners[8],
                         float splitDist,
                         float farDist,
                         vec4  planeCorners[4]);
+
+CGLM_EXPORT
+void
+glmc_frustum_splits(float  nearZ,
+                    float  farZ,
+                    float  lambda,
+                    size_t count,
+                    float *dest);
+
+CGLM_EXPORT
+void
+glmc_frustum_cascades(vec4   corners[8],
+                      float  nearZ,
+                      float  farZ,
+                      float *splits,
+                      size_t count,
+                      mat4   lightView,
+                      float  size,
+                      vec4   planeCorners[][4],
+                      vec3   boxes[][2],
+                      mat4  *proj);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,10 @@ CGLM_EXPORT
 void
 glmc_mat4_mulN(mat4 * __restrict matrices[], uint32_t len, mat4 dest);
 
+CGLM_EXPORT
+void
+glmc_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count, mat4 *dest);
+
 CGLM_EXPORT
 void
 glmc_mat4_mulv(mat4 m, vec4 v, vec4 dest);
@@ -65,6 +69,22 @@ CGLM_EXPORT
 void
 glmc_mat4_mulv3(mat4 m, vec3 v, float last, vec3 dest);
 
+CGLM_EXPORT
+void
+glmc_mat4_mulv_array(mat4 m, vec4 *v, size_t count, vec4 *dest);
+
+CGLM_EXPORT
+void
+glmc_mat4_mulv3_array(mat4 m, vec3 *v, float last, size_t count, vec3 *dest);
+
+CGLM_EXPORT
+void
+glmc_mat4_mulv3_soa(mat4   m,
+                    float *v[3],
+                    float  last,
+                    size_t count,
+                    float *dest[3]);
+
 CGLM_EXPORT
 float
 glmc_mat4_trace(mat4 m);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglmc_pack_h
+#define cglmc_pack_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../cglm.h"
+
+CGLM_EXPORT
+uint16_t
+glmc_pack_half(float f);
+
+CGLM_EXPORT
+float
+glmc_unpack_half(uint16_t h);
+
+CGLM_EXPORT
+uint8_t
+glmc_pack_unorm8(float f);
+
+CGLM_EXPORT
+float
+glmc_unpack_unorm8(uint8_t v);
+
+CGLM_EXPORT
+int8_t
+glmc_pack_snorm8(float f);
+
+CGLM_EXPORT
+float
+glmc_unpack_snorm8(int8_t v);
+
+CGLM_EXPORT
+uint16_t
+glmc_pack_unorm16(float f);
+
+CGLM_EXPORT
+float
+glmc_unpack_unorm16(uint16_t v);
+
+CGLM_EXPORT
+int16_t
+glmc_pack_snorm16(float f);
+
+CGLM_EXPORT
+float
+glmc_unpack_snorm16(int16_t v);
+
+CGLM_EXPORT
+uint32_t
+glmc_pack_oct(vec3 n);
+
+CGLM_EXPORT
+void
+glmc_unpack_oct(uint32_t p, vec3 dest);
+
+CGLM_EXPORT
+uint32_t
+glmc_pack_unorm1010102(vec4 v);
+
+CGLM_EXPORT
+void
+glmc_unpack_unorm1010102(uint32_t p, vec4 dest);
+
+CGLM_EXPORT
+uint32_t
+glmc_pack_snorm1010102(vec4 v);
+
+CGLM_EXPORT
+void
+glmc_unpack_snorm1010102(uint32_t p, vec4 dest);
+
+CGLM_EXPORT
+void
+glmc_pack_half_array(float *v, size_t count, uint16_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_half_array(uint16_t *v, size_t count, float *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_unorm8_array(float *v, size_t count, uint8_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_unorm8_array(uint8_t *v, size_t count, float *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_snorm8_array(float *v, size_t count, int8_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_snorm8_array(int8_t *v, size_t count, float *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_unorm16_array(float *v, size_t count, uint16_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_unorm16_array(uint16_t *v, size_t count, float *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_snorm16_array(float *v, size_t count, int16_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_snorm16_array(int16_t *v, size_t count, float *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_oct_array(vec3 *n, size_t count, uint32_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_oct_array(uint32_t *p, size_t count, vec3 *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_unorm1010102_array(vec4 *v, size_t count, uint32_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_unorm1010102_array(uint32_t *p, size_t count, vec4 *dest);
+
+CGLM_EXPORT
+void
+glmc_pack_snorm1010102_array(vec4 *v, size_t count, uint32_t *dest);
+
+CGLM_EXPORT
+void
+glmc_unpack_snorm1010102_array(uint32_t *p, size_t count, vec4 *dest);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* cglmc_pack_h */
@@ -133,6 +133,22 @@ CGLM_EXPORT
 void
 glmc_quat_slerp(versor q, versor r, float t, versor dest);
 
+CGLM_EXPORT
+void
+glmc_quat_slerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]);
+
+CGLM_EXPORT
+void
+glmc_quat_nlerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]);
+
 CGLM_EXPORT
 void
 glmc_quat_look(vec3 eye, versor ori, mat4 dest);
@@ -20,6 +20,15 @@ glmc_ray_triangle(vec3   origin,
                   vec3   v1,
                   vec3   v2,
                   float *d);
+
+CGLM_EXPORT
+bool
+glmc_ray_triangle_soa(vec3    origin,
+                      vec3    direction,
+                      float  *tri[9],
+                      size_t  count,
+                      float  *d,
+                      size_t *index);
     
 #ifdef __cplusplus
 }
@@ -25,6 +25,14 @@ CGLM_EXPORT
 void
 glmc_sphere_merge(vec4 s1, vec4 s2, vec4 dest);
 
+CGLM_EXPORT
+void
+glmc_sphere_transform_array(vec4 *s, mat4 *m, size_t count, vec4 *dest);
+
+CGLM_EXPORT
+void
+glmc_sphere_merge_array(vec4 *s, size_t count, vec4 dest);
+
 CGLM_EXPORT
 bool
 glmc_sphere_sphere(vec4 s1, vec4 s2);
@@ -31,6 +31,8 @@
 #include "curve.h"
 #include "bezier.h"
 #include "ray.h"
+#include "bvh.h"
+#include "pack.h"
 #include "affine2d.h"
 
 #endif /* cglm_h */
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ Runtime dispatch for the hot functions of the call api. cglm picks its SIMD
+ path at compile time, so a binary built for baseline x86-64 never reaches
+ the AVX / AVX-512 code. glmd_* functions are compiled once per ISA and
+ glmd_init() picks the best set for the running CPU with cpuid.
+
+ This is optional, the build must add three translation units which only
+ include the implementation:
+
+   dispatch.c         #include <cglm/dispatch/impl.h>
+   dispatch-avx2.c    #define CGLM_DISPATCH_AVX2
+                      #include <cglm/dispatch/isa.h>
+   dispatch-avx512.c  #define CGLM_DISPATCH_AVX512
+                      #include <cglm/dispatch/isa.h>
+
+ GCC switches the ISA of the last two with #pragma GCC target, with other
+ compilers they must be built with -mavx2 -mfma -mf16c / -mavx512f -mavx2
+ -mfma -mf16c, otherwise they compile to nothing and glmd_init() stays on
+ the baseline.
+ Until glmd_init() is called every glmd_* function runs the baseline code.
+
+ Enums:
+   enum glmd_isa
+
+ Functions:
+   CGLM_EXPORT glmd_isa    glmd_init(void);
+   CGLM_EXPORT glmd_isa    glmd_select(glmd_isa isa);
+   CGLM_EXPORT glmd_isa    glmd_current(void);
+   CGLM_EXPORT const char *glmd_isa_name(glmd_isa isa);
+   CGLM_EXPORT void glmd_mat4_mul(mat4 m1, mat4 m2, mat4 dest);
+   CGLM_EXPORT void glmd_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count,
+                                        mat4 *dest);
+   CGLM_EXPORT void glmd_mat4_mulv(mat4 m, vec4 v, vec4 dest);
+   CGLM_EXPORT void glmd_mat4_mulv_array(mat4 m, vec4 *v, size_t count,
+                                         vec4 *dest);
+   CGLM_EXPORT void glmd_mat4_mulv3_array(mat4 m, vec3 *v, float last,
+                                          size_t count, vec3 *dest);
+   CGLM_EXPORT void glmd_mat4_mulv3_soa(mat4 m, float *v[3], float last,
+                                        size_t count, float *dest[3]);
+   CGLM_EXPORT void glmd_mat4_transpose_to(mat4 m, mat4 dest);
+   CGLM_EXPORT void glmd_mat4_inv(mat4 mat, mat4 dest);
+   CGLM_EXPORT void glmd_mat4_inv_fast(mat4 mat, mat4 dest);
+   CGLM_EXPORT void glmd_mat3_mul(mat3 m1, mat3 m2, mat3 dest);
+   CGLM_EXPORT void glmd_quat_mul(versor p, versor q, versor dest);
+   CGLM_EXPORT void glmd_quat_mat4(versor q, mat4 dest);
+   CGLM_EXPORT void glmd_quat_slerp_soa(float *from[4], float *to[4], float t,
+                                        size_t count, float *dest[4]);
+   CGLM_EXPORT void glmd_quat_nlerp_soa(float *from[4], float *to[4], float t,
+                                        size_t count, float *dest[4]);
+   CGLM_EXPORT void glmd_aabb_frustum_soa(float *min[3], float *max[3],
+                                          size_t count, vec4 planes[6],
+                                          uint32_t * __restrict visible);
+   CGLM_EXPORT void glmd_sphere_transform_array(vec4 *s, mat4 *m,
+                                                size_t count, vec4 *dest);
+   CGLM_EXPORT void glmd_sphere_merge_array(vec4 *s, size_t count,
+                                            vec4 dest);
+   CGLM_EXPORT bool glmd_ray_triangle_soa(vec3 origin, vec3 direction,
+                                          float *tri[9], size_t count,
+                                          float *d, size_t *index);
+   CGLM_EXPORT bool glmd_bvh_ray(glm_bvh *bvh, vec3 origin, vec3 direction,
+                                 float *d, size_t *tri);
+   CGLM_EXPORT void glmd_pack_half_array(float *v, size_t count,
+                                         uint16_t *dest);
+   CGLM_EXPORT void glmd_unpack_half_array(uint16_t *v, size_t count,
+                                           float *dest);
+ */
+
+#ifndef cglm_dispatch_h
+#define cglm_dispatch_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "bvh.h"
+
+/*!
+ * @brief instruction sets glmd_* functions are compiled for,
+ *        later ones are preferred
+ */
+typedef enum glmd_isa {
+  GLMD_ISA_BASE   = 0, /* whatever the build targets, e.g. SSE2 or NEON */
+  GLMD_ISA_AVX2   = 1, /* AVX2 + FMA + F16C                             */
+  GLMD_ISA_AVX512 = 2  /* AVX-512F + AVX2 + FMA + F16C                  */
+} glmd_isa;
+
+/*!
+ * @brief selects the best ISA the CPU, the OS and the build support
+ *
+ * call it once at startup before other threads use glmd_* functions
+ *
+ * @returns selected ISA
+ */
+CGLM_EXPORT
+glmd_isa
+glmd_init(void);
+
+/*!
+ * @brief selects isa, or the best supported one below it
+ *
+ * meant for comparing paths on one machine, glmd_init() is the usual entry
+ *
+ * @param[in] isa highest ISA to use
+ * @returns selected ISA
+ */
+CGLM_EXPORT
+glmd_isa
+glmd_select(glmd_isa isa);
+
+/*!
+ * @brief ISA glmd_* functions currently run
+ */
+CGLM_EXPORT
+glmd_isa
+glmd_current(void);
+
+/*!
+ * @brief printable name of isa
+ */
+CGLM_EXPORT
+const char*
+glmd_isa_name(glmd_isa isa);
+
+CGLM_EXPORT
+void
+glmd_mat4_mul(mat4 m1, mat4 m2, mat4 dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count, mat4 *dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv(mat4 m, vec4 v, vec4 dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv_array(mat4 m, vec4 *v, size_t count, vec4 *dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv3_array(mat4 m, vec3 *v, float last, size_t count, vec3 *dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv3_soa(mat4   m,
+                    float *v[3],
+                    float  last,
+                    size_t count,
+                    float *dest[3]);
+
+CGLM_EXPORT
+void
+glmd_mat4_transpose_to(mat4 m, mat4 dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_inv(mat4 mat, mat4 dest);
+
+CGLM_EXPORT
+void
+glmd_mat4_inv_fast(mat4 mat, mat4 dest);
+
+CGLM_EXPORT
+void
+glmd_mat3_mul(mat3 m1, mat3 m2, mat3 dest);
+
+CGLM_EXPORT
+void
+glmd_quat_mul(versor p, versor q, versor dest);
+
+CGLM_EXPORT
+void
+glmd_quat_mat4(versor q, mat4 dest);
+
+CGLM_EXPORT
+void
+glmd_quat_slerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]);
+
+CGLM_EXPORT
+void
+glmd_quat_nlerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]);
+
+CGLM_EXPORT
+void
+glmd_aabb_frustum_soa(float    *min[3],
+                      float    *max[3],
+                      size_t    count,
+                      vec4      planes[6],
+                      uint32_t * __restrict visible);
+
+CGLM_EXPORT
+void
+glmd_sphere_transform_array(vec4 *s, mat4 *m, size_t count, vec4 *dest);
+
+CGLM_EXPORT
+void
+glmd_sphere_merge_array(vec4 *s, size_t count, vec4 dest);
+
+CGLM_EXPORT
+bool
+glmd_ray_triangle_soa(vec3    origin,
+                      vec3    direction,
+                      float  *tri[9],
+                      size_t  count,
+                      float  *d,
+                      size_t *index);
+
+CGLM_EXPORT
+bool
+glmd_bvh_ray(glm_bvh *bvh,
+             vec3     origin,
+             vec3     direction,
+             float   *d,
+             size_t  *tri);
+
+CGLM_EXPORT
+void
+glmd_pack_half_array(float *v, size_t count, uint16_t *dest);
+
+CGLM_EXPORT
+void
+glmd_unpack_half_array(uint16_t *v, size_t count, float *dest);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* cglm_dispatch_h */
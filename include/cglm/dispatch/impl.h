@@ -0,0 +1,322 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ Selection and entry points of the dispatch layer, see dispatch.h. Include it
+ from exactly one translation unit built with the baseline flags, it also
+ builds the baseline kernel set.
+ */
+
+#ifndef cglm_dispatch_impl_h
+#define cglm_dispatch_impl_h
+
+#include "isa.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define GLMD_X86 1
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  include <cpuid.h>
+#  define GLMD_X86 1
+#endif
+
+/* until glmd_init() the baseline set runs */
+static glmd_table glmd__table = {
+  glmd_base_mat4_mul,
+  glmd_base_mat4_mul_array,
+  glmd_base_mat4_mulv,
+  glmd_base_mat4_mulv_array,
+  glmd_base_mat4_mulv3_array,
+  glmd_base_mat4_mulv3_soa,
+  glmd_base_mat4_transpose_to,
+  glmd_base_mat4_inv,
+  glmd_base_mat4_inv_fast,
+  glmd_base_mat3_mul,
+  glmd_base_quat_mul,
+  glmd_base_quat_mat4,
+  glmd_base_quat_slerp_soa,
+  glmd_base_quat_nlerp_soa,
+  glmd_base_aabb_frustum_soa,
+  glmd_base_sphere_transform_array,
+  glmd_base_sphere_merge_array,
+  glmd_base_ray_triangle_soa,
+  glmd_base_bvh_ray,
+  glmd_base_pack_half_array,
+  glmd_base_unpack_half_array
+};
+static glmd_isa glmd__isa = GLMD_ISA_BASE;
+
+#ifdef GLMD_X86
+static
+void
+glmd__cpuid(unsigned leaf, unsigned sub, unsigned r[4]) {
+#if defined(_MSC_VER)
+  int regs[4];
+  __cpuidex(regs, (int)leaf, (int)sub);
+  r[0] = (unsigned)regs[0]; r[1] = (unsigned)regs[1];
+  r[2] = (unsigned)regs[2]; r[3] = (unsigned)regs[3];
+#else
+  __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+static
+uint64_t
+glmd__xgetbv(void) {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t lo, hi;
+  __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return ((uint64_t)hi << 32) | lo;
+#endif
+}
+#endif
+
+/* best ISA the CPU and the OS support, regardless of the build */
+static
+glmd_isa
+glmd__cpu(void) {
+#ifdef GLMD_X86
+  unsigned r[4];
+  uint64_t xcr0;
+  bool     avx2;
+
+  glmd__cpuid(0, 0, r);
+  if (r[0] < 7)
+    return GLMD_ISA_BASE;
+
+  /* FMA, OSXSAVE, AVX and F16C in ecx of leaf 1 */
+  glmd__cpuid(1, 0, r);
+  if ((r[2] & 0x38001000u) != 0x38001000u)
+    return GLMD_ISA_BASE;
+
+  /* the OS must save ymm state, and opmask + zmm state for AVX-512 */
+  xcr0 = glmd__xgetbv();
+  if ((xcr0 & 0x06) != 0x06)
+    return GLMD_ISA_BASE;
+
+  glmd__cpuid(7, 0, r);
+  avx2 = (r[1] >> 5) & 1;
+  if (!avx2)
+    return GLMD_ISA_BASE;
+
+  if (((r[1] >> 16) & 1) && (xcr0 & 0xE6) == 0xE6)
+    return GLMD_ISA_AVX512;
+
+  return GLMD_ISA_AVX2;
+#else
+  return GLMD_ISA_BASE;
+#endif
+}
+
+static
+bool
+glmd__load(glmd_isa isa, glmd_table *table) {
+  switch (isa) {
+    case GLMD_ISA_AVX512: return glmd_avx512_table(table);
+    case GLMD_ISA_AVX2:   return glmd_avx2_table(table);
+    default:              return glmd_base_table(table);
+  }
+}
+
+CGLM_EXPORT
+glmd_isa
+glmd_select(glmd_isa isa) {
+  glmd_table table;
+  glmd_isa   cpu;
+
+  cpu = glmd__cpu();
+  if (isa > cpu)
+    isa = cpu;
+
+  /* fall back while the build lacks a set, the baseline always exists */
+  while (!glmd__load(isa, &table))
+    isa = (glmd_isa)(isa - 1);
+
+  glmd__table = table;
+  glmd__isa   = isa;
+
+  return isa;
+}
+
+CGLM_EXPORT
+glmd_isa
+glmd_init(void) {
+  return glmd_select(GLMD_ISA_AVX512);
+}
+
+CGLM_EXPORT
+glmd_isa
+glmd_current(void) {
+  return glmd__isa;
+}
+
+CGLM_EXPORT
+const char*
+glmd_isa_name(glmd_isa isa) {
+  switch (isa) {
+    case GLMD_ISA_AVX512: return "avx512";
+    case GLMD_ISA_AVX2:   return "avx2";
+    default:              return "base";
+  }
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mul(mat4 m1, mat4 m2, mat4 dest) {
+  glmd__table.mat4_mul(m1, m2, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count, mat4 *dest) {
+  glmd__table.mat4_mul_array(m1, m2, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv(mat4 m, vec4 v, vec4 dest) {
+  glmd__table.mat4_mulv(m, v, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv_array(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  glmd__table.mat4_mulv_array(m, v, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv3_array(mat4 m, vec3 *v, float last, size_t count, vec3 *dest) {
+  glmd__table.mat4_mulv3_array(m, v, last, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_mulv3_soa(mat4   m,
+                    float *v[3],
+                    float  last,
+                    size_t count,
+                    float *dest[3]) {
+  glmd__table.mat4_mulv3_soa(m, v, last, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_transpose_to(mat4 m, mat4 dest) {
+  glmd__table.mat4_transpose_to(m, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_inv(mat4 mat, mat4 dest) {
+  glmd__table.mat4_inv(mat, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat4_inv_fast(mat4 mat, mat4 dest) {
+  glmd__table.mat4_inv_fast(mat, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_mat3_mul(mat3 m1, mat3 m2, mat3 dest) {
+  glmd__table.mat3_mul(m1, m2, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_quat_mul(versor p, versor q, versor dest) {
+  glmd__table.quat_mul(p, q, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_quat_mat4(versor q, mat4 dest) {
+  glmd__table.quat_mat4(q, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_quat_slerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]) {
+  glmd__table.quat_slerp_soa(from, to, t, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_quat_nlerp_soa(float *from[4],
+                    float *to[4],
+                    float  t,
+                    size_t count,
+                    float *dest[4]) {
+  glmd__table.quat_nlerp_soa(from, to, t, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_aabb_frustum_soa(float    *min[3],
+                      float    *max[3],
+                      size_t    count,
+                      vec4      planes[6],
+                      uint32_t * __restrict visible) {
+  glmd__table.aabb_frustum_soa(min, max, count, planes, visible);
+}
+
+CGLM_EXPORT
+void
+glmd_sphere_transform_array(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  glmd__table.sphere_transform_array(s, m, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_sphere_merge_array(vec4 *s, size_t count, vec4 dest) {
+  glmd__table.sphere_merge_array(s, count, dest);
+}
+
+CGLM_EXPORT
+bool
+glmd_ray_triangle_soa(vec3    origin,
+                      vec3    direction,
+                      float  *tri[9],
+                      size_t  count,
+                      float  *d,
+                      size_t *index) {
+  return glmd__table.ray_triangle_soa(origin, direction, tri, count, d, index);
+}
+
+CGLM_EXPORT
+bool
+glmd_bvh_ray(glm_bvh *bvh,
+             vec3     origin,
+             vec3     direction,
+             float   *d,
+             size_t  *tri) {
+  return glmd__table.bvh_ray(bvh, origin, direction, d, tri);
+}
+
+CGLM_EXPORT
+void
+glmd_pack_half_array(float *v, size_t count, uint16_t *dest) {
+  glmd__table.pack_half_array(v, count, dest);
+}
+
+CGLM_EXPORT
+void
+glmd_unpack_half_array(uint16_t *v, size_t count, float *dest) {
+  glmd__table.unpack_half_array(v, count, dest);
+}
+
+#undef GLMD_X86
+
+#endif /* cglm_dispatch_impl_h */
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ One kernel set of the dispatch layer, see dispatch.h. This must be the only
+ thing a translation unit includes, because the ISA has to be switched before
+ the first cglm header is seen. Define CGLM_DISPATCH_AVX2 or
+ CGLM_DISPATCH_AVX512 before including it, without either it builds the
+ baseline set (dispatch/impl.h does that).
+ */
+
+#ifndef cglm_dispatch_isa_h
+#define cglm_dispatch_isa_h
+
+#if defined(CGLM_DISPATCH_AVX512) || defined(CGLM_DISPATCH_AVX2)
+/* AVX raises mat4 alignment to 32, baseline callers only guarantee 16 */
+#  ifndef CGLM_ALL_UNALIGNED
+#    define CGLM_ALL_UNALIGNED
+#  endif
+#  if defined(__GNUC__) && !defined(__clang__) \
+      && (defined(__x86_64__) || defined(__i386__))
+#    ifdef CGLM_DISPATCH_AVX512
+#      pragma GCC target("avx,avx2,fma,f16c,avx512f")
+#    else
+#      pragma GCC target("avx,avx2,fma,f16c")
+#    endif
+#  endif
+#endif
+
+#include "../cglm.h"
+#include "table.h"
+
+#if defined(CGLM_DISPATCH_AVX512)
+#  define glmd__fn(name) glmd_avx512_##name
+#  if defined(__AVX512F__) && defined(__AVX2__) && defined(__FMA__) \
+      && defined(__F16C__)
+#    define glmd__enabled 1
+#  endif
+#elif defined(CGLM_DISPATCH_AVX2)
+#  define glmd__fn(name) glmd_avx2_##name
+#  if defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+#    define glmd__enabled 1
+#  endif
+#else
+#  define glmd__fn(name) glmd_base_##name
+#  define glmd__enabled 1
+#endif
+
+#ifdef glmd__enabled
+
+static
+void
+glmd__fn(mat4_mul)(mat4 m1, mat4 m2, mat4 dest) {
+  glm_mat4_mul(m1, m2, dest);
+}
+
+static
+void
+glmd__fn(mat4_mul_array)(mat4 *m1, mat4 *m2, size_t count, mat4 *dest) {
+  glm_mat4_mul_array(m1, m2, count, dest);
+}
+
+static
+void
+glmd__fn(mat4_mulv)(mat4 m, vec4 v, vec4 dest) {
+  glm_mat4_mulv(m, v, dest);
+}
+
+static
+void
+glmd__fn(mat4_mulv_array)(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  glm_mat4_mulv_array(m, v, count, dest);
+}
+
+static
+void
+glmd__fn(mat4_mulv3_array)(mat4   m,
+                           vec3  *v,
+                           float  last,
+                           size_t count,
+                           vec3  *dest) {
+  glm_mat4_mulv3_array(m, v, last, count, dest);
+}
+
+static
+void
+glmd__fn(mat4_mulv3_soa)(mat4   m,
+                         float *v[3],
+                         float  last,
+                         size_t count,
+                         float *dest[3]) {
+  glm_mat4_mulv3_soa(m, v, last, count, dest);
+}
+
+static
+void
+glmd__fn(mat4_transpose_to)(mat4 m, mat4 dest) {
+  glm_mat4_transpose_to(m, dest);
+}
+
+static
+void
+glmd__fn(mat4_inv)(mat4 mat, mat4 dest) {
+  glm_mat4_inv(mat, dest);
+}
+
+static
+void
+glmd__fn(mat4_inv_fast)(mat4 mat, mat4 dest) {
+  glm_mat4_inv_fast(mat, dest);
+}
+
+static
+void
+glmd__fn(mat3_mul)(mat3 m1, mat3 m2, mat3 dest) {
+  glm_mat3_mul(m1, m2, dest);
+}
+
+static
+void
+glmd__fn(quat_mul)(versor p, versor q, versor dest) {
+  glm_quat_mul(p, q, dest);
+}
+
+static
+void
+glmd__fn(quat_mat4)(versor q, mat4 dest) {
+  glm_quat_mat4(q, dest);
+}
+
+static
+void
+glmd__fn(quat_slerp_soa)(float *from[4],
+                         float *to[4],
+                         float  t,
+                         size_t count,
+                         float *dest[4]) {
+  glm_quat_slerp_soa(from, to, t, count, dest);
+}
+
+static
+void
+glmd__fn(quat_nlerp_soa)(float *from[4],
+                         float *to[4],
+                         float  t,
+                         size_t count,
+                         float *dest[4]) {
+  glm_quat_nlerp_soa(from, to, t, count, dest);
+}
+
+static
+void
+glmd__fn(aabb_frustum_soa)(float    *min[3],
+                           float    *max[3],
+                           size_t    count,
+                           vec4      planes[6],
+                           uint32_t * __restrict visible) {
+  glm_aabb_frustum_soa(min, max, count, planes, visible);
+}
+
+static
+void
+glmd__fn(sphere_transform_array)(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  glm_sphere_transform_array(s, m, count, dest);
+}
+
+static
+void
+glmd__fn(sphere_merge_array)(vec4 *s, size_t count, vec4 dest) {
+  glm_sphere_merge_array(s, count, dest);
+}
+
+static
+bool
+glmd__fn(ray_triangle_soa)(vec3    origin,
+                           vec3    direction,
+                           float  *tri[9],
+                           size_t  count,
+                           float  *d,
+                           size_t *index) {
+  return glm_ray_triangle_soa(origin, direction, tri, count, d, index);
+}
+
+static
+bool
+glmd__fn(bvh_ray)(glm_bvh *bvh,
+                  vec3     origin,
+                  vec3     direction,
+                  float   *d,
+                  size_t  *tri) {
+  return glm_bvh_ray(bvh, origin, direction, d, tri);
+}
+
+static
+void
+glmd__fn(pack_half_array)(float *v, size_t count, uint16_t *dest) {
+  glm_pack_half_array(v, count, dest);
+}
+
+static
+void
+glmd__fn(unpack_half_array)(uint16_t *v, size_t count, float *dest) {
+  glm_unpack_half_array(v, count, dest);
+}
+
+bool
+glmd__fn(table)(glmd_table *table) {
+  table->mat4_mul          = glmd__fn(mat4_mul);
+  table->mat4_mul_array    = glmd__fn(mat4_mul_array);
+  table->mat4_mulv         = glmd__fn(mat4_mulv);
+  table->mat4_mulv_array   = glmd__fn(mat4_mulv_array);
+  table->mat4_mulv3_array  = glmd__fn(mat4_mulv3_array);
+  table->mat4_mulv3_soa    = glmd__fn(mat4_mulv3_soa);
+  table->mat4_transpose_to = glmd__fn(mat4_transpose_to);
+  table->mat4_inv          = glmd__fn(mat4_inv);
+  table->mat4_inv_fast     = glmd__fn(mat4_inv_fast);
+  table->mat3_mul          = glmd__fn(mat3_mul);
+  table->quat_mul          = glmd__fn(quat_mul);
+  table->quat_mat4         = glmd__fn(quat_mat4);
+  table->quat_slerp_soa    = glmd__fn(quat_slerp_soa);
+  table->quat_nlerp_soa    = glmd__fn(quat_nlerp_soa);
+  table->aabb_frustum_soa  = glmd__fn(aabb_frustum_soa);
+  table->sphere_transform_array = glmd__fn(sphere_transform_array);
+  table->sphere_merge_array     = glmd__fn(sphere_merge_array);
+  table->ray_triangle_soa       = glmd__fn(ray_triangle_soa);
+  table->bvh_ray                = glmd__fn(bvh_ray);
+  table->pack_half_array        = glmd__fn(pack_half_array);
+  table->unpack_half_array      = glmd__fn(unpack_half_array);
+  return true;
+}
+
+#else
+
+bool
+glmd__fn(table)(glmd_table *table) {
+  (void)table;
+  return false;
+}
+
+#endif
+
+#undef glmd__fn
+#undef glmd__enabled
+
+#endif /* cglm_dispatch_isa_h */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ internal: kernel table shared by dispatch/isa.h and dispatch/impl.h
+ */
+
+#ifndef cglm_dispatch_table_h
+#define cglm_dispatch_table_h
+
+#include "../dispatch.h"
+
+typedef struct glmd_table {
+  void (*mat4_mul)(mat4 m1, mat4 m2, mat4 dest);
+  void (*mat4_mul_array)(mat4 *m1, mat4 *m2, size_t count, mat4 *dest);
+  void (*mat4_mulv)(mat4 m, vec4 v, vec4 dest);
+  void (*mat4_mulv_array)(mat4 m, vec4 *v, size_t count, vec4 *dest);
+  void (*mat4_mulv3_array)(mat4   m,
+                           vec3  *v,
+                           float  last,
+                           size_t count,
+                           vec3  *dest);
+  void (*mat4_mulv3_soa)(mat4   m,
+                         float *v[3],
+                         float  last,
+                         size_t count,
+                         float *dest[3]);
+  void (*mat4_transpose_to)(mat4 m, mat4 dest);
+  void (*mat4_inv)(mat4 mat, mat4 dest);
+  void (*mat4_inv_fast)(mat4 mat, mat4 dest);
+  void (*mat3_mul)(mat3 m1, mat3 m2, mat3 dest);
+  void (*quat_mul)(versor p, versor q, versor dest);
+  void (*quat_mat4)(versor q, mat4 dest);
+  void (*quat_slerp_soa)(float *from[4],
+                         float *to[4],
+                         float  t,
+                         size_t count,
+                         float *dest[4]);
+  void (*quat_nlerp_soa)(float *from[4],
+                         float *to[4],
+                         float  t,
+                         size_t count,
+                         float *dest[4]);
+  void (*aabb_frustum_soa)(float    *min[3],
+                           float    *max[3],
+                           size_t    count,
+                           vec4      planes[6],
+                           uint32_t * __restrict visible);
+  void (*sphere_transform_array)(vec4 *s, mat4 *m, size_t count, vec4 *dest);
+  void (*sphere_merge_array)(vec4 *s, size_t count, vec4 dest);
+  bool (*ray_triangle_soa)(vec3    origin,
+                           vec3    direction,
+                           float  *tri[9],
+                           size_t  count,
+                           float  *d,
+                           size_t *index);
+  bool (*bvh_ray)(glm_bvh *bvh,
+                  vec3     origin,
+                  vec3     direction,
+                  float   *d,
+                  size_t  *tri);
+  void (*pack_half_array)(float *v, size_t count, uint16_t *dest);
+  void (*unpack_half_array)(uint16_t *v, size_t count, float *dest);
+} glmd_table;
+
+/* each returns false if its translation unit was built without the ISA */
+bool glmd_base_table(glmd_table *table);
+bool glmd_avx2_table(glmd_table *table);
+bool glmd_avx512_table(glmd_table *table);
+
+#endif /* cglm_dispatch_table_h */
@@ -13,6 +13,7 @@
 #include "vec3.h"
 #include "vec4.h"
 #include "mat4.h"
+#include "cam.h"
 
 #define GLM_LBN 0 /* left  bottom near */
 #define GLM_LTN 1 /* left  top    near */
@@ -50,6 +51,14 @@
 
 #endif
 
+#ifdef CGLM_SSE_FP
+#  include "simd/sse2/frustum.h"
+#endif
+
+#ifdef CGLM_NEON_FP
+#  include "simd/neon/frustum.h"
+#endif
+
 /*!
  * @brief extracts view frustum planes
  *
@@ -252,4 +261,156 @@ glm_frustum_corners_at(vec4  corners[8],
   glm_vec4_add(corners[GLM_RBN], corner, planeCorners[3]);
 }
 
+/*!
+ * @brief computes split distances for cascaded shadow maps
+ *
+ * blends logarithmic and uniform splits (practical split scheme), lambda = 0
+ * is uniform, lambda = 1 is logarithmic, 0.5 - 0.8 are common.
+ * dest[0] is nearZ and dest[count] is farZ.
+ *
+ * @param[in]  nearZ  near distance of the view frustum
+ * @param[in]  farZ   far distance of the view frustum
+ * @param[in]  lambda weight of logarithmic splits
+ * @param[in]  count  number of cascades
+ * @param[out] dest   count + 1 split distances
+ */
+CGLM_INLINE
+void
+glm_frustum_splits(float  nearZ,
+                   float  farZ,
+                   float  lambda,
+                   size_t count,
+                   float *dest) {
+  float  f;
+  size_t i;
+
+  for (i = 1; i < count; i++) {
+    f       = (float)i / (float)count;
+    dest[i] = lambda * nearZ * powf(farZ / nearZ, f)
+              + (1.0f - lambda) * (nearZ + (farZ - nearZ) * f);
+  }
+
+  dest[0]     = nearZ;
+  dest[count] = farZ;
+}
+
+/*!
+ * @brief splits view frustum and sets up an orthographic projection per
+ *        cascade for cascaded shadow maps
+ *
+ * corners of all split planes are computed once and lerped in light space, so
+ * each cascade only needs one more plane. Projections are stabilized: x and y
+ * extents come from the bounding sphere of the cascade which does not change
+ * when the camera rotates, padded by one texel, and its center is snapped to
+ * shadow map texels so shadow edges don't shimmer when the camera moves. z extents are the
+ * depth range of the cascade, use glm_ortho_aabb_pz on boxes to make room for
+ * casters between the light and the cascade.
+ *
+ * cascade i is between planeCorners[i] and planeCorners[i + 1].
+ *
+ * @param[in]  corners      view frustum corners, see glm_frustum_corners
+ * @param[in]  nearZ        near distance of the view frustum
+ * @param[in]  farZ         far distance of the view frustum
+ * @param[in]  splits       count + 1 split distances, see glm_frustum_splits
+ * @param[in]  count        number of cascades
+ * @param[in]  lightView    light view matrix, rotation and translation only
+ * @param[in]  size         shadow map size in texels
+ * @param[out] planeCorners count + 1 split plane corners [LB, LT, RT, RB]
+ * @param[out] boxes        count light space boxes as [min, max]
+ * @param[out] proj         count orthographic projection matrices
+ */
+CGLM_INLINE
+void
+glm_frustum_cascades(vec4   corners[8],
+                     float  nearZ,
+                     float  farZ,
+                     float *splits,
+                     size_t count,
+                     mat4   lightView,
+                     float  size,
+                     vec4   planeCorners[][4],
+                     vec3   boxes[][2],
+                     mat4  *proj) {
+  float  r, texel, x, y;
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  glm_frustum_cascades_sse2(corners, nearZ, farZ, splits, count, lightView,
+                            planeCorners, boxes);
+#elif defined(CGLM_NEON_FP)
+  glm_frustum_cascades_neon(corners, nearZ, farZ, splits, count, lightView,
+                            planeCorners, boxes);
+#else
+  vec4  edge[4];
+  vec3  ln[4], le[4], l[8], center;
+  float t, z0, z1;
+  int   j;
+
+  /* light view is affine, so split corners can be lerped in light space */
+  for (j = 0; j < 4; j++) {
+    glm_vec4_sub(corners[j + 4], corners[j], edge[j]);
+    glm_mat4_mulv3(lightView, corners[j], 1.0f, ln[j]);
+    glm_mat4_mulv3(lightView, edge[j], 0.0f, le[j]);
+  }
+
+  for (i = 0; i <= count; i++) {
+    t = (splits[i] - nearZ) / (farZ - nearZ);
+
+    /* l[0..3] is the previous plane in light space, l[4..7] the current */
+    for (j = 0; j < 4; j++) {
+      glm_vec4_scale(edge[j], t, planeCorners[i][j]);
+      glm_vec4_add(planeCorners[i][j], corners[j], planeCorners[i][j]);
+      planeCorners[i][j][3] = 1.0f;
+
+      glm_vec3_scale(le[j], t, l[j + 4]);
+      glm_vec3_add(l[j + 4], ln[j], l[j + 4]);
+    }
+
+    if (i > 0) {
+      glm_vec3_zero(center);
+      for (j = 0; j < 8; j++)
+        glm_vec3_add(center, l[j], center);
+      glm_vec3_scale(center, 0.125f, center);
+
+      r  = 0.0f;
+      z0 = FLT_MAX;
+      z1 = -FLT_MAX;
+      for (j = 0; j < 8; j++) {
+        r  = glm_max(r, glm_vec3_distance2(center, l[j]));
+        z0 = glm_min(z0, l[j][2]);
+        z1 = glm_max(z1, l[j][2]);
+      }
+
+      boxes[i - 1][0][0] = center[0];
+      boxes[i - 1][0][1] = center[1];
+      boxes[i - 1][0][2] = z0;
+      boxes[i - 1][1][0] = sqrtf(r);
+      boxes[i - 1][1][1] = sqrtf(r);
+      boxes[i - 1][1][2] = z1;
+    }
+
+    for (j = 0; j < 4; j++)
+      glm_vec3_copy(l[j + 4], l[j]);
+  }
+#endif
+
+  /* boxes hold [{center x, center y, min z}, {radius, radius, max z}] */
+  for (i = 0; i < count; i++) {
+    /* pad radius by a texel so snapping the center down never uncovers the
+       cascade, r - 2r / size >= radius, then round it up, so float noise
+       doesn't change the texel size */
+    r     = ceilf(boxes[i][1][0] * 16.0f * size / (size - 2.0f)) * 0.0625f;
+    texel = 2.0f * r / size;
+    x     = floorf(boxes[i][0][0] / texel) * texel;
+    y     = floorf(boxes[i][0][1] / texel) * texel;
+
+    boxes[i][0][0] = x - r;
+    boxes[i][0][1] = y - r;
+    boxes[i][1][0] = x + r;
+    boxes[i][1][1] = y + r;
+
+    glm_ortho_aabb(boxes[i], proj[i]);
+  }
+}
+
 #endif /* cglm_frustum_h */
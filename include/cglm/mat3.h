@@ -42,6 +42,14 @@
 #  include "simd/sse2/mat3.h"
 #endif
 
+#ifdef CGLM_AVX2_FP
+#  include "simd/avx/mat3.h"
+#endif
+
+#ifdef CGLM_AVX512_FP
+#  include "simd/avx512/mat3.h"
+#endif
+
 #define GLM_MAT3_IDENTITY_INIT  {{1.0f, 0.0f, 0.0f},                          \
                                  {0.0f, 1.0f, 0.0f},                          \
                                  {0.0f, 0.0f, 1.0f}}
@@ -148,7 +156,11 @@ glm_mat3_zero(mat3 mat) {
 CGLM_INLINE
 void
 glm_mat3_mul(mat3 m1, mat3 m2, mat3 dest) {
-#if defined( __SSE__ ) || defined( __SSE2__ )
+#if defined(__AVX512F__)
+  glm_mat3_mul_avx512(m1, m2, dest);
+#elif defined(__AVX2__)
+  glm_mat3_mul_avx2(m1, m2, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
   glm_mat3_mul_sse2(m1, m2, dest);
 #else
   float a00 = m1[0][0], a01 = m1[0][1], a02 = m1[0][2],
@@ -28,8 +28,12 @@
    CGLM_INLINE void  glm_mat4_ins3(mat3 mat, mat4 dest);
    CGLM_INLINE void  glm_mat4_mul(mat4 m1, mat4 m2, mat4 dest);
    CGLM_INLINE void  glm_mat4_mulN(mat4 *matrices[], int len, mat4 dest);
+   CGLM_INLINE void  glm_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count, mat4 *dest);
    CGLM_INLINE void  glm_mat4_mulv(mat4 m, vec4 v, vec4 dest);
    CGLM_INLINE void  glm_mat4_mulv3(mat4 m, vec3 v, vec3 dest);
+   CGLM_INLINE void  glm_mat4_mulv_array(mat4 m, vec4 *v, size_t count, vec4 *dest);
+   CGLM_INLINE void  glm_mat4_mulv3_array(mat4 m, vec3 *v, float last, size_t count, vec3 *dest);
+   CGLM_INLINE void  glm_mat4_mulv3_soa(mat4 m, float *v[3], float last, size_t count, float *dest[3]);
    CGLM_INLINE float glm_mat4_trace(mat4 m);
    CGLM_INLINE float glm_mat4_trace3(mat4 m);
    CGLM_INLINE void  glm_mat4_quat(mat4 m, versor dest) ;
@@ -60,6 +64,10 @@
 #  include "simd/avx/mat4.h"
 #endif
 
+#ifdef CGLM_AVX512_FP
+#  include "simd/avx512/mat4.h"
+#endif
+
 #ifdef CGLM_NEON_FP
 #  include "simd/neon/mat4.h"
 #endif
@@ -367,6 +375,41 @@ glm_mat4_mulN(mat4 * __restrict matrices[], uint32_t len, mat4 dest) {
     glm_mat4_mul(dest, *matrices[i], dest);
 }
 
+/*!
+ * @brief multiply two arrays of matrices pair by pair, dest[i] = m1[i] * m2[i]
+ *
+ * this is the batch version of glm_mat4_mul, e.g. for updating world
+ * transforms of a transform hierarchy level by level:
+ * @code
+ * // parents[i] holds the world matrix of local[i]'s parent
+ * glm_mat4_mul_array(parents, local, count, world);
+ * @endcode
+ *
+ * with AVX and AVX-512 matrices are multiplied with whole columns or whole
+ * matrices per register, other paths loop over glm_mat4_mul.
+ *
+ * dest may be m1 or m2 but must not partially overlap them
+ *
+ * @param[in]  m1    left matrices
+ * @param[in]  m2    right matrices
+ * @param[in]  count count of matrices in each array
+ * @param[out] dest  result matrices
+ */
+CGLM_INLINE
+void
+glm_mat4_mul_array(mat4 *m1, mat4 *m2, size_t count, mat4 *dest) {
+#if defined(__AVX512F__)
+  glm_mat4_mul_array_avx512(m1, m2, count, dest);
+#elif defined(__AVX__)
+  glm_mat4_mul_array_avx(m1, m2, count, dest);
+#else
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    glm_mat4_mul(m1[i], m2[i], dest[i]);
+#endif
+}
+
 /*!
  * @brief multiply mat4 with vec4 (column vector) and store in dest vector
  *
@@ -486,6 +529,126 @@ glm_mat4_mulv3(mat4 m, vec3 v, float last, vec3 dest) {
   glm_vec3(res, dest);
 }
 
+/*!
+ * @brief multiply an array of vectors with mat4, dest[i] = m * v[i]
+ *
+ * e.g. for CPU skinning or preprocessing vertices. 1 or 2 vectors are
+ * transformed per iteration depending on the SIMD extension available.
+ * Outputs of CGLM_STREAM_MIN_BYTES or more are written with non-temporal
+ * stores on x86 if dest is aligned to the store size (16 or 32 bytes).
+ *
+ * dest may be v but must not partially overlap it
+ *
+ * @param[in]  m     mat4 (left)
+ * @param[in]  v     vectors (right, column vectors)
+ * @param[in]  count number of vectors
+ * @param[out] dest  result vectors
+ */
+CGLM_INLINE
+void
+glm_mat4_mulv_array(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  size_t i;
+
+#if defined(__AVX__)
+  i = glm_mat4_mulv_array_avx(m, v, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_mat4_mulv_array_sse2(m, v, count, dest);
+#elif defined(CGLM_NEON_FP)
+  i = glm_mat4_mulv_array_neon(m, v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    glm_mat4_mulv(m, v[i], dest[i]);
+}
+
+/*!
+ * @brief multiply an array of vec3 with mat4, see glm_mat4_mulv3
+ *
+ * 4 or 8 vectors are shuffled to x, y and z registers and transformed per
+ * iteration depending on the SIMD extension available. Outputs of
+ * CGLM_STREAM_MIN_BYTES or more are written with non-temporal stores on x86
+ * if dest is 16 byte aligned.
+ *
+ * dest may be v but must not partially overlap it
+ *
+ * @param[in]  m     mat4 (affine transform)
+ * @param[in]  v     vectors
+ * @param[in]  last  4th item of each vector, 1 for points and 0 for directions
+ * @param[in]  count number of vectors
+ * @param[out] dest  result vectors
+ */
+CGLM_INLINE
+void
+glm_mat4_mulv3_array(mat4 m, vec3 *v, float last, size_t count, vec3 *dest) {
+  size_t i;
+
+#if defined(__AVX__)
+  i = glm_mat4_mulv3_array_avx(m, v, last, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_mat4_mulv3_array_sse2(m, v, last, count, dest);
+#elif defined(CGLM_NEON_FP)
+  i = glm_mat4_mulv3_array_neon(m, v, last, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    glm_mat4_mulv3(m, v[i], last, dest[i]);
+}
+
+/*!
+ * @brief multiply vectors given as structure of arrays with mat4,
+ *        see glm_mat4_mulv3
+ *
+ * v[0] is the stream of x values, v[1] of y and v[2] of z, same for dest.
+ * 4 or 8 vectors are transformed per iteration depending on the SIMD
+ * extension available. Outputs of CGLM_STREAM_MIN_BYTES or more are written
+ * with non-temporal stores on x86 if all dest streams are aligned to the
+ * store size (16 or 32 bytes).
+ *
+ * dest streams may be v streams but must not partially overlap them
+ *
+ * @param[in]  m     mat4 (affine transform)
+ * @param[in]  v     x, y, z streams
+ * @param[in]  last  4th item of each vector, 1 for points and 0 for directions
+ * @param[in]  count number of vectors
+ * @param[out] dest  x, y, z streams of result vectors
+ */
+CGLM_INLINE
+void
+glm_mat4_mulv3_soa(mat4   m,
+                   float *v[3],
+                   float  last,
+                   size_t count,
+                   float *dest[3]) {
+  vec3   r;
+  size_t i;
+
+#if defined(__AVX__)
+  i = glm_mat4_mulv3_soa_avx(m, v, last, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_mat4_mulv3_soa_sse2(m, v, last, count, dest);
+#elif defined(CGLM_NEON_FP)
+  i = glm_mat4_mulv3_soa_neon(m, v, last, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    r[0] = v[0][i];
+    r[1] = v[1][i];
+    r[2] = v[2][i];
+
+    glm_mat4_mulv3(m, r, last, r);
+
+    dest[0][i] = r[0];
+    dest[1][i] = r[1];
+    dest[2][i] = r[2];
+  }
+}
+
 /*!
  * @brief transpose mat4 and store in dest
  *
@@ -616,7 +779,11 @@ glm_mat4_det(mat4 mat) {
 CGLM_INLINE
 void
 glm_mat4_inv(mat4 mat, mat4 dest) {
-#if defined( __SSE__ ) || defined( __SSE2__ )
+#if defined(__AVX512F__)
+  glm_mat4_inv_avx512(mat, dest);
+#elif defined(__AVX__)
+  glm_mat4_inv_avx(mat, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
   glm_mat4_inv_sse2(mat, dest);
 #elif defined(CGLM_NEON_FP)
   glm_mat4_inv_neon(mat, dest);
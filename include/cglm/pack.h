@@ -0,0 +1,666 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+/*
+ Conversions between floats and compact vertex formats, packed values match
+ the GPU formats of the same name (e.g. R16G16B16A16_SFLOAT, R8G8B8A8_UNORM,
+ A2B10G10R10_UNORM_PACK32). Array versions are component wise, pass
+ count * 2, 3 or 4 for vec2, vec3 or vec4 arrays.
+
+ Floats are rounded to nearest even and clamped to the range of the format,
+ NaN is only preserved by half floats.
+
+ Functions:
+   CGLM_INLINE uint16_t glm_pack_half(float f);
+   CGLM_INLINE float    glm_unpack_half(uint16_t h);
+   CGLM_INLINE uint8_t  glm_pack_unorm8(float f);
+   CGLM_INLINE float    glm_unpack_unorm8(uint8_t v);
+   CGLM_INLINE int8_t   glm_pack_snorm8(float f);
+   CGLM_INLINE float    glm_unpack_snorm8(int8_t v);
+   CGLM_INLINE uint16_t glm_pack_unorm16(float f);
+   CGLM_INLINE float    glm_unpack_unorm16(uint16_t v);
+   CGLM_INLINE int16_t  glm_pack_snorm16(float f);
+   CGLM_INLINE float    glm_unpack_snorm16(int16_t v);
+   CGLM_INLINE uint32_t glm_pack_oct(vec3 n);
+   CGLM_INLINE void     glm_unpack_oct(uint32_t p, vec3 dest);
+   CGLM_INLINE uint32_t glm_pack_unorm1010102(vec4 v);
+   CGLM_INLINE void     glm_unpack_unorm1010102(uint32_t p, vec4 dest);
+   CGLM_INLINE uint32_t glm_pack_snorm1010102(vec4 v);
+   CGLM_INLINE void     glm_unpack_snorm1010102(uint32_t p, vec4 dest);
+   CGLM_INLINE void glm_pack_half_array(float *v, size_t count,
+                                        uint16_t *dest);
+   CGLM_INLINE void glm_unpack_half_array(uint16_t *v, size_t count,
+                                          float *dest);
+   CGLM_INLINE void glm_pack_unorm8_array(float *v, size_t count,
+                                          uint8_t *dest);
+   CGLM_INLINE void glm_unpack_unorm8_array(uint8_t *v, size_t count,
+                                            float *dest);
+   CGLM_INLINE void glm_pack_snorm8_array(float *v, size_t count,
+                                          int8_t *dest);
+   CGLM_INLINE void glm_unpack_snorm8_array(int8_t *v, size_t count,
+                                            float *dest);
+   CGLM_INLINE void glm_pack_unorm16_array(float *v, size_t count,
+                                           uint16_t *dest);
+   CGLM_INLINE void glm_unpack_unorm16_array(uint16_t *v, size_t count,
+                                             float *dest);
+   CGLM_INLINE void glm_pack_snorm16_array(float *v, size_t count,
+                                           int16_t *dest);
+   CGLM_INLINE void glm_unpack_snorm16_array(int16_t *v, size_t count,
+                                             float *dest);
+   CGLM_INLINE void glm_pack_oct_array(vec3 *n, size_t count,
+                                       uint32_t *dest);
+   CGLM_INLINE void glm_unpack_oct_array(uint32_t *p, size_t count,
+                                         vec3 *dest);
+   CGLM_INLINE void glm_pack_unorm1010102_array(vec4 *v, size_t count,
+                                                uint32_t *dest);
+   CGLM_INLINE void glm_unpack_unorm1010102_array(uint32_t *p, size_t count,
+                                                  vec4 *dest);
+   CGLM_INLINE void glm_pack_snorm1010102_array(vec4 *v, size_t count,
+                                                uint32_t *dest);
+   CGLM_INLINE void glm_unpack_snorm1010102_array(uint32_t *p, size_t count,
+                                                  vec4 *dest);
+ */
+
+#ifndef cglm_pack_h
+#define cglm_pack_h
+
+#include "common.h"
+#include "util.h"
+
+#ifdef CGLM_SSE_FP
+#  include "simd/sse2/pack.h"
+#endif
+
+#ifdef CGLM_AVX_FP
+#  include "simd/avx/pack.h"
+#endif
+
+#ifdef CGLM_NEON_FP
+#  include "simd/neon/pack.h"
+#endif
+
+/*!
+ * @brief converts float to half float
+ *
+ * out of range values become infinity, NaN becomes a quiet NaN
+ *
+ * @param[in] f float
+ * @returns half float bits
+ */
+CGLM_INLINE
+uint16_t
+glm_pack_half(float f) {
+  union { float f; uint32_t u; } x, dn;
+  uint32_t sign, o;
+
+  x.f   = f;
+  sign  = x.u & 0x80000000u;
+  x.u  ^= sign;
+
+  if (x.u >= 0x47800000u) {
+    /* too large for half, infinity or NaN */
+    o = x.u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+  } else if (x.u < 0x38800000u) {
+    /* half denormal or zero, the add does the rounding */
+    dn.u = 0x3f000000u;
+    x.f += dn.f;
+    o    = x.u - dn.u;
+  } else {
+    /* rebias exponent and round mantissa to nearest even */
+    o = (x.u + 0xc8000fffu + ((x.u >> 13) & 1u)) >> 13;
+  }
+
+  return (uint16_t)(o | (sign >> 16));
+}
+
+/*!
+ * @brief converts half float to float, exact
+ *
+ * @param[in] h half float bits
+ * @returns float
+ */
+CGLM_INLINE
+float
+glm_unpack_half(uint16_t h) {
+  union { float f; uint32_t u; } o, scale;
+  uint32_t em;
+
+  em      = h & 0x7fffu;
+  scale.u = 0x77800000u; /* 2^112 moves exponent bias from 15 to 127 */
+  o.u     = em << 13;
+  o.f    *= scale.f;
+
+  if (em > 0x7bffu)
+    o.u |= 0x7f800000u;
+
+  o.u |= (uint32_t)(h & 0x8000u) << 16;
+
+  return o.f;
+}
+
+/*!
+ * @brief converts float in [0, 1] to 8-bit unsigned normalized
+ */
+CGLM_INLINE
+uint8_t
+glm_pack_unorm8(float f) {
+  return (uint8_t)lrintf(glm_clamp(f, 0.0f, 1.0f) * 255.0f);
+}
+
+/*!
+ * @brief converts 8-bit unsigned normalized to float
+ */
+CGLM_INLINE
+float
+glm_unpack_unorm8(uint8_t v) {
+  return (float)v / 255.0f;
+}
+
+/*!
+ * @brief converts float in [-1, 1] to 8-bit signed normalized
+ */
+CGLM_INLINE
+int8_t
+glm_pack_snorm8(float f) {
+  return (int8_t)lrintf(glm_clamp(f, -1.0f, 1.0f) * 127.0f);
+}
+
+/*!
+ * @brief converts 8-bit signed normalized to float, -128 becomes -1 too
+ */
+CGLM_INLINE
+float
+glm_unpack_snorm8(int8_t v) {
+  return glm_max((float)v / 127.0f, -1.0f);
+}
+
+/*!
+ * @brief converts float in [0, 1] to 16-bit unsigned normalized
+ */
+CGLM_INLINE
+uint16_t
+glm_pack_unorm16(float f) {
+  return (uint16_t)lrintf(glm_clamp(f, 0.0f, 1.0f) * 65535.0f);
+}
+
+/*!
+ * @brief converts 16-bit unsigned normalized to float
+ */
+CGLM_INLINE
+float
+glm_unpack_unorm16(uint16_t v) {
+  return (float)v / 65535.0f;
+}
+
+/*!
+ * @brief converts float in [-1, 1] to 16-bit signed normalized
+ */
+CGLM_INLINE
+int16_t
+glm_pack_snorm16(float f) {
+  return (int16_t)lrintf(glm_clamp(f, -1.0f, 1.0f) * 32767.0f);
+}
+
+/*!
+ * @brief converts 16-bit signed normalized to float, -32768 becomes -1 too
+ */
+CGLM_INLINE
+float
+glm_unpack_snorm16(int16_t v) {
+  return glm_max((float)v / 32767.0f, -1.0f);
+}
+
+/*!
+ * @brief encodes unit vector with octahedral mapping to 2 snorm16
+ *
+ * x is in low 16 bits and y in high 16 bits, e.g. R16G16_SNORM.
+ * Max angle error is about 0.005 degrees.
+ *
+ * @param[in] n non zero vector, need not be normalized
+ * @returns packed vector
+ */
+CGLM_INLINE
+uint32_t
+glm_pack_oct(vec3 n) {
+  float l, x, y, t;
+
+  l = 1.0f / (fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]));
+  x = n[0] * l;
+  y = n[1] * l;
+
+  /* fold lower hemisphere over the diagonals */
+  if (n[2] < 0.0f) {
+    t = x;
+    x = copysignf(1.0f - fabsf(y), x);
+    y = copysignf(1.0f - fabsf(t), y);
+  }
+
+  return (uint32_t)(uint16_t)glm_pack_snorm16(x)
+         | (uint32_t)(uint16_t)glm_pack_snorm16(y) << 16;
+}
+
+/*!
+ * @brief decodes octahedral mapped unit vector, see glm_pack_oct
+ *
+ * @param[in]  p    packed vector
+ * @param[out] dest unit vector
+ */
+CGLM_INLINE
+void
+glm_unpack_oct(uint32_t p, vec3 dest) {
+  float x, y, z, t, l;
+
+  x = glm_unpack_snorm16((int16_t)(p & 0xffffu));
+  y = glm_unpack_snorm16((int16_t)(p >> 16));
+  z = 1.0f - fabsf(x) - fabsf(y);
+  t = glm_max(-z, 0.0f);
+  x = x - copysignf(t, x);
+  y = y - copysignf(t, y);
+  l = 1.0f / sqrtf(x * x + y * y + z * z);
+
+  dest[0] = x * l;
+  dest[1] = y * l;
+  dest[2] = z * l;
+}
+
+/*!
+ * @brief converts vector in [0, 1] to 10-10-10-2 unsigned normalized
+ *
+ * x is in lowest 10 bits and w in highest 2 bits, e.g. A2B10G10R10_UNORM
+ */
+CGLM_INLINE
+uint32_t
+glm_pack_unorm1010102(vec4 v) {
+  return (uint32_t)lrintf(glm_clamp(v[0], 0.0f, 1.0f) * 1023.0f)
+         | (uint32_t)lrintf(glm_clamp(v[1], 0.0f, 1.0f) * 1023.0f) << 10
+         | (uint32_t)lrintf(glm_clamp(v[2], 0.0f, 1.0f) * 1023.0f) << 20
+         | (uint32_t)lrintf(glm_clamp(v[3], 0.0f, 1.0f) * 3.0f)    << 30;
+}
+
+/*!
+ * @brief converts 10-10-10-2 unsigned normalized to vector
+ */
+CGLM_INLINE
+void
+glm_unpack_unorm1010102(uint32_t p, vec4 dest) {
+  dest[0] = (float)(p         & 0x3ffu) / 1023.0f;
+  dest[1] = (float)((p >> 10) & 0x3ffu) / 1023.0f;
+  dest[2] = (float)((p >> 20) & 0x3ffu) / 1023.0f;
+  dest[3] = (float)(p >> 30)            / 3.0f;
+}
+
+/*!
+ * @brief converts vector in [-1, 1] to 10-10-10-2 signed normalized
+ *
+ * x is in lowest 10 bits and w in highest 2 bits, e.g. A2B10G10R10_SNORM
+ */
+CGLM_INLINE
+uint32_t
+glm_pack_snorm1010102(vec4 v) {
+  return ((uint32_t)lrintf(glm_clamp(v[0], -1.0f, 1.0f) * 511.0f) & 0x3ffu)
+         | ((uint32_t)lrintf(glm_clamp(v[1], -1.0f, 1.0f) * 511.0f)
+            & 0x3ffu) << 10
+         | ((uint32_t)lrintf(glm_clamp(v[2], -1.0f, 1.0f) * 511.0f)
+            & 0x3ffu) << 20
+         | (uint32_t)lrintf(glm_clamp(v[3], -1.0f, 1.0f)) << 30;
+}
+
+/*!
+ * @brief converts 10-10-10-2 signed normalized to vector
+ */
+CGLM_INLINE
+void
+glm_unpack_snorm1010102(uint32_t p, vec4 dest) {
+  dest[0] = glm_max((float)((int32_t)(p << 22) >> 22) / 511.0f, -1.0f);
+  dest[1] = glm_max((float)((int32_t)(p << 12) >> 22) / 511.0f, -1.0f);
+  dest[2] = glm_max((float)((int32_t)(p << 2)  >> 22) / 511.0f, -1.0f);
+  dest[3] = glm_max((float)((int32_t)p         >> 30),          -1.0f);
+}
+
+/*!
+ * @brief converts floats to half floats, see glm_pack_half
+ *
+ * @param[in]  v     floats
+ * @param[in]  count number of floats
+ * @param[out] dest  half floats
+ */
+CGLM_INLINE
+void
+glm_pack_half_array(float *v, size_t count, uint16_t *dest) {
+  size_t i;
+
+#if defined(__AVX__) && defined(__F16C__)
+  i = glm_pack_half_array_avx(v, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_half_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_half_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_half(v[i]);
+}
+
+/*!
+ * @brief converts half floats to floats, see glm_unpack_half
+ *
+ * @param[in]  v     half floats
+ * @param[in]  count number of half floats
+ * @param[out] dest  floats
+ */
+CGLM_INLINE
+void
+glm_unpack_half_array(uint16_t *v, size_t count, float *dest) {
+  size_t i;
+
+#if defined(__AVX__) && defined(__F16C__)
+  i = glm_unpack_half_array_avx(v, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_half_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_half_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_unpack_half(v[i]);
+}
+
+/*!
+ * @brief converts floats to 8-bit unsigned normalized, see glm_pack_unorm8
+ */
+CGLM_INLINE
+void
+glm_pack_unorm8_array(float *v, size_t count, uint8_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_unorm8_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_unorm8_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_unorm8(v[i]);
+}
+
+/*!
+ * @brief converts 8-bit unsigned normalized to floats
+ */
+CGLM_INLINE
+void
+glm_unpack_unorm8_array(uint8_t *v, size_t count, float *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_unorm8_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_unorm8_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_unpack_unorm8(v[i]);
+}
+
+/*!
+ * @brief converts floats to 8-bit signed normalized, see glm_pack_snorm8
+ */
+CGLM_INLINE
+void
+glm_pack_snorm8_array(float *v, size_t count, int8_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_snorm8_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_snorm8_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_snorm8(v[i]);
+}
+
+/*!
+ * @brief converts 8-bit signed normalized to floats
+ */
+CGLM_INLINE
+void
+glm_unpack_snorm8_array(int8_t *v, size_t count, float *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_snorm8_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_snorm8_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_unpack_snorm8(v[i]);
+}
+
+/*!
+ * @brief converts floats to 16-bit unsigned normalized, see glm_pack_unorm16
+ */
+CGLM_INLINE
+void
+glm_pack_unorm16_array(float *v, size_t count, uint16_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_unorm16_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_unorm16_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_unorm16(v[i]);
+}
+
+/*!
+ * @brief converts 16-bit unsigned normalized to floats
+ */
+CGLM_INLINE
+void
+glm_unpack_unorm16_array(uint16_t *v, size_t count, float *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_unorm16_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_unorm16_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_unpack_unorm16(v[i]);
+}
+
+/*!
+ * @brief converts floats to 16-bit signed normalized, see glm_pack_snorm16
+ */
+CGLM_INLINE
+void
+glm_pack_snorm16_array(float *v, size_t count, int16_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_snorm16_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_snorm16_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_snorm16(v[i]);
+}
+
+/*!
+ * @brief converts 16-bit signed normalized to floats
+ */
+CGLM_INLINE
+void
+glm_unpack_snorm16_array(int16_t *v, size_t count, float *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_snorm16_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_snorm16_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_unpack_snorm16(v[i]);
+}
+
+/*!
+ * @brief encodes normals with octahedral mapping, see glm_pack_oct
+ *
+ * @param[in]  n     non zero vectors
+ * @param[in]  count number of vectors
+ * @param[out] dest  packed vectors
+ */
+CGLM_INLINE
+void
+glm_pack_oct_array(vec3 *n, size_t count, uint32_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_oct_array_sse2(n, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_oct_array_neon(n, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_oct(n[i]);
+}
+
+/*!
+ * @brief decodes octahedral mapped normals, see glm_unpack_oct
+ *
+ * @param[in]  p     packed vectors
+ * @param[in]  count number of vectors
+ * @param[out] dest  unit vectors
+ */
+CGLM_INLINE
+void
+glm_unpack_oct_array(uint32_t *p, size_t count, vec3 *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_oct_array_sse2(p, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_oct_array_neon(p, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    glm_unpack_oct(p[i], dest[i]);
+}
+
+/*!
+ * @brief converts vectors to 10-10-10-2 unsigned normalized,
+ *        see glm_pack_unorm1010102
+ */
+CGLM_INLINE
+void
+glm_pack_unorm1010102_array(vec4 *v, size_t count, uint32_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_unorm1010102_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_unorm1010102_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_unorm1010102(v[i]);
+}
+
+/*!
+ * @brief converts 10-10-10-2 unsigned normalized to vectors
+ */
+CGLM_INLINE
+void
+glm_unpack_unorm1010102_array(uint32_t *p, size_t count, vec4 *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_unorm1010102_array_sse2(p, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_unorm1010102_array_neon(p, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    glm_unpack_unorm1010102(p[i], dest[i]);
+}
+
+/*!
+ * @brief converts vectors to 10-10-10-2 signed normalized,
+ *        see glm_pack_snorm1010102
+ */
+CGLM_INLINE
+void
+glm_pack_snorm1010102_array(vec4 *v, size_t count, uint32_t *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_pack_snorm1010102_array_sse2(v, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_pack_snorm1010102_array_neon(v, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    dest[i] = glm_pack_snorm1010102(v[i]);
+}
+
+/*!
+ * @brief converts 10-10-10-2 signed normalized to vectors
+ */
+CGLM_INLINE
+void
+glm_unpack_snorm1010102_array(uint32_t *p, size_t count, vec4 *dest) {
+  size_t i;
+
+#if defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_unpack_snorm1010102_array_sse2(p, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_unpack_snorm1010102_array_neon(p, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    glm_unpack_snorm1010102(p[i], dest[i]);
+}
+
+#endif /* cglm_pack_h */
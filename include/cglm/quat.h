@@ -40,6 +40,16 @@
    CGLM_INLINE void glm_quat_lerpc(versor from, versor to, float t, versor dest);
    CGLM_INLINE void glm_quat_slerp(versor q, versor r, float t, versor dest);
    CGLM_INLINE void glm_quat_nlerp(versor q, versor r, float t, versor dest);
+   CGLM_INLINE void glm_quat_slerp_soa(float *from[4],
+                                       float *to[4],
+                                       float  t,
+                                       size_t count,
+                                       float *dest[4]);
+   CGLM_INLINE void glm_quat_nlerp_soa(float *from[4],
+                                       float *to[4],
+                                       float  t,
+                                       size_t count,
+                                       float *dest[4]);
    CGLM_INLINE void glm_quat_look(vec3 eye, versor ori, mat4 dest);
    CGLM_INLINE void glm_quat_for(vec3 dir, vec3 fwd, vec3 up, versor dest);
    CGLM_INLINE void glm_quat_forp(vec3 from,
@@ -66,6 +76,14 @@
 #  include "simd/sse2/quat.h"
 #endif
 
+#ifdef CGLM_AVX_FP
+#  include "simd/avx/quat.h"
+#endif
+
+#ifdef CGLM_AVX512_FP
+#  include "simd/avx512/quat.h"
+#endif
+
 #ifdef CGLM_NEON_FP
 #  include "simd/neon/quat.h"
 #endif
@@ -438,7 +456,11 @@ glm_quat_mul(versor p, versor q, versor dest) {
     + (a1 d2 + b1 c2 − c1 b2 + d1 a2)k
        a1 a2 − b1 b2 − c1 c2 − d1 d2
    */
-#if defined( __SSE__ ) || defined( __SSE2__ )
+#if defined(__AVX512F__)
+  glm_quat_mul_avx512(p, q, dest);
+#elif defined(__AVX__)
+  glm_quat_mul_avx(p, q, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
   glm_quat_mul_sse2(p, q, dest);
 #elif defined(CGLM_NEON_FP)
   glm_quat_mul_neon(p, q, dest);
@@ -459,6 +481,16 @@ glm_quat_mul(versor p, versor q, versor dest) {
 CGLM_INLINE
 void
 glm_quat_mat4(versor q, mat4 dest) {
+#if defined(__AVX__)
+  float norm;
+
+  norm = glm_quat_norm(q);
+#if defined(__AVX512F__)
+  glm_quat_mat4_avx512(q, norm > 0.0f ? 2.0f / norm : 0.0f, dest);
+#else
+  glm_quat_mat4_avx(q, norm > 0.0f ? 2.0f / norm : 0.0f, dest);
+#endif
+#else
   float w, x, y, z,
         xx, yy, zz,
         xy, yz, xz,
@@ -495,6 +527,7 @@ glm_quat_mat4(versor q, mat4 dest) {
   dest[3][1] = 0.0f;
   dest[3][2] = 0.0f;
   dest[3][3] = 1.0f;
+#endif
 }
 
 /*!
@@ -720,6 +753,147 @@ glm_quat_slerp(versor from, versor to, float t, versor dest) {
   glm_vec4_scale(q1, 1.0f / sinTheta, dest);
 }
 
+/*!
+ * @brief interpolates many quaternions at once using spherical linear
+ *        interpolation, quaternions are given as structure of arrays
+ *
+ * from[0] is the stream of x components, from[3] the stream of w components
+ * and so on, each stream must hold count floats, no alignment is required.
+ * dest may be from or to.
+ *
+ * acos and sin are evaluated with polynomials (glm_acos01_approx,
+ * glm_sin_approx), for unit quaternions and t in [0, 1] the absolute error
+ * against an exact slerp stays below 1e-6. The shorter arc is always taken,
+ * nearly equal rotations are lerped. 4, 8 or 16 quaternions are interpolated
+ * at a time depending on the SIMD extension available, with FMA the last bit
+ * may differ from the scalar remainder loop.
+ *
+ * @param[in]   from  from quaternion streams, x y z w
+ * @param[in]   to    to quaternion streams, x y z w
+ * @param[in]   t     interpolant (amount) in [0, 1]
+ * @param[in]   count number of quaternions
+ * @param[out]  dest  result quaternion streams, x y z w
+ */
+CGLM_INLINE
+void
+glm_quat_slerp_soa(float *from[4],
+                   float *to[4],
+                   float  t,
+                   size_t count,
+                   float *dest[4]) {
+  float  f[4], q[4], c, th, s, a, b;
+  size_t i;
+  int    j;
+
+#if defined(__AVX512F__)
+  i = glm_quat_slerp_soa_avx512(from, to, t, count, dest);
+#elif defined(__AVX__)
+  i = glm_quat_slerp_soa_avx(from, to, t, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_quat_slerp_soa_sse2(from, to, t, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_quat_slerp_soa_neon(from, to, t, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    for (j = 0; j < 4; j++) {
+      f[j] = from[j][i];
+      q[j] = to[j][i];
+    }
+
+    c = f[0] * q[0];
+    c = f[1] * q[1] + c;
+    c = f[2] * q[2] + c;
+    c = f[3] * q[3] + c;
+
+    if (signbit(c)) {
+      glm_vec4_negate(f);
+      c = -c;
+    }
+
+    c  = glm_min(c, 1.0f);
+    th = glm_acos01_approx(c);
+    s  = glm_sin_approx(th);
+
+    if (s < 0.001f) {
+      a = 1.0f - t;
+      b = t;
+    } else {
+      s = 1.0f / s;
+      a = glm_sin_approx((1.0f - t) * th) * s;
+      b = glm_sin_approx(t * th) * s;
+    }
+
+    for (j = 0; j < 4; j++)
+      dest[j][i] = a * f[j] + b * q[j];
+  }
+}
+
+/*!
+ * @brief interpolates many quaternions at once using normalized linear
+ *        interpolation, quaternions are given as structure of arrays
+ *
+ * streams are laid out as in glm_quat_slerp_soa, dest may be from or to.
+ * The shorter arc is taken like glm_quat_nlerp does.
+ *
+ * @param[in]   from  from quaternion streams, x y z w
+ * @param[in]   to    to quaternion streams, x y z w
+ * @param[in]   t     interpolant (amount)
+ * @param[in]   count number of quaternions
+ * @param[out]  dest  result quaternion streams, x y z w
+ */
+CGLM_INLINE
+void
+glm_quat_nlerp_soa(float *from[4],
+                   float *to[4],
+                   float  t,
+                   size_t count,
+                   float *dest[4]) {
+  float  d[4], c, b, n;
+  size_t i;
+  int    j;
+
+#if defined(__AVX512F__)
+  i = glm_quat_nlerp_soa_avx512(from, to, t, count, dest);
+#elif defined(__AVX__)
+  i = glm_quat_nlerp_soa_avx(from, to, t, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_quat_nlerp_soa_sse2(from, to, t, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_quat_nlerp_soa_neon(from, to, t, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    c = from[0][i] * to[0][i];
+    c = from[1][i] * to[1][i] + c;
+    c = from[2][i] * to[2][i] + c;
+    c = from[3][i] * to[3][i] + c;
+
+    b = signbit(c) ? -t : t;
+
+    for (j = 0; j < 4; j++)
+      d[j] = (1.0f - t) * from[j][i] + b * to[j][i];
+
+    n = d[0] * d[0];
+    n = d[1] * d[1] + n;
+    n = d[2] * d[2] + n;
+    n = d[3] * d[3] + n;
+
+    if (n <= 0.0f) {
+      d[0] = d[1] = d[2] = 0.0f;
+      d[3] = n = 1.0f;
+    }
+
+    n = sqrtf(n);
+    for (j = 0; j < 4; j++)
+      dest[j][i] = d[j] / n;
+  }
+}
+
 /*!
  * @brief creates view matrix using quaternion as camera orientation
  *
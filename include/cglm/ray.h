@@ -13,6 +13,12 @@
                                                 vec3   v1,
                                                 vec3   v2,
                                                 float *d);
+   CGLM_INLINE bool glm_ray_triangle_soa(vec3    origin,
+                                         vec3    direction,
+                                         float  *tri[9],
+                                         size_t  count,
+                                         float  *d,
+                                         size_t *index);
 */
 
 #ifndef cglm_ray_h
@@ -20,6 +26,18 @@
 
 #include "vec3.h"
 
+#ifdef CGLM_SSE_FP
+#  include "simd/sse2/ray.h"
+#endif
+
+#ifdef CGLM_AVX_FP
+#  include "simd/avx/ray.h"
+#endif
+
+#ifdef CGLM_NEON_FP
+#  include "simd/neon/ray.h"
+#endif
+
 /*!
  * @brief Möller–Trumbore ray-triangle intersection algorithm
  * 
@@ -74,4 +92,88 @@ glm_ray_triangle(vec3   origin,
   return dist > epsilon;
 }
 
+/*!
+ * @brief nearest hit of a ray against many triangles, Möller–Trumbore
+ *
+ * triangles are stored as structure of arrays: tri[0..2] hold x, y, z of the
+ * first vertex, tri[3..5] of the first edge (v1 - v0) and tri[6..8] of the
+ * second edge (v2 - v0). 4 or 8 triangles are tested at a time depending on
+ * the SIMD extension available, with the same arithmetic as
+ * glm_ray_triangle so the result does not depend on it.
+ *
+ * @param[in]      origin    origin of ray
+ * @param[in]      direction direction of ray
+ * @param[in]      tri       first vertices and edges of triangles
+ * @param[in]      count     number of triangles
+ * @param[in, out] d         in: farthest distance to accept (e.g. FLT_MAX),
+ *                           out: distance to nearest intersection
+ * @param[out]     index     index of nearest triangle, lowest one on ties
+ * @return whether there is intersection closer than d
+ */
+CGLM_INLINE
+bool
+glm_ray_triangle_soa(vec3    origin,
+                     vec3    direction,
+                     float  *tri[9],
+                     size_t  count,
+                     float  *d,
+                     size_t *index) {
+  vec3        e1, e2, p, t, q;
+  float       det, inv_det, u, v, dist, best;
+  size_t      i;
+  const float epsilon = 0.000001f;
+
+  best = *d;
+
+#if defined(__AVX__)
+  i = glm_ray_triangle_soa_avx(origin, direction, tri, count, &best, index);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_ray_triangle_soa_sse2(origin, direction, tri, count, &best, index);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_ray_triangle_soa_neon(origin, direction, tri, count, &best, index);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    e1[0] = tri[3][i]; e1[1] = tri[4][i]; e1[2] = tri[5][i];
+    e2[0] = tri[6][i]; e2[1] = tri[7][i]; e2[2] = tri[8][i];
+
+    glm_vec3_cross(direction, e2, p);
+
+    det = glm_vec3_dot(e1, p);
+    if (det > -epsilon && det < epsilon)
+      continue;
+
+    inv_det = 1.0f / det;
+
+    t[0] = origin[0] - tri[0][i];
+    t[1] = origin[1] - tri[1][i];
+    t[2] = origin[2] - tri[2][i];
+
+    u = glm_vec3_dot(t, p) * inv_det;
+    if (u < 0.0f || u > 1.0f)
+      continue;
+
+    glm_vec3_cross(t, e1, q);
+
+    v = glm_vec3_dot(direction, q) * inv_det;
+    if (v < 0.0f || u + v > 1.0f)
+      continue;
+
+    dist = glm_vec3_dot(e2, q) * inv_det;
+    if (dist > epsilon && dist < best) {
+      best   = dist;
+      *index = i;
+    }
+  }
+
+  if (best < *d) {
+    *d = best;
+    return true;
+  }
+
+  return false;
+}
+
 #endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_box_simd_avx_h
+#define cglm_box_simd_avx_h
+#ifdef __AVX__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/*!
+ * @brief tests 8 boxes per iteration against frustum planes, see
+ *        glm_aabb_frustum_soa
+ *
+ * @returns number of boxes tested, always a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_aabb_frustum_soa_avx(float    *min[3],
+                         float    *max[3],
+                         size_t    count,
+                         vec4      planes[6],
+                         uint32_t * __restrict visible) {
+  float   *px[6], *py[6], *pz[6];
+  __m256   nx[6], ny[6], nz[6], nw[6], x, y, z, dp, vis;
+  uint32_t bits;
+  size_t   i;
+  int      j;
+
+  for (j = 0; j < 6; j++) {
+    px[j] = planes[j][0] > 0.0f ? max[0] : min[0];
+    py[j] = planes[j][1] > 0.0f ? max[1] : min[1];
+    pz[j] = planes[j][2] > 0.0f ? max[2] : min[2];
+
+    nx[j] = _mm256_set1_ps(planes[j][0]);
+    ny[j] = _mm256_set1_ps(planes[j][1]);
+    nz[j] = _mm256_set1_ps(planes[j][2]);
+    nw[j] = _mm256_set1_ps(-planes[j][3]);
+  }
+
+  bits = 0;
+  for (i = 0; i + 8 <= count; i += 8) {
+    vis = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    /* mul + add instead of fma keeps results identical to the scalar test */
+    for (j = 0; j < 6; j++) {
+      x   = _mm256_loadu_ps(px[j] + i);
+      y   = _mm256_loadu_ps(py[j] + i);
+      z   = _mm256_loadu_ps(pz[j] + i);
+      dp  = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[j], x),
+                                        _mm256_mul_ps(ny[j], y)),
+                          _mm256_mul_ps(nz[j], z));
+      vis = _mm256_and_ps(vis, _mm256_cmp_ps(dp, nw[j], _CMP_NLT_UQ));
+    }
+
+    bits |= (uint32_t)_mm256_movemask_ps(vis) << (i & 31);
+    if (((i + 8) & 31) == 0) {
+      visible[i >> 5] = bits;
+      bits            = 0;
+    }
+  }
+
+  if (i & 31)
+    visible[i >> 5] = bits;
+
+  return i;
+}
+
+#endif
+#endif /* cglm_box_simd_avx_h */
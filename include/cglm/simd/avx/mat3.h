@@ -0,0 +1,60 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_mat3_simd_avx_h
+#define cglm_mat3_simd_avx_h
+#ifdef __AVX2__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+CGLM_INLINE
+void
+glm_mat3_mul_avx2(mat3 m1, mat3 m2, mat3 dest) {
+  /*
+   the first 8 floats of dest are one y register, lane n is
+   column n / 3, row n % 3:
+     dest[n] = m1[0][n % 3] * m2[n / 3][0]
+             + m1[1][n % 3] * m2[n / 3][1]
+             + m1[2][n % 3] * m2[n / 3][2]
+   the 9th float is a plain dot product
+   */
+
+  __m256i i0, i1, i2, i3, i4;
+  __m256  y0, y1, y2, y3, y4;
+  float   d22;
+
+  y0 = _mm256_loadu_ps(m1[0]);     /* a21 a20 a12 a11 a10 a02 a01 a00 */
+  y1 = _mm256_loadu_ps(&m1[0][1]); /* a22 a21 a20 a12 a11 a10 a02 a01 */
+  y2 = _mm256_loadu_ps(m2[0]);     /* b21 b20 b12 b11 b10 b02 b01 b00 */
+  y3 = _mm256_loadu_ps(&m2[0][1]); /* b22 b21 b20 b12 b11 b10 b02 b01 */
+
+  i0 = _mm256_setr_epi32(0, 1, 2, 0, 1, 2, 0, 1);
+  i1 = _mm256_setr_epi32(3, 4, 5, 3, 4, 5, 3, 4);
+  i2 = _mm256_setr_epi32(5, 6, 7, 5, 6, 7, 5, 6);
+  i3 = _mm256_setr_epi32(0, 0, 0, 3, 3, 3, 6, 6);
+  i4 = _mm256_setr_epi32(1, 1, 1, 4, 4, 4, 7, 7);
+
+  d22 = m1[0][2] * m2[2][0] + m1[1][2] * m2[2][1] + m1[2][2] * m2[2][2];
+
+  y4 = _mm256_mul_ps(_mm256_permutevar8x32_ps(y0, i0),
+                     _mm256_permutevar8x32_ps(y2, i3));
+  y4 = glmm256_fmadd(_mm256_permutevar8x32_ps(y0, i1),
+                     _mm256_permutevar8x32_ps(y2, i4),
+                     y4);
+  y4 = glmm256_fmadd(_mm256_permutevar8x32_ps(y1, i2),
+                     _mm256_permutevar8x32_ps(y3, i4),
+                     y4);
+
+  _mm256_storeu_ps(dest[0], y4);
+  dest[2][2] = d22;
+}
+
+#endif
+#endif /* cglm_mat3_simd_avx_h */
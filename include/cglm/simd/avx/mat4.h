@@ -72,5 +72,309 @@ glm_mat4_mul_avx(mat4 m1, mat4 m2, mat4 dest) {
                                             _mm256_mul_ps(y5, y9))));
 }
 
+CGLM_INLINE
+void
+glm_mat4_mul_array_avx(mat4 *m1, mat4 *m2, size_t count, mat4 *dest) {
+  /* D = R * L (Column-Major), each 128 bit lane holds one column of D */
+
+  __m256 y0, y1, y2, y3, y4, y5, y6, y7;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    /* both lanes get the same column of L, broadcasts are free loads */
+    y0 = _mm256_broadcast_ps((__m128 *)m1[i][0]);
+    y1 = _mm256_broadcast_ps((__m128 *)m1[i][1]);
+    y2 = _mm256_broadcast_ps((__m128 *)m1[i][2]);
+    y3 = _mm256_broadcast_ps((__m128 *)m1[i][3]);
+
+    y4 = glmm_load256(m2[i][0]); /* h g f e d c b a */
+    y5 = glmm_load256(m2[i][2]); /* p o n m l k j i */
+
+    /* e e e e a a a a, f f f f b b b b, ... */
+    y6 = _mm256_mul_ps(y0, _mm256_permute_ps(y4, 0x00));
+    y7 = _mm256_mul_ps(y0, _mm256_permute_ps(y5, 0x00));
+    y6 = _mm256_add_ps(y6, _mm256_mul_ps(y1, _mm256_permute_ps(y4, 0x55)));
+    y7 = _mm256_add_ps(y7, _mm256_mul_ps(y1, _mm256_permute_ps(y5, 0x55)));
+    y6 = _mm256_add_ps(y6, _mm256_mul_ps(y2, _mm256_permute_ps(y4, 0xAA)));
+    y7 = _mm256_add_ps(y7, _mm256_mul_ps(y2, _mm256_permute_ps(y5, 0xAA)));
+    y6 = _mm256_add_ps(y6, _mm256_mul_ps(y3, _mm256_permute_ps(y4, 0xFF)));
+    y7 = _mm256_add_ps(y7, _mm256_mul_ps(y3, _mm256_permute_ps(y5, 0xFF)));
+
+    glmm_store256(dest[i][0], y6);
+    glmm_store256(dest[i][2], y7);
+  }
+}
+
+CGLM_INLINE
+void
+glm_mat4_inv_avx(mat4 mat, mat4 dest) {
+  /*
+   2x2 block inverse, the matrix is split into the blocks
+     A B
+     C D
+   and each pair of blocks that is computed alike shares one y register:
+     X = |D|A - B(D#C)        W = |A|D - C(A#B)
+     Y = |B|C - D(A#B)#       Z = |C|B - A(D#C)#
+   where # is the adjugate. Blocks of columns work the same as blocks of
+   rows, since inverse(transpose(M)) = transpose(inverse(M)).
+   */
+
+  __m128 r0, r1, r2, r3, a, b, c, d, x0, x1, x2;
+  __m256 y0, y1, y2, y3, y4, y5, y6, y7;
+
+  r0 = glmm_load(mat[0]); /* d c b a */
+  r1 = glmm_load(mat[1]); /* h g f e */
+  r2 = glmm_load(mat[2]); /* l k j i */
+  r3 = glmm_load(mat[3]); /* p o n m */
+
+  a = _mm_movelh_ps(r0, r1);               /* f e b a */
+  b = _mm_movehl_ps(r1, r0);               /* h g d c */
+  c = _mm_movelh_ps(r2, r3);               /* n m j i */
+  d = _mm_movehl_ps(r3, r2);               /* p o l k */
+
+  /* |A| |B| |C| |D| */
+  x0 = _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)),
+                  _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1)));
+  x0 = glmm_fnmadd(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)),
+                   _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)),
+                   x0);
+
+  y0 = _mm256_set_m128(d, a);              /* D | A */
+  y1 = _mm256_set_m128(c, b);              /* C | B */
+
+  /* D#C | A#B */
+  y2 = _mm256_mul_ps(_mm256_permute_ps(y0, _MM_SHUFFLE(0, 0, 3, 3)), y1);
+  y2 = glmm256_fnmadd(_mm256_permute_ps(y0, _MM_SHUFFLE(2, 2, 1, 1)),
+                      _mm256_permute_ps(y1, _MM_SHUFFLE(1, 0, 3, 2)),
+                      y2);
+  y3 = _mm256_permute2f128_ps(y2, y2, 0x01); /* A#B | D#C */
+
+  /* W | X = |A||D| * D | A - (C | B) * (A#B | D#C) */
+  y4 = _mm256_set_m128(x0, x0);
+  y5 = _mm256_permutevar_ps(y4, _mm256_set_epi32(0, 0, 0, 0, 3, 3, 3, 3));
+  y5 = _mm256_mul_ps(y5, y0);
+  y5 = glmm256_fnmadd(y1, _mm256_permute_ps(y3, _MM_SHUFFLE(3, 0, 3, 0)), y5);
+  y5 = glmm256_fnmadd(_mm256_permute_ps(y1, _MM_SHUFFLE(2, 3, 0, 1)),
+                      _mm256_permute_ps(y3, _MM_SHUFFLE(1, 2, 1, 2)),
+                      y5);
+
+  /* Z | Y = |C||B| * B | C - (A | D) * (D#C | A#B)# */
+  y6 = _mm256_permute2f128_ps(y0, y0, 0x01); /* A | D */
+  y7 = _mm256_permutevar_ps(y4, _mm256_set_epi32(2, 2, 2, 2, 1, 1, 1, 1));
+  y7 = _mm256_mul_ps(y7, _mm256_permute2f128_ps(y1, y1, 0x01));
+  y7 = glmm256_fnmadd(y6, _mm256_permute_ps(y2, _MM_SHUFFLE(0, 3, 0, 3)), y7);
+  y7 = glmm256_fmadd(_mm256_permute_ps(y6, _MM_SHUFFLE(2, 3, 0, 1)),
+                     _mm256_permute_ps(y2, _MM_SHUFFLE(1, 2, 1, 2)),
+                     y7);
+
+  /* |M| = |A||D| + |B||C| - tr((A#B)(D#C)) */
+  x1 = _mm_mul_ps(x0, glmm_shuff1(x0, 0, 1, 2, 3));
+  x1 = _mm_add_ps(glmm_splat_x(x1), glmm_splat_y(x1));
+  x2 = _mm_mul_ps(_mm256_castps256_ps128(y2),
+                  glmm_shuff1(_mm256_extractf128_ps(y2, 1), 3, 1, 2, 0));
+  x1 = _mm_sub_ps(x1, glmm_vhadd(x2));
+  x1 = _mm_div_ps(_mm_set_ps(1.0f, -1.0f, -1.0f, 1.0f), x1);
+
+  y4 = _mm256_set_m128(x1, x1);
+  y5 = _mm256_mul_ps(y5, y4);
+  y7 = _mm256_mul_ps(y7, y4);
+
+  /* adjugate of each block, back to columns: Z | X and W | Y */
+  y0 = _mm256_blend_ps(y5, y7, 0xF0);
+  y1 = _mm256_blend_ps(y7, y5, 0xF0);
+  y2 = _mm256_shuffle_ps(y0, y1, _MM_SHUFFLE(1, 3, 1, 3)); /* 2 | 0 */
+  y3 = _mm256_shuffle_ps(y0, y1, _MM_SHUFFLE(0, 2, 0, 2)); /* 3 | 1 */
+
+  glmm_store256(dest[0], _mm256_permute2f128_ps(y2, y3, 0x20));
+  glmm_store256(dest[2], _mm256_permute2f128_ps(y2, y3, 0x31));
+}
+
+/* 8 lanes version of glmm_mat4_mulv3_soa */
+#define glmm256_mat4_mulv3_soa(M, B, X, Y, Z, R)                              \
+  do {                                                                        \
+    R[0] = glmm256_fmadd(M[0][0], X,                                          \
+                         glmm256_fmadd(M[1][0], Y,                            \
+                                       glmm256_fmadd(M[2][0], Z, B[0])));     \
+    R[1] = glmm256_fmadd(M[0][1], X,                                          \
+                         glmm256_fmadd(M[1][1], Y,                            \
+                                       glmm256_fmadd(M[2][1], Z, B[1])));     \
+    R[2] = glmm256_fmadd(M[0][2], X,                                          \
+                         glmm256_fmadd(M[1][2], Y,                            \
+                                       glmm256_fmadd(M[2][2], Z, B[2])));     \
+  } while (0)
+
+/*!
+ * @brief transforms 2 vectors per iteration, see glm_mat4_mulv_array
+ *
+ * @returns number of vectors transformed, a multiple of 2
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv_array_avx(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  __m256 y0, y1, y2, y3, x0, x1;
+  size_t i;
+  bool   nt;
+
+  /* each column in both lanes */
+  y0 = _mm256_broadcast_ps((__m128 *)m[0]);
+  y1 = _mm256_broadcast_ps((__m128 *)m[1]);
+  y2 = _mm256_broadcast_ps((__m128 *)m[2]);
+  y3 = _mm256_broadcast_ps((__m128 *)m[3]);
+  nt = count * sizeof(vec4) >= CGLM_STREAM_MIN_BYTES
+       && ((uintptr_t)dest & 31) == 0;
+
+  for (i = 0; i + 2 <= count; i += 2) {
+    x0 = _mm256_loadu_ps(v[i]);
+
+    x1 = _mm256_mul_ps(y3, _mm256_permute_ps(x0, _MM_SHUFFLE(3, 3, 3, 3)));
+    x1 = glmm256_fmadd(y2, _mm256_permute_ps(x0, _MM_SHUFFLE(2, 2, 2, 2)), x1);
+    x1 = glmm256_fmadd(y1, _mm256_permute_ps(x0, _MM_SHUFFLE(1, 1, 1, 1)), x1);
+    x1 = glmm256_fmadd(y0, _mm256_permute_ps(x0, _MM_SHUFFLE(0, 0, 0, 0)), x1);
+
+    if (nt)
+      _mm256_stream_ps(dest[i], x1);
+    else
+      _mm256_storeu_ps(dest[i], x1);
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
+/*!
+ * @brief transforms 8 vectors per iteration, see glm_mat4_mulv3_array
+ *
+ * each lane takes 4 vec3 and shuffles them like glm_mat4_mulv3_array_sse2.
+ *
+ * @returns number of vectors transformed, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_array_avx(mat4   m,
+                         vec3  *v,
+                         float  last,
+                         size_t count,
+                         vec3  *dest) {
+  __m256 c[3][3], b[3], r[3], a0, a1, a2, x, y, z, t0, t1;
+  float *p;
+  size_t i;
+  int    j, k;
+  bool   nt;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = _mm256_set1_ps(m[j][k]);
+    b[j] = _mm256_mul_ps(_mm256_set1_ps(m[3][j]), _mm256_set1_ps(last));
+  }
+
+  nt = count * sizeof(vec3) >= CGLM_STREAM_MIN_BYTES
+       && ((uintptr_t)dest & 15) == 0;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    p  = v[i];
+    a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)),
+                              _mm_loadu_ps(p + 12), 1);
+    a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)),
+                              _mm_loadu_ps(p + 16), 1);
+    a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)),
+                              _mm_loadu_ps(p + 20), 1);
+
+    t0 = _mm256_shuffle_ps(a1, a2, _MM_SHUFFLE(1, 1, 2, 2));
+    x  = _mm256_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+    t0 = _mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(0, 0, 1, 1));
+    t1 = _mm256_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 2, 3, 3));
+    y  = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 1, 2, 2));
+    z  = _mm256_shuffle_ps(t0, a2, _MM_SHUFFLE(3, 0, 2, 0));
+
+    glmm256_mat4_mulv3_soa(c, b, x, y, z, r);
+
+    t0 = _mm256_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 0, 0));
+    t1 = _mm256_shuffle_ps(r[2], r[0], _MM_SHUFFLE(1, 1, 0, 0));
+    a0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm256_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 1, 1, 1));
+    t1 = _mm256_shuffle_ps(r[0], r[1], _MM_SHUFFLE(2, 2, 2, 2));
+    a1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm256_shuffle_ps(r[2], r[0], _MM_SHUFFLE(3, 3, 2, 2));
+    t1 = _mm256_shuffle_ps(r[1], r[2], _MM_SHUFFLE(3, 3, 3, 3));
+    a2 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+
+    p = dest[i];
+    if (nt) {
+      _mm_stream_ps(p,      _mm256_castps256_ps128(a0));
+      _mm_stream_ps(p + 4,  _mm256_castps256_ps128(a1));
+      _mm_stream_ps(p + 8,  _mm256_castps256_ps128(a2));
+      _mm_stream_ps(p + 12, _mm256_extractf128_ps(a0, 1));
+      _mm_stream_ps(p + 16, _mm256_extractf128_ps(a1, 1));
+      _mm_stream_ps(p + 20, _mm256_extractf128_ps(a2, 1));
+    } else {
+      _mm_storeu_ps(p,      _mm256_castps256_ps128(a0));
+      _mm_storeu_ps(p + 4,  _mm256_castps256_ps128(a1));
+      _mm_storeu_ps(p + 8,  _mm256_castps256_ps128(a2));
+      _mm_storeu_ps(p + 12, _mm256_extractf128_ps(a0, 1));
+      _mm_storeu_ps(p + 16, _mm256_extractf128_ps(a1, 1));
+      _mm_storeu_ps(p + 20, _mm256_extractf128_ps(a2, 1));
+    }
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
+/*!
+ * @brief transforms 8 vectors per iteration, see glm_mat4_mulv3_soa
+ *
+ * @returns number of vectors transformed, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_soa_avx(mat4   m,
+                       float *v[3],
+                       float  last,
+                       size_t count,
+                       float *dest[3]) {
+  __m256 c[3][3], b[3], r[3], x, y, z;
+  size_t i;
+  int    j, k;
+  bool   nt;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = _mm256_set1_ps(m[j][k]);
+    b[j] = _mm256_mul_ps(_mm256_set1_ps(m[3][j]), _mm256_set1_ps(last));
+  }
+
+  nt = count * sizeof(vec3) >= CGLM_STREAM_MIN_BYTES
+       && (((uintptr_t)dest[0] | (uintptr_t)dest[1] | (uintptr_t)dest[2])
+           & 31) == 0;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    x = _mm256_loadu_ps(v[0] + i);
+    y = _mm256_loadu_ps(v[1] + i);
+    z = _mm256_loadu_ps(v[2] + i);
+
+    glmm256_mat4_mulv3_soa(c, b, x, y, z, r);
+
+    if (nt) {
+      _mm256_stream_ps(dest[0] + i, r[0]);
+      _mm256_stream_ps(dest[1] + i, r[1]);
+      _mm256_stream_ps(dest[2] + i, r[2]);
+    } else {
+      _mm256_storeu_ps(dest[0] + i, r[0]);
+      _mm256_storeu_ps(dest[1] + i, r[1]);
+      _mm256_storeu_ps(dest[2] + i, r[2]);
+    }
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
 #endif
 #endif /* cglm_mat_simd_avx_h */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_pack_simd_avx_h
+#define cglm_pack_simd_avx_h
+#if defined(__AVX__) && defined(__F16C__)
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/*!
+ * @brief converts 16 floats per iteration with F16C,
+ *        see glm_pack_half_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_half_array_avx(float *v, size_t count, uint16_t *dest) {
+  __m128i a0, a1;
+  size_t  i;
+
+#define GLMM__RN _MM_FROUND_TO_NEAREST_INT
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = _mm256_cvtps_ph(_mm256_loadu_ps(v + i),     GLMM__RN);
+    a1 = _mm256_cvtps_ph(_mm256_loadu_ps(v + i + 8), GLMM__RN);
+    _mm_storeu_si128((__m128i *)(dest + i),     a0);
+    _mm_storeu_si128((__m128i *)(dest + i + 8), a1);
+  }
+
+  if (i + 8 <= count) {
+    a0 = _mm256_cvtps_ph(_mm256_loadu_ps(v + i), GLMM__RN);
+    _mm_storeu_si128((__m128i *)(dest + i), a0);
+    i += 8;
+  }
+#undef GLMM__RN
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 half floats per iteration with F16C,
+ *        see glm_unpack_half_array
+ *
+ * @returns number of half floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_half_array_avx(uint16_t *v, size_t count, float *dest) {
+  __m256 a0, a1;
+  size_t i;
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = _mm256_cvtph_ps(_mm_loadu_si128((__m128i *)(v + i)));
+    a1 = _mm256_cvtph_ps(_mm_loadu_si128((__m128i *)(v + i + 8)));
+    _mm256_storeu_ps(dest + i,     a0);
+    _mm256_storeu_ps(dest + i + 8, a1);
+  }
+
+  if (i + 8 <= count) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_cvtph_ps(_mm_loadu_si128((__m128i *)(v + i))));
+    i += 8;
+  }
+
+  return i;
+}
+
+#endif
+#endif /* cglm_pack_simd_avx_h */
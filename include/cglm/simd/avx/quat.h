@@ -0,0 +1,252 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_quat_simd_avx_h
+#define cglm_quat_simd_avx_h
+#ifdef __AVX__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+CGLM_INLINE
+void
+glm_quat_mat4_avx(versor q, float s, mat4 dest) {
+  /*
+   with a = s * q every entry of the rotation is either
+     a[i] * q[j] +- a[k] * q[l]          (off diagonal)
+     1 - a[i] * q[i] - a[j] * q[j]       (diagonal)
+   so the operands of two columns are permuted into one y register each.
+   no fma, entries are rounded exactly like glm_quat_mat4 rounds them.
+   */
+
+  __m256 y0, y1, y2, y3, y4, y5;
+  __m128 x0;
+
+  x0 = glmm_load(q);
+  y0 = _mm256_set_m128(x0, x0);                     /* q | q */
+  x0 = _mm_mul_ps(_mm_set1_ps(s), x0);
+  y1 = _mm256_set_m128(x0, x0);                     /* a | a */
+  y5 = _mm256_set1_ps(1.0f);
+
+#define CGLM_QUAT_MAT4_PERM(Y, I0, I1, I2, I3, I4, I5, I6, I7)               \
+  _mm256_permutevar_ps(Y, _mm256_setr_epi32(I0, I1, I2, I3, I4, I5, I6, I7))
+
+  /* column 1 | column 0 */
+  y2 = _mm256_mul_ps(CGLM_QUAT_MAT4_PERM(y1, 1, 0, 0, 0, 0, 0, 1, 0),
+                     CGLM_QUAT_MAT4_PERM(y0, 1, 1, 2, 0, 1, 0, 2, 0));
+  y3 = _mm256_mul_ps(CGLM_QUAT_MAT4_PERM(y1, 2, 3, 3, 0, 3, 2, 3, 0),
+                     CGLM_QUAT_MAT4_PERM(y0, 2, 2, 1, 0, 2, 2, 0, 0));
+  y2 = _mm256_blend_ps(y2, _mm256_sub_ps(y5, y2), 0x21);
+  y3 = _mm256_xor_ps(y3, _mm256_setr_ps(-0.0f,  0.0f, -0.0f, 0.0f,
+                                        -0.0f, -0.0f,  0.0f, 0.0f));
+  y2 = _mm256_add_ps(y2, y3);
+  y2 = _mm256_blend_ps(y2, _mm256_setzero_ps(), 0x88);
+
+  /* column 3 | column 2 */
+  y3 = _mm256_mul_ps(CGLM_QUAT_MAT4_PERM(y1, 0, 1, 0, 0, 0, 0, 0, 0),
+                     CGLM_QUAT_MAT4_PERM(y0, 2, 2, 0, 0, 0, 0, 0, 0));
+  y4 = _mm256_mul_ps(CGLM_QUAT_MAT4_PERM(y1, 3, 3, 1, 0, 0, 0, 0, 0),
+                     CGLM_QUAT_MAT4_PERM(y0, 1, 0, 1, 0, 0, 0, 0, 0));
+  y3 = _mm256_blend_ps(y3, _mm256_sub_ps(y5, y3), 0x04);
+  y4 = _mm256_xor_ps(y4, _mm256_setr_ps(0.0f, -0.0f, -0.0f, 0.0f,
+                                        0.0f,  0.0f,  0.0f, 0.0f));
+  y3 = _mm256_add_ps(y3, y4);
+  y3 = _mm256_blend_ps(y3, _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f,
+                                          0.0f, 0.0f, 0.0f, 1.0f), 0xF8);
+
+#undef CGLM_QUAT_MAT4_PERM
+
+  glmm_store256(dest[0], y2);
+  glmm_store256(dest[2], y3);
+}
+
+CGLM_INLINE
+void
+glm_quat_mul_avx(versor p, versor q, versor dest) {
+  /*
+   dest is the sum of four terms p[k] * (q permuted, signed), the p[3] and
+   p[0] terms share one y register and the p[1] and p[2] terms the other,
+   the two halves are added at the end
+   */
+
+  __m256 y0, y1, y2;
+  __m128 x0;
+
+  x0 = glmm_load(p);
+  y0 = _mm256_set_m128(x0, x0);                     /* p | p */
+  x0 = glmm_load(q);
+  y1 = _mm256_set_m128(x0, x0);                     /* q | q */
+
+  y2 = _mm256_mul_ps(
+         _mm256_xor_ps(_mm256_permutevar_ps(y0, _mm256_setr_epi32(3, 3, 3, 3,
+                                                                  0, 0, 0, 0)),
+                       _mm256_setr_ps(0.0f, 0.0f,  0.0f, 0.0f,
+                                      0.0f, -0.0f, 0.0f, -0.0f)),
+         _mm256_permutevar_ps(y1, _mm256_setr_epi32(0, 1, 2, 3, 3, 2, 1, 0)));
+  y2 = glmm256_fmadd(
+         _mm256_xor_ps(_mm256_permutevar_ps(y0, _mm256_setr_epi32(1, 1, 1, 1,
+                                                                  2, 2, 2, 2)),
+                       _mm256_setr_ps(0.0f,  0.0f, -0.0f, -0.0f,
+                                      -0.0f, 0.0f,  0.0f, -0.0f)),
+         _mm256_permutevar_ps(y1, _mm256_setr_epi32(2, 3, 0, 1, 1, 0, 3, 2)),
+         y2);
+
+  glmm_store(dest, _mm_add_ps(_mm256_castps256_ps128(y2),
+                              _mm256_extractf128_ps(y2, 1)));
+}
+
+/* same polynomials as glm_acos01_approx and glm_sin_approx */
+static inline
+__m256
+glmm256_acos01_approx(__m256 x) {
+  __m256 p;
+
+  p = glmm256_fmadd(_mm256_set1_ps(-0.0012624911f), x,
+                    _mm256_set1_ps(0.0066700901f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps(-0.0170881256f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps( 0.0308918810f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps(-0.0501743046f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps( 0.0889789874f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps(-0.2145988016f));
+  p = glmm256_fmadd(p, x, _mm256_set1_ps( 1.5707963050f));
+
+  return _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x)),
+                       p);
+}
+
+static inline
+__m256
+glmm256_sin_approx(__m256 x) {
+  __m256 x2, p;
+
+  x2 = _mm256_mul_ps(x, x);
+  p  = glmm256_fmadd(_mm256_set1_ps(-2.5052108e-8f), x2,
+                     _mm256_set1_ps(2.7557319e-6f));
+  p  = glmm256_fmadd(p, x2, _mm256_set1_ps(-1.9841270e-4f));
+  p  = glmm256_fmadd(p, x2, _mm256_set1_ps( 8.3333333e-3f));
+  p  = glmm256_fmadd(p, x2, _mm256_set1_ps(-1.6666667e-1f));
+
+  return glmm256_fmadd(_mm256_mul_ps(p, x2), x, x);
+}
+
+/*!
+ * @brief slerps 8 quaternions per iteration, see glm_quat_slerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_quat_slerp_soa_avx(float *from[4],
+                       float *to[4],
+                       float  t,
+                       size_t count,
+                       float *dest[4]) {
+  __m256 f[4], q[4], c, sgn, th, s, a, b, lerp, one, vt, vt1;
+  size_t i;
+  int    j;
+
+  one = _mm256_set1_ps(1.0f);
+  vt  = _mm256_set1_ps(t);
+  vt1 = _mm256_set1_ps(1.0f - t);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm256_loadu_ps(from[j] + i);
+      q[j] = _mm256_loadu_ps(to[j] + i);
+    }
+
+    c = _mm256_mul_ps(f[0], q[0]);
+    c = glmm256_fmadd(f[1], q[1], c);
+    c = glmm256_fmadd(f[2], q[2], c);
+    c = glmm256_fmadd(f[3], q[3], c);
+
+    /* shorter arc: from is negated where cos(theta) < 0 */
+    sgn = _mm256_and_ps(c, _mm256_set1_ps(-0.0f));
+    c   = _mm256_min_ps(_mm256_xor_ps(c, sgn), one);
+
+    th = glmm256_acos01_approx(c);
+    s  = glmm256_sin_approx(th);
+    a  = glmm256_sin_approx(_mm256_mul_ps(vt1, th));
+    b  = glmm256_sin_approx(_mm256_mul_ps(vt, th));
+
+    /* lerp where sin(theta) is too small to divide by */
+    lerp = _mm256_cmp_ps(s, _mm256_set1_ps(0.001f), _CMP_LT_OQ);
+    s    = _mm256_div_ps(one, s);
+    a    = _mm256_blendv_ps(_mm256_mul_ps(a, s), vt1, lerp);
+    b    = _mm256_blendv_ps(_mm256_mul_ps(b, s), vt,  lerp);
+    a    = _mm256_xor_ps(a, sgn);
+
+    for (j = 0; j < 4; j++)
+      _mm256_storeu_ps(dest[j] + i,
+                       glmm256_fmadd(a, f[j], _mm256_mul_ps(b, q[j])));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief nlerps 8 quaternions per iteration, see glm_quat_nlerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_quat_nlerp_soa_avx(float *from[4],
+                       float *to[4],
+                       float  t,
+                       size_t count,
+                       float *dest[4]) {
+  __m256 f[4], q[4], d[4], c, b, n, zero, vt, vt1;
+  size_t i;
+  int    j;
+
+  vt  = _mm256_set1_ps(t);
+  vt1 = _mm256_set1_ps(1.0f - t);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm256_loadu_ps(from[j] + i);
+      q[j] = _mm256_loadu_ps(to[j] + i);
+    }
+
+    c = _mm256_mul_ps(f[0], q[0]);
+    c = glmm256_fmadd(f[1], q[1], c);
+    c = glmm256_fmadd(f[2], q[2], c);
+    c = glmm256_fmadd(f[3], q[3], c);
+
+    /* shorter arc: to is negated where cos(theta) < 0 */
+    b = _mm256_xor_ps(vt, _mm256_and_ps(c, _mm256_set1_ps(-0.0f)));
+
+    for (j = 0; j < 4; j++)
+      d[j] = glmm256_fmadd(vt1, f[j], _mm256_mul_ps(b, q[j]));
+
+    n = _mm256_mul_ps(d[0], d[0]);
+    n = glmm256_fmadd(d[1], d[1], n);
+    n = glmm256_fmadd(d[2], d[2], n);
+    n = glmm256_fmadd(d[3], d[3], n);
+
+    /* zero length results become identity like glm_quat_normalize */
+    zero = _mm256_cmp_ps(n, _mm256_setzero_ps(), _CMP_LE_OQ);
+    n    = _mm256_sqrt_ps(n);
+
+    for (j = 0; j < 3; j++)
+      _mm256_storeu_ps(dest[j] + i,
+                       _mm256_andnot_ps(zero, _mm256_div_ps(d[j], n)));
+
+    _mm256_storeu_ps(dest[3] + i,
+                     _mm256_blendv_ps(_mm256_div_ps(d[3], n),
+                                      _mm256_set1_ps(1.0f),
+                                      zero));
+  }
+
+  return i;
+}
+
+#endif
+#endif /* cglm_quat_simd_avx_h */
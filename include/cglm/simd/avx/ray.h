@@ -0,0 +1,147 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_ray_simd_avx_h
+#define cglm_ray_simd_avx_h
+#ifdef __AVX__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/*!
+ * @brief tests 8 triangles per iteration, see glm_ray_triangle_soa
+ *
+ * the last 1-7 triangles are read with a masked load, zero edges never pass
+ * the determinant test.
+ *
+ * @returns number of triangles tested, always count
+ */
+CGLM_INLINE
+size_t
+glm_ray_triangle_soa_avx(vec3    origin,
+                         vec3    direction,
+                         float  *tri[9],
+                         size_t  count,
+                         float  *d,
+                         size_t *index) {
+  float   tb[8];
+  int32_t ib[8];
+  __m256  ox, oy, oz, dx, dy, dz, eps, neps, one, zero, best, ld;
+  __m256  e1x, e1y, e1z, e2x, e2y, e2z, tx, ty, tz, px, py, pz;
+  __m256  det, inv, u, v, t, m;
+  __m128i lane0, lane1, bi0, bi1, m0, m1, step;
+  __m256i lm;
+  size_t  i, j;
+
+  ox    = _mm256_set1_ps(origin[0]);
+  oy    = _mm256_set1_ps(origin[1]);
+  oz    = _mm256_set1_ps(origin[2]);
+  dx    = _mm256_set1_ps(direction[0]);
+  dy    = _mm256_set1_ps(direction[1]);
+  dz    = _mm256_set1_ps(direction[2]);
+  eps   = _mm256_set1_ps(0.000001f);
+  neps  = _mm256_set1_ps(-0.000001f);
+  one   = _mm256_set1_ps(1.0f);
+  zero  = _mm256_setzero_ps();
+  best  = _mm256_set1_ps(*d);
+  ld    = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+  lm    = _mm256_set1_epi32(-1);
+  lane0 = _mm_set_epi32(3, 2, 1, 0);
+  lane1 = _mm_set_epi32(7, 6, 5, 4);
+  step  = _mm_set1_epi32(8);
+  bi0   = bi1 = _mm_set1_epi32(-1);
+
+  for (i = 0; i < count; i += 8) {
+    if (count - i < 8)
+      lm = _mm256_castps_si256(_mm256_cmp_ps(ld,
+                                             _mm256_set1_ps((float)(count - i)),
+                                             _CMP_LT_OQ));
+
+    e1x = _mm256_maskload_ps(tri[3] + i, lm);
+    e1y = _mm256_maskload_ps(tri[4] + i, lm);
+    e1z = _mm256_maskload_ps(tri[5] + i, lm);
+    e2x = _mm256_maskload_ps(tri[6] + i, lm);
+    e2y = _mm256_maskload_ps(tri[7] + i, lm);
+    e2z = _mm256_maskload_ps(tri[8] + i, lm);
+
+    /* p = direction x e2 */
+    px  = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    py  = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    pz  = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+
+    det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px),
+                                      _mm256_mul_ps(e1y, py)),
+                        _mm256_mul_ps(e1z, pz));
+    inv = _mm256_div_ps(one, det);
+    m   = _mm256_or_ps(_mm256_cmp_ps(det, neps, _CMP_LE_OQ),
+                       _mm256_cmp_ps(det, eps, _CMP_GE_OQ));
+
+    /* t = origin - v0 */
+    tx  = _mm256_sub_ps(ox, _mm256_maskload_ps(tri[0] + i, lm));
+    ty  = _mm256_sub_ps(oy, _mm256_maskload_ps(tri[1] + i, lm));
+    tz  = _mm256_sub_ps(oz, _mm256_maskload_ps(tri[2] + i, lm));
+
+    u   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px),
+                                      _mm256_mul_ps(ty, py)),
+                        _mm256_mul_ps(tz, pz));
+    u   = _mm256_mul_ps(u, inv);
+    m   = _mm256_and_ps(m, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ),
+                                         _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+
+    /* q = t x e1, reuses p */
+    px  = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y));
+    py  = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z));
+    pz  = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x));
+
+    v   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, px),
+                                      _mm256_mul_ps(dy, py)),
+                        _mm256_mul_ps(dz, pz));
+    v   = _mm256_mul_ps(v, inv);
+    m   = _mm256_and_ps(m, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ),
+                                         _mm256_cmp_ps(_mm256_add_ps(u, v),
+                                                       one, _CMP_LE_OQ)));
+
+    t   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, px),
+                                      _mm256_mul_ps(e2y, py)),
+                        _mm256_mul_ps(e2z, pz));
+    t   = _mm256_mul_ps(t, inv);
+    m   = _mm256_and_ps(m, _mm256_and_ps(_mm256_cmp_ps(t, eps, _CMP_GT_OQ),
+                                         _mm256_cmp_ps(t, best, _CMP_LT_OQ)));
+
+    best = _mm256_blendv_ps(best, t, m);
+
+    /* AVX has no 256-bit integer ops, indices are kept in two halves */
+    m0    = _mm_castps_si128(_mm256_castps256_ps128(m));
+    m1    = _mm_castps_si128(_mm256_extractf128_ps(m, 1));
+    bi0   = _mm_or_si128(_mm_and_si128(m0, lane0), _mm_andnot_si128(m0, bi0));
+    bi1   = _mm_or_si128(_mm_and_si128(m1, lane1), _mm_andnot_si128(m1, bi1));
+    lane0 = _mm_add_epi32(lane0, step);
+    lane1 = _mm_add_epi32(lane1, step);
+  }
+
+  /* nearest lane, the lowest index on ties like the scalar loop */
+  _mm256_storeu_ps(tb, best);
+  _mm_storeu_si128((__m128i *)ib, bi0);
+  _mm_storeu_si128((__m128i *)(ib + 4), bi1);
+
+  for (j = 0; j < 8; j++) {
+    if (ib[j] < 0 || tb[j] > *d)
+      continue;
+
+    if (tb[j] < *d || (size_t)ib[j] < *index) {
+      *d     = tb[j];
+      *index = (size_t)ib[j];
+    }
+  }
+
+  return count;
+}
+
+#endif
+#endif /* cglm_ray_simd_avx_h */
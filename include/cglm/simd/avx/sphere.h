@@ -0,0 +1,182 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_sphere_simd_avx_h
+#define cglm_sphere_simd_avx_h
+#ifdef __AVX__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/* four spheres per 128-bit lane to x y z r, as _MM_TRANSPOSE4_PS per lane */
+#define glmm256_sphere_soa(Y0, Y1, Y2, Y3, X, Y, Z, R)                        \
+  do {                                                                        \
+    __m256 t0_ = _mm256_unpacklo_ps(Y0, Y1);                                  \
+    __m256 t1_ = _mm256_unpacklo_ps(Y2, Y3);                                  \
+    __m256 t2_ = _mm256_unpackhi_ps(Y0, Y1);                                  \
+    __m256 t3_ = _mm256_unpackhi_ps(Y2, Y3);                                  \
+    X = _mm256_shuffle_ps(t0_, t1_, _MM_SHUFFLE(1, 0, 1, 0));                 \
+    Y = _mm256_shuffle_ps(t0_, t1_, _MM_SHUFFLE(3, 2, 3, 2));                 \
+    Z = _mm256_shuffle_ps(t2_, t3_, _MM_SHUFFLE(1, 0, 1, 0));                 \
+    R = _mm256_shuffle_ps(t2_, t3_, _MM_SHUFFLE(3, 2, 3, 2));                 \
+  } while (0)
+
+static inline
+float
+glmm256_hmin(__m256 x) {
+  return glmm_hmin(_mm_min_ps(_mm256_castps256_ps128(x),
+                              _mm256_extractf128_ps(x, 1)));
+}
+
+static inline
+float
+glmm256_hmax(__m256 x) {
+  return glmm_hmax(_mm_max_ps(_mm256_castps256_ps128(x),
+                              _mm256_extractf128_ps(x, 1)));
+}
+
+/*!
+ * @brief transforms two spheres per iteration, see glm_sphere_transform_array
+ *
+ * @returns number of spheres transformed, always a multiple of 2
+ */
+CGLM_INLINE
+size_t
+glm_sphere_transform_array_avx(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  __m256 y0, y1, y2, y3, c0, c1, c2, c3, x0, x1, t0, t1, t2, t3;
+  size_t i;
+
+  for (i = 0; i + 2 <= count; i += 2) {
+    y0 = _mm256_loadu_ps(m[i][0]);                  /* A.c1 | A.c0 */
+    y1 = _mm256_loadu_ps(m[i][2]);                  /* A.c3 | A.c2 */
+    y2 = _mm256_loadu_ps(m[i + 1][0]);              /* B.c1 | B.c0 */
+    y3 = _mm256_loadu_ps(m[i + 1][2]);              /* B.c3 | B.c2 */
+    x0 = _mm256_loadu_ps(s[i]);                     /* B.s  | A.s  */
+
+    c0 = _mm256_permute2f128_ps(y0, y2, 0x20);      /* B.c0 | A.c0 */
+    c1 = _mm256_permute2f128_ps(y0, y2, 0x31);      /* B.c1 | A.c1 */
+    c2 = _mm256_permute2f128_ps(y1, y3, 0x20);      /* B.c2 | A.c2 */
+    c3 = _mm256_permute2f128_ps(y1, y3, 0x31);      /* B.c3 | A.c3 */
+
+    x1 = glmm256_fmadd(c0, _mm256_permute_ps(x0, 0x00), c3);
+    x1 = glmm256_fmadd(c1, _mm256_permute_ps(x0, 0x55), x1);
+    x1 = glmm256_fmadd(c2, _mm256_permute_ps(x0, 0xAA), x1);
+
+    /* squared lengths of the x, y and z axes, transposed so they add up */
+    c0 = _mm256_mul_ps(c0, c0);
+    c1 = _mm256_mul_ps(c1, c1);
+    c2 = _mm256_mul_ps(c2, c2);
+
+    t0 = _mm256_unpacklo_ps(c0, c1);
+    t1 = _mm256_unpacklo_ps(c2, c2);
+    t2 = _mm256_unpackhi_ps(c0, c1);
+    t3 = _mm256_unpackhi_ps(c2, c2);
+
+    t0 = _mm256_add_ps(
+           _mm256_add_ps(_mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+                         _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2))),
+           _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+
+    t0 = _mm256_max_ps(t0, _mm256_permute_ps(t0, _MM_SHUFFLE(1, 0, 3, 2)));
+    t0 = _mm256_max_ps(t0, _mm256_permute_ps(t0, _MM_SHUFFLE(2, 3, 0, 1)));
+    t0 = _mm256_mul_ps(_mm256_sqrt_ps(t0), _mm256_permute_ps(x0, 0xFF));
+
+    _mm256_storeu_ps(dest[i], _mm256_blend_ps(x1, t0, 0x88));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief grows box by eight spheres per iteration, see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_aabb_avx(vec4 *s, size_t count, vec3 box[2]) {
+  __m256 y0, y1, y2, y3, x, y, z, r, minx, miny, minz, maxx, maxy, maxz;
+  size_t i;
+
+  minx = _mm256_set1_ps(box[0][0]);
+  miny = _mm256_set1_ps(box[0][1]);
+  minz = _mm256_set1_ps(box[0][2]);
+  maxx = _mm256_set1_ps(box[1][0]);
+  maxy = _mm256_set1_ps(box[1][1]);
+  maxz = _mm256_set1_ps(box[1][2]);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    y0 = _mm256_loadu_ps(s[i]);
+    y1 = _mm256_loadu_ps(s[i + 2]);
+    y2 = _mm256_loadu_ps(s[i + 4]);
+    y3 = _mm256_loadu_ps(s[i + 6]);
+    glmm256_sphere_soa(y0, y1, y2, y3, x, y, z, r);
+
+    minx = _mm256_min_ps(minx, _mm256_sub_ps(x, r));
+    miny = _mm256_min_ps(miny, _mm256_sub_ps(y, r));
+    minz = _mm256_min_ps(minz, _mm256_sub_ps(z, r));
+    maxx = _mm256_max_ps(maxx, _mm256_add_ps(x, r));
+    maxy = _mm256_max_ps(maxy, _mm256_add_ps(y, r));
+    maxz = _mm256_max_ps(maxz, _mm256_add_ps(z, r));
+  }
+
+  box[0][0] = glmm256_hmin(minx);
+  box[0][1] = glmm256_hmin(miny);
+  box[0][2] = glmm256_hmin(minz);
+  box[1][0] = glmm256_hmax(maxx);
+  box[1][1] = glmm256_hmax(maxy);
+  box[1][2] = glmm256_hmax(maxz);
+
+  return i;
+}
+
+/*!
+ * @brief grows radius around center by eight spheres per iteration,
+ *        see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_radius_avx(vec4   *s,
+                            size_t  count,
+                            vec3    center,
+                            float  *radius) {
+  __m256 y0, y1, y2, y3, x, y, z, r, cx, cy, cz, rmax;
+  size_t i;
+
+  cx   = _mm256_set1_ps(center[0]);
+  cy   = _mm256_set1_ps(center[1]);
+  cz   = _mm256_set1_ps(center[2]);
+  rmax = _mm256_set1_ps(*radius);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    y0 = _mm256_loadu_ps(s[i]);
+    y1 = _mm256_loadu_ps(s[i + 2]);
+    y2 = _mm256_loadu_ps(s[i + 4]);
+    y3 = _mm256_loadu_ps(s[i + 6]);
+    glmm256_sphere_soa(y0, y1, y2, y3, x, y, z, r);
+
+    x = _mm256_sub_ps(x, cx);
+    y = _mm256_sub_ps(y, cy);
+    z = _mm256_sub_ps(z, cz);
+
+    /* mul + add keeps results identical to the scalar loop */
+    x = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                      _mm256_mul_ps(z, z));
+    rmax = _mm256_max_ps(rmax, _mm256_add_ps(_mm256_sqrt_ps(x), r));
+  }
+
+  *radius = glmm256_hmax(rmax);
+
+  return i;
+}
+
+#endif
+#endif /* cglm_sphere_simd_avx_h */
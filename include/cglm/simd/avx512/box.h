@@ -0,0 +1,77 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_box_simd_avx512_h
+#define cglm_box_simd_avx512_h
+#ifdef __AVX512F__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/*!
+ * @brief tests 16 boxes per iteration against frustum planes, see
+ *        glm_aabb_frustum_soa
+ *
+ * the remainder is tested with masked loads, so all boxes are tested here
+ *
+ * @returns number of boxes tested, always count
+ */
+CGLM_INLINE
+size_t
+glm_aabb_frustum_soa_avx512(float    *min[3],
+                            float    *max[3],
+                            size_t    count,
+                            vec4      planes[6],
+                            uint32_t * __restrict visible) {
+  float    *px[6], *py[6], *pz[6];
+  __m512    nx[6], ny[6], nz[6], nw[6], x, y, z, dp;
+  __mmask16 lanes, vis;
+  uint32_t  bits;
+  size_t    i;
+  int       j;
+
+  for (j = 0; j < 6; j++) {
+    px[j] = planes[j][0] > 0.0f ? max[0] : min[0];
+    py[j] = planes[j][1] > 0.0f ? max[1] : min[1];
+    pz[j] = planes[j][2] > 0.0f ? max[2] : min[2];
+
+    nx[j] = _mm512_set1_ps(planes[j][0]);
+    ny[j] = _mm512_set1_ps(planes[j][1]);
+    nz[j] = _mm512_set1_ps(planes[j][2]);
+    nw[j] = _mm512_set1_ps(-planes[j][3]);
+  }
+
+  bits = 0;
+  for (i = 0; i < count; i += 16) {
+    lanes = count - i >= 16 ? 0xFFFF : (__mmask16)((1u << (count - i)) - 1u);
+    vis   = lanes;
+
+    /* mul + add instead of fma keeps results identical to the scalar test */
+    for (j = 0; j < 6; j++) {
+      x   = _mm512_maskz_loadu_ps(lanes, px[j] + i);
+      y   = _mm512_maskz_loadu_ps(lanes, py[j] + i);
+      z   = _mm512_maskz_loadu_ps(lanes, pz[j] + i);
+      dp  = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(nx[j], x),
+                                        _mm512_mul_ps(ny[j], y)),
+                          _mm512_mul_ps(nz[j], z));
+      vis = _mm512_mask_cmp_ps_mask(vis, dp, nw[j], _CMP_NLT_UQ);
+    }
+
+    bits |= (uint32_t)vis << (i & 31);
+    if (((i + 16) & 31) == 0 || i + 16 >= count) {
+      visible[i >> 5] = bits;
+      bits            = 0;
+    }
+  }
+
+  return count;
+}
+
+#endif
+#endif /* cglm_box_simd_avx512_h */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_mat3_simd_avx512_h
+#define cglm_mat3_simd_avx512_h
+#ifdef __AVX512F__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+CGLM_INLINE
+void
+glm_mat3_mul_avx512(mat3 m1, mat3 m2, mat3 dest) {
+  /*
+   all 9 floats of dest are one z register, lane n is
+   column n / 3, row n % 3, as in glm_mat3_mul_avx2:
+     dest[n] = m1[0][n % 3] * m2[n / 3][0]
+             + m1[1][n % 3] * m2[n / 3][1]
+             + m1[2][n % 3] * m2[n / 3][2]
+   the matrices are read and written with masked loads and stores
+   */
+
+  __m512 z0, z1, z2;
+
+  z0 = _mm512_maskz_loadu_ps(0x01FF, m1[0]);
+  z1 = _mm512_maskz_loadu_ps(0x01FF, m2[0]);
+
+  z2 = _mm512_mul_ps(
+         _mm512_permutexvar_ps(_mm512_setr_epi32(0, 1, 2, 0, 1, 2, 0, 1,
+                                                 2, 0, 0, 0, 0, 0, 0, 0), z0),
+         _mm512_permutexvar_ps(_mm512_setr_epi32(0, 0, 0, 3, 3, 3, 6, 6,
+                                                 6, 0, 0, 0, 0, 0, 0, 0), z1));
+  z2 = _mm512_fmadd_ps(
+         _mm512_permutexvar_ps(_mm512_setr_epi32(3, 4, 5, 3, 4, 5, 3, 4,
+                                                 5, 0, 0, 0, 0, 0, 0, 0), z0),
+         _mm512_permutexvar_ps(_mm512_setr_epi32(1, 1, 1, 4, 4, 4, 7, 7,
+                                                 7, 0, 0, 0, 0, 0, 0, 0), z1),
+         z2);
+  z2 = _mm512_fmadd_ps(
+         _mm512_permutexvar_ps(_mm512_setr_epi32(6, 7, 8, 6, 7, 8, 6, 7,
+                                                 8, 0, 0, 0, 0, 0, 0, 0), z0),
+         _mm512_permutexvar_ps(_mm512_setr_epi32(2, 2, 2, 5, 5, 5, 8, 8,
+                                                 8, 0, 0, 0, 0, 0, 0, 0), z1),
+         z2);
+
+  _mm512_mask_storeu_ps(dest[0], 0x01FF, z2);
+}
+
+#endif
+#endif /* cglm_mat3_simd_avx512_h */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_mat_simd_avx512_h
+#define cglm_mat_simd_avx512_h
+#ifdef __AVX512F__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+CGLM_INLINE
+void
+glm_mat4_mul_array_avx512(mat4 *m1, mat4 *m2, size_t count, mat4 *dest) {
+  /* D = R * L (Column-Major), one z register holds a whole matrix */
+
+  __m512 z0, z1, z2, z3, z4, z5;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    /* every 128 bit lane gets the same column of L */
+    z0 = _mm512_broadcast_f32x4(glmm_load(m1[i][0]));
+    z1 = _mm512_broadcast_f32x4(glmm_load(m1[i][1]));
+    z2 = _mm512_broadcast_f32x4(glmm_load(m1[i][2]));
+    z3 = _mm512_broadcast_f32x4(glmm_load(m1[i][3]));
+
+    z4 = _mm512_loadu_ps(m2[i][0]); /* p o n m | l k j i | h g f e | d c b a */
+
+    /* m m m m i i i i e e e e a a a a, then n j f b and so on */
+    z5 = _mm512_mul_ps(z0, _mm512_permute_ps(z4, 0x00));
+    z5 = _mm512_add_ps(z5, _mm512_mul_ps(z1, _mm512_permute_ps(z4, 0x55)));
+    z5 = _mm512_add_ps(z5, _mm512_mul_ps(z2, _mm512_permute_ps(z4, 0xAA)));
+    z5 = _mm512_add_ps(z5, _mm512_mul_ps(z3, _mm512_permute_ps(z4, 0xFF)));
+
+    _mm512_storeu_ps(dest[i][0], z5);
+  }
+}
+
+CGLM_INLINE
+void
+glm_mat4_inv_avx512(mat4 mat, mat4 dest) {
+  /*
+   the 2x2 block inverse of glm_mat4_inv_avx with all four result blocks
+   in one z register, one 128 bit lane per block:
+     X = |D|A - B(D#C)        W = |A|D - C(A#B)
+     Y = |B|C - D(A#B)#       Z = |C|B - A(D#C)#
+   lanes are X W Y Z, the blocks are gathered from the whole matrix
+   */
+
+  __m512 z0, z1, z2, z3, z4;
+  __m128 r0, r1, r2, r3, x0, x1, x2;
+
+  z0 = _mm512_loadu_ps(mat[0]); /* p o n m | l k j i | h g f e | d c b a */
+
+  r0 = glmm_load(mat[0]);
+  r1 = glmm_load(mat[1]);
+  r2 = glmm_load(mat[2]);
+  r3 = glmm_load(mat[3]);
+
+  /* |A| |B| |C| |D| */
+  x0 = _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)),
+                  _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1)));
+  x0 = glmm_fnmadd(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)),
+                   _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)),
+                   x0);
+
+  /* D#C A#B A#B D#C */
+  z1 = _mm512_permutexvar_ps(_mm512_setr_epi32(10, 11, 14, 15, 0, 1, 4, 5,
+                                               0, 1, 4, 5, 10, 11, 14, 15), z0);
+  z2 = _mm512_permutexvar_ps(_mm512_setr_epi32(8, 9, 12, 13, 2, 3, 6, 7,
+                                               2, 3, 6, 7, 8, 9, 12, 13), z0);
+  z3 = _mm512_mul_ps(_mm512_permute_ps(z1, _MM_SHUFFLE(0, 0, 3, 3)), z2);
+  z3 = _mm512_fnmadd_ps(_mm512_permute_ps(z1, _MM_SHUFFLE(2, 2, 1, 1)),
+                        _mm512_permute_ps(z2, _MM_SHUFFLE(1, 0, 3, 2)),
+                        z3);
+
+  /* |D|A |A|D |B|C |C|B */
+  z1 = _mm512_permutexvar_ps(_mm512_setr_epi32(3, 3, 3, 3, 0, 0, 0, 0,
+                                               1, 1, 1, 1, 2, 2, 2, 2),
+                             _mm512_castps128_ps512(x0));
+  z4 = _mm512_mul_ps(z1,
+                     _mm512_permutexvar_ps(
+                       _mm512_setr_epi32(0, 1, 4, 5, 10, 11, 14, 15,
+                                         8, 9, 12, 13, 2, 3, 6, 7), z0));
+
+  /* B C D A times the adjugate products, the second term adds in Y and Z */
+  z2 = _mm512_permutexvar_ps(_mm512_setr_epi32(2, 3, 6, 7, 8, 9, 12, 13,
+                                               10, 11, 14, 15, 0, 1, 4, 5), z0);
+  z4 = _mm512_fnmadd_ps(z2,
+                        _mm512_permutevar_ps(
+                          z3, _mm512_setr_epi32(0, 3, 0, 3, 0, 3, 0, 3,
+                                                3, 0, 3, 0, 3, 0, 3, 0)),
+                        z4);
+  z1 = _mm512_permute_ps(z2, _MM_SHUFFLE(2, 3, 0, 1));
+  z2 = _mm512_permute_ps(z3, _MM_SHUFFLE(1, 2, 1, 2));
+  z4 = _mm512_mask_blend_ps(0xFF00,
+                            _mm512_fnmadd_ps(z1, z2, z4),
+                            _mm512_fmadd_ps(z1, z2, z4));
+
+  /* |M| = |A||D| + |B||C| - tr((A#B)(D#C)) */
+  x1 = _mm_mul_ps(x0, glmm_shuff1(x0, 0, 1, 2, 3));
+  x1 = _mm_add_ps(glmm_splat_x(x1), glmm_splat_y(x1));
+  x2 = _mm_mul_ps(_mm512_extractf32x4_ps(z3, 1),
+                  glmm_shuff1(_mm512_castps512_ps128(z3), 3, 1, 2, 0));
+  x1 = _mm_sub_ps(x1, glmm_vhadd(x2));
+  x1 = _mm_div_ps(_mm_set_ps(1.0f, -1.0f, -1.0f, 1.0f), x1);
+
+  z4 = _mm512_mul_ps(z4, _mm512_broadcast_f32x4(x1));
+
+  /* adjugate of each block, back to columns */
+  z4 = _mm512_permutexvar_ps(_mm512_setr_epi32(3, 1, 11, 9, 2, 0, 10, 8,
+                                               15, 13, 7, 5, 14, 12, 6, 4), z4);
+
+  _mm512_storeu_ps(dest[0], z4);
+}
+
+#endif
+#endif /* cglm_mat_simd_avx512_h */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_quat_simd_avx512_h
+#define cglm_quat_simd_avx512_h
+#ifdef __AVX512F__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/* same polynomials as glm_acos01_approx and glm_sin_approx */
+static inline
+__m512
+glmm512_acos01_approx(__m512 x) {
+  __m512 p;
+
+  p = _mm512_fmadd_ps(_mm512_set1_ps(-0.0012624911f), x,
+                      _mm512_set1_ps(0.0066700901f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps(-0.0170881256f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps( 0.0308918810f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps(-0.0501743046f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps( 0.0889789874f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps(-0.2145988016f));
+  p = _mm512_fmadd_ps(p, x, _mm512_set1_ps( 1.5707963050f));
+
+  return _mm512_mul_ps(_mm512_sqrt_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), x)),
+                       p);
+}
+
+static inline
+__m512
+glmm512_sin_approx(__m512 x) {
+  __m512 x2, p;
+
+  x2 = _mm512_mul_ps(x, x);
+  p  = _mm512_fmadd_ps(_mm512_set1_ps(-2.5052108e-8f), x2,
+                       _mm512_set1_ps(2.7557319e-6f));
+  p  = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(-1.9841270e-4f));
+  p  = _mm512_fmadd_ps(p, x2, _mm512_set1_ps( 8.3333333e-3f));
+  p  = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(-1.6666667e-1f));
+
+  return _mm512_fmadd_ps(_mm512_mul_ps(p, x2), x, x);
+}
+
+/* sign bits of x, and/xor on floats need AVX-512DQ so integers are used */
+static inline
+__m512i
+glmm512_signbits(__m512 x) {
+  return _mm512_and_epi32(_mm512_castps_si512(x),
+                          _mm512_set1_epi32((int)0x80000000));
+}
+
+static inline
+__m512
+glmm512_xorsign(__m512 x, __m512i sign) {
+  return _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(x), sign));
+}
+
+/* sign bits set in the given lanes, for glmm512_xorsign */
+static inline
+__m512i
+glmm512_signmask(__mmask16 lanes) {
+  return _mm512_maskz_mov_epi32(lanes, _mm512_set1_epi32((int)0x80000000));
+}
+
+CGLM_INLINE
+void
+glm_quat_mul_avx512(versor p, versor q, versor dest) {
+  /*
+   each 128 bit lane holds one of the four terms p[k] * (q permuted,
+   signed) of glm_quat_mul, the lanes are summed pairwise at the end
+   */
+
+  __m512 z0, z1, z2;
+
+  z0 = _mm512_broadcast_f32x4(glmm_load(p));
+  z1 = _mm512_broadcast_f32x4(glmm_load(q));
+
+  z0 = _mm512_permutevar_ps(z0, _mm512_setr_epi32(3, 3, 3, 3, 0, 0, 0, 0,
+                                                  1, 1, 1, 1, 2, 2, 2, 2));
+  z1 = _mm512_permutevar_ps(z1, _mm512_setr_epi32(0, 1, 2, 3, 3, 2, 1, 0,
+                                                  2, 3, 0, 1, 1, 0, 3, 2));
+  z2 = _mm512_mul_ps(glmm512_xorsign(z0, glmm512_signmask(0x9CA0)), z1);
+
+  z2 = _mm512_add_ps(z2, _mm512_shuffle_f32x4(z2, z2, _MM_SHUFFLE(1, 0, 3, 2)));
+  z2 = _mm512_add_ps(z2, _mm512_shuffle_f32x4(z2, z2, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  glmm_store(dest, _mm512_castps512_ps128(z2));
+}
+
+CGLM_INLINE
+void
+glm_quat_mat4_avx512(versor q, float s, mat4 dest) {
+  /*
+   same terms as glm_quat_mat4_avx with all four columns in one z
+   register, entries are rounded exactly like the AVX path rounds them
+   */
+
+  __m512 z0, z1, z2, z3;
+  __m128 x0;
+
+  x0 = glmm_load(q);
+  z0 = _mm512_broadcast_f32x4(x0);                             /* q */
+  z1 = _mm512_broadcast_f32x4(_mm_mul_ps(_mm_set1_ps(s), x0)); /* a = s * q */
+
+  z2 = _mm512_mul_ps(
+         _mm512_permutevar_ps(z1, _mm512_setr_epi32(1, 0, 0, 0, 0, 0, 1, 0,
+                                                    0, 1, 0, 0, 0, 0, 0, 0)),
+         _mm512_permutevar_ps(z0, _mm512_setr_epi32(1, 1, 2, 0, 1, 0, 2, 0,
+                                                    2, 2, 0, 0, 0, 0, 0, 0)));
+  z3 = _mm512_mul_ps(
+         _mm512_permutevar_ps(z1, _mm512_setr_epi32(2, 3, 3, 0, 3, 2, 3, 0,
+                                                    3, 3, 1, 0, 0, 0, 0, 0)),
+         _mm512_permutevar_ps(z0, _mm512_setr_epi32(2, 2, 1, 0, 2, 2, 0, 0,
+                                                    1, 0, 1, 0, 0, 0, 0, 0)));
+
+  /* the diagonal is 1 - ..., the last row and column come from identity */
+  z2 = _mm512_mask_sub_ps(z2, 0x0421, _mm512_set1_ps(1.0f), z2);
+  z2 = _mm512_add_ps(z2, glmm512_xorsign(z3, glmm512_signmask(0x0635)));
+  z2 = _mm512_mask_blend_ps(0xF888, z2, _mm512_setr_ps(0.0f, 0.0f, 0.0f, 0.0f,
+                                                       0.0f, 0.0f, 0.0f, 0.0f,
+                                                       0.0f, 0.0f, 0.0f, 0.0f,
+                                                       0.0f, 0.0f, 0.0f, 1.0f));
+
+  _mm512_storeu_ps(dest[0], z2);
+}
+
+/*!
+ * @brief slerps 16 quaternions per iteration, see glm_quat_slerp_soa
+ *
+ * the remainder is handled with masked loads and stores
+ *
+ * @returns number of quaternions interpolated, always count
+ */
+CGLM_INLINE
+size_t
+glm_quat_slerp_soa_avx512(float *from[4],
+                          float *to[4],
+                          float  t,
+                          size_t count,
+                          float *dest[4]) {
+  __m512    f[4], q[4], c, th, s, a, b, one, vt, vt1;
+  __m512i   sgn;
+  __mmask16 lanes, lerp;
+  size_t    i;
+  int       j;
+
+  one = _mm512_set1_ps(1.0f);
+  vt  = _mm512_set1_ps(t);
+  vt1 = _mm512_set1_ps(1.0f - t);
+
+  for (i = 0; i < count; i += 16) {
+    lanes = count - i >= 16 ? 0xFFFF : (__mmask16)((1u << (count - i)) - 1u);
+
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm512_maskz_loadu_ps(lanes, from[j] + i);
+      q[j] = _mm512_maskz_loadu_ps(lanes, to[j] + i);
+    }
+
+    c = _mm512_mul_ps(f[0], q[0]);
+    c = _mm512_fmadd_ps(f[1], q[1], c);
+    c = _mm512_fmadd_ps(f[2], q[2], c);
+    c = _mm512_fmadd_ps(f[3], q[3], c);
+
+    /* shorter arc: from is negated where cos(theta) < 0 */
+    sgn = glmm512_signbits(c);
+    c   = _mm512_min_ps(glmm512_xorsign(c, sgn), one);
+
+    th = glmm512_acos01_approx(c);
+    s  = glmm512_sin_approx(th);
+    a  = glmm512_sin_approx(_mm512_mul_ps(vt1, th));
+    b  = glmm512_sin_approx(_mm512_mul_ps(vt, th));
+
+    /* lerp where sin(theta) is too small to divide by */
+    lerp = _mm512_cmp_ps_mask(s, _mm512_set1_ps(0.001f), _CMP_LT_OQ);
+    s    = _mm512_div_ps(one, s);
+    a    = _mm512_mask_blend_ps(lerp, _mm512_mul_ps(a, s), vt1);
+    b    = _mm512_mask_blend_ps(lerp, _mm512_mul_ps(b, s), vt);
+    a    = glmm512_xorsign(a, sgn);
+
+    for (j = 0; j < 4; j++)
+      _mm512_mask_storeu_ps(dest[j] + i, lanes,
+                            _mm512_fmadd_ps(a, f[j], _mm512_mul_ps(b, q[j])));
+  }
+
+  return count;
+}
+
+/*!
+ * @brief nlerps 16 quaternions per iteration, see glm_quat_nlerp_soa
+ *
+ * the remainder is handled with masked loads and stores
+ *
+ * @returns number of quaternions interpolated, always count
+ */
+CGLM_INLINE
+size_t
+glm_quat_nlerp_soa_avx512(float *from[4],
+                          float *to[4],
+                          float  t,
+                          size_t count,
+                          float *dest[4]) {
+  __m512    f[4], q[4], d[4], c, b, n, vt, vt1;
+  __mmask16 lanes, zero;
+  size_t    i;
+  int       j;
+
+  vt  = _mm512_set1_ps(t);
+  vt1 = _mm512_set1_ps(1.0f - t);
+
+  for (i = 0; i < count; i += 16) {
+    lanes = count - i >= 16 ? 0xFFFF : (__mmask16)((1u << (count - i)) - 1u);
+
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm512_maskz_loadu_ps(lanes, from[j] + i);
+      q[j] = _mm512_maskz_loadu_ps(lanes, to[j] + i);
+    }
+
+    c = _mm512_mul_ps(f[0], q[0]);
+    c = _mm512_fmadd_ps(f[1], q[1], c);
+    c = _mm512_fmadd_ps(f[2], q[2], c);
+    c = _mm512_fmadd_ps(f[3], q[3], c);
+
+    /* shorter arc: to is negated where cos(theta) < 0 */
+    b = glmm512_xorsign(vt, glmm512_signbits(c));
+
+    for (j = 0; j < 4; j++)
+      d[j] = _mm512_fmadd_ps(vt1, f[j], _mm512_mul_ps(b, q[j]));
+
+    n = _mm512_mul_ps(d[0], d[0]);
+    n = _mm512_fmadd_ps(d[1], d[1], n);
+    n = _mm512_fmadd_ps(d[2], d[2], n);
+    n = _mm512_fmadd_ps(d[3], d[3], n);
+
+    /* zero length results become identity like glm_quat_normalize */
+    zero = _mm512_cmp_ps_mask(n, _mm512_setzero_ps(), _CMP_LE_OQ);
+    n    = _mm512_sqrt_ps(n);
+
+    for (j = 0; j < 3; j++)
+      _mm512_mask_storeu_ps(dest[j] + i, lanes,
+                            _mm512_maskz_div_ps((__mmask16)~zero, d[j], n));
+
+    _mm512_mask_storeu_ps(dest[3] + i, lanes,
+                          _mm512_mask_blend_ps(zero,
+                                               _mm512_div_ps(d[3], n),
+                                               _mm512_set1_ps(1.0f)));
+  }
+
+  return count;
+}
+
+#endif
+#endif /* cglm_quat_simd_avx512_h */
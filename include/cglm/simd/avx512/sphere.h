@@ -0,0 +1,176 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_sphere_simd_avx512_h
+#define cglm_sphere_simd_avx512_h
+#ifdef __AVX512F__
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#include <immintrin.h>
+
+/* four spheres per 128-bit lane to x y z r, as _MM_TRANSPOSE4_PS per lane */
+#define glmm512_sphere_soa(Z0, Z1, Z2, Z3, X, Y, Z, R)                        \
+  do {                                                                        \
+    __m512 t0_ = _mm512_unpacklo_ps(Z0, Z1);                                  \
+    __m512 t1_ = _mm512_unpacklo_ps(Z2, Z3);                                  \
+    __m512 t2_ = _mm512_unpackhi_ps(Z0, Z1);                                  \
+    __m512 t3_ = _mm512_unpackhi_ps(Z2, Z3);                                  \
+    X = _mm512_shuffle_ps(t0_, t1_, _MM_SHUFFLE(1, 0, 1, 0));                 \
+    Y = _mm512_shuffle_ps(t0_, t1_, _MM_SHUFFLE(3, 2, 3, 2));                 \
+    Z = _mm512_shuffle_ps(t2_, t3_, _MM_SHUFFLE(1, 0, 1, 0));                 \
+    R = _mm512_shuffle_ps(t2_, t3_, _MM_SHUFFLE(3, 2, 3, 2));                 \
+  } while (0)
+
+/*!
+ * @brief transforms four spheres per iteration, see glm_sphere_transform_array
+ *
+ * @returns number of spheres transformed, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_sphere_transform_array_avx512(vec4   *s,
+                                  mat4   *m,
+                                  size_t  count,
+                                  vec4   *dest) {
+  __m512 z0, z1, z2, z3, c0, c1, c2, c3, x0, x1, t0, t1, t2, t3;
+  size_t i;
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    z0 = _mm512_loadu_ps(m[i][0]);                  /* A.c3 A.c2 A.c1 A.c0 */
+    z1 = _mm512_loadu_ps(m[i + 1][0]);              /* B.c3 B.c2 B.c1 B.c0 */
+    z2 = _mm512_loadu_ps(m[i + 2][0]);              /* C.c3 C.c2 C.c1 C.c0 */
+    z3 = _mm512_loadu_ps(m[i + 3][0]);              /* D.c3 D.c2 D.c1 D.c0 */
+    x0 = _mm512_loadu_ps(s[i]);                     /* D.s  C.s  B.s  A.s  */
+
+    /* 4x4 transpose of 128-bit lanes, column k of each matrix in one reg */
+    t0 = _mm512_shuffle_f32x4(z0, z1, _MM_SHUFFLE(1, 0, 1, 0));
+    t1 = _mm512_shuffle_f32x4(z0, z1, _MM_SHUFFLE(3, 2, 3, 2));
+    t2 = _mm512_shuffle_f32x4(z2, z3, _MM_SHUFFLE(1, 0, 1, 0));
+    t3 = _mm512_shuffle_f32x4(z2, z3, _MM_SHUFFLE(3, 2, 3, 2));
+    c0 = _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+    c1 = _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+    c2 = _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+    c3 = _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+
+    x1 = _mm512_fmadd_ps(c0, _mm512_permute_ps(x0, 0x00), c3);
+    x1 = _mm512_fmadd_ps(c1, _mm512_permute_ps(x0, 0x55), x1);
+    x1 = _mm512_fmadd_ps(c2, _mm512_permute_ps(x0, 0xAA), x1);
+
+    /* squared lengths of the x, y and z axes, transposed so they add up */
+    c0 = _mm512_mul_ps(c0, c0);
+    c1 = _mm512_mul_ps(c1, c1);
+    c2 = _mm512_mul_ps(c2, c2);
+
+    t0 = _mm512_unpacklo_ps(c0, c1);
+    t1 = _mm512_unpacklo_ps(c2, c2);
+    t2 = _mm512_unpackhi_ps(c0, c1);
+    t3 = _mm512_unpackhi_ps(c2, c2);
+
+    t0 = _mm512_add_ps(
+           _mm512_add_ps(_mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+                         _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2))),
+           _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+
+    t0 = _mm512_max_ps(t0, _mm512_permute_ps(t0, _MM_SHUFFLE(1, 0, 3, 2)));
+    t0 = _mm512_max_ps(t0, _mm512_permute_ps(t0, _MM_SHUFFLE(2, 3, 0, 1)));
+    t0 = _mm512_mul_ps(_mm512_sqrt_ps(t0), _mm512_permute_ps(x0, 0xFF));
+
+    _mm512_storeu_ps(dest[i], _mm512_mask_blend_ps(0x8888, x1, t0));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief grows box by 16 spheres per iteration, see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_aabb_avx512(vec4 *s, size_t count, vec3 box[2]) {
+  __m512 z0, z1, z2, z3, x, y, z, r, minx, miny, minz, maxx, maxy, maxz;
+  size_t i;
+
+  minx = _mm512_set1_ps(box[0][0]);
+  miny = _mm512_set1_ps(box[0][1]);
+  minz = _mm512_set1_ps(box[0][2]);
+  maxx = _mm512_set1_ps(box[1][0]);
+  maxy = _mm512_set1_ps(box[1][1]);
+  maxz = _mm512_set1_ps(box[1][2]);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    z0 = _mm512_loadu_ps(s[i]);
+    z1 = _mm512_loadu_ps(s[i + 4]);
+    z2 = _mm512_loadu_ps(s[i + 8]);
+    z3 = _mm512_loadu_ps(s[i + 12]);
+    glmm512_sphere_soa(z0, z1, z2, z3, x, y, z, r);
+
+    minx = _mm512_min_ps(minx, _mm512_sub_ps(x, r));
+    miny = _mm512_min_ps(miny, _mm512_sub_ps(y, r));
+    minz = _mm512_min_ps(minz, _mm512_sub_ps(z, r));
+    maxx = _mm512_max_ps(maxx, _mm512_add_ps(x, r));
+    maxy = _mm512_max_ps(maxy, _mm512_add_ps(y, r));
+    maxz = _mm512_max_ps(maxz, _mm512_add_ps(z, r));
+  }
+
+  box[0][0] = _mm512_reduce_min_ps(minx);
+  box[0][1] = _mm512_reduce_min_ps(miny);
+  box[0][2] = _mm512_reduce_min_ps(minz);
+  box[1][0] = _mm512_reduce_max_ps(maxx);
+  box[1][1] = _mm512_reduce_max_ps(maxy);
+  box[1][2] = _mm512_reduce_max_ps(maxz);
+
+  return i;
+}
+
+/*!
+ * @brief grows radius around center by 16 spheres per iteration,
+ *        see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_radius_avx512(vec4   *s,
+                               size_t  count,
+                               vec3    center,
+                               float  *radius) {
+  __m512 z0, z1, z2, z3, x, y, z, r, cx, cy, cz, rmax;
+  size_t i;
+
+  cx   = _mm512_set1_ps(center[0]);
+  cy   = _mm512_set1_ps(center[1]);
+  cz   = _mm512_set1_ps(center[2]);
+  rmax = _mm512_set1_ps(*radius);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    z0 = _mm512_loadu_ps(s[i]);
+    z1 = _mm512_loadu_ps(s[i + 4]);
+    z2 = _mm512_loadu_ps(s[i + 8]);
+    z3 = _mm512_loadu_ps(s[i + 12]);
+    glmm512_sphere_soa(z0, z1, z2, z3, x, y, z, r);
+
+    x = _mm512_sub_ps(x, cx);
+    y = _mm512_sub_ps(y, cy);
+    z = _mm512_sub_ps(z, cz);
+
+    /* mul + add keeps results identical to the scalar loop */
+    x = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)),
+                      _mm512_mul_ps(z, z));
+    rmax = _mm512_max_ps(rmax, _mm512_add_ps(_mm512_sqrt_ps(x), r));
+  }
+
+  *radius = _mm512_reduce_max_ps(rmax);
+
+  return i;
+}
+
+#endif
+#endif /* cglm_sphere_simd_avx512_h */
@@ -62,6 +62,18 @@
 #  endif
 #endif
 
+#ifdef __AVX2__
+#  define CGLM_AVX2_FP 1
+#endif
+
+#ifdef __AVX512F__
+#  include <immintrin.h>
+#  define CGLM_AVX512_FP 1
+#  ifndef CGLM_SIMD_x86
+#    define CGLM_SIMD_x86
+#  endif
+#endif
+
 /* ARM Neon */
 #if defined(__ARM_NEON)
 #  include <arm_neon.h>
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_box_neon_h
+#define cglm_box_neon_h
+#if defined(__ARM_NEON_FP)
+
+#include "../../common.h"
+#include "../intrin.h"
+
+/*!
+ * @brief tests 4 boxes per iteration against frustum planes, see
+ *        glm_aabb_frustum_soa
+ *
+ * @returns number of boxes tested, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_aabb_frustum_soa_neon(float    *min[3],
+                          float    *max[3],
+                          size_t    count,
+                          vec4      planes[6],
+                          uint32_t * __restrict visible) {
+  static const uint32_t lanebits[4] = {1, 2, 4, 8};
+
+  float      *px[6], *py[6], *pz[6];
+  float32x4_t nx[6], ny[6], nz[6], nw[6], dp;
+  uint32x4_t  vis, weights;
+  uint32_t    bits, mask;
+  size_t      i;
+  int         j;
+
+  for (j = 0; j < 6; j++) {
+    px[j] = planes[j][0] > 0.0f ? max[0] : min[0];
+    py[j] = planes[j][1] > 0.0f ? max[1] : min[1];
+    pz[j] = planes[j][2] > 0.0f ? max[2] : min[2];
+
+    nx[j] = vdupq_n_f32(planes[j][0]);
+    ny[j] = vdupq_n_f32(planes[j][1]);
+    nz[j] = vdupq_n_f32(planes[j][2]);
+    nw[j] = vdupq_n_f32(-planes[j][3]);
+  }
+
+  weights = vld1q_u32(lanebits);
+  bits    = 0;
+  for (i = 0; i + 4 <= count; i += 4) {
+    vis = vdupq_n_u32(0xFFFFFFFF);
+
+    /* mul + add instead of fma keeps results identical to the scalar test */
+    for (j = 0; j < 6; j++) {
+      dp  = vaddq_f32(vaddq_f32(vmulq_f32(nx[j], vld1q_f32(px[j] + i)),
+                                vmulq_f32(ny[j], vld1q_f32(py[j] + i))),
+                      vmulq_f32(nz[j], vld1q_f32(pz[j] + i)));
+      vis = vbicq_u32(vis, vcltq_f32(dp, nw[j]));
+    }
+
+    vis = vandq_u32(vis, weights);
+#if CGLM_ARM64
+    mask = vaddvq_u32(vis);
+#else
+    {
+      uint32x2_t t;
+      t    = vpadd_u32(vget_low_u32(vis), vget_high_u32(vis));
+      t    = vpadd_u32(t, t);
+      mask = vget_lane_u32(t, 0);
+    }
+#endif
+
+    bits |= mask << (i & 31);
+    if (((i + 4) & 31) == 0) {
+      visible[i >> 5] = bits;
+      bits            = 0;
+    }
+  }
+
+  if (i & 31)
+    visible[i >> 5] = bits;
+
+  return i;
+}
+
+#endif
+#endif /* cglm_box_neon_h */
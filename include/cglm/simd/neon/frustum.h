@@ -0,0 +1,117 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_frustum_neon_h
+#define cglm_frustum_neon_h
+#if defined(__ARM_NEON_FP)
+
+#include "../../common.h"
+#include "../intrin.h"
+#include "mat4.h"
+
+/*!
+ * @brief splits frustum and bounds the cascades, see glm_frustum_cascades
+ *
+ * near and far corners are deinterleaved by vld4q, see
+ * glm_frustum_cascades_sse2 for the output of boxes.
+ */
+CGLM_INLINE
+void
+glm_frustum_cascades_neon(vec4   corners[8],
+                          float  nearZ,
+                          float  farZ,
+                          float *splits,
+                          size_t count,
+                          mat4   lightView,
+                          vec4   planes[][4],
+                          vec3   boxes[][2]) {
+  float32x4_t   c[3][3], b[3], z[3], t, inv, d0, d1, q0, q1;
+  float32x4_t   ex, ey, ez, ln[3], le[3], l[3], p[3], sx, sy, sz;
+  float32x4x4_t n, f, w;
+  float         cx, cy, cz;
+  size_t        i;
+  int           j, k;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = vdupq_n_f32(lightView[j][k]);
+    b[j] = vdupq_n_f32(lightView[3][j]);
+    z[j] = vdupq_n_f32(0.0f);
+  }
+
+  inv = vdupq_n_f32(1.0f / (farZ - nearZ));
+
+  /* [LB, LT, RT, RB] of near plane and near to far edges as x, y, z */
+  n  = vld4q_f32(corners[GLM_LBN]);
+  f  = vld4q_f32(corners[GLM_LBF]);
+
+  ex = vsubq_f32(f.val[0], n.val[0]);
+  ey = vsubq_f32(f.val[1], n.val[1]);
+  ez = vsubq_f32(f.val[2], n.val[2]);
+
+  /* light view is affine, so split corners can be lerped in light space */
+  glmm_mat4_mulv3_soa(c, b, n.val[0], n.val[1], n.val[2], ln);
+  glmm_mat4_mulv3_soa(c, z, ex, ey, ez, le);
+
+  w.val[3] = vdupq_n_f32(1.0f);
+
+  p[0] = ln[0];
+  p[1] = ln[1];
+  p[2] = ln[2];
+
+  for (i = 0; i <= count; i++) {
+    t = vmulq_f32(vdupq_n_f32(splits[i] - nearZ), inv);
+
+    w.val[0] = glmm_fmadd(ex, t, n.val[0]);
+    w.val[1] = glmm_fmadd(ey, t, n.val[1]);
+    w.val[2] = glmm_fmadd(ez, t, n.val[2]);
+
+    vst4q_f32(planes[i][0], w);
+
+    l[0] = glmm_fmadd(le[0], t, ln[0]);
+    l[1] = glmm_fmadd(le[1], t, ln[1]);
+    l[2] = glmm_fmadd(le[2], t, ln[2]);
+
+    if (i > 0) {
+      /* cascade i - 1 is bounded by the previous and the current plane */
+      cx = glmm_hadd(vaddq_f32(p[0], l[0])) * 0.125f;
+      cy = glmm_hadd(vaddq_f32(p[1], l[1])) * 0.125f;
+      cz = glmm_hadd(vaddq_f32(p[2], l[2])) * 0.125f;
+
+      sx = vdupq_n_f32(cx);
+      sy = vdupq_n_f32(cy);
+      sz = vdupq_n_f32(cz);
+
+      d0 = vsubq_f32(p[0], sx);
+      d1 = vsubq_f32(l[0], sx);
+      d0 = vmulq_f32(d0, d0);
+      d1 = vmulq_f32(d1, d1);
+      q0 = vsubq_f32(p[1], sy);
+      q1 = vsubq_f32(l[1], sy);
+      d0 = glmm_fmadd(q0, q0, d0);
+      d1 = glmm_fmadd(q1, q1, d1);
+      q0 = vsubq_f32(p[2], sz);
+      q1 = vsubq_f32(l[2], sz);
+      d0 = glmm_fmadd(q0, q0, d0);
+      d1 = glmm_fmadd(q1, q1, d1);
+
+      boxes[i - 1][0][0] = cx;
+      boxes[i - 1][0][1] = cy;
+      boxes[i - 1][0][2] = glmm_hmin(vminq_f32(p[2], l[2]));
+      boxes[i - 1][1][0] = sqrtf(glmm_hmax(vmaxq_f32(d0, d1)));
+      boxes[i - 1][1][1] = boxes[i - 1][1][0];
+      boxes[i - 1][1][2] = glmm_hmax(vmaxq_f32(p[2], l[2]));
+    }
+
+    p[0] = l[0];
+    p[1] = l[1];
+    p[2] = l[2];
+  }
+}
+
+#endif
+#endif /* cglm_frustum_neon_h */
@@ -313,5 +313,117 @@ glm_mat4_inv_neon(mat4 mat, mat4 dest) {
   glmm_store(dest[3], glmm_div(v3, x0));
 }
 
+/* one column of products per output component, same order as mulv_neon */
+#define glmm_mat4_mulv3_soa(M, B, X, Y, Z, R)                                 \
+  do {                                                                        \
+    int k_;                                                                   \
+    for (k_ = 0; k_ < 3; k_++) {                                              \
+      R[k_] = vmulq_f32(M[0][k_], X);                                         \
+      R[k_] = vmlaq_f32(R[k_], M[1][k_], Y);                                  \
+      R[k_] = vmlaq_f32(R[k_], M[2][k_], Z);                                  \
+      R[k_] = vaddq_f32(R[k_], B[k_]);                                        \
+    }                                                                         \
+  } while (0)
+
+/*!
+ * @brief transforms one vector per iteration, see glm_mat4_mulv_array
+ *
+ * @returns number of vectors transformed, always count
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv_array_neon(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  float32x4_t l0, l1, l2, l3, x0;
+  float32x2_t vlo, vhi;
+  size_t      i;
+
+  l0 = vld1q_f32(m[0]);
+  l1 = vld1q_f32(m[1]);
+  l2 = vld1q_f32(m[2]);
+  l3 = vld1q_f32(m[3]);
+
+  for (i = 0; i < count; i++) {
+    vlo = vld1_f32(&v[i][0]);
+    vhi = vld1_f32(&v[i][2]);
+
+    x0  = vmulq_lane_f32(l0, vlo, 0);
+    x0  = vmlaq_lane_f32(x0, l1, vlo, 1);
+    x0  = vmlaq_lane_f32(x0, l2, vhi, 0);
+    x0  = vmlaq_lane_f32(x0, l3, vhi, 1);
+
+    vst1q_f32(dest[i], x0);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief transforms 4 vectors per iteration, see glm_mat4_mulv3_array
+ *
+ * @returns number of vectors transformed, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_array_neon(mat4   m,
+                          vec3  *v,
+                          float  last,
+                          size_t count,
+                          vec3  *dest) {
+  float32x4_t   c[3][3], b[3];
+  float32x4x3_t a, r;
+  size_t        i;
+  int           j, k;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = vdupq_n_f32(m[j][k]);
+    b[j] = vmulq_f32(vdupq_n_f32(m[3][j]), vdupq_n_f32(last));
+  }
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vld3q_f32(v[i]);
+    glmm_mat4_mulv3_soa(c, b, a.val[0], a.val[1], a.val[2], r.val);
+    vst3q_f32(dest[i], r);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief transforms 4 vectors per iteration, see glm_mat4_mulv3_soa
+ *
+ * @returns number of vectors transformed, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_soa_neon(mat4   m,
+                        float *v[3],
+                        float  last,
+                        size_t count,
+                        float *dest[3]) {
+  float32x4_t c[3][3], b[3], r[3], x, y, z;
+  size_t      i;
+  int         j, k;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = vdupq_n_f32(m[j][k]);
+    b[j] = vmulq_f32(vdupq_n_f32(m[3][j]), vdupq_n_f32(last));
+  }
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    x = vld1q_f32(v[0] + i);
+    y = vld1q_f32(v[1] + i);
+    z = vld1q_f32(v[2] + i);
+
+    glmm_mat4_mulv3_soa(c, b, x, y, z, r);
+
+    for (k = 0; k < 3; k++)
+      vst1q_f32(dest[k] + i, r[k]);
+  }
+
+  return i;
+}
+
 #endif
 #endif /* cglm_mat4_neon_h */
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_pack_neon_h
+#define cglm_pack_neon_h
+#if defined(__ARM_NEON_FP)
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#if CGLM_ARM64
+/* clamp, scale and round to nearest even, like lrintf in glm_pack_* */
+static inline
+int32x4_t
+glmm_pack_cvt(float32x4_t x, float32x4_t lo, float32x4_t hi, float32x4_t s) {
+  return vcvtnq_s32_f32(vmulq_f32(vminq_f32(vmaxq_f32(x, lo), hi), s));
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_half_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_half_array_neon(float *v, size_t count, uint16_t *dest) {
+  float16x8_t a;
+  size_t      i;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(v + i)),
+                          vld1q_f32(v + i + 4));
+    vst1q_u16(dest + i, vreinterpretq_u16_f16(a));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 half floats per iteration, see glm_unpack_half_array
+ *
+ * @returns number of half floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_half_array_neon(uint16_t *v, size_t count, float *dest) {
+  float16x8_t a;
+  size_t      i;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = vreinterpretq_f16_u16(vld1q_u16(v + i));
+    vst1q_f32(dest + i,     vcvt_f32_f16(vget_low_f16(a)));
+    vst1q_f32(dest + i + 4, vcvt_high_f32_f16(a));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 floats per iteration, see glm_pack_unorm8_array
+ *
+ * @returns number of floats converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm8_array_neon(float *v, size_t count, uint8_t *dest) {
+  float32x4_t lo, hi, s;
+  int16x8_t   a0, a1;
+  size_t      i;
+
+  lo = vdupq_n_f32(0.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(255.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = vcombine_s16(vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i), lo, hi, s)),
+                      vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 4),
+                                               lo, hi, s)));
+    a1 = vcombine_s16(vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 8),
+                                               lo, hi, s)),
+                      vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 12),
+                                               lo, hi, s)));
+    vst1q_u8(dest + i, vcombine_u8(vqmovun_s16(a0), vqmovun_s16(a1)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 values per iteration, see glm_unpack_unorm8_array
+ *
+ * @returns number of values converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm8_array_neon(uint8_t *v, size_t count, float *dest) {
+  float32x4_t s;
+  uint8x16_t  a;
+  uint16x8_t  w;
+  size_t      i;
+
+  s = vdupq_n_f32(255.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a = vld1q_u8(v + i);
+    w = vmovl_u8(vget_low_u8(a));
+    vst1q_f32(dest + i,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(w))), s));
+    vst1q_f32(dest + i + 4,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(w))), s));
+    w = vmovl_u8(vget_high_u8(a));
+    vst1q_f32(dest + i + 8,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(w))), s));
+    vst1q_f32(dest + i + 12,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(w))), s));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 floats per iteration, see glm_pack_snorm8_array
+ *
+ * @returns number of floats converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm8_array_neon(float *v, size_t count, int8_t *dest) {
+  float32x4_t lo, hi, s;
+  int16x8_t   a0, a1;
+  size_t      i;
+
+  lo = vdupq_n_f32(-1.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(127.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = vcombine_s16(vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i), lo, hi, s)),
+                      vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 4),
+                                               lo, hi, s)));
+    a1 = vcombine_s16(vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 8),
+                                               lo, hi, s)),
+                      vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 12),
+                                               lo, hi, s)));
+    vst1q_s8(dest + i, vcombine_s8(vqmovn_s16(a0), vqmovn_s16(a1)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 values per iteration, see glm_unpack_snorm8_array
+ *
+ * @returns number of values converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm8_array_neon(int8_t *v, size_t count, float *dest) {
+  float32x4_t s, m;
+  int8x16_t   a;
+  int16x8_t   w;
+  size_t      i;
+
+  s = vdupq_n_f32(127.0f);
+  m = vdupq_n_f32(-1.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a = vld1q_s8(v + i);
+    w = vmovl_s8(vget_low_s8(a));
+    vst1q_f32(dest + i,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))),
+                                  s), m));
+    vst1q_f32(dest + i + 4,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))),
+                                  s), m));
+    w = vmovl_s8(vget_high_s8(a));
+    vst1q_f32(dest + i + 8,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))),
+                                  s), m));
+    vst1q_f32(dest + i + 12,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))),
+                                  s), m));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_unorm16_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm16_array_neon(float *v, size_t count, uint16_t *dest) {
+  float32x4_t lo, hi, s;
+  size_t      i;
+
+  lo = vdupq_n_f32(0.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(65535.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    vst1q_u16(dest + i,
+              vcombine_u16(vqmovun_s32(glmm_pack_cvt(vld1q_f32(v + i),
+                                                     lo, hi, s)),
+                           vqmovun_s32(glmm_pack_cvt(vld1q_f32(v + i + 4),
+                                                     lo, hi, s))));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 values per iteration, see glm_unpack_unorm16_array
+ *
+ * @returns number of values converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm16_array_neon(uint16_t *v, size_t count, float *dest) {
+  float32x4_t s;
+  uint16x8_t  a;
+  size_t      i;
+
+  s = vdupq_n_f32(65535.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = vld1q_u16(v + i);
+    vst1q_f32(dest + i,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(a))), s));
+    vst1q_f32(dest + i + 4,
+              vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(a))), s));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_snorm16_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm16_array_neon(float *v, size_t count, int16_t *dest) {
+  float32x4_t lo, hi, s;
+  size_t      i;
+
+  lo = vdupq_n_f32(-1.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(32767.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    vst1q_s16(dest + i,
+              vcombine_s16(vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i),
+                                                    lo, hi, s)),
+                           vqmovn_s32(glmm_pack_cvt(vld1q_f32(v + i + 4),
+                                                    lo, hi, s))));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 values per iteration, see glm_unpack_snorm16_array
+ *
+ * @returns number of values converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm16_array_neon(int16_t *v, size_t count, float *dest) {
+  float32x4_t s, m;
+  int16x8_t   a;
+  size_t      i;
+
+  s = vdupq_n_f32(32767.0f);
+  m = vdupq_n_f32(-1.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = vld1q_s16(v + i);
+    vst1q_f32(dest + i,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(a))),
+                                  s), m));
+    vst1q_f32(dest + i + 4,
+              vmaxq_f32(vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(a))),
+                                  s), m));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief encodes 4 normals per iteration, see glm_pack_oct_array
+ *
+ * @returns number of normals encoded, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_oct_array_neon(vec3 *n, size_t count, uint32_t *dest) {
+  float32x4x3_t a;
+  float32x4_t   x, y, l, fx, fy, one, lo, s;
+  uint32x4_t    sm, neg, ix, iy;
+  size_t        i;
+
+  sm  = vdupq_n_u32(0x80000000u);
+  one = vdupq_n_f32(1.0f);
+  lo  = vdupq_n_f32(-1.0f);
+  s   = vdupq_n_f32(32767.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vld3q_f32(n[i]);
+
+    l = vaddq_f32(vaddq_f32(vabsq_f32(a.val[0]), vabsq_f32(a.val[1])),
+                  vabsq_f32(a.val[2]));
+    l = vdivq_f32(one, l);
+    x = vmulq_f32(a.val[0], l);
+    y = vmulq_f32(a.val[1], l);
+
+    /* fold lower hemisphere over the diagonals */
+    fx  = vbslq_f32(sm, x, vsubq_f32(one, vabsq_f32(y)));
+    fy  = vbslq_f32(sm, y, vsubq_f32(one, vabsq_f32(x)));
+    neg = vcltq_f32(a.val[2], vdupq_n_f32(0.0f));
+    x   = vbslq_f32(neg, fx, x);
+    y   = vbslq_f32(neg, fy, y);
+
+    ix  = vreinterpretq_u32_s32(glmm_pack_cvt(x, lo, one, s));
+    iy  = vreinterpretq_u32_s32(glmm_pack_cvt(y, lo, one, s));
+    ix  = vandq_u32(ix, vdupq_n_u32(0xffff));
+    vst1q_u32(dest + i, vorrq_u32(ix, vshlq_n_u32(iy, 16)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief decodes 4 normals per iteration, see glm_unpack_oct_array
+ *
+ * @returns number of normals decoded, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_oct_array_neon(uint32_t *p, size_t count, vec3 *dest) {
+  float32x4x3_t r;
+  float32x4_t   x, y, z, t, l, one, m, s;
+  int32x4_t     a;
+  uint32x4_t    sm;
+  size_t        i;
+
+  sm  = vdupq_n_u32(0x80000000u);
+  one = vdupq_n_f32(1.0f);
+  m   = vdupq_n_f32(-1.0f);
+  s   = vdupq_n_f32(32767.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vreinterpretq_s32_u32(vld1q_u32(p + i));
+    x = vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(a, 16), 16));
+    y = vcvtq_f32_s32(vshrq_n_s32(a, 16));
+    x = vmaxq_f32(vdivq_f32(x, s), m);
+    y = vmaxq_f32(vdivq_f32(y, s), m);
+    z = vsubq_f32(vsubq_f32(one, vabsq_f32(x)), vabsq_f32(y));
+
+    /* unfold lower hemisphere */
+    t = vmaxq_f32(vnegq_f32(z), vdupq_n_f32(0.0f));
+    x = vsubq_f32(x, vbslq_f32(sm, x, t));
+    y = vsubq_f32(y, vbslq_f32(sm, y, t));
+
+    l = vaddq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)),
+                  vmulq_f32(z, z));
+    l = vdivq_f32(one, vsqrtq_f32(l));
+
+    r.val[0] = vmulq_f32(x, l);
+    r.val[1] = vmulq_f32(y, l);
+    r.val[2] = vmulq_f32(z, l);
+    vst3q_f32(dest[i], r);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration, see glm_pack_unorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm1010102_array_neon(vec4 *v, size_t count, uint32_t *dest) {
+  float32x4x4_t a;
+  float32x4_t   lo, hi, s, sw;
+  uint32x4_t    o;
+  size_t        i;
+
+  lo = vdupq_n_f32(0.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(1023.0f);
+  sw = vdupq_n_f32(3.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vld4q_f32(v[i]);
+    o = vreinterpretq_u32_s32(glmm_pack_cvt(a.val[0], lo, hi, s));
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[1],
+                                                           lo, hi, s)), 10);
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[2],
+                                                           lo, hi, s)), 20);
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[3],
+                                                           lo, hi, sw)), 30);
+    vst1q_u32(dest + i, o);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration,
+ *        see glm_unpack_unorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm1010102_array_neon(uint32_t *p, size_t count, vec4 *dest) {
+  float32x4x4_t r;
+  float32x4_t   s, sw;
+  uint32x4_t    a, mask;
+  size_t        i;
+
+  s    = vdupq_n_f32(1023.0f);
+  sw   = vdupq_n_f32(3.0f);
+  mask = vdupq_n_u32(0x3ff);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vld1q_u32(p + i);
+    r.val[0] = vcvtq_f32_u32(vandq_u32(a, mask));
+    r.val[1] = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(a, 10), mask));
+    r.val[2] = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(a, 20), mask));
+    r.val[3] = vcvtq_f32_u32(vshrq_n_u32(a, 30));
+    r.val[0] = vdivq_f32(r.val[0], s);
+    r.val[1] = vdivq_f32(r.val[1], s);
+    r.val[2] = vdivq_f32(r.val[2], s);
+    r.val[3] = vdivq_f32(r.val[3], sw);
+    vst4q_f32(dest[i], r);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration, see glm_pack_snorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm1010102_array_neon(vec4 *v, size_t count, uint32_t *dest) {
+  float32x4x4_t a;
+  float32x4_t   lo, hi, s;
+  uint32x4_t    o;
+  size_t        i;
+
+  lo = vdupq_n_f32(-1.0f);
+  hi = vdupq_n_f32(1.0f);
+  s  = vdupq_n_f32(511.0f);
+
+  /* vsli keeps only the bits of o below the shift, that drops the sign
+     bits of the previous component */
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vld4q_f32(v[i]);
+    o = vreinterpretq_u32_s32(glmm_pack_cvt(a.val[0], lo, hi, s));
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[1],
+                                                           lo, hi, s)), 10);
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[2],
+                                                           lo, hi, s)), 20);
+    o = vsliq_n_u32(o, vreinterpretq_u32_s32(glmm_pack_cvt(a.val[3],
+                                                           lo, hi, hi)), 30);
+    vst1q_u32(dest + i, o);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration,
+ *        see glm_unpack_snorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm1010102_array_neon(uint32_t *p, size_t count, vec4 *dest) {
+  float32x4x4_t r;
+  float32x4_t   s, m;
+  int32x4_t     a;
+  size_t        i;
+
+  s = vdupq_n_f32(511.0f);
+  m = vdupq_n_f32(-1.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = vreinterpretq_s32_u32(vld1q_u32(p + i));
+    r.val[0] = vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(a, 22), 22));
+    r.val[1] = vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(a, 12), 22));
+    r.val[2] = vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(a, 2),  22));
+    r.val[3] = vcvtq_f32_s32(vshrq_n_s32(a, 30));
+    r.val[0] = vmaxq_f32(vdivq_f32(r.val[0], s), m);
+    r.val[1] = vmaxq_f32(vdivq_f32(r.val[1], s), m);
+    r.val[2] = vmaxq_f32(vdivq_f32(r.val[2], s), m);
+    r.val[3] = vmaxq_f32(r.val[3], m);
+    vst4q_f32(dest[i], r);
+  }
+
+  return i;
+}
+#endif
+
+#endif
+#endif /* cglm_pack_neon_h */
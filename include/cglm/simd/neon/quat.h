@@ -52,5 +52,151 @@ glm_quat_mul_neon(versor p, versor q, versor dest) {
   glmm_store(dest, r);
 }
 
+#if CGLM_ARM64
+/* same polynomials as glm_acos01_approx and glm_sin_approx */
+static inline
+float32x4_t
+glmm_acos01_approx(float32x4_t x) {
+  float32x4_t p;
+
+  p = glmm_fmadd(vdupq_n_f32(-0.0012624911f), x, vdupq_n_f32(0.0066700901f));
+  p = glmm_fmadd(p, x, vdupq_n_f32(-0.0170881256f));
+  p = glmm_fmadd(p, x, vdupq_n_f32( 0.0308918810f));
+  p = glmm_fmadd(p, x, vdupq_n_f32(-0.0501743046f));
+  p = glmm_fmadd(p, x, vdupq_n_f32( 0.0889789874f));
+  p = glmm_fmadd(p, x, vdupq_n_f32(-0.2145988016f));
+  p = glmm_fmadd(p, x, vdupq_n_f32( 1.5707963050f));
+
+  return vmulq_f32(vsqrtq_f32(vsubq_f32(vdupq_n_f32(1.0f), x)), p);
+}
+
+static inline
+float32x4_t
+glmm_sin_approx(float32x4_t x) {
+  float32x4_t x2, p;
+
+  x2 = vmulq_f32(x, x);
+  p  = glmm_fmadd(vdupq_n_f32(-2.5052108e-8f), x2, vdupq_n_f32(2.7557319e-6f));
+  p  = glmm_fmadd(p, x2, vdupq_n_f32(-1.9841270e-4f));
+  p  = glmm_fmadd(p, x2, vdupq_n_f32( 8.3333333e-3f));
+  p  = glmm_fmadd(p, x2, vdupq_n_f32(-1.6666667e-1f));
+
+  return glmm_fmadd(vmulq_f32(p, x2), x, x);
+}
+
+/*!
+ * @brief slerps 4 quaternions per iteration, see glm_quat_slerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_quat_slerp_soa_neon(float *from[4],
+                        float *to[4],
+                        float  t,
+                        size_t count,
+                        float *dest[4]) {
+  float32x4_t f[4], q[4], c, th, s, a, b, one, vt, vt1;
+  uint32x4_t  sgn, lerp;
+  size_t      i;
+  int         j;
+
+  one = vdupq_n_f32(1.0f);
+  vt  = vdupq_n_f32(t);
+  vt1 = vdupq_n_f32(1.0f - t);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    for (j = 0; j < 4; j++) {
+      f[j] = vld1q_f32(from[j] + i);
+      q[j] = vld1q_f32(to[j] + i);
+    }
+
+    c = vmulq_f32(f[0], q[0]);
+    c = glmm_fmadd(f[1], q[1], c);
+    c = glmm_fmadd(f[2], q[2], c);
+    c = glmm_fmadd(f[3], q[3], c);
+
+    /* shorter arc: from is negated where cos(theta) < 0 */
+    sgn = vandq_u32(vreinterpretq_u32_f32(c), vdupq_n_u32(0x80000000));
+    c   = vminq_f32(vabsq_f32(c), one);
+
+    th = glmm_acos01_approx(c);
+    s  = glmm_sin_approx(th);
+    a  = glmm_sin_approx(vmulq_f32(vt1, th));
+    b  = glmm_sin_approx(vmulq_f32(vt, th));
+
+    /* lerp where sin(theta) is too small to divide by */
+    lerp = vcltq_f32(s, vdupq_n_f32(0.001f));
+    s    = vdivq_f32(one, s);
+    a    = vbslq_f32(lerp, vt1, vmulq_f32(a, s));
+    b    = vbslq_f32(lerp, vt,  vmulq_f32(b, s));
+    a    = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), sgn));
+
+    for (j = 0; j < 4; j++)
+      vst1q_f32(dest[j] + i, glmm_fmadd(a, f[j], vmulq_f32(b, q[j])));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief nlerps 4 quaternions per iteration, see glm_quat_nlerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_quat_nlerp_soa_neon(float *from[4],
+                        float *to[4],
+                        float  t,
+                        size_t count,
+                        float *dest[4]) {
+  float32x4_t f[4], q[4], d[4], c, b, n, vt, vt1;
+  uint32x4_t  sgn, zero;
+  size_t      i;
+  int         j;
+
+  vt  = vdupq_n_f32(t);
+  vt1 = vdupq_n_f32(1.0f - t);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    for (j = 0; j < 4; j++) {
+      f[j] = vld1q_f32(from[j] + i);
+      q[j] = vld1q_f32(to[j] + i);
+    }
+
+    c = vmulq_f32(f[0], q[0]);
+    c = glmm_fmadd(f[1], q[1], c);
+    c = glmm_fmadd(f[2], q[2], c);
+    c = glmm_fmadd(f[3], q[3], c);
+
+    /* shorter arc: to is negated where cos(theta) < 0 */
+    sgn = vandq_u32(vreinterpretq_u32_f32(c), vdupq_n_u32(0x80000000));
+    b   = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vt), sgn));
+
+    for (j = 0; j < 4; j++)
+      d[j] = glmm_fmadd(vt1, f[j], vmulq_f32(b, q[j]));
+
+    n = vmulq_f32(d[0], d[0]);
+    n = glmm_fmadd(d[1], d[1], n);
+    n = glmm_fmadd(d[2], d[2], n);
+    n = glmm_fmadd(d[3], d[3], n);
+
+    /* zero length results become identity like glm_quat_normalize */
+    zero = vcleq_f32(n, vdupq_n_f32(0.0f));
+    n    = vsqrtq_f32(n);
+
+    for (j = 0; j < 3; j++)
+      vst1q_f32(dest[j] + i,
+                vbslq_f32(zero, vdupq_n_f32(0.0f), vdivq_f32(d[j], n)));
+
+    vst1q_f32(dest[3] + i,
+              vbslq_f32(zero, vdupq_n_f32(1.0f), vdivq_f32(d[3], n)));
+  }
+
+  return i;
+}
+#endif
+
 #endif
 #endif /* cglm_quat_neon_h */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_ray_neon_h
+#define cglm_ray_neon_h
+#if defined(__ARM_NEON_FP)
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#if CGLM_ARM64
+/*!
+ * @brief tests 4 triangles per iteration, see glm_ray_triangle_soa
+ *
+ * the last 1-3 triangles are copied to a zero padded buffer, zero edges
+ * never pass the determinant test.
+ *
+ * @returns number of triangles tested, always count
+ */
+CGLM_INLINE
+size_t
+glm_ray_triangle_soa_neon(vec3    origin,
+                          vec3    direction,
+                          float  *tri[9],
+                          size_t  count,
+                          float  *d,
+                          size_t *index) {
+  float       pad[9][4], tb[4];
+  int32_t     ib[4];
+  float      *r[9];
+  float32x4_t ox, oy, oz, dx, dy, dz, eps, neps, one, zero, best;
+  float32x4_t e1x, e1y, e1z, e2x, e2y, e2z, tx, ty, tz, px, py, pz;
+  float32x4_t det, inv, u, v, t;
+  uint32x4_t  m;
+  int32x4_t   lane, bi;
+  size_t      i, j, k;
+
+  ox   = vdupq_n_f32(origin[0]);
+  oy   = vdupq_n_f32(origin[1]);
+  oz   = vdupq_n_f32(origin[2]);
+  dx   = vdupq_n_f32(direction[0]);
+  dy   = vdupq_n_f32(direction[1]);
+  dz   = vdupq_n_f32(direction[2]);
+  eps  = vdupq_n_f32(0.000001f);
+  neps = vdupq_n_f32(-0.000001f);
+  one  = vdupq_n_f32(1.0f);
+  zero = vdupq_n_f32(0.0f);
+  best = vdupq_n_f32(*d);
+  lane = (int32x4_t){0, 1, 2, 3};
+  bi   = vdupq_n_s32(-1);
+
+  for (i = 0; i < count; i += 4) {
+    if (count - i >= 4) {
+      for (k = 0; k < 9; k++)
+        r[k] = tri[k] + i;
+    } else {
+      for (k = 0; k < 9; k++) {
+        for (j = 0; j < 4; j++)
+          pad[k][j] = i + j < count ? tri[k][i + j] : 0.0f;
+        r[k] = pad[k];
+      }
+    }
+
+    e1x = vld1q_f32(r[3]);
+    e1y = vld1q_f32(r[4]);
+    e1z = vld1q_f32(r[5]);
+    e2x = vld1q_f32(r[6]);
+    e2y = vld1q_f32(r[7]);
+    e2z = vld1q_f32(r[8]);
+
+    /* p = direction x e2 */
+    px  = vsubq_f32(vmulq_f32(dy, e2z), vmulq_f32(dz, e2y));
+    py  = vsubq_f32(vmulq_f32(dz, e2x), vmulq_f32(dx, e2z));
+    pz  = vsubq_f32(vmulq_f32(dx, e2y), vmulq_f32(dy, e2x));
+
+    det = vaddq_f32(vaddq_f32(vmulq_f32(e1x, px), vmulq_f32(e1y, py)),
+                    vmulq_f32(e1z, pz));
+    inv = vdivq_f32(one, det);
+    m   = vorrq_u32(vcleq_f32(det, neps), vcgeq_f32(det, eps));
+
+    /* t = origin - v0 */
+    tx  = vsubq_f32(ox, vld1q_f32(r[0]));
+    ty  = vsubq_f32(oy, vld1q_f32(r[1]));
+    tz  = vsubq_f32(oz, vld1q_f32(r[2]));
+
+    u   = vaddq_f32(vaddq_f32(vmulq_f32(tx, px), vmulq_f32(ty, py)),
+                    vmulq_f32(tz, pz));
+    u   = vmulq_f32(u, inv);
+    m   = vandq_u32(m, vandq_u32(vcgeq_f32(u, zero), vcleq_f32(u, one)));
+
+    /* q = t x e1, reuses p */
+    px  = vsubq_f32(vmulq_f32(ty, e1z), vmulq_f32(tz, e1y));
+    py  = vsubq_f32(vmulq_f32(tz, e1x), vmulq_f32(tx, e1z));
+    pz  = vsubq_f32(vmulq_f32(tx, e1y), vmulq_f32(ty, e1x));
+
+    v   = vaddq_f32(vaddq_f32(vmulq_f32(dx, px), vmulq_f32(dy, py)),
+                    vmulq_f32(dz, pz));
+    v   = vmulq_f32(v, inv);
+    m   = vandq_u32(m, vandq_u32(vcgeq_f32(v, zero),
+                                 vcleq_f32(vaddq_f32(u, v), one)));
+
+    t   = vaddq_f32(vaddq_f32(vmulq_f32(e2x, px), vmulq_f32(e2y, py)),
+                    vmulq_f32(e2z, pz));
+    t   = vmulq_f32(t, inv);
+    m   = vandq_u32(m, vandq_u32(vcgtq_f32(t, eps), vcltq_f32(t, best)));
+
+    best = vbslq_f32(m, t, best);
+    bi   = vbslq_s32(m, lane, bi);
+    lane = vaddq_s32(lane, vdupq_n_s32(4));
+  }
+
+  /* nearest lane, the lowest index on ties like the scalar loop */
+  vst1q_f32(tb, best);
+  vst1q_s32(ib, bi);
+
+  for (j = 0; j < 4; j++) {
+    if (ib[j] < 0 || tb[j] > *d)
+      continue;
+
+    if (tb[j] < *d || (size_t)ib[j] < *index) {
+      *d     = tb[j];
+      *index = (size_t)ib[j];
+    }
+  }
+
+  return count;
+}
+#endif
+
+#endif
+#endif /* cglm_ray_neon_h */
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_sphere_neon_h
+#define cglm_sphere_neon_h
+#if defined(__ARM_NEON_FP)
+
+#include "../../common.h"
+#include "../intrin.h"
+
+#if CGLM_ARM64
+/*!
+ * @brief transforms one sphere per iteration, see glm_sphere_transform_array
+ *
+ * @returns number of spheres transformed, always count
+ */
+CGLM_INLINE
+size_t
+glm_sphere_transform_array_neon(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  static const uint32_t xyz[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0};
+
+  float32x4_t c0, c1, c2, c3, x0, x1, l;
+  uint32x4_t  mask;
+  size_t      i;
+
+  mask = vld1q_u32(xyz);
+  for (i = 0; i < count; i++) {
+    c0 = glmm_load(m[i][0]);
+    c1 = glmm_load(m[i][1]);
+    c2 = glmm_load(m[i][2]);
+    c3 = glmm_load(m[i][3]);
+    x0 = glmm_load(s[i]);
+
+    x1 = glmm_fmadd(c0, glmm_splat_x(x0), c3);
+    x1 = glmm_fmadd(c1, glmm_splat_y(x0), x1);
+    x1 = glmm_fmadd(c2, glmm_splat_z(x0), x1);
+
+    /* squared lengths of the x, y and z axes, w is masked off */
+    c0 = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(
+                                           vmulq_f32(c0, c0)), mask));
+    c1 = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(
+                                           vmulq_f32(c1, c1)), mask));
+    c2 = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(
+                                           vmulq_f32(c2, c2)), mask));
+
+    l  = vpaddq_f32(vpaddq_f32(c0, c1), vpaddq_f32(c2, c2));
+    x1 = vsetq_lane_f32(sqrtf(vmaxvq_f32(l)) * vgetq_lane_f32(x0, 3), x1, 3);
+
+    glmm_store(dest[i], x1);
+  }
+
+  return i;
+}
+#endif
+
+/*!
+ * @brief grows box by four spheres per iteration, see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_aabb_neon(vec4 *s, size_t count, vec3 box[2]) {
+  float32x4x4_t v;
+  float32x4_t   minx, miny, minz, maxx, maxy, maxz;
+  size_t        i;
+
+  minx = vdupq_n_f32(box[0][0]);
+  miny = vdupq_n_f32(box[0][1]);
+  minz = vdupq_n_f32(box[0][2]);
+  maxx = vdupq_n_f32(box[1][0]);
+  maxy = vdupq_n_f32(box[1][1]);
+  maxz = vdupq_n_f32(box[1][2]);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    v = vld4q_f32(s[i]);                            /* x, y, z, r streams */
+
+    minx = vminq_f32(minx, vsubq_f32(v.val[0], v.val[3]));
+    miny = vminq_f32(miny, vsubq_f32(v.val[1], v.val[3]));
+    minz = vminq_f32(minz, vsubq_f32(v.val[2], v.val[3]));
+    maxx = vmaxq_f32(maxx, vaddq_f32(v.val[0], v.val[3]));
+    maxy = vmaxq_f32(maxy, vaddq_f32(v.val[1], v.val[3]));
+    maxz = vmaxq_f32(maxz, vaddq_f32(v.val[2], v.val[3]));
+  }
+
+  box[0][0] = glmm_hmin(minx);
+  box[0][1] = glmm_hmin(miny);
+  box[0][2] = glmm_hmin(minz);
+  box[1][0] = glmm_hmax(maxx);
+  box[1][1] = glmm_hmax(maxy);
+  box[1][2] = glmm_hmax(maxz);
+
+  return i;
+}
+
+#if CGLM_ARM64
+/*!
+ * @brief grows radius around center by four spheres per iteration,
+ *        see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_radius_neon(vec4   *s,
+                             size_t  count,
+                             vec3    center,
+                             float  *radius) {
+  float32x4x4_t v;
+  float32x4_t   x, y, z, cx, cy, cz, rmax;
+  size_t        i;
+
+  cx   = vdupq_n_f32(center[0]);
+  cy   = vdupq_n_f32(center[1]);
+  cz   = vdupq_n_f32(center[2]);
+  rmax = vdupq_n_f32(*radius);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    v = vld4q_f32(s[i]);                            /* x, y, z, r streams */
+
+    x = vsubq_f32(v.val[0], cx);
+    y = vsubq_f32(v.val[1], cy);
+    z = vsubq_f32(v.val[2], cz);
+
+    /* mul + add keeps results identical to the scalar loop */
+    x = vaddq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)),
+                  vmulq_f32(z, z));
+    rmax = vmaxq_f32(rmax, vaddq_f32(vsqrtq_f32(x), v.val[3]));
+  }
+
+  *radius = vmaxvq_f32(rmax);
+
+  return i;
+}
+#endif
+
+#endif
+#endif /* cglm_sphere_neon_h */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_box_sse_h
+#define cglm_box_sse_h
+#if defined( __SSE__ ) || defined( __SSE2__ )
+
+#include "../../common.h"
+#include "../intrin.h"
+
+/*!
+ * @brief tests 4 boxes per iteration against frustum planes, see
+ *        glm_aabb_frustum_soa
+ *
+ * @returns number of boxes tested, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_aabb_frustum_soa_sse2(float    *min[3],
+                          float    *max[3],
+                          size_t    count,
+                          vec4      planes[6],
+                          uint32_t * __restrict visible) {
+  float   *px[6], *py[6], *pz[6];
+  __m128   nx[6], ny[6], nz[6], nw[6], dp, vis;
+  uint32_t bits;
+  size_t   i;
+  int      j;
+
+  /* plane normals are uniform, so the positive vertex is picked per stream */
+  for (j = 0; j < 6; j++) {
+    px[j] = planes[j][0] > 0.0f ? max[0] : min[0];
+    py[j] = planes[j][1] > 0.0f ? max[1] : min[1];
+    pz[j] = planes[j][2] > 0.0f ? max[2] : min[2];
+
+    nx[j] = _mm_set1_ps(planes[j][0]);
+    ny[j] = _mm_set1_ps(planes[j][1]);
+    nz[j] = _mm_set1_ps(planes[j][2]);
+    nw[j] = _mm_set1_ps(-planes[j][3]);
+  }
+
+  bits = 0;
+  for (i = 0; i + 4 <= count; i += 4) {
+    vis = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    for (j = 0; j < 6; j++) {
+      dp  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[j], _mm_loadu_ps(px[j] + i)),
+                                  _mm_mul_ps(ny[j], _mm_loadu_ps(py[j] + i))),
+                       _mm_mul_ps(nz[j], _mm_loadu_ps(pz[j] + i)));
+      vis = _mm_and_ps(vis, _mm_cmpnlt_ps(dp, nw[j]));
+    }
+
+    bits |= (uint32_t)_mm_movemask_ps(vis) << (i & 31);
+    if (((i + 4) & 31) == 0) {
+      visible[i >> 5] = bits;
+      bits            = 0;
+    }
+  }
+
+  if (i & 31)
+    visible[i >> 5] = bits;
+
+  return i;
+}
+
+#endif
+#endif /* cglm_box_sse_h */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_frustum_sse2_h
+#define cglm_frustum_sse2_h
+#if defined( __SSE__ ) || defined( __SSE2__ )
+
+#include "../../common.h"
+#include "../intrin.h"
+#include "mat4.h"
+
+/*!
+ * @brief splits frustum and bounds the cascades, see glm_frustum_cascades
+ *
+ * the 4 corners of a split plane are kept as x, y, z vectors, so one plane
+ * costs 3 fmadds in world space and 3 in light space.
+ *
+ * boxes are written as [{center x, center y, min z}, {radius, radius, max z}]
+ * in light space, glm_frustum_cascades turns them into boxes.
+ */
+CGLM_INLINE
+void
+glm_frustum_cascades_sse2(vec4   corners[8],
+                          float  nearZ,
+                          float  farZ,
+                          float *splits,
+                          size_t count,
+                          mat4   lightView,
+                          vec4   planes[][4],
+                          vec3   boxes[][2]) {
+  __m128 c[3][3], b[3], z[3], one, t, inv, d0, d1, q0, q1;
+  __m128 nx, ny, nz, nw, ex, ey, ez, ew, wx, wy, wz, w1;
+  __m128 ln[3], le[3], l[3], p[3], sx, sy, sz;
+  float  cx, cy, cz;
+  size_t i;
+  int    j, k;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = _mm_set1_ps(lightView[j][k]);
+    b[j] = _mm_set1_ps(lightView[3][j]);
+    z[j] = _mm_setzero_ps();
+  }
+
+  one = _mm_set1_ps(1.0f);
+  inv = _mm_set1_ps(1.0f / (farZ - nearZ));
+
+  /* [LB, LT, RT, RB] of near plane and near to far edges as x, y, z */
+  nx = glmm_load(corners[GLM_LBN]);
+  ny = glmm_load(corners[GLM_LTN]);
+  nz = glmm_load(corners[GLM_RTN]);
+  nw = glmm_load(corners[GLM_RBN]);
+  ex = glmm_load(corners[GLM_LBF]);
+  ey = glmm_load(corners[GLM_LTF]);
+  ez = glmm_load(corners[GLM_RTF]);
+  ew = glmm_load(corners[GLM_RBF]);
+
+  _MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+  _MM_TRANSPOSE4_PS(ex, ey, ez, ew);
+
+  ex = _mm_sub_ps(ex, nx);
+  ey = _mm_sub_ps(ey, ny);
+  ez = _mm_sub_ps(ez, nz);
+
+  /* light view is affine, so split corners can be lerped in light space */
+  glmm_mat4_mulv3_soa(c, b, nx, ny, nz, ln);
+  glmm_mat4_mulv3_soa(c, z, ex, ey, ez, le);
+
+  p[0] = ln[0];
+  p[1] = ln[1];
+  p[2] = ln[2];
+
+  for (i = 0; i <= count; i++) {
+    t  = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(splits[i]), _mm_set1_ps(nearZ)),
+                    inv);
+
+    wx = glmm_fmadd(ex, t, nx);
+    wy = glmm_fmadd(ey, t, ny);
+    wz = glmm_fmadd(ez, t, nz);
+    w1 = one;
+
+    _MM_TRANSPOSE4_PS(wx, wy, wz, w1);
+
+    glmm_store(planes[i][0], wx);
+    glmm_store(planes[i][1], wy);
+    glmm_store(planes[i][2], wz);
+    glmm_store(planes[i][3], w1);
+
+    l[0] = glmm_fmadd(le[0], t, ln[0]);
+    l[1] = glmm_fmadd(le[1], t, ln[1]);
+    l[2] = glmm_fmadd(le[2], t, ln[2]);
+
+    if (i > 0) {
+      /* cascade i - 1 is bounded by the previous and the current plane */
+      cx = glmm_hadd(_mm_add_ps(p[0], l[0])) * 0.125f;
+      cy = glmm_hadd(_mm_add_ps(p[1], l[1])) * 0.125f;
+      cz = glmm_hadd(_mm_add_ps(p[2], l[2])) * 0.125f;
+
+      sx = _mm_set1_ps(cx);
+      sy = _mm_set1_ps(cy);
+      sz = _mm_set1_ps(cz);
+
+      d0 = _mm_sub_ps(p[0], sx);
+      d1 = _mm_sub_ps(l[0], sx);
+      d0 = _mm_mul_ps(d0, d0);
+      d1 = _mm_mul_ps(d1, d1);
+      q0 = _mm_sub_ps(p[1], sy);
+      q1 = _mm_sub_ps(l[1], sy);
+      d0 = glmm_fmadd(q0, q0, d0);
+      d1 = glmm_fmadd(q1, q1, d1);
+      q0 = _mm_sub_ps(p[2], sz);
+      q1 = _mm_sub_ps(l[2], sz);
+      d0 = glmm_fmadd(q0, q0, d0);
+      d1 = glmm_fmadd(q1, q1, d1);
+
+      boxes[i - 1][0][0] = cx;
+      boxes[i - 1][0][1] = cy;
+      boxes[i - 1][0][2] = glmm_hmin(_mm_min_ps(p[2], l[2]));
+      boxes[i - 1][1][0] = sqrtf(glmm_hmax(_mm_max_ps(d0, d1)));
+      boxes[i - 1][1][1] = boxes[i - 1][1][0];
+      boxes[i - 1][1][2] = glmm_hmax(_mm_max_ps(p[2], l[2]));
+    }
+
+    p[0] = l[0];
+    p[1] = l[1];
+    p[2] = l[2];
+  }
+}
+
+#endif
+#endif /* cglm_frustum_sse2_h */
@@ -430,5 +430,179 @@ glm_mat4_inv_sse2(mat4 mat, mat4 dest) {
   glmm_store(dest[3], _mm_mul_ps(v3, x0));
 }
 
+/* one column of products per output component, same order as mulv_sse2 */
+#define glmm_mat4_mulv3_soa(M, B, X, Y, Z, R)                                 \
+  do {                                                                        \
+    R[0] = glmm_fmadd(M[0][0], X, glmm_fmadd(M[1][0], Y,                      \
+                                             glmm_fmadd(M[2][0], Z, B[0])));  \
+    R[1] = glmm_fmadd(M[0][1], X, glmm_fmadd(M[1][1], Y,                      \
+                                             glmm_fmadd(M[2][1], Z, B[1])));  \
+    R[2] = glmm_fmadd(M[0][2], X, glmm_fmadd(M[1][2], Y,                      \
+                                             glmm_fmadd(M[2][2], Z, B[2])));  \
+  } while (0)
+
+/*!
+ * @brief transforms one vector per iteration, see glm_mat4_mulv_array
+ *
+ * @returns number of vectors transformed, always count
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv_array_sse2(mat4 m, vec4 *v, size_t count, vec4 *dest) {
+  __m128 m0, m1, m2, m3, x0, x1;
+  size_t i;
+  bool   nt;
+
+  m0 = glmm_load(m[0]);
+  m1 = glmm_load(m[1]);
+  m2 = glmm_load(m[2]);
+  m3 = glmm_load(m[3]);
+  nt = count * sizeof(vec4) >= CGLM_STREAM_MIN_BYTES
+       && ((uintptr_t)dest & 15) == 0;
+
+  for (i = 0; i < count; i++) {
+    x0 = glmm_load(v[i]);
+
+    x1 = _mm_mul_ps(m3, glmm_splat_w(x0));
+    x1 = glmm_fmadd(m2, glmm_splat_z(x0), x1);
+    x1 = glmm_fmadd(m1, glmm_splat_y(x0), x1);
+    x1 = glmm_fmadd(m0, glmm_splat_x(x0), x1);
+
+    if (nt)
+      _mm_stream_ps(dest[i], x1);
+    else
+      glmm_store(dest[i], x1);
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
+/*!
+ * @brief transforms 4 vectors per iteration, see glm_mat4_mulv3_array
+ *
+ * 4 vec3 are 3 registers, they are shuffled to x, y and z registers and back.
+ *
+ * @returns number of vectors transformed, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_array_sse2(mat4   m,
+                          vec3  *v,
+                          float  last,
+                          size_t count,
+                          vec3  *dest) {
+  __m128 c[3][3], b[3], r[3], a0, a1, a2, x, y, z, t0, t1;
+  float *p;
+  size_t i;
+  int    j, k;
+  bool   nt;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = _mm_set1_ps(m[j][k]);
+    b[j] = _mm_mul_ps(_mm_set1_ps(m[3][j]), _mm_set1_ps(last));
+  }
+
+  nt = count * sizeof(vec3) >= CGLM_STREAM_MIN_BYTES
+       && ((uintptr_t)dest & 15) == 0;
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    p  = v[i];
+    a0 = _mm_loadu_ps(p);                                   /* x1 z0 y0 x0 */
+    a1 = _mm_loadu_ps(p + 4);                               /* y2 x2 z1 y1 */
+    a2 = _mm_loadu_ps(p + 8);                               /* z3 y3 x3 z2 */
+
+    t0 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(1, 1, 2, 2));   /* x3 x3 x2 x2 */
+    x  = _mm_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+    t0 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(0, 0, 1, 1));   /* y1 y1 y0 y0 */
+    t1 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 2, 3, 3));   /* y3 y3 y2 y2 */
+    y  = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 1, 2, 2));   /* z1 z1 z0 z0 */
+    z  = _mm_shuffle_ps(t0, a2, _MM_SHUFFLE(3, 0, 2, 0));
+
+    glmm_mat4_mulv3_soa(c, b, x, y, z, r);
+
+    t0 = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 0, 0));
+    t1 = _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(1, 1, 0, 0));
+    a0 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 1, 1, 1));
+    t1 = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(2, 2, 2, 2));
+    a1 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(3, 3, 2, 2));
+    t1 = _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(3, 3, 3, 3));
+    a2 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+
+    p = dest[i];
+    if (nt) {
+      _mm_stream_ps(p,     a0);
+      _mm_stream_ps(p + 4, a1);
+      _mm_stream_ps(p + 8, a2);
+    } else {
+      _mm_storeu_ps(p,     a0);
+      _mm_storeu_ps(p + 4, a1);
+      _mm_storeu_ps(p + 8, a2);
+    }
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
+/*!
+ * @brief transforms 4 vectors per iteration, see glm_mat4_mulv3_soa
+ *
+ * @returns number of vectors transformed, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_mat4_mulv3_soa_sse2(mat4   m,
+                        float *v[3],
+                        float  last,
+                        size_t count,
+                        float *dest[3]) {
+  __m128 c[3][3], b[3], r[3], x, y, z;
+  size_t i;
+  int    j, k;
+  bool   nt;
+
+  for (j = 0; j < 3; j++) {
+    for (k = 0; k < 3; k++)
+      c[j][k] = _mm_set1_ps(m[j][k]);
+    b[j] = _mm_mul_ps(_mm_set1_ps(m[3][j]), _mm_set1_ps(last));
+  }
+
+  nt = count * sizeof(vec3) >= CGLM_STREAM_MIN_BYTES
+       && (((uintptr_t)dest[0] | (uintptr_t)dest[1] | (uintptr_t)dest[2])
+           & 15) == 0;
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    x = _mm_loadu_ps(v[0] + i);
+    y = _mm_loadu_ps(v[1] + i);
+    z = _mm_loadu_ps(v[2] + i);
+
+    glmm_mat4_mulv3_soa(c, b, x, y, z, r);
+
+    if (nt) {
+      _mm_stream_ps(dest[0] + i, r[0]);
+      _mm_stream_ps(dest[1] + i, r[1]);
+      _mm_stream_ps(dest[2] + i, r[2]);
+    } else {
+      _mm_storeu_ps(dest[0] + i, r[0]);
+      _mm_storeu_ps(dest[1] + i, r[1]);
+      _mm_storeu_ps(dest[2] + i, r[2]);
+    }
+  }
+
+  if (nt)
+    _mm_sfence();
+
+  return i;
+}
+
 #endif
 #endif /* cglm_mat_sse_h */
@@ -0,0 +1,623 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_pack_sse2_h
+#define cglm_pack_sse2_h
+#if defined( __SSE__ ) || defined( __SSE2__ )
+
+#include "../../common.h"
+#include "../intrin.h"
+
+/* clamp, scale and round to nearest even, like lrintf in glm_pack_* */
+static inline
+__m128i
+glmm_pack_cvt(__m128 x, __m128 lo, __m128 hi, __m128 s) {
+  return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, lo), hi), s));
+}
+
+/* glm_pack_half for 4 floats, results are in low 16 bits, sign extended */
+static inline
+__m128i
+glmm_pack_half(__m128 f) {
+  __m128i x, sign, o, nm, dn, big, sub;
+
+  x    = _mm_castps_si128(f);
+  sign = _mm_and_si128(x, _mm_set1_epi32((int)0x80000000u));
+  x    = _mm_xor_si128(x, sign);
+
+  /* too large for half, infinity or NaN */
+  big  = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477fffff));
+  o    = _mm_or_si128(_mm_set1_epi32(0x7c00),
+                      _mm_and_si128(_mm_cmpgt_epi32(x,
+                                                    _mm_set1_epi32(0x7f800000)),
+                                    _mm_set1_epi32(0x0200)));
+
+  /* half denormal or zero, the add does the rounding */
+  sub  = _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000));
+  dn   = _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.5f)));
+  dn   = _mm_sub_epi32(dn, _mm_set1_epi32(0x3f000000));
+
+  /* rebias exponent and round mantissa to nearest even */
+  nm   = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+  nm   = _mm_add_epi32(nm, _mm_add_epi32(x, _mm_set1_epi32((int)0xc8000fffu)));
+  nm   = _mm_srli_epi32(nm, 13);
+
+  nm   = _mm_or_si128(_mm_and_si128(sub, dn), _mm_andnot_si128(sub, nm));
+  o    = _mm_or_si128(_mm_and_si128(big, o), _mm_andnot_si128(big, nm));
+  o    = _mm_or_si128(o, _mm_srli_epi32(sign, 16));
+
+  /* sign extend so _mm_packs_epi32 keeps the bits */
+  return _mm_srai_epi32(_mm_slli_epi32(o, 16), 16);
+}
+
+/* glm_unpack_half for 4 half floats in low 16 bits */
+static inline
+__m128
+glmm_unpack_half(__m128i h) {
+  __m128i em, inf, sign;
+  __m128  o;
+
+  em   = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+  inf  = _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7bff));
+  inf  = _mm_and_si128(inf, _mm_set1_epi32(0x7f800000));
+  sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+
+  /* 2^112 moves exponent bias from 15 to 127 */
+  o    = _mm_castsi128_ps(_mm_slli_epi32(em, 13));
+  o    = _mm_mul_ps(o, _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+
+  return _mm_or_ps(o, _mm_castsi128_ps(_mm_or_si128(inf, sign)));
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_half_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_half_array_sse2(float *v, size_t count, uint16_t *dest) {
+  __m128i a0, a1;
+  size_t  i;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a0 = glmm_pack_half(_mm_loadu_ps(v + i));
+    a1 = glmm_pack_half(_mm_loadu_ps(v + i + 4));
+    _mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi32(a0, a1));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 half floats per iteration, see glm_unpack_half_array
+ *
+ * @returns number of half floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_half_array_sse2(uint16_t *v, size_t count, float *dest) {
+  __m128i a, z;
+  size_t  i;
+
+  z = _mm_setzero_si128();
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = _mm_loadu_si128((__m128i *)(v + i));
+    _mm_storeu_ps(dest + i,     glmm_unpack_half(_mm_unpacklo_epi16(a, z)));
+    _mm_storeu_ps(dest + i + 4, glmm_unpack_half(_mm_unpackhi_epi16(a, z)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 floats per iteration, see glm_pack_unorm8_array
+ *
+ * @returns number of floats converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm8_array_sse2(float *v, size_t count, uint8_t *dest) {
+  __m128  lo, hi, s;
+  __m128i a0, a1, a2, a3;
+  size_t  i;
+
+  lo = _mm_setzero_ps();
+  hi = _mm_set1_ps(1.0f);
+  s  = _mm_set1_ps(255.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = glmm_pack_cvt(_mm_loadu_ps(v + i),      lo, hi, s);
+    a1 = glmm_pack_cvt(_mm_loadu_ps(v + i + 4),  lo, hi, s);
+    a2 = glmm_pack_cvt(_mm_loadu_ps(v + i + 8),  lo, hi, s);
+    a3 = glmm_pack_cvt(_mm_loadu_ps(v + i + 12), lo, hi, s);
+    a0 = _mm_packs_epi32(a0, a1);
+    a2 = _mm_packs_epi32(a2, a3);
+    _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(a0, a2));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 values per iteration, see glm_unpack_unorm8_array
+ *
+ * @returns number of values converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm8_array_sse2(uint8_t *v, size_t count, float *dest) {
+  __m128  s;
+  __m128i a, w, z;
+  size_t  i;
+
+  s = _mm_set1_ps(255.0f);
+  z = _mm_setzero_si128();
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a = _mm_loadu_si128((__m128i *)(v + i));
+    w = _mm_unpacklo_epi8(a, z);
+    _mm_storeu_ps(dest + i,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(w, z)), s));
+    _mm_storeu_ps(dest + i + 4,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(w, z)), s));
+    w = _mm_unpackhi_epi8(a, z);
+    _mm_storeu_ps(dest + i + 8,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(w, z)), s));
+    _mm_storeu_ps(dest + i + 12,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(w, z)), s));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 floats per iteration, see glm_pack_snorm8_array
+ *
+ * @returns number of floats converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm8_array_sse2(float *v, size_t count, int8_t *dest) {
+  __m128  lo, hi, s;
+  __m128i a0, a1, a2, a3;
+  size_t  i;
+
+  lo = _mm_set1_ps(-1.0f);
+  hi = _mm_set1_ps(1.0f);
+  s  = _mm_set1_ps(127.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a0 = glmm_pack_cvt(_mm_loadu_ps(v + i),      lo, hi, s);
+    a1 = glmm_pack_cvt(_mm_loadu_ps(v + i + 4),  lo, hi, s);
+    a2 = glmm_pack_cvt(_mm_loadu_ps(v + i + 8),  lo, hi, s);
+    a3 = glmm_pack_cvt(_mm_loadu_ps(v + i + 12), lo, hi, s);
+    a0 = _mm_packs_epi32(a0, a1);
+    a2 = _mm_packs_epi32(a2, a3);
+    _mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi16(a0, a2));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 16 values per iteration, see glm_unpack_snorm8_array
+ *
+ * @returns number of values converted, a multiple of 16
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm8_array_sse2(int8_t *v, size_t count, float *dest) {
+  __m128  s, m;
+  __m128i a, w;
+  size_t  i;
+
+  s = _mm_set1_ps(127.0f);
+  m = _mm_set1_ps(-1.0f);
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    a = _mm_loadu_si128((__m128i *)(v + i));
+
+    /* sign extension by unpacking a value with itself and shifting */
+    w = _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8);
+    _mm_storeu_ps(dest + i,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(w, w), 16)), s), m));
+    _mm_storeu_ps(dest + i + 4,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpackhi_epi16(w, w), 16)), s), m));
+
+    w = _mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8);
+    _mm_storeu_ps(dest + i + 8,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(w, w), 16)), s), m));
+    _mm_storeu_ps(dest + i + 12,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpackhi_epi16(w, w), 16)), s), m));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_unorm16_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm16_array_sse2(float *v, size_t count, uint16_t *dest) {
+  __m128  lo, hi, s;
+  __m128i a0, a1, bias;
+  size_t  i;
+
+  lo   = _mm_setzero_ps();
+  hi   = _mm_set1_ps(1.0f);
+  s    = _mm_set1_ps(65535.0f);
+  bias = _mm_set1_epi32(32768);
+
+  /* SSE2 has no unsigned saturating pack, bias to signed and back */
+  for (i = 0; i + 8 <= count; i += 8) {
+    a0 = _mm_sub_epi32(glmm_pack_cvt(_mm_loadu_ps(v + i), lo, hi, s), bias);
+    a1 = _mm_sub_epi32(glmm_pack_cvt(_mm_loadu_ps(v + i + 4), lo, hi, s),
+                       bias);
+    _mm_storeu_si128((__m128i *)(dest + i),
+                     _mm_xor_si128(_mm_packs_epi32(a0, a1),
+                                   _mm_set1_epi16((short)0x8000)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 values per iteration, see glm_unpack_unorm16_array
+ *
+ * @returns number of values converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm16_array_sse2(uint16_t *v, size_t count, float *dest) {
+  __m128  s;
+  __m128i a, z;
+  size_t  i;
+
+  s = _mm_set1_ps(65535.0f);
+  z = _mm_setzero_si128();
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = _mm_loadu_si128((__m128i *)(v + i));
+    _mm_storeu_ps(dest + i,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(a, z)), s));
+    _mm_storeu_ps(dest + i + 4,
+                  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(a, z)), s));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 floats per iteration, see glm_pack_snorm16_array
+ *
+ * @returns number of floats converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm16_array_sse2(float *v, size_t count, int16_t *dest) {
+  __m128  lo, hi, s;
+  __m128i a0, a1;
+  size_t  i;
+
+  lo = _mm_set1_ps(-1.0f);
+  hi = _mm_set1_ps(1.0f);
+  s  = _mm_set1_ps(32767.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a0 = glmm_pack_cvt(_mm_loadu_ps(v + i),     lo, hi, s);
+    a1 = glmm_pack_cvt(_mm_loadu_ps(v + i + 4), lo, hi, s);
+    _mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi32(a0, a1));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 8 values per iteration, see glm_unpack_snorm16_array
+ *
+ * @returns number of values converted, a multiple of 8
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm16_array_sse2(int16_t *v, size_t count, float *dest) {
+  __m128  s, m;
+  __m128i a;
+  size_t  i;
+
+  s = _mm_set1_ps(32767.0f);
+  m = _mm_set1_ps(-1.0f);
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    a = _mm_loadu_si128((__m128i *)(v + i));
+    _mm_storeu_ps(dest + i,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16)), s), m));
+    _mm_storeu_ps(dest + i + 4,
+                  _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(
+                    _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16)), s), m));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief encodes 4 normals per iteration, see glm_pack_oct_array
+ *
+ * @returns number of normals encoded, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_oct_array_sse2(vec3 *n, size_t count, uint32_t *dest) {
+  __m128  a0, a1, a2, t0, t1, x, y, z, l, fx, fy, neg, sm, one, lo, s;
+  __m128i ix, iy;
+  float  *p;
+  size_t  i;
+
+  sm  = _mm_set1_ps(-0.0f);
+  one = _mm_set1_ps(1.0f);
+  lo  = _mm_set1_ps(-1.0f);
+  s   = _mm_set1_ps(32767.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    p  = n[i];
+    a0 = _mm_loadu_ps(p);                                   /* x1 z0 y0 x0 */
+    a1 = _mm_loadu_ps(p + 4);                               /* y2 x2 z1 y1 */
+    a2 = _mm_loadu_ps(p + 8);                               /* z3 y3 x3 z2 */
+
+    t0 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(1, 1, 2, 2));   /* x3 x3 x2 x2 */
+    x  = _mm_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+    t0 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(0, 0, 1, 1));   /* y1 y1 y0 y0 */
+    t1 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 2, 3, 3));   /* y3 y3 y2 y2 */
+    y  = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 1, 2, 2));   /* z1 z1 z0 z0 */
+    z  = _mm_shuffle_ps(t0, a2, _MM_SHUFFLE(3, 0, 2, 0));
+
+    l  = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sm, x), _mm_andnot_ps(sm, y)),
+                    _mm_andnot_ps(sm, z));
+    l  = _mm_div_ps(one, l);
+    x  = _mm_mul_ps(x, l);
+    y  = _mm_mul_ps(y, l);
+
+    /* fold lower hemisphere over the diagonals */
+    fx  = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(sm, y)),
+                    _mm_and_ps(sm, x));
+    fy  = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(sm, x)),
+                    _mm_and_ps(sm, y));
+    neg = _mm_cmplt_ps(z, _mm_setzero_ps());
+    x   = _mm_or_ps(_mm_and_ps(neg, fx), _mm_andnot_ps(neg, x));
+    y   = _mm_or_ps(_mm_and_ps(neg, fy), _mm_andnot_ps(neg, y));
+
+    ix  = glmm_pack_cvt(x, lo, one, s);
+    iy  = glmm_pack_cvt(y, lo, one, s);
+    ix  = _mm_and_si128(ix, _mm_set1_epi32(0xffff));
+    _mm_storeu_si128((__m128i *)(dest + i),
+                     _mm_or_si128(ix, _mm_slli_epi32(iy, 16)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief decodes 4 normals per iteration, see glm_unpack_oct_array
+ *
+ * @returns number of normals decoded, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_oct_array_sse2(uint32_t *p, size_t count, vec3 *dest) {
+  __m128  a0, a1, a2, t0, t1, x, y, z, t, l, sm, one, m, s;
+  __m128i a;
+  float  *d;
+  size_t  i;
+
+  sm  = _mm_set1_ps(-0.0f);
+  one = _mm_set1_ps(1.0f);
+  m   = _mm_set1_ps(-1.0f);
+  s   = _mm_set1_ps(32767.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = _mm_loadu_si128((__m128i *)(p + i));
+    x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16));
+    y = _mm_cvtepi32_ps(_mm_srai_epi32(a, 16));
+    x = _mm_max_ps(_mm_div_ps(x, s), m);
+    y = _mm_max_ps(_mm_div_ps(y, s), m);
+    z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(sm, x)),
+                   _mm_andnot_ps(sm, y));
+
+    /* unfold lower hemisphere */
+    t = _mm_max_ps(_mm_xor_ps(z, sm), _mm_setzero_ps());
+    x = _mm_sub_ps(x, _mm_or_ps(t, _mm_and_ps(sm, x)));
+    y = _mm_sub_ps(y, _mm_or_ps(t, _mm_and_ps(sm, y)));
+
+    l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                   _mm_mul_ps(z, z));
+    l = _mm_div_ps(one, _mm_sqrt_ps(l));
+    x = _mm_mul_ps(x, l);
+    y = _mm_mul_ps(y, l);
+    z = _mm_mul_ps(z, l);
+
+    t0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+    t1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+    a0 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+    t1 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+    a1 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+    t0 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+    t1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+    a2 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+
+    d = dest[i];
+    _mm_storeu_ps(d,     a0);
+    _mm_storeu_ps(d + 4, a1);
+    _mm_storeu_ps(d + 8, a2);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration, see glm_pack_unorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_unorm1010102_array_sse2(vec4 *v, size_t count, uint32_t *dest) {
+  __m128  x, y, z, w, lo, hi, s, sw;
+  __m128i o;
+  size_t  i;
+
+  lo = _mm_setzero_ps();
+  hi = _mm_set1_ps(1.0f);
+  s  = _mm_set1_ps(1023.0f);
+  sw = _mm_set1_ps(3.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    x = glmm_load(v[i]);
+    y = glmm_load(v[i + 1]);
+    z = glmm_load(v[i + 2]);
+    w = glmm_load(v[i + 3]);
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    o = glmm_pack_cvt(x, lo, hi, s);
+    o = _mm_or_si128(o, _mm_slli_epi32(glmm_pack_cvt(y, lo, hi, s),  10));
+    o = _mm_or_si128(o, _mm_slli_epi32(glmm_pack_cvt(z, lo, hi, s),  20));
+    o = _mm_or_si128(o, _mm_slli_epi32(glmm_pack_cvt(w, lo, hi, sw), 30));
+    _mm_storeu_si128((__m128i *)(dest + i), o);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration,
+ *        see glm_unpack_unorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_unorm1010102_array_sse2(uint32_t *p, size_t count, vec4 *dest) {
+  __m128  x, y, z, w, s, sw;
+  __m128i a, mask;
+  size_t  i;
+
+  s    = _mm_set1_ps(1023.0f);
+  sw   = _mm_set1_ps(3.0f);
+  mask = _mm_set1_epi32(0x3ff);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = _mm_loadu_si128((__m128i *)(p + i));
+    x = _mm_cvtepi32_ps(_mm_and_si128(a, mask));
+    y = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(a, 10), mask));
+    z = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(a, 20), mask));
+    w = _mm_cvtepi32_ps(_mm_srli_epi32(a, 30));
+    x = _mm_div_ps(x, s);
+    y = _mm_div_ps(y, s);
+    z = _mm_div_ps(z, s);
+    w = _mm_div_ps(w, sw);
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    glmm_store(dest[i],     x);
+    glmm_store(dest[i + 1], y);
+    glmm_store(dest[i + 2], z);
+    glmm_store(dest[i + 3], w);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration, see glm_pack_snorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_pack_snorm1010102_array_sse2(vec4 *v, size_t count, uint32_t *dest) {
+  __m128  x, y, z, w, lo, hi, s;
+  __m128i o, mask;
+  size_t  i;
+
+  lo   = _mm_set1_ps(-1.0f);
+  hi   = _mm_set1_ps(1.0f);
+  s    = _mm_set1_ps(511.0f);
+  mask = _mm_set1_epi32(0x3ff);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    x = glmm_load(v[i]);
+    y = glmm_load(v[i + 1]);
+    z = glmm_load(v[i + 2]);
+    w = glmm_load(v[i + 3]);
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    o = _mm_and_si128(glmm_pack_cvt(x, lo, hi, s), mask);
+    o = _mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(glmm_pack_cvt(y, lo,
+                                                                   hi, s),
+                                                     mask), 10));
+    o = _mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(glmm_pack_cvt(z, lo,
+                                                                   hi, s),
+                                                     mask), 20));
+    o = _mm_or_si128(o, _mm_slli_epi32(glmm_pack_cvt(w, lo, hi, hi), 30));
+    _mm_storeu_si128((__m128i *)(dest + i), o);
+  }
+
+  return i;
+}
+
+/*!
+ * @brief converts 4 vectors per iteration,
+ *        see glm_unpack_snorm1010102_array
+ *
+ * @returns number of vectors converted, a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_unpack_snorm1010102_array_sse2(uint32_t *p, size_t count, vec4 *dest) {
+  __m128  x, y, z, w, s, m;
+  __m128i a;
+  size_t  i;
+
+  s = _mm_set1_ps(511.0f);
+  m = _mm_set1_ps(-1.0f);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    a = _mm_loadu_si128((__m128i *)(p + i));
+    x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 22), 22));
+    y = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 12), 22));
+    z = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 2),  22));
+    w = _mm_cvtepi32_ps(_mm_srai_epi32(a, 30));
+    x = _mm_max_ps(_mm_div_ps(x, s), m);
+    y = _mm_max_ps(_mm_div_ps(y, s), m);
+    z = _mm_max_ps(_mm_div_ps(z, s), m);
+    w = _mm_max_ps(w, m);
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    glmm_store(dest[i],     x);
+    glmm_store(dest[i + 1], y);
+    glmm_store(dest[i + 2], z);
+    glmm_store(dest[i + 3], w);
+  }
+
+  return i;
+}
+
+#endif
+#endif /* cglm_pack_sse2_h */
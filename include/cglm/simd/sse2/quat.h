@@ -50,5 +50,148 @@ glm_quat_mul_sse2(versor p, versor q, versor dest) {
   glmm_store(dest, r);
 }
 
+/* same polynomials as glm_acos01_approx and glm_sin_approx */
+static inline
+__m128
+glmm_acos01_approx(__m128 x) {
+  __m128 p;
+
+  p = glmm_fmadd(_mm_set1_ps(-0.0012624911f), x, _mm_set1_ps(0.0066700901f));
+  p = glmm_fmadd(p, x, _mm_set1_ps(-0.0170881256f));
+  p = glmm_fmadd(p, x, _mm_set1_ps( 0.0308918810f));
+  p = glmm_fmadd(p, x, _mm_set1_ps(-0.0501743046f));
+  p = glmm_fmadd(p, x, _mm_set1_ps( 0.0889789874f));
+  p = glmm_fmadd(p, x, _mm_set1_ps(-0.2145988016f));
+  p = glmm_fmadd(p, x, _mm_set1_ps( 1.5707963050f));
+
+  return _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)), p);
+}
+
+static inline
+__m128
+glmm_sin_approx(__m128 x) {
+  __m128 x2, p;
+
+  x2 = _mm_mul_ps(x, x);
+  p  = glmm_fmadd(_mm_set1_ps(-2.5052108e-8f), x2, _mm_set1_ps(2.7557319e-6f));
+  p  = glmm_fmadd(p, x2, _mm_set1_ps(-1.9841270e-4f));
+  p  = glmm_fmadd(p, x2, _mm_set1_ps( 8.3333333e-3f));
+  p  = glmm_fmadd(p, x2, _mm_set1_ps(-1.6666667e-1f));
+
+  return glmm_fmadd(_mm_mul_ps(p, x2), x, x);
+}
+
+/*!
+ * @brief slerps 4 quaternions per iteration, see glm_quat_slerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_quat_slerp_soa_sse2(float *from[4],
+                        float *to[4],
+                        float  t,
+                        size_t count,
+                        float *dest[4]) {
+  __m128 f[4], q[4], c, sgn, th, s, a, b, lerp, one, vt, vt1;
+  size_t i;
+  int    j;
+
+  one = _mm_set1_ps(1.0f);
+  vt  = _mm_set1_ps(t);
+  vt1 = _mm_set1_ps(1.0f - t);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm_loadu_ps(from[j] + i);
+      q[j] = _mm_loadu_ps(to[j] + i);
+    }
+
+    c = _mm_mul_ps(f[0], q[0]);
+    c = glmm_fmadd(f[1], q[1], c);
+    c = glmm_fmadd(f[2], q[2], c);
+    c = glmm_fmadd(f[3], q[3], c);
+
+    /* shorter arc: from is negated where cos(theta) < 0 */
+    sgn = _mm_and_ps(c, _mm_set1_ps(-0.0f));
+    c   = _mm_min_ps(_mm_xor_ps(c, sgn), one);
+
+    th = glmm_acos01_approx(c);
+    s  = glmm_sin_approx(th);
+    a  = glmm_sin_approx(_mm_mul_ps(vt1, th));
+    b  = glmm_sin_approx(_mm_mul_ps(vt, th));
+
+    /* lerp where sin(theta) is too small to divide by */
+    lerp = _mm_cmplt_ps(s, _mm_set1_ps(0.001f));
+    s    = _mm_div_ps(one, s);
+    a    = _mm_or_ps(_mm_and_ps(lerp, vt1),
+                     _mm_andnot_ps(lerp, _mm_mul_ps(a, s)));
+    b    = _mm_or_ps(_mm_and_ps(lerp, vt),
+                     _mm_andnot_ps(lerp, _mm_mul_ps(b, s)));
+    a    = _mm_xor_ps(a, sgn);
+
+    for (j = 0; j < 4; j++)
+      _mm_storeu_ps(dest[j] + i, glmm_fmadd(a, f[j], _mm_mul_ps(b, q[j])));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief nlerps 4 quaternions per iteration, see glm_quat_nlerp_soa
+ *
+ * @returns number of quaternions interpolated, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_quat_nlerp_soa_sse2(float *from[4],
+                        float *to[4],
+                        float  t,
+                        size_t count,
+                        float *dest[4]) {
+  __m128 f[4], q[4], d[4], c, b, n, zero, vt, vt1;
+  size_t i;
+  int    j;
+
+  vt  = _mm_set1_ps(t);
+  vt1 = _mm_set1_ps(1.0f - t);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    for (j = 0; j < 4; j++) {
+      f[j] = _mm_loadu_ps(from[j] + i);
+      q[j] = _mm_loadu_ps(to[j] + i);
+    }
+
+    c = _mm_mul_ps(f[0], q[0]);
+    c = glmm_fmadd(f[1], q[1], c);
+    c = glmm_fmadd(f[2], q[2], c);
+    c = glmm_fmadd(f[3], q[3], c);
+
+    /* shorter arc: to is negated where cos(theta) < 0 */
+    b = _mm_xor_ps(vt, _mm_and_ps(c, _mm_set1_ps(-0.0f)));
+
+    for (j = 0; j < 4; j++)
+      d[j] = glmm_fmadd(vt1, f[j], _mm_mul_ps(b, q[j]));
+
+    n = _mm_mul_ps(d[0], d[0]);
+    n = glmm_fmadd(d[1], d[1], n);
+    n = glmm_fmadd(d[2], d[2], n);
+    n = glmm_fmadd(d[3], d[3], n);
+
+    /* zero length results become identity like glm_quat_normalize */
+    zero = _mm_cmple_ps(n, _mm_setzero_ps());
+    n    = _mm_sqrt_ps(n);
+
+    for (j = 0; j < 3; j++)
+      _mm_storeu_ps(dest[j] + i, _mm_andnot_ps(zero, _mm_div_ps(d[j], n)));
+
+    _mm_storeu_ps(dest[3] + i,
+                  _mm_or_ps(_mm_and_ps(zero, _mm_set1_ps(1.0f)),
+                            _mm_andnot_ps(zero, _mm_div_ps(d[3], n))));
+  }
+
+  return i;
+}
+
 #endif
 #endif /* cglm_quat_simd_h */
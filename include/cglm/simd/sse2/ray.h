@@ -0,0 +1,135 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_ray_sse2_h
+#define cglm_ray_sse2_h
+#if defined( __SSE__ ) || defined( __SSE2__ )
+
+#include "../../common.h"
+#include "../intrin.h"
+
+/*!
+ * @brief tests 4 triangles per iteration, see glm_ray_triangle_soa
+ *
+ * the last 1-3 triangles are copied to a zero padded buffer, zero edges
+ * never pass the determinant test.
+ *
+ * @returns number of triangles tested, always count
+ */
+CGLM_INLINE
+size_t
+glm_ray_triangle_soa_sse2(vec3    origin,
+                          vec3    direction,
+                          float  *tri[9],
+                          size_t  count,
+                          float  *d,
+                          size_t *index) {
+  float   pad[9][4], tb[4];
+  int32_t ib[4];
+  float  *r[9];
+  __m128  ox, oy, oz, dx, dy, dz, eps, neps, one, zero, best;
+  __m128  e1x, e1y, e1z, e2x, e2y, e2z, tx, ty, tz, px, py, pz;
+  __m128  det, inv, u, v, t, m;
+  __m128i lane, bi;
+  size_t  i, j, k;
+
+  ox   = _mm_set1_ps(origin[0]);
+  oy   = _mm_set1_ps(origin[1]);
+  oz   = _mm_set1_ps(origin[2]);
+  dx   = _mm_set1_ps(direction[0]);
+  dy   = _mm_set1_ps(direction[1]);
+  dz   = _mm_set1_ps(direction[2]);
+  eps  = _mm_set1_ps(0.000001f);
+  neps = _mm_set1_ps(-0.000001f);
+  one  = _mm_set1_ps(1.0f);
+  zero = _mm_setzero_ps();
+  best = _mm_set1_ps(*d);
+  lane = _mm_set_epi32(3, 2, 1, 0);
+  bi   = _mm_set1_epi32(-1);
+
+  for (i = 0; i < count; i += 4) {
+    if (count - i >= 4) {
+      for (k = 0; k < 9; k++)
+        r[k] = tri[k] + i;
+    } else {
+      for (k = 0; k < 9; k++) {
+        for (j = 0; j < 4; j++)
+          pad[k][j] = i + j < count ? tri[k][i + j] : 0.0f;
+        r[k] = pad[k];
+      }
+    }
+
+    e1x = _mm_loadu_ps(r[3]);
+    e1y = _mm_loadu_ps(r[4]);
+    e1z = _mm_loadu_ps(r[5]);
+    e2x = _mm_loadu_ps(r[6]);
+    e2y = _mm_loadu_ps(r[7]);
+    e2z = _mm_loadu_ps(r[8]);
+
+    /* p = direction x e2 */
+    px  = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    py  = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    pz  = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+    det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)),
+                     _mm_mul_ps(e1z, pz));
+    inv = _mm_div_ps(one, det);
+    m   = _mm_or_ps(_mm_cmple_ps(det, neps), _mm_cmpge_ps(det, eps));
+
+    /* t = origin - v0 */
+    tx  = _mm_sub_ps(ox, _mm_loadu_ps(r[0]));
+    ty  = _mm_sub_ps(oy, _mm_loadu_ps(r[1]));
+    tz  = _mm_sub_ps(oz, _mm_loadu_ps(r[2]));
+
+    u   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)),
+                     _mm_mul_ps(tz, pz));
+    u   = _mm_mul_ps(u, inv);
+    m   = _mm_and_ps(m, _mm_and_ps(_mm_cmpge_ps(u, zero),
+                                   _mm_cmple_ps(u, one)));
+
+    /* q = t x e1, reuses p */
+    px  = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+    py  = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+    pz  = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+    v   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, px), _mm_mul_ps(dy, py)),
+                     _mm_mul_ps(dz, pz));
+    v   = _mm_mul_ps(v, inv);
+    m   = _mm_and_ps(m, _mm_and_ps(_mm_cmpge_ps(v, zero),
+                                   _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+    t   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, px), _mm_mul_ps(e2y, py)),
+                     _mm_mul_ps(e2z, pz));
+    t   = _mm_mul_ps(t, inv);
+    m   = _mm_and_ps(m, _mm_and_ps(_mm_cmpgt_ps(t, eps),
+                                   _mm_cmplt_ps(t, best)));
+
+    best = _mm_or_ps(_mm_and_ps(m, t), _mm_andnot_ps(m, best));
+    bi   = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), lane),
+                        _mm_andnot_si128(_mm_castps_si128(m), bi));
+    lane = _mm_add_epi32(lane, _mm_set1_epi32(4));
+  }
+
+  /* nearest lane, the lowest index on ties like the scalar loop */
+  _mm_storeu_ps(tb, best);
+  _mm_storeu_si128((__m128i *)ib, bi);
+
+  for (j = 0; j < 4; j++) {
+    if (ib[j] < 0 || tb[j] > *d)
+      continue;
+
+    if (tb[j] < *d || (size_t)ib[j] < *index) {
+      *d     = tb[j];
+      *index = (size_t)ib[j];
+    }
+  }
+
+  return count;
+}
+
+#endif
+#endif /* cglm_ray_sse2_h */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c), Recep Aslantas.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ */
+
+#ifndef cglm_sphere_sse2_h
+#define cglm_sphere_sse2_h
+#if defined( __SSE__ ) || defined( __SSE2__ )
+
+#include "../../common.h"
+#include "../intrin.h"
+
+/*!
+ * @brief transforms one sphere per iteration, see glm_sphere_transform_array
+ *
+ * @returns number of spheres transformed, always count
+ */
+CGLM_INLINE
+size_t
+glm_sphere_transform_array_sse2(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  __m128 c0, c1, c2, c3, x0, x1, t0, t1, t2, t3;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    c0 = glmm_load(m[i][0]);
+    c1 = glmm_load(m[i][1]);
+    c2 = glmm_load(m[i][2]);
+    c3 = glmm_load(m[i][3]);
+    x0 = glmm_load(s[i]);
+
+    x1 = glmm_fmadd(c0, glmm_splat_x(x0), c3);
+    x1 = glmm_fmadd(c1, glmm_splat_y(x0), x1);
+    x1 = glmm_fmadd(c2, glmm_splat_z(x0), x1);
+
+    /* squared lengths of the x, y and z axes, transposed so they add up */
+    c0 = _mm_mul_ps(c0, c0);
+    c1 = _mm_mul_ps(c1, c1);
+    c2 = _mm_mul_ps(c2, c2);
+
+    t0 = _mm_unpacklo_ps(c0, c1);                      /* b1 a1 b0 a0 */
+    t1 = _mm_unpacklo_ps(c2, c2);                      /* c1 c1 c0 c0 */
+    t2 = _mm_unpackhi_ps(c0, c1);                      /* b3 a3 b2 a2 */
+    t3 = _mm_unpackhi_ps(c2, c2);                      /* c3 c3 c2 c2 */
+
+    t0 = _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+                               _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2))),
+                    _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+
+    t0 = _mm_max_ps(t0, glmm_shuff1(t0, 1, 0, 3, 2));
+    t0 = _mm_max_ps(t0, glmm_shuff1(t0, 2, 3, 0, 1));
+    t0 = _mm_mul_ps(_mm_sqrt_ps(t0), glmm_splat_w(x0));
+
+    /* x y z of the center, w of the radius */
+    t1 = _mm_unpackhi_ps(x1, t0);
+    glmm_store(dest[i], _mm_shuffle_ps(x1, t1, _MM_SHUFFLE(3, 0, 1, 0)));
+  }
+
+  return i;
+}
+
+/*!
+ * @brief grows box by four spheres per iteration, see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_aabb_sse2(vec4 *s, size_t count, vec3 box[2]) {
+  __m128 x, y, z, r, t0, t1, t2, t3, minx, miny, minz, maxx, maxy, maxz;
+  size_t i;
+
+  minx = _mm_set1_ps(box[0][0]);
+  miny = _mm_set1_ps(box[0][1]);
+  minz = _mm_set1_ps(box[0][2]);
+  maxx = _mm_set1_ps(box[1][0]);
+  maxy = _mm_set1_ps(box[1][1]);
+  maxz = _mm_set1_ps(box[1][2]);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    t0 = glmm_load(s[i]);
+    t1 = glmm_load(s[i + 1]);
+    t2 = glmm_load(s[i + 2]);
+    t3 = glmm_load(s[i + 3]);
+
+    _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+    x = t0; y = t1; z = t2; r = t3;
+
+    minx = _mm_min_ps(minx, _mm_sub_ps(x, r));
+    miny = _mm_min_ps(miny, _mm_sub_ps(y, r));
+    minz = _mm_min_ps(minz, _mm_sub_ps(z, r));
+    maxx = _mm_max_ps(maxx, _mm_add_ps(x, r));
+    maxy = _mm_max_ps(maxy, _mm_add_ps(y, r));
+    maxz = _mm_max_ps(maxz, _mm_add_ps(z, r));
+  }
+
+  box[0][0] = glmm_hmin(minx);
+  box[0][1] = glmm_hmin(miny);
+  box[0][2] = glmm_hmin(minz);
+  box[1][0] = glmm_hmax(maxx);
+  box[1][1] = glmm_hmax(maxy);
+  box[1][2] = glmm_hmax(maxz);
+
+  return i;
+}
+
+/*!
+ * @brief grows radius around center by four spheres per iteration,
+ *        see glm_sphere_merge_array
+ *
+ * @returns number of spheres merged, always a multiple of 4
+ */
+CGLM_INLINE
+size_t
+glm_sphere_merge_radius_sse2(vec4   *s,
+                             size_t  count,
+                             vec3    center,
+                             float  *radius) {
+  __m128 x, y, z, r, t0, t1, t2, t3, cx, cy, cz, rmax;
+  size_t i;
+
+  cx   = _mm_set1_ps(center[0]);
+  cy   = _mm_set1_ps(center[1]);
+  cz   = _mm_set1_ps(center[2]);
+  rmax = _mm_set1_ps(*radius);
+
+  for (i = 0; i + 4 <= count; i += 4) {
+    t0 = glmm_load(s[i]);
+    t1 = glmm_load(s[i + 1]);
+    t2 = glmm_load(s[i + 2]);
+    t3 = glmm_load(s[i + 3]);
+
+    _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+    x = _mm_sub_ps(t0, cx);
+    y = _mm_sub_ps(t1, cy);
+    z = _mm_sub_ps(t2, cz);
+    r = t3;
+
+    /* mul + add keeps results identical to the scalar loop */
+    x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                   _mm_mul_ps(z, z));
+    rmax = _mm_max_ps(rmax, _mm_add_ps(_mm_sqrt_ps(x), r));
+  }
+
+  *radius = glmm_hmax(rmax);
+
+  return i;
+}
+
+#endif
+#endif /* cglm_sphere_sse2_h */
@@ -54,6 +54,12 @@
 #  endif
 #endif
 
+/* batch kernels switch to non-temporal stores when they write at least this
+   many bytes, so large outputs do not evict their inputs from the caches */
+#ifndef CGLM_STREAM_MIN_BYTES
+#  define CGLM_STREAM_MIN_BYTES (1 << 22)
+#endif
+
 static inline
 __m128
 glmm_abs(__m128 x) {
@@ -11,6 +11,22 @@
 #include "common.h"
 #include "mat4.h"
 
+#ifdef CGLM_SSE_FP
+#  include "simd/sse2/sphere.h"
+#endif
+
+#ifdef CGLM_AVX_FP
+#  include "simd/avx/sphere.h"
+#endif
+
+#ifdef CGLM_AVX512_FP
+#  include "simd/avx512/sphere.h"
+#endif
+
+#ifdef CGLM_NEON_FP
+#  include "simd/neon/sphere.h"
+#endif
+
 /*
   Sphere Representation in cglm: [center.x, center.y, center.z, radii]
 
@@ -70,6 +86,126 @@ glm_sphere_merge(vec4 s1, vec4 s2, vec4 dest) {
   dest[3] = radii;
 }
 
+/*!
+ * @brief apply a transform to each sphere of an array
+ *
+ * sphere i is transformed by m[i]. Unlike glm_sphere_transform the radius is
+ * scaled too, by the length of the longest x, y or z axis of the matrix, so
+ * the result keeps bounding the object under rotation and (non-uniform)
+ * scale. 1, 2 or 4 spheres are transformed at a time depending on the SIMD
+ * extension available. dest may be s.
+ *
+ * @param[in]  s     spheres
+ * @param[in]  m     transform matrices, one per sphere
+ * @param[in]  count number of spheres
+ * @param[out] dest  transformed spheres
+ */
+CGLM_INLINE
+void
+glm_sphere_transform_array(vec4 *s, mat4 *m, size_t count, vec4 *dest) {
+  vec4   c;
+  float  l;
+  size_t i;
+  int    j;
+
+#if defined(__AVX512F__)
+  i = glm_sphere_transform_array_avx512(s, m, count, dest);
+#elif defined(__AVX__)
+  i = glm_sphere_transform_array_avx(s, m, count, dest);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_sphere_transform_array_sse2(s, m, count, dest);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_sphere_transform_array_neon(s, m, count, dest);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    for (j = 0; j < 3; j++) {
+      c[j] = m[i][0][j] * s[i][0] + m[i][3][j];
+      c[j] = m[i][1][j] * s[i][1] + c[j];
+      c[j] = m[i][2][j] * s[i][2] + c[j];
+    }
+
+    l = glm_max(glm_vec3_norm2(m[i][0]), glm_vec3_norm2(m[i][1]));
+    l = glm_max(l, glm_vec3_norm2(m[i][2]));
+
+    c[3] = sqrtf(l) * s[i][3];
+    glm_vec4_copy(c, dest[i]);
+  }
+}
+
+/*!
+ * @brief merges an array of spheres into one bounding sphere
+ *
+ * all spheres must be in same space. The center is the center of the AABB
+ * around the spheres and the radius reaches the farthest sphere surface from
+ * there, which is much tighter than merging the spheres one by one with
+ * glm_sphere_merge. Both passes are reductions that run 4, 8 or 16 spheres at
+ * a time depending on the SIMD extension available. Merging no spheres gives
+ * a zero sphere.
+ *
+ * @param[in]  s     spheres
+ * @param[in]  count number of spheres
+ * @param[out] dest  merged sphere
+ */
+CGLM_INLINE
+void
+glm_sphere_merge_array(vec4 *s, size_t count, vec4 dest) {
+  vec3   box[2], center;
+  float  radius;
+  size_t i;
+  int    j;
+
+  if (count == 0) {
+    glm_vec4_zero(dest);
+    return;
+  }
+
+  glm_vec3_broadcast(FLT_MAX,  box[0]);
+  glm_vec3_broadcast(-FLT_MAX, box[1]);
+
+#if defined(__AVX512F__)
+  i = glm_sphere_merge_aabb_avx512(s, count, box);
+#elif defined(__AVX__)
+  i = glm_sphere_merge_aabb_avx(s, count, box);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_sphere_merge_aabb_sse2(s, count, box);
+#elif defined(CGLM_NEON_FP)
+  i = glm_sphere_merge_aabb_neon(s, count, box);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++) {
+    for (j = 0; j < 3; j++) {
+      box[0][j] = glm_min(box[0][j], s[i][j] - s[i][3]);
+      box[1][j] = glm_max(box[1][j], s[i][j] + s[i][3]);
+    }
+  }
+
+  glm_vec3_center(box[0], box[1], center);
+  radius = 0.0f;
+
+#if defined(__AVX512F__)
+  i = glm_sphere_merge_radius_avx512(s, count, center, &radius);
+#elif defined(__AVX__)
+  i = glm_sphere_merge_radius_avx(s, count, center, &radius);
+#elif defined( __SSE__ ) || defined( __SSE2__ )
+  i = glm_sphere_merge_radius_sse2(s, count, center, &radius);
+#elif defined(CGLM_NEON_FP) && CGLM_ARM64
+  i = glm_sphere_merge_radius_neon(s, count, center, &radius);
+#else
+  i = 0;
+#endif
+
+  for (; i < count; i++)
+    radius = glm_max(radius, sqrtf(glm_vec3_distance2(s[i], center)) + s[i][3]);
+
+  glm_vec3_copy(center, dest);
+  dest[3] = radius;
+}
+
 /*!
  * @brief check if two sphere intersects
  *
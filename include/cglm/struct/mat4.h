@@ -28,11 +28,14 @@
    CGLM_INLINE mat4s   glms_mat4_ins3(mat3s mat);
    CGLM_INLINE mat4s   glms_mat4_mul(mat4s m1, mat4s m2);
    CGLM_INLINE mat4s   glms_mat4_mulN(mat4s * __restrict matrices[], uint32_t len);
+   CGLM_INLINE void    glms_mat4_mul_array(mat4s *m1, mat4s *m2, size_t count, mat4s *dest);
    CGLM_INLINE vec4s   glms_mat4_mulv(mat4s m, vec4s v);
    CGLM_INLINE float   glms_mat4_trace(mat4s m);
    CGLM_INLINE float   glms_mat4_trace3(mat4s m);
    CGLM_INLINE versors glms_mat4_quat(mat4s m);
    CGLM_INLINE vec3s   glms_mat4_mulv3(mat4s m, vec3s v, float last);
+   CGLM_INLINE void    glms_mat4_mulv_array(mat4s m, vec4s *v, size_t count, vec4s *dest);
+   CGLM_INLINE void    glms_mat4_mulv3_array(mat4s m, vec3s *v, float last, size_t count, vec3s *dest);
    CGLM_INLINE mat4s   glms_mat4_transpose(mat4s m);
    CGLM_INLINE mat4s   glms_mat4_scale_p(mat4s m, float s);
    CGLM_INLINE mat4s   glms_mat4_scale(mat4s m, float s);
@@ -243,6 +246,20 @@ glms_mat4_mulN(mat4s * __restrict matrices[], uint32_t len) {
   return r;
 }
 
+/*!
+ * @brief multiply two arrays of matrices pair by pair, dest[i] = m1[i] * m2[i]
+ *
+ * @param[in]  m1    left matrices
+ * @param[in]  m2    right matrices
+ * @param[in]  count count of matrices in each array
+ * @param[out] dest  result matrices
+ */
+CGLM_INLINE
+void
+glms_mat4_mul_array(mat4s *m1, mat4s *m2, size_t count, mat4s *dest) {
+  glm_mat4_mul_array((mat4 *)m1, (mat4 *)m2, count, (mat4 *)dest);
+}
+
 /*!
  * @brief multiply mat4 with vec4 (column vector) and store in dest vector
  *
@@ -314,6 +331,39 @@ glms_mat4_mulv3(mat4s m, vec3s v, float last) {
   return r;
 }
 
+/*!
+ * @brief multiply an array of vectors with mat4, dest[i] = m * v[i]
+ *
+ * @param[in]  m     mat4 (left)
+ * @param[in]  v     vectors (right, column vectors)
+ * @param[in]  count number of vectors
+ * @param[out] dest  result vectors
+ */
+CGLM_INLINE
+void
+glms_mat4_mulv_array(mat4s m, vec4s *v, size_t count, vec4s *dest) {
+  glm_mat4_mulv_array(m.raw, (vec4 *)v, count, (vec4 *)dest);
+}
+
+/*!
+ * @brief multiply an array of vec3 with mat4, see glm_mat4_mulv3_array
+ *
+ * @param[in]  m     mat4 (affine transform)
+ * @param[in]  v     vectors
+ * @param[in]  last  4th item of each vector
+ * @param[in]  count number of vectors
+ * @param[out] dest  result vectors
+ */
+CGLM_INLINE
+void
+glms_mat4_mulv3_array(mat4s  m,
+                      vec3s *v,
+                      float  last,
+                      size_t count,
+                      vec3s *dest) {
+  glm_mat4_mulv3_array(m.raw, (vec3 *)v, last, count, (vec3 *)dest);
+}
+
 /*!
  * @brief tranpose mat4 and store result in same matrix
  *
@@ -66,6 +66,37 @@ glms_sphere_merge(vec4s s1, vec4s s2) {
   return r;
 }
 
+/*!
+ * @brief apply a transform to each sphere of an array, radii are scaled by
+ *        the longest axis of their matrix, see glm_sphere_transform_array
+ *
+ * @param[in]  s     spheres
+ * @param[in]  m     transform matrices, one per sphere
+ * @param[in]  count number of spheres
+ * @param[out] dest  transformed spheres
+ */
+CGLM_INLINE
+void
+glms_sphere_transform_array(vec4s *s, mat4s *m, size_t count, vec4s *dest) {
+  glm_sphere_transform_array((vec4 *)s, (mat4 *)m, count, (vec4 *)dest);
+}
+
+/*!
+ * @brief merges an array of spheres into one bounding sphere,
+ *        see glm_sphere_merge_array
+ *
+ * @param[in]  s     spheres
+ * @param[in]  count number of spheres
+ * @returns          merged sphere
+ */
+CGLM_INLINE
+vec4s
+glms_sphere_merge_array(vec4s *s, size_t count) {
+  vec4s r;
+  glm_sphere_merge_array((vec4 *)s, count, r.raw);
+  return r;
+}
+
 /*!
  * @brief check if two sphere intersects
  *
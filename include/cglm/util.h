@@ -28,6 +28,8 @@
    CGLM_INLINE bool  glm_eq(float a, float b);
    CGLM_INLINE float glm_percent(float from, float to, float current);
    CGLM_INLINE float glm_percentc(float from, float to, float current);
+   CGLM_INLINE float glm_acos01_approx(float x);
+   CGLM_INLINE float glm_sin_approx(float x);
  */
 
 #ifndef cglm_util_h
@@ -340,4 +342,49 @@ glm_swapf(float * __restrict a, float * __restrict b) {
   *b = t;
 }
 
+/*!
+ * @brief polynomial acos for x in [0, 1], Abramowitz & Stegun 4.4.46
+ *
+ * absolute error is below 2e-8 before float rounding, about 2e-7 after it.
+ * The batch quaternion functions use the same polynomial in SIMD registers.
+ *
+ * @param[in]   x value in [0, 1]
+ */
+CGLM_INLINE
+float
+glm_acos01_approx(float x) {
+  float p;
+
+  p = -0.0012624911f * x + 0.0066700901f;
+  p = p * x - 0.0170881256f;
+  p = p * x + 0.0308918810f;
+  p = p * x - 0.0501743046f;
+  p = p * x + 0.0889789874f;
+  p = p * x - 0.2145988016f;
+  p = p * x + 1.5707963050f;
+
+  return sqrtf(1.0f - x) * p;
+}
+
+/*!
+ * @brief polynomial sin for x in [-pi/2, pi/2], odd Taylor series to x^11
+ *
+ * absolute error is below 6e-8 before float rounding
+ *
+ * @param[in]   x angle in radians, in [-pi/2, pi/2]
+ */
+CGLM_INLINE
+float
+glm_sin_approx(float x) {
+  float x2, p;
+
+  x2 = x * x;
+  p  = -2.5052108e-8f * x2 + 2.7557319e-6f;
+  p  = p * x2 - 1.9841270e-4f;
+  p  = p * x2 + 8.3333333e-3f;
+  p  = p * x2 - 1.6666667e-1f;
+
+  return p * x2 * x + x;
+}
+
 #endif /* cglm_util_h */
@@ -0,0 +1,370 @@
+#define _DEFAULT_SOURCE
+#include "AssetArchive.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#ifdef ASSET_ARCHIVE_LZ4
+    #include <lz4.h>
+#endif
+#ifdef ASSET_ARCHIVE_ZSTD
+    #include <zstd.h>
+#endif
+
+/* PRIVATE VISIBILITY */
+bool MapArchiveFile( const char*, AssetArchive* );
+void UnmapArchiveFile( AssetArchive* );
+uint8_t *DecompressAsset( const AssetArchive*, const AssetArchiveEntry* );
+uint8_t *ReadWholeFile( const char*, uint64_t* );
+uint32_t CompressAsset( const uint8_t*, uint64_t, uint32_t, uint8_t**, uint64_t* );
+bool IsCompressionSupported( uint32_t );
+int CompareAssetEntries( const void*, const void* );
+
+/* METHODS */
+bool OpenAssetArchive( const char *filename, AssetArchive *archive ) {
+    method( "OpenAssetArchive" );
+
+    memset( archive, 0, sizeof( AssetArchive ) );
+    if ( !MapArchiveFile( filename, archive ) ) {
+        fail_method( "OpenAssetArchive", "failed to map \"%s\"!\n", filename );
+        return false;
+    }
+
+    const AssetArchiveHeader *header = ( const AssetArchiveHeader* )archive->data;
+    if ( archive->size < sizeof( AssetArchiveHeader ) ||
+         header->magic != ASSET_ARCHIVE_MAGIC ||
+         header->version != ASSET_ARCHIVE_VERSION ||
+         header->indexOffset + ( uint64_t )header->entryCount * sizeof( AssetArchiveEntry ) > archive->size ) {
+        fail_method( "OpenAssetArchive", "\"%s\" is not a valid asset archive!\n", filename );
+        UnmapArchiveFile( archive );
+        return false;
+    }
+
+    archive->entries = ( const AssetArchiveEntry* )( archive->data + header->indexOffset );
+    archive->entryLength = header->entryCount;
+    archive->decompressed = calloc( archive->entryLength, sizeof( uint8_t* ) );
+
+    printf( "\t\t%u assets, %llu bytes mapped\n", archive->entryLength, ( unsigned long long )archive->size );
+    ok_method( "OpenAssetArchive" );
+    return true;
+}
+void CloseAssetArchive( AssetArchive *archive ) {
+    method( "CloseAssetArchive" );
+
+    if ( archive->decompressed ) {
+        for ( uint32_t i = 0; i < archive->entryLength; i++ ) free( archive->decompressed[ i ] );
+        free( archive->decompressed );
+    }
+    UnmapArchiveFile( archive );
+    memset( archive, 0, sizeof( AssetArchive ) );
+
+    ok_method( "CloseAssetArchive" );
+}
+const AssetArchiveEntry *FindAssetEntry( const AssetArchive *archive, const char *name ) {
+    if ( archive->entries == NULL || name == NULL ) return NULL;
+
+    uint64_t hash = HashBytes( name, strlen( name ), UTILS_HASH_SEED );
+    uint32_t low = 0;
+    uint32_t high = archive->entryLength;
+    while ( low < high ) {
+        uint32_t middle = low + ( high - low ) / 2;
+        uint64_t middleHash = archive->entries[ middle ].pathHash;
+        if ( middleHash == hash ) return &archive->entries[ middle ];
+        if ( middleHash < hash ) low = middle + 1;
+        else high = middle;
+    }
+
+    return NULL;
+}
+const uint8_t *GetAssetData( AssetArchive *archive, const char *name, uint32_t *size ) {
+    const AssetArchiveEntry *entry = FindAssetEntry( archive, name );
+    if ( entry == NULL || entry->offset + entry->size > archive->size ) return NULL;
+
+    if ( size != NULL ) *size = ( uint32_t )entry->rawSize;
+    if ( entry->compression == ASSET_COMPRESSION_NONE ) return archive->data + entry->offset;
+
+    // Compressed entries are inflated once and kept until the archive is closed
+    uint32_t index = ( uint32_t )( entry - archive->entries );
+    if ( archive->decompressed[ index ] == NULL ) {
+        archive->decompressed[ index ] = DecompressAsset( archive, entry );
+    }
+
+    return archive->decompressed[ index ];
+}
+bool IsArchiveData( const AssetArchive *archive, const void *data ) {
+    const uint8_t *bytes = ( const uint8_t* )data;
+    if ( archive->data == NULL || bytes == NULL ) return false;
+    if ( bytes >= archive->data && bytes < archive->data + archive->size ) return true;
+
+    for ( uint32_t i = 0; i < archive->entryLength; i++ ) {
+        if ( archive->decompressed[ i ] == bytes ) return true;
+    }
+
+    return false;
+}
+bool WriteAssetArchive( const char *filename, const char *root, const char **names, uint32_t nameLength, uint32_t compression ) {
+    method( "WriteAssetArchive" );
+
+    // A codec that is not compiled in would quietly store everything raw
+    if ( !IsCompressionSupported( compression ) ) {
+        fail_method( "WriteAssetArchive", "compression %u is not supported by this build!\n", compression );
+        return false;
+    }
+
+    AssetArchiveEntry *entries = calloc( nameLength, sizeof( AssetArchiveEntry ) );
+    uint8_t **blobs = calloc( nameLength, sizeof( uint8_t* ) );
+    uint64_t offset = sizeof( AssetArchiveHeader ) + ( uint64_t )nameLength * sizeof( AssetArchiveEntry );
+    bool isWritten = false;
+
+    for ( uint32_t i = 0; i < nameLength; i++ ) {
+        char *path = malloc( strlen( root ) + strlen( names[ i ] ) + 2 );
+        sprintf( path, "%s/%s", root, names[ i ] );
+        uint8_t *raw = ReadWholeFile( path, &entries[ i ].rawSize );
+        free( path );
+        if ( raw == NULL ) {
+            fail_method( "WriteAssetArchive", "failed to read \"%s\"!\n", names[ i ] );
+            goto cleanup;
+        }
+
+        entries[ i ].pathHash = HashBytes( names[ i ], strlen( names[ i ] ), UTILS_HASH_SEED );
+        entries[ i ].compression = CompressAsset( raw, entries[ i ].rawSize, compression, &blobs[ i ], &entries[ i ].size );
+        if ( entries[ i ].compression == ASSET_COMPRESSION_NONE ) {
+            blobs[ i ] = raw;
+            entries[ i ].size = entries[ i ].rawSize;
+        } else {
+            free( raw );
+        }
+
+        offset = ( offset + ASSET_ARCHIVE_ALIGNMENT - 1 ) & ~( uint64_t )( ASSET_ARCHIVE_ALIGNMENT - 1 );
+        entries[ i ].offset = offset;
+        offset += entries[ i ].size;
+        printf( "\t\t%s: %llu -> %llu bytes\n", names[ i ],
+            ( unsigned long long )entries[ i ].rawSize,
+            ( unsigned long long )entries[ i ].size
+        );
+    }
+
+    // Blobs are written in input order, only the index is sorted
+    AssetArchiveEntry *index = malloc( nameLength * sizeof( AssetArchiveEntry ) );
+    memcpy( index, entries, nameLength * sizeof( AssetArchiveEntry ) );
+    qsort( index, nameLength, sizeof( AssetArchiveEntry ), CompareAssetEntries );
+    for ( uint32_t i = 1; i < nameLength; i++ ) {
+        if ( index[ i ].pathHash == index[ i - 1 ].pathHash ) {
+            fail_method( "WriteAssetArchive", "duplicate or colliding asset path hash 0x%llx!\n", ( unsigned long long )index[ i ].pathHash );
+            free( index );
+            goto cleanup;
+        }
+    }
+
+    FILE *file = fopen( filename, "wb" );
+    if ( file == NULL ) {
+        fail_method( "WriteAssetArchive", "failed to open \"%s\" for writing!\n", filename );
+        free( index );
+        goto cleanup;
+    }
+
+    AssetArchiveHeader header = {
+        .magic = ASSET_ARCHIVE_MAGIC,
+        .version = ASSET_ARCHIVE_VERSION,
+        .entryCount = nameLength,
+        .reserved = 0,
+        .indexOffset = sizeof( AssetArchiveHeader )
+    };
+    fwrite( &header, sizeof( header ), 1, file );
+    fwrite( index, sizeof( AssetArchiveEntry ), nameLength, file );
+    free( index );
+
+    static const uint8_t padding[ ASSET_ARCHIVE_ALIGNMENT ] = { 0 };
+    uint64_t position = sizeof( AssetArchiveHeader ) + ( uint64_t )nameLength * sizeof( AssetArchiveEntry );
+    for ( uint32_t i = 0; i < nameLength; i++ ) {
+        fwrite( padding, 1, entries[ i ].offset - position, file );
+        fwrite( blobs[ i ], 1, entries[ i ].size, file );
+        position = entries[ i ].offset + entries[ i ].size;
+    }
+    isWritten = ferror( file ) == 0;
+    fclose( file );
+
+cleanup:
+    for ( uint32_t i = 0; i < nameLength; i++ ) free( blobs[ i ] );
+    free( blobs );
+    free( entries );
+
+    if ( !isWritten ) return false;
+    ok_method( "WriteAssetArchive" );
+    return true;
+}
+
+/* HELPERS */
+bool MapArchiveFile( const char *filename, AssetArchive *archive ) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL );
+    if ( file == INVALID_HANDLE_VALUE ) return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = NULL;
+    if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart == 0 ||
+         ( mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL ) ) == NULL ) {
+        CloseHandle( file );
+        return false;
+    }
+
+    archive->data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if ( archive->data == NULL ) {
+        CloseHandle( mapping );
+        CloseHandle( file );
+        return false;
+    }
+    archive->size = ( uint64_t )fileSize.QuadPart;
+    archive->fileHandle = file;
+    archive->mappingHandle = mapping;
+    return true;
+#else
+    int fd = open( filename, O_RDONLY );
+    if ( fd < 0 ) return false;
+
+    struct stat fileStat;
+    if ( fstat( fd, &fileStat ) != 0 || fileStat.st_size == 0 ) {
+        close( fd );
+        return false;
+    }
+
+    int flags = MAP_PRIVATE;
+    #ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;
+    #endif
+    void *data = mmap( NULL, ( size_t )fileStat.st_size, PROT_READ, flags, fd, 0 );
+    close( fd );
+    if ( data == MAP_FAILED ) return false;
+
+    archive->data = data;
+    archive->size = ( uint64_t )fileStat.st_size;
+    return true;
+#endif
+}
+void UnmapArchiveFile( AssetArchive *archive ) {
+    if ( archive->data == NULL ) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile( archive->data );
+    CloseHandle( archive->mappingHandle );
+    CloseHandle( archive->fileHandle );
+#else
+    munmap( ( void* )archive->data, ( size_t )archive->size );
+#endif
+    archive->data = NULL;
+}
+uint8_t *DecompressAsset( const AssetArchive *archive, const AssetArchiveEntry *entry ) {
+    ( void )archive; // Only read by the codecs compiled in
+    uint8_t *buffer = malloc( entry->rawSize != 0 ? entry->rawSize : 1 );
+    bool isDecompressed = false;
+
+    switch ( entry->compression ) {
+#ifdef ASSET_ARCHIVE_LZ4
+        case ASSET_COMPRESSION_LZ4:
+            isDecompressed = LZ4_decompress_safe(
+                ( const char* )archive->data + entry->offset, ( char* )buffer, ( int )entry->size, ( int )entry->rawSize
+            ) == ( int )entry->rawSize;
+            break;
+#endif
+#ifdef ASSET_ARCHIVE_ZSTD
+        case ASSET_COMPRESSION_ZSTD:
+            isDecompressed = ZSTD_decompress( buffer, entry->rawSize, archive->data + entry->offset, entry->size ) == entry->rawSize;
+            break;
+#endif
+        default:
+            fail_method( "DecompressAsset", "compression %u is not supported by this build!\n", entry->compression );
+            break;
+    }
+
+    if ( !isDecompressed ) {
+        free( buffer );
+        return NULL;
+    }
+
+    return buffer;
+}
+uint8_t *ReadWholeFile( const char *filename, uint64_t *size ) {
+    FILE *file = fopen( filename, "rb" );
+    if ( file == NULL ) return NULL;
+
+    fseek( file, 0, SEEK_END );
+    long length = ftell( file );
+    fseek( file, 0, SEEK_SET );
+    if ( length < 0 ) {
+        fclose( file );
+        return NULL;
+    }
+
+    uint8_t *buffer = malloc( length != 0 ? ( size_t )length : 1 );
+    size_t read = fread( buffer, 1, ( size_t )length, file );
+    fclose( file );
+    if ( read != ( size_t )length ) {
+        free( buffer );
+        return NULL;
+    }
+
+    *size = ( uint64_t )length;
+    return buffer;
+}
+uint32_t CompressAsset( const uint8_t *raw, uint64_t rawSize, uint32_t compression, uint8_t **blob, uint64_t *size ) {
+    ( void )raw; // Only read by the codecs compiled in
+    *blob = NULL;
+    *size = 0;
+
+    switch ( compression ) {
+#ifdef ASSET_ARCHIVE_LZ4
+        case ASSET_COMPRESSION_LZ4: {
+            int bound = LZ4_compressBound( ( int )rawSize );
+            *blob = malloc( bound );
+            *size = ( uint64_t )LZ4_compress_default( ( const char* )raw, ( char* )*blob, ( int )rawSize, bound );
+            break;
+        }
+#endif
+#ifdef ASSET_ARCHIVE_ZSTD
+        case ASSET_COMPRESSION_ZSTD: {
+            size_t bound = ZSTD_compressBound( rawSize );
+            *blob = malloc( bound );
+            size_t result = ZSTD_compress( *blob, bound, raw, rawSize, 19 );
+            *size = ZSTD_isError( result ) ? 0 : result;
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+
+    // Keep incompressible assets raw so they stay zero-copy
+    if ( *size == 0 || *size >= rawSize ) {
+        free( *blob );
+        *blob = NULL;
+        *size = 0;
+        return ASSET_COMPRESSION_NONE;
+    }
+
+    return compression;
+}
+bool IsCompressionSupported( uint32_t compression ) {
+    switch ( compression ) {
+        case ASSET_COMPRESSION_NONE:
+#ifdef ASSET_ARCHIVE_LZ4
+        case ASSET_COMPRESSION_LZ4:
+#endif
+#ifdef ASSET_ARCHIVE_ZSTD
+        case ASSET_COMPRESSION_ZSTD:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+int CompareAssetEntries( const void *a, const void *b ) {
+    uint64_t hashA = ( ( const AssetArchiveEntry* )a )->pathHash;
+    uint64_t hashB = ( ( const AssetArchiveEntry* )b )->pathHash;
+    return hashA < hashB ? -1 : hashA > hashB;
+}
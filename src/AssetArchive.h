@@ -0,0 +1,55 @@
+#ifndef __ASSET_ARCHIVE__
+#define __ASSET_ARCHIVE__
+
+#include <stdbool.h>
+#include "utils.h"
+
+#define ASSET_ARCHIVE_MAGIC 0x41504B56 // "VKPA"
+#define ASSET_ARCHIVE_VERSION 1
+#define ASSET_ARCHIVE_ALIGNMENT 16
+
+#define ASSET_COMPRESSION_NONE 0
+#define ASSET_COMPRESSION_LZ4 1
+#define ASSET_COMPRESSION_ZSTD 2
+
+/*
+ * File layout:
+ *   AssetArchiveHeader
+ *   AssetArchiveEntry[ entryCount ] sorted by pathHash
+ *   blobs, each starting on ASSET_ARCHIVE_ALIGNMENT
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+} AssetArchiveHeader;
+
+typedef struct {
+    uint64_t pathHash;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t rawSize;
+    uint32_t compression;
+    uint32_t reserved;
+} AssetArchiveEntry;
+
+typedef struct {
+    const uint8_t *data;
+    uint64_t size;
+    const AssetArchiveEntry *entries;
+    uint32_t entryLength;
+    uint8_t **decompressed;
+    void *fileHandle;
+    void *mappingHandle;
+} AssetArchive;
+
+bool OpenAssetArchive( const char*, AssetArchive* );
+void CloseAssetArchive( AssetArchive* );
+const AssetArchiveEntry *FindAssetEntry( const AssetArchive*, const char* );
+const uint8_t *GetAssetData( AssetArchive*, const char*, uint32_t* );
+bool IsArchiveData( const AssetArchive*, const void* );
+bool WriteAssetArchive( const char*, const char*, const char**, uint32_t, uint32_t );
+
+#endif
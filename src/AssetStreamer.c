@@ -0,0 +1,580 @@
+#define _DEFAULT_SOURCE
+#include "AssetStreamer.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+#if defined( __linux__ ) && !defined( ASSET_STREAMER_NO_IO_URING ) && defined( __has_include )
+    #if __has_include( <linux/io_uring.h> )
+        #define ASSET_STREAMER_IO_URING
+        #include <errno.h>
+        #include <poll.h>
+        #include <linux/io_uring.h>
+        #include <sys/eventfd.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+// Largest single read, bigger assets are read in several chunks
+#define ASSET_STREAMER_READ_CHUNK ( 1u << 30 )
+
+// user_data of the poll on the wake eventfd, requests are never NULL
+#define ASSET_STREAMER_WAKE_DATA 0
+
+/* PRIVATE VISIBILITY */
+bool IsHigherPriority( const AssetRequest*, const AssetRequest* );
+void PushRequest( AssetStreamer*, AssetRequest* );
+AssetRequest *PopRequest( AssetStreamer* );
+bool RemoveRequest( AssetStreamer*, AssetRequest* );
+void SiftRequestUp( AssetStreamer*, uint32_t );
+void SiftRequestDown( AssetStreamer*, uint32_t );
+void CompleteRequest( AssetStreamer*, AssetRequest*, AssetRequestState );
+void FreeRequest( AssetRequest* );
+void WakeStreamer( AssetStreamer* );
+bool OpenRequest( AssetRequest* );
+void CloseRequest( AssetRequest* );
+bool ReadRequestBlocking( AssetRequest* );
+void *StreamerWorker( void* );
+#ifdef ASSET_STREAMER_IO_URING
+bool SetupIoRing( IoRing*, uint32_t );
+void DestroyIoRing( IoRing* );
+struct io_uring_sqe *GetIoRingEntry( IoRing* );
+void SubmitIoRingRead( IoRing*, AssetRequest* );
+void SubmitIoRingWake( IoRing* );
+void ReapIoRing( AssetStreamer* );
+void FailIoRing( AssetStreamer* );
+void *StreamerIoRingWorker( void* );
+#endif
+
+/* METHODS */
+bool StartAssetStreamer( AssetStreamer *streamer ) {
+    method( "StartAssetStreamer" );
+
+    memset( streamer, 0, sizeof( AssetStreamer ) );
+    pthread_mutex_init( &streamer->mutex, NULL );
+    pthread_cond_init( &streamer->wake, NULL );
+    pthread_cond_init( &streamer->done, NULL );
+    streamer->isRunning = true;
+
+    // One io_uring thread keeps the whole queue in flight, otherwise a small pread pool
+    // The ring has room for the wake poll on top of a full queue of reads
+#ifdef ASSET_STREAMER_IO_URING
+    streamer->useIoRing = SetupIoRing( &streamer->ring, ASSET_STREAMER_QUEUE_DEPTH + 1 );
+#endif
+    uint32_t threadLength = streamer->useIoRing ? 1 : ASSET_STREAMER_THREAD_COUNT;
+    for ( uint32_t i = 0; i < threadLength; i++ ) {
+        void *( *worker )( void* ) = StreamerWorker;
+#ifdef ASSET_STREAMER_IO_URING
+        if ( streamer->useIoRing ) worker = StreamerIoRingWorker;
+#endif
+        if ( pthread_create( &streamer->threads[ i ], NULL, worker, streamer ) != 0 ) {
+            fail_method( "StartAssetStreamer", "failed to start worker %u!\n", i );
+            StopAssetStreamer( streamer );
+            return false;
+        }
+        streamer->threadLength++;
+    }
+
+    printf( "\t\tBackend: %s, %u threads\n", streamer->useIoRing ? "io_uring" : "pread", streamer->threadLength );
+    ok_method( "StartAssetStreamer" );
+    return true;
+}
+void StopAssetStreamer( AssetStreamer *streamer ) {
+    method( "StopAssetStreamer" );
+
+    pthread_mutex_lock( &streamer->mutex );
+    streamer->isRunning = false;
+    pthread_cond_broadcast( &streamer->done );
+    pthread_mutex_unlock( &streamer->mutex );
+    WakeStreamer( streamer );
+
+    for ( uint32_t i = 0; i < streamer->threadLength; i++ ) pthread_join( streamer->threads[ i ], NULL );
+    streamer->threadLength = 0;
+
+#ifdef ASSET_STREAMER_IO_URING
+    if ( streamer->useIoRing ) DestroyIoRing( &streamer->ring );
+#endif
+
+    // Requests never picked up or never polled are dropped without callbacks
+    for ( uint32_t i = 0; i < streamer->queueLength; i++ ) FreeRequest( streamer->queue[ i ] );
+    free( streamer->queue );
+    streamer->queue = NULL;
+    streamer->queueLength = 0;
+    while ( streamer->completed ) {
+        AssetRequest *next = streamer->completed->next;
+        FreeRequest( streamer->completed );
+        streamer->completed = next;
+    }
+
+    pthread_cond_destroy( &streamer->wake );
+    pthread_cond_destroy( &streamer->done );
+    pthread_mutex_destroy( &streamer->mutex );
+
+    ok_method( "StopAssetStreamer" );
+}
+AssetRequest *RequestAsset( AssetStreamer *streamer, const char *path, int priority, AssetCallback callback, void *userData ) {
+    if ( strlen( path ) >= UTILS_MAX_PATH_SIZE ) {
+        fail_method( "RequestAsset", "path \"%s\" is too long!\n", path );
+        return NULL;
+    }
+
+    AssetRequest *request = calloc( 1, sizeof( AssetRequest ) );
+    strcpy( request->path, path );
+    request->priority = priority;
+    request->state = ASSET_REQUEST_PENDING;
+    request->callback = callback;
+    request->userData = userData;
+    request->fd = -1;
+    atomic_init( &request->isCancelled, false );
+
+    pthread_mutex_lock( &streamer->mutex );
+    request->sequence = streamer->sequence++;
+    if ( streamer->isFailed ) {
+        // Nothing reads anymore, the request fails on the next poll
+        request->state = ASSET_REQUEST_FAILED;
+        request->next = streamer->completed;
+        streamer->completed = request;
+        pthread_cond_broadcast( &streamer->done );
+    } else {
+        PushRequest( streamer, request );
+    }
+    pthread_mutex_unlock( &streamer->mutex );
+
+    WakeStreamer( streamer );
+    return request;
+}
+void CancelAssetRequest( AssetStreamer *streamer, AssetRequest *request ) {
+    pthread_mutex_lock( &streamer->mutex );
+    atomic_store( &request->isCancelled, true );
+
+    // Queued requests are retired right away, in-flight ones when their read finishes
+    if ( RemoveRequest( streamer, request ) ) {
+        request->next = streamer->completed;
+        streamer->completed = request;
+        pthread_cond_broadcast( &streamer->done );
+    }
+    pthread_mutex_unlock( &streamer->mutex );
+}
+uint32_t PollAssetStreamer( AssetStreamer *streamer ) {
+    pthread_mutex_lock( &streamer->mutex );
+    AssetRequest *completed = streamer->completed;
+    streamer->completed = NULL;
+    pthread_mutex_unlock( &streamer->mutex );
+
+    // Completed list is LIFO, restore completion order
+    AssetRequest *ordered = NULL;
+    while ( completed ) {
+        AssetRequest *next = completed->next;
+        completed->next = ordered;
+        ordered = completed;
+        completed = next;
+    }
+
+    uint32_t delivered = 0;
+    while ( ordered ) {
+        AssetRequest *next = ordered->next;
+        if ( !atomic_load( &ordered->isCancelled ) && ordered->callback ) {
+            ordered->callback( ordered, ordered->userData );
+            delivered++;
+        }
+        FreeRequest( ordered );
+        ordered = next;
+    }
+
+    return delivered;
+}
+uint32_t WaitAssetStreamer( AssetStreamer *streamer ) {
+    pthread_mutex_lock( &streamer->mutex );
+    while ( streamer->isRunning && streamer->completed == NULL ) {
+        pthread_cond_wait( &streamer->done, &streamer->mutex );
+    }
+    pthread_mutex_unlock( &streamer->mutex );
+
+    return PollAssetStreamer( streamer );
+}
+
+/* QUEUE */
+bool IsHigherPriority( const AssetRequest *a, const AssetRequest *b ) {
+    if ( a->priority != b->priority ) return a->priority > b->priority;
+    return a->sequence < b->sequence;
+}
+void PushRequest( AssetStreamer *streamer, AssetRequest *request ) {
+    if ( streamer->queueLength == streamer->queueCapacity ) {
+        streamer->queueCapacity = max( 16, streamer->queueCapacity * 2 );
+        streamer->queue = realloc( streamer->queue, streamer->queueCapacity * sizeof( AssetRequest* ) );
+    }
+    streamer->queue[ streamer->queueLength ] = request;
+    SiftRequestUp( streamer, streamer->queueLength++ );
+}
+AssetRequest *PopRequest( AssetStreamer *streamer ) {
+    if ( streamer->queueLength == 0 ) return NULL;
+
+    AssetRequest *request = streamer->queue[ 0 ];
+    streamer->queue[ 0 ] = streamer->queue[ --streamer->queueLength ];
+    SiftRequestDown( streamer, 0 );
+    return request;
+}
+bool RemoveRequest( AssetStreamer *streamer, AssetRequest *request ) {
+    for ( uint32_t i = 0; i < streamer->queueLength; i++ ) {
+        if ( streamer->queue[ i ] != request ) continue;
+
+        streamer->queue[ i ] = streamer->queue[ --streamer->queueLength ];
+        if ( i < streamer->queueLength ) {
+            SiftRequestUp( streamer, i );
+            SiftRequestDown( streamer, i );
+        }
+        return true;
+    }
+
+    return false;
+}
+void SiftRequestUp( AssetStreamer *streamer, uint32_t index ) {
+    AssetRequest **queue = streamer->queue;
+    while ( index > 0 ) {
+        uint32_t parent = ( index - 1 ) / 2;
+        if ( !IsHigherPriority( queue[ index ], queue[ parent ] ) ) break;
+
+        AssetRequest *swap = queue[ parent ];
+        queue[ parent ] = queue[ index ];
+        queue[ index ] = swap;
+        index = parent;
+    }
+}
+void SiftRequestDown( AssetStreamer *streamer, uint32_t index ) {
+    AssetRequest **queue = streamer->queue;
+    while ( true ) {
+        uint32_t highest = index;
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+        if ( left < streamer->queueLength && IsHigherPriority( queue[ left ], queue[ highest ] ) ) highest = left;
+        if ( right < streamer->queueLength && IsHigherPriority( queue[ right ], queue[ highest ] ) ) highest = right;
+        if ( highest == index ) break;
+
+        AssetRequest *swap = queue[ highest ];
+        queue[ highest ] = queue[ index ];
+        queue[ index ] = swap;
+        index = highest;
+    }
+}
+void CompleteRequest( AssetStreamer *streamer, AssetRequest *request, AssetRequestState state ) {
+    CloseRequest( request );
+    if ( state == ASSET_REQUEST_FAILED ) {
+        free( request->data );
+        request->data = NULL;
+        request->size = 0;
+    }
+
+    pthread_mutex_lock( &streamer->mutex );
+    request->state = state;
+    request->next = streamer->completed;
+    streamer->completed = request;
+    pthread_cond_broadcast( &streamer->done );
+    pthread_mutex_unlock( &streamer->mutex );
+}
+void FreeRequest( AssetRequest *request ) {
+    CloseRequest( request );
+    free( request->data );
+    free( request );
+}
+// The pread workers sleep on the condition, the io_uring worker in io_uring_enter on the wake poll
+void WakeStreamer( AssetStreamer *streamer ) {
+    pthread_mutex_lock( &streamer->mutex );
+    pthread_cond_broadcast( &streamer->wake );
+    pthread_mutex_unlock( &streamer->mutex );
+
+#ifdef ASSET_STREAMER_IO_URING
+    if ( streamer->useIoRing ) {
+        uint64_t value = 1;
+        ssize_t written = write( streamer->ring.wakeFd, &value, sizeof( value ) );
+        ( void )written; // Only fails when the counter is already full, the worker is woken either way
+    }
+#endif
+}
+
+/* FILE ACCESS */
+bool OpenRequest( AssetRequest *request ) {
+#ifdef _WIN32
+    return true;
+#else
+    request->fd = open( request->path, O_RDONLY );
+    if ( request->fd < 0 ) return false;
+
+    struct stat fileStat;
+    if ( fstat( request->fd, &fileStat ) != 0 ) return false;
+
+    request->size = ( uint64_t )fileStat.st_size;
+    request->offset = 0;
+    request->data = malloc( request->size != 0 ? request->size : 1 );
+    return request->data != NULL;
+#endif
+}
+void CloseRequest( AssetRequest *request ) {
+#ifndef _WIN32
+    if ( request->fd >= 0 ) close( request->fd );
+#endif
+    request->fd = -1;
+}
+bool ReadRequestBlocking( AssetRequest *request ) {
+#ifdef _WIN32
+    FILE *file = fopen( request->path, "rb" );
+    if ( file == NULL ) return false;
+
+    fseek( file, 0, SEEK_END );
+    long length = ftell( file );
+    fseek( file, 0, SEEK_SET );
+    request->size = length > 0 ? ( uint64_t )length : 0;
+    request->data = malloc( request->size != 0 ? request->size : 1 );
+    request->offset = fread( request->data, 1, request->size, file );
+    fclose( file );
+    return request->offset == request->size;
+#else
+    if ( request->fd < 0 && !OpenRequest( request ) ) return false;
+
+    while ( request->offset < request->size ) {
+        if ( atomic_load( &request->isCancelled ) ) return false;
+
+        size_t chunk = ( size_t )min( request->size - request->offset, ASSET_STREAMER_READ_CHUNK );
+        ssize_t read = pread( request->fd, request->data + request->offset, chunk, ( off_t )request->offset );
+        if ( read <= 0 ) return false;
+        request->offset += ( uint64_t )read;
+    }
+    return true;
+#endif
+}
+void *StreamerWorker( void *argument ) {
+    AssetStreamer *streamer = ( AssetStreamer* )argument;
+
+    while ( true ) {
+        pthread_mutex_lock( &streamer->mutex );
+        while ( streamer->isRunning && streamer->queueLength == 0 ) {
+            pthread_cond_wait( &streamer->wake, &streamer->mutex );
+        }
+        if ( !streamer->isRunning ) {
+            pthread_mutex_unlock( &streamer->mutex );
+            break;
+        }
+        AssetRequest *request = PopRequest( streamer );
+        request->state = ASSET_REQUEST_LOADING;
+        pthread_mutex_unlock( &streamer->mutex );
+
+        bool isRead = ReadRequestBlocking( request );
+        CompleteRequest( streamer, request, isRead ? ASSET_REQUEST_DONE : ASSET_REQUEST_FAILED );
+    }
+
+    return NULL;
+}
+
+/* IO_URING BACKEND */
+#ifdef ASSET_STREAMER_IO_URING
+bool SetupIoRing( IoRing *ring, uint32_t entries ) {
+    struct io_uring_params params;
+    memset( &params, 0, sizeof( params ) );
+    memset( ring, 0, sizeof( IoRing ) );
+    ring->wakeFd = -1;
+
+    ring->fd = ( int )syscall( __NR_io_uring_setup, entries, &params );
+    if ( ring->fd < 0 ) {
+        printf( "\t\tio_uring unavailable (errno %d), using pread workers\n", errno );
+        return false;
+    }
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof( uint32_t );
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof( struct io_uring_cqe );
+    if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+        ring->sqRingSize = max( ring->sqRingSize, ring->cqRingSize );
+        ring->cqRingSize = ring->sqRingSize;
+    }
+    ring->sqesSize = params.sq_entries * sizeof( struct io_uring_sqe );
+
+    ring->sqRing = mmap( NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING );
+    ring->cqRing = ring->sqRing;
+    if ( ring->sqRing != MAP_FAILED && !( params.features & IORING_FEAT_SINGLE_MMAP ) ) {
+        ring->cqRing = mmap( NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING );
+    }
+    ring->sqes = mmap( NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES );
+    if ( ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED ) {
+        if ( ring->sqes != MAP_FAILED ) munmap( ring->sqes, ring->sqesSize );
+        if ( ring->cqRing != MAP_FAILED && ring->cqRing != ring->sqRing ) munmap( ring->cqRing, ring->cqRingSize );
+        if ( ring->sqRing != MAP_FAILED ) munmap( ring->sqRing, ring->sqRingSize );
+        close( ring->fd );
+        return false;
+    }
+
+    uint8_t *sq = ( uint8_t* )ring->sqRing;
+    uint8_t *cq = ( uint8_t* )ring->cqRing;
+    ring->sqHead = ( uint32_t* )( sq + params.sq_off.head );
+    ring->sqTail = ( uint32_t* )( sq + params.sq_off.tail );
+    ring->sqMask = ( uint32_t* )( sq + params.sq_off.ring_mask );
+    ring->sqArray = ( uint32_t* )( sq + params.sq_off.array );
+    ring->cqHead = ( uint32_t* )( cq + params.cq_off.head );
+    ring->cqTail = ( uint32_t* )( cq + params.cq_off.tail );
+    ring->cqMask = ( uint32_t* )( cq + params.cq_off.ring_mask );
+    ring->cqes = cq + params.cq_off.cqes;
+
+    // New requests write the eventfd, its poll completion ends the worker's wait for reads
+    ring->wakeFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+    if ( ring->wakeFd < 0 ) {
+        printf( "\t\teventfd unavailable (errno %d), using pread workers\n", errno );
+        DestroyIoRing( ring );
+        return false;
+    }
+    return true;
+}
+void DestroyIoRing( IoRing *ring ) {
+    munmap( ring->sqes, ring->sqesSize );
+    if ( ring->cqRing != ring->sqRing ) munmap( ring->cqRing, ring->cqRingSize );
+    munmap( ring->sqRing, ring->sqRingSize );
+    close( ring->fd );
+    if ( ring->wakeFd >= 0 ) close( ring->wakeFd );
+    memset( ring, 0, sizeof( IoRing ) );
+}
+struct io_uring_sqe *GetIoRingEntry( IoRing *ring ) {
+    uint32_t tail = *ring->sqTail;
+    uint32_t index = tail & *ring->sqMask;
+    struct io_uring_sqe *sqe = &( ( struct io_uring_sqe* )ring->sqes )[ index ];
+    memset( sqe, 0, sizeof( struct io_uring_sqe ) );
+
+    ring->sqArray[ index ] = index;
+    __atomic_store_n( ring->sqTail, tail + 1, __ATOMIC_RELEASE );
+    ring->pending++;
+    return sqe;
+}
+void SubmitIoRingRead( IoRing *ring, AssetRequest *request ) {
+    struct io_uring_sqe *sqe = GetIoRingEntry( ring );
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = request->fd;
+    sqe->addr = ( uint64_t )( uintptr_t )( request->data + request->offset );
+    sqe->len = ( uint32_t )min( request->size - request->offset, ASSET_STREAMER_READ_CHUNK );
+    sqe->off = request->offset;
+    sqe->user_data = ( uint64_t )( uintptr_t )request;
+    ring->requests[ ring->inFlight++ ] = request;
+}
+void SubmitIoRingWake( IoRing *ring ) {
+    struct io_uring_sqe *sqe = GetIoRingEntry( ring );
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = ring->wakeFd;
+    sqe->poll_events = POLLIN;
+    sqe->user_data = ASSET_STREAMER_WAKE_DATA;
+    ring->isWakeArmed = true;
+}
+void ReapIoRing( AssetStreamer *streamer ) {
+    IoRing *ring = &streamer->ring;
+    uint32_t head = *ring->cqHead;
+
+    while ( head != __atomic_load_n( ring->cqTail, __ATOMIC_ACQUIRE ) ) {
+        struct io_uring_cqe *cqe = &( ( struct io_uring_cqe* )ring->cqes )[ head & *ring->cqMask ];
+        AssetRequest *request = ( AssetRequest* )( uintptr_t )cqe->user_data;
+        int32_t result = cqe->res;
+        head++;
+
+        // Drain the eventfd, the worker looks at the queue and rearms the poll before it waits again
+        if ( cqe->user_data == ASSET_STREAMER_WAKE_DATA ) {
+            uint64_t value;
+            ssize_t drained = read( ring->wakeFd, &value, sizeof( value ) );
+            ( void )drained;
+            ring->isWakeArmed = false;
+            continue;
+        }
+
+        for ( uint32_t i = 0; i < ring->inFlight; i++ ) {
+            if ( ring->requests[ i ] != request ) continue;
+            ring->requests[ i ] = ring->requests[ --ring->inFlight ];
+            break;
+        }
+
+        // Kernels without IORING_OP_READ report EINVAL, finish those synchronously
+        if ( result == -EINVAL && request->offset == 0 ) {
+            bool isRead = ReadRequestBlocking( request );
+            CompleteRequest( streamer, request, isRead ? ASSET_REQUEST_DONE : ASSET_REQUEST_FAILED );
+            continue;
+        }
+        if ( result <= 0 || atomic_load( &request->isCancelled ) ) {
+            CompleteRequest( streamer, request, ASSET_REQUEST_FAILED );
+            continue;
+        }
+
+        request->offset += ( uint64_t )result;
+        if ( request->offset < request->size ) {
+            SubmitIoRingRead( ring, request );
+        } else {
+            CompleteRequest( streamer, request, ASSET_REQUEST_DONE );
+        }
+    }
+
+    __atomic_store_n( ring->cqHead, head, __ATOMIC_RELEASE );
+}
+void FailIoRing( AssetStreamer *streamer ) {
+    IoRing *ring = &streamer->ring;
+
+    // Keep what already landed, the kernel may still write into the buffers of the rest so those leak
+    ReapIoRing( streamer );
+    while ( ring->inFlight != 0 ) {
+        AssetRequest *request = ring->requests[ --ring->inFlight ];
+        request->data = NULL;
+        CompleteRequest( streamer, request, ASSET_REQUEST_FAILED );
+    }
+    ring->pending = 0;
+
+    pthread_mutex_lock( &streamer->mutex );
+    streamer->isFailed = true;
+    AssetRequest *request;
+    while ( ( request = PopRequest( streamer ) ) != NULL ) {
+        request->state = ASSET_REQUEST_FAILED;
+        request->next = streamer->completed;
+        streamer->completed = request;
+    }
+    pthread_cond_broadcast( &streamer->done );
+    pthread_mutex_unlock( &streamer->mutex );
+}
+void *StreamerIoRingWorker( void *argument ) {
+    AssetStreamer *streamer = ( AssetStreamer* )argument;
+    IoRing *ring = &streamer->ring;
+    AssetRequest *batch[ ASSET_STREAMER_QUEUE_DEPTH ];
+
+    while ( true ) {
+        pthread_mutex_lock( &streamer->mutex );
+        if ( !streamer->isRunning && ring->inFlight == 0 ) {
+            pthread_mutex_unlock( &streamer->mutex );
+            break;
+        }
+
+        uint32_t batchLength = 0;
+        while ( streamer->isRunning && streamer->queueLength != 0 &&
+                ring->inFlight + batchLength < ASSET_STREAMER_QUEUE_DEPTH ) {
+            batch[ batchLength ] = PopRequest( streamer );
+            batch[ batchLength++ ]->state = ASSET_REQUEST_LOADING;
+        }
+        pthread_mutex_unlock( &streamer->mutex );
+
+        for ( uint32_t i = 0; i < batchLength; i++ ) {
+            AssetRequest *request = batch[ i ];
+            if ( !OpenRequest( request ) ) {
+                CompleteRequest( streamer, request, ASSET_REQUEST_FAILED );
+            } else if ( request->size == 0 ) {
+                CompleteRequest( streamer, request, ASSET_REQUEST_DONE );
+            } else {
+                SubmitIoRingRead( ring, request );
+            }
+        }
+
+        // Sleep until a read lands or a request arrives, new requests reach the ring in priority order
+        // instead of waiting behind the reads already in flight
+        if ( !ring->isWakeArmed ) SubmitIoRingWake( ring );
+        long entered = syscall( __NR_io_uring_enter, ring->fd, ring->pending, 1, IORING_ENTER_GETEVENTS, NULL, 0 );
+        if ( entered >= 0 ) {
+            ring->pending -= min( ( uint32_t )entered, ring->pending );
+        } else if ( errno != EINTR && errno != EAGAIN && errno != EBUSY ) {
+            fail_method( "StreamerIoRingWorker", "io_uring_enter failed (errno %d), streaming stopped\n", errno );
+            FailIoRing( streamer );
+            break;
+        }
+        ReapIoRing( streamer );
+    }
+
+    return NULL;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef __ASSET_STREAMER__
+#define __ASSET_STREAMER__
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "utils.h"
+
+#define ASSET_STREAMER_THREAD_COUNT 2
+#define ASSET_STREAMER_QUEUE_DEPTH 32
+
+#define ASSET_PRIORITY_LOW 0
+#define ASSET_PRIORITY_NORMAL 50
+#define ASSET_PRIORITY_HIGH 100
+
+typedef enum {
+    ASSET_REQUEST_PENDING,
+    ASSET_REQUEST_LOADING,
+    ASSET_REQUEST_DONE,
+    ASSET_REQUEST_FAILED
+} AssetRequestState;
+
+typedef struct AssetRequest AssetRequest;
+
+// Called on the thread running PollAssetStreamer, set request->data to NULL to keep the buffer
+// The request is freed as soon as the callback returns
+typedef void ( *AssetCallback )( AssetRequest*, void* );
+
+struct AssetRequest {
+    char path[ UTILS_MAX_PATH_SIZE ];
+    int priority;
+    uint64_t sequence;
+    AssetRequestState state;
+    atomic_bool isCancelled;
+
+    uint8_t *data;
+    uint64_t size;
+    uint64_t offset;
+    int fd;
+
+    AssetCallback callback;
+    void *userData;
+    AssetRequest *next;
+};
+
+typedef struct {
+    int fd;
+    uint32_t *sqHead;
+    uint32_t *sqTail;
+    uint32_t *sqMask;
+    uint32_t *sqArray;
+    uint32_t *cqHead;
+    uint32_t *cqTail;
+    uint32_t *cqMask;
+    void *sqes;
+    void *cqes;
+    void *sqRing;
+    size_t sqRingSize;
+    void *cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+    int wakeFd;
+    bool isWakeArmed;
+    uint32_t pending;
+    uint32_t inFlight;
+    AssetRequest *requests[ ASSET_STREAMER_QUEUE_DEPTH ];
+} IoRing;
+
+typedef struct {
+    pthread_t threads[ ASSET_STREAMER_THREAD_COUNT ];
+    uint32_t threadLength;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    bool isRunning;
+    bool isFailed;
+
+    AssetRequest **queue;
+    uint32_t queueLength;
+    uint32_t queueCapacity;
+    uint64_t sequence;
+
+    AssetRequest *completed;
+
+    bool useIoRing;
+    IoRing ring;
+} AssetStreamer;
+
+bool StartAssetStreamer( AssetStreamer* );
+void StopAssetStreamer( AssetStreamer* );
+// The returned request belongs to the streamer, PollAssetStreamer frees it once it completes
+// It may only be cancelled before then, or from its own callback
+AssetRequest *RequestAsset( AssetStreamer*, const char*, int, AssetCallback, void* );
+void CancelAssetRequest( AssetStreamer*, AssetRequest* );
+uint32_t PollAssetStreamer( AssetStreamer* );
+// Blocks until at least one request has completed, then polls
+uint32_t WaitAssetStreamer( AssetStreamer* );
+
+#endif
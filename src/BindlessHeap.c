@@ -0,0 +1,146 @@
+#include "HelloTriangleApplication.h"
+
+/* METHODS */
+VkResult CreateBindlessHeap( BindlessHeap *heap, VkDevice device, uint32_t bufferCapacity, uint32_t textureCapacity ) {
+    method( "CreateBindlessHeap" );
+
+    memset( heap, 0, sizeof( BindlessHeap ) );
+    heap->bufferCapacity = min( bufferCapacity, BINDLESS_MAX_BUFFERS );
+    heap->textureCapacity = min( textureCapacity, BINDLESS_MAX_TEXTURES );
+
+    VkDescriptorSetLayoutBinding bindings[] = {
+        {
+            .binding = BINDLESS_BUFFER_BINDING,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = heap->bufferCapacity,
+            .stageFlags = VK_SHADER_STAGE_ALL,
+            .pImmutableSamplers = NULL
+        },
+        {
+            .binding = BINDLESS_TEXTURE_BINDING,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = heap->textureCapacity,
+            .stageFlags = VK_SHADER_STAGE_ALL,
+            .pImmutableSamplers = NULL
+        }
+    };
+
+    // Slots may stay empty and be filled while the set is bound by a pending frame
+    VkDescriptorBindingFlagsEXT bindingFlags[] = {
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT,
+
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+        .pNext = NULL,
+        .bindingCount = 2,
+        .pBindingFlags = bindingFlags
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &bindingFlagsInfo,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+        .bindingCount = 2,
+        .pBindings = bindings
+    };
+
+    VkResult result = vkCreateDescriptorSetLayout( device, &layoutInfo, NULL, &heap->setLayout );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateBindlessHeap", "failed to create bindless set layout.\nError code: %d\n", result );
+        return result;
+    }
+
+    VkDescriptorPoolSize poolSizes[] = {
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, heap->bufferCapacity },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, heap->textureCapacity }
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = NULL,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+        .maxSets = 1,
+        .poolSizeCount = 2,
+        .pPoolSizes = poolSizes
+    };
+
+    result = vkCreateDescriptorPool( device, &poolInfo, NULL, &heap->pool );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateBindlessHeap", "failed to create bindless descriptor pool.\nError code: %d\n", result );
+        DestroyBindlessHeap( heap, device );
+        return result;
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = NULL,
+        .descriptorPool = heap->pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &heap->setLayout
+    };
+
+    result = vkAllocateDescriptorSets( device, &allocInfo, &heap->set );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateBindlessHeap", "failed to allocate bindless descriptor set.\nError code: %d\n", result );
+        DestroyBindlessHeap( heap, device );
+        return result;
+    }
+
+    printf( "\t\tBindless heap: %u buffers, %u textures\n", heap->bufferCapacity, heap->textureCapacity );
+    ok_method( "CreateBindlessHeap" );
+    return VK_SUCCESS;
+}
+void DestroyBindlessHeap( BindlessHeap *heap, VkDevice device ) {
+    if ( heap->pool ) vkDestroyDescriptorPool( device, heap->pool, NULL );
+    if ( heap->setLayout ) vkDestroyDescriptorSetLayout( device, heap->setLayout, NULL );
+    memset( heap, 0, sizeof( BindlessHeap ) );
+}
+uint32_t RegisterBindlessBuffer( BindlessHeap *heap, VkDevice device, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range ) {
+    if ( heap->bufferLength == heap->bufferCapacity ) return BINDLESS_INVALID_INDEX;
+
+    uint32_t index = heap->bufferLength++;
+    VkDescriptorBufferInfo bufferInfo = { buffer, offset, range };
+    VkWriteDescriptorSet write = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext = NULL,
+        .dstSet = heap->set,
+        .dstBinding = BINDLESS_BUFFER_BINDING,
+        .dstArrayElement = index,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pImageInfo = NULL,
+        .pBufferInfo = &bufferInfo,
+        .pTexelBufferView = NULL
+    };
+    vkUpdateDescriptorSets( device, 1, &write, 0, NULL );
+
+    return index;
+}
+uint32_t RegisterBindlessTexture( BindlessHeap *heap, VkDevice device, VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout ) {
+    if ( heap->textureLength == heap->textureCapacity ) return BINDLESS_INVALID_INDEX;
+
+    uint32_t index = heap->textureLength++;
+    VkDescriptorImageInfo imageInfo = { sampler, imageView, imageLayout };
+    VkWriteDescriptorSet write = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext = NULL,
+        .dstSet = heap->set,
+        .dstBinding = BINDLESS_TEXTURE_BINDING,
+        .dstArrayElement = index,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .pImageInfo = &imageInfo,
+        .pBufferInfo = NULL,
+        .pTexelBufferView = NULL
+    };
+    vkUpdateDescriptorSets( device, 1, &write, 0, NULL );
+
+    return index;
+}
@@ -0,0 +1,31 @@
+#ifndef __BINDLESS_HEAP__
+#define __BINDLESS_HEAP__
+
+#include <vulkan/vulkan.h>
+
+#define BINDLESS_MAX_BUFFERS 1024
+#define BINDLESS_MAX_TEXTURES 4096
+#define BINDLESS_BUFFER_BINDING 0
+#define BINDLESS_TEXTURE_BINDING 1
+#define BINDLESS_INVALID_INDEX UINT32_MAX
+
+/*
+ * One update-after-bind descriptor set holding every storage buffer and texture,
+ * shaders index the arrays with values passed through push constants.
+ */
+typedef struct {
+    VkDescriptorSetLayout setLayout;
+    VkDescriptorPool pool;
+    VkDescriptorSet set;
+    uint32_t bufferCapacity;
+    uint32_t bufferLength;
+    uint32_t textureCapacity;
+    uint32_t textureLength;
+} BindlessHeap;
+
+VkResult CreateBindlessHeap( BindlessHeap*, VkDevice, uint32_t, uint32_t );
+void DestroyBindlessHeap( BindlessHeap*, VkDevice );
+uint32_t RegisterBindlessBuffer( BindlessHeap*, VkDevice, VkBuffer, VkDeviceSize, VkDeviceSize );
+uint32_t RegisterBindlessTexture( BindlessHeap*, VkDevice, VkImageView, VkSampler, VkImageLayout );
+
+#endif
@@ -0,0 +1,132 @@
+#include "HelloTriangleApplication.h"
+
+/* PRIVATE VISIBILITY */
+uint32_t PreviousPowerOfTwo( uint32_t );
+
+/* METHODS */
+void GetDepthPyramidExtent( uint32_t depthWidth, uint32_t depthHeight, uint32_t *width, uint32_t *height, uint32_t *levelLength ) {
+    *width = PreviousPowerOfTwo( depthWidth );
+    *height = PreviousPowerOfTwo( depthHeight );
+    *levelLength = 1;
+    while ( ( max( *width, *height ) >> *levelLength ) > 0 && *levelLength < DEPTH_PYRAMID_MAX_LEVELS ) ( *levelLength )++;
+}
+VkResult CreateDepthPyramid( DepthPyramid *pyramid, VkDevice device, const GpuImage *image, uint32_t depthWidth, uint32_t depthHeight ) {
+    method( "CreateDepthPyramid" );
+
+    // Pipeline and descriptor sets are filled in by the caller
+    pyramid->image = *image;
+    pyramid->depthWidth = depthWidth;
+    pyramid->depthHeight = depthHeight;
+    uint32_t levelLength = image->levelLength;
+    VkResult result;
+
+    for ( uint32_t i = 0; i < levelLength; i++ ) {
+        result = CreateGpuImageView( device, &pyramid->image, i, 1, &pyramid->levelViews[ i ] );
+        if ( result != VK_SUCCESS ) {
+            fail_method( "CreateDepthPyramid", "failed to create pyramid level view.\nError code: %d\n", result );
+            DestroyDepthPyramid( pyramid, device );
+            return result;
+        }
+    }
+
+    // Levels are read with texelFetch, the sampler only has to exist
+    VkSamplerCreateInfo samplerInfo = {
+        .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .magFilter = VK_FILTER_NEAREST,
+        .minFilter = VK_FILTER_NEAREST,
+        .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+        .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .mipLodBias = 0.0f,
+        .anisotropyEnable = VK_FALSE,
+        .maxAnisotropy = 1.0f,
+        .compareEnable = VK_FALSE,
+        .compareOp = VK_COMPARE_OP_ALWAYS,
+        .minLod = 0.0f,
+        .maxLod = ( float )levelLength,
+        .borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE,
+        .unnormalizedCoordinates = VK_FALSE
+    };
+
+    result = vkCreateSampler( device, &samplerInfo, NULL, &pyramid->sampler );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateDepthPyramid", "failed to create pyramid sampler.\nError code: %d\n", result );
+        DestroyDepthPyramid( pyramid, device );
+        return result;
+    }
+
+    ok_method( "CreateDepthPyramid" );
+    return VK_SUCCESS;
+}
+void DestroyDepthPyramid( DepthPyramid *pyramid, VkDevice device ) {
+    method( "DestroyDepthPyramid" );
+
+    for ( uint32_t i = 0; i < pyramid->image.levelLength; i++ ) {
+        if ( pyramid->levelViews[ i ] ) vkDestroyImageView( device, pyramid->levelViews[ i ], NULL );
+    }
+    if ( pyramid->sampler ) vkDestroySampler( device, pyramid->sampler, NULL );
+    if ( pyramid->pipeline ) vkDestroyPipeline( device, pyramid->pipeline, NULL );
+
+    // The image belongs to the render graph, the pipeline and set layouts to the layout cache
+    memset( pyramid, 0, sizeof( DepthPyramid ) );
+
+    ok_method( "DestroyDepthPyramid" );
+}
+void RecordDepthPyramid( const DepthPyramid *pyramid, VkCommandBuffer commandBuffer ) {
+    // The graph already made the depth buffer readable and the pyramid writable
+    vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramid->pipeline );
+
+    uint32_t inputWidth = pyramid->depthWidth;
+    uint32_t inputHeight = pyramid->depthHeight;
+    for ( uint32_t i = 0; i < pyramid->image.levelLength; i++ ) {
+        DepthPyramidParams params = {
+            .inputWidth = inputWidth,
+            .inputHeight = inputHeight,
+            .outputWidth = max( pyramid->image.width >> i, 1 ),
+            .outputHeight = max( pyramid->image.height >> i, 1 )
+        };
+
+        vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramid->pipelineLayout, 0, 1, &pyramid->sets[ i ], 0, NULL );
+        vkCmdPushConstants( commandBuffer, pyramid->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( DepthPyramidParams ), &params );
+        vkCmdDispatch(
+            commandBuffer,
+            ( params.outputWidth + DEPTH_PYRAMID_WORKGROUP_SIZE - 1 ) / DEPTH_PYRAMID_WORKGROUP_SIZE,
+            ( params.outputHeight + DEPTH_PYRAMID_WORKGROUP_SIZE - 1 ) / DEPTH_PYRAMID_WORKGROUP_SIZE,
+            1
+        );
+
+        inputWidth = params.outputWidth;
+        inputHeight = params.outputHeight;
+        if ( i + 1 == pyramid->image.levelLength ) break;
+
+        // Each level is the input of the next one, the graph orders the last one against the culling pass
+        VkImageMemoryBarrier levelBarrier = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = NULL,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = pyramid->image.image,
+            .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, i, 1, 0, 1 }
+        };
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, NULL, 0, NULL, 1, &levelBarrier
+        );
+    }
+}
+
+/* HELPERS */
+uint32_t PreviousPowerOfTwo( uint32_t value ) {
+    uint32_t result = 1;
+    while ( result * 2 <= value ) result *= 2;
+    return result;
+}
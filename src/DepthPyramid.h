@@ -0,0 +1,45 @@
+#ifndef __DEPTH_PYRAMID__
+#define __DEPTH_PYRAMID__
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+#include "GpuImage.h"
+
+#define DEPTH_PYRAMID_MAX_LEVELS 16
+#define DEPTH_PYRAMID_WORKGROUP_SIZE 8
+#define DEPTH_PYRAMID_INPUT_BINDING 0
+#define DEPTH_PYRAMID_OUTPUT_BINDING 1
+
+// Matches the push constant block of shader_depth_pyramid.comp
+typedef struct {
+    uint32_t inputWidth;
+    uint32_t inputHeight;
+    uint32_t outputWidth;
+    uint32_t outputHeight;
+} DepthPyramidParams;
+
+/*
+ * Hierarchical Z buffer, every texel holds the farthest depth of the texels it covers one level below.
+ * Level 0 is the largest power of two that fits in the depth buffer so each level halves cleanly.
+ * The image comes from the render graph, which also moves it and the depth buffer between passes.
+ */
+typedef struct {
+    GpuImage image;
+    VkImageView levelViews[ DEPTH_PYRAMID_MAX_LEVELS ];
+    VkDescriptorSet sets[ DEPTH_PYRAMID_MAX_LEVELS ];
+    VkSampler sampler;
+    uint32_t depthWidth;
+    uint32_t depthHeight;
+
+    VkPipeline pipeline;
+    VkPipelineLayout pipelineLayout;
+    VkDescriptorSetLayout setLayout;
+} DepthPyramid;
+
+void GetDepthPyramidExtent( uint32_t, uint32_t, uint32_t*, uint32_t*, uint32_t* );
+VkResult CreateDepthPyramid( DepthPyramid*, VkDevice, const GpuImage*, uint32_t, uint32_t );
+void DestroyDepthPyramid( DepthPyramid*, VkDevice );
+void RecordDepthPyramid( const DepthPyramid*, VkCommandBuffer );
+
+#endif
@@ -0,0 +1,231 @@
+#include "HelloTriangleApplication.h"
+
+// Descriptors reserved per set in every new pool, by type
+static const struct {
+    VkDescriptorType type;
+    float ratio;
+} DESCRIPTOR_POOL_RATIOS[] = {
+    { VK_DESCRIPTOR_TYPE_SAMPLER, 0.5f },
+    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+    { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f }
+};
+#define DESCRIPTOR_POOL_RATIO_COUNT ( sizeof( DESCRIPTOR_POOL_RATIOS ) / sizeof( DESCRIPTOR_POOL_RATIOS[ 0 ] ) )
+
+/* PRIVATE VISIBILITY */
+VkResult AcquireDescriptorPool( DescriptorAllocator*, VkDevice, VkDescriptorPool* );
+VkResult AllocateFromPoolList( DescriptorAllocator*, VkDevice, DescriptorPoolList*, VkDescriptorSetLayout, VkDescriptorSet* );
+uint32_t WriteDescriptorKey( VkDescriptorSetLayout, const VkWriteDescriptorSet*, uint32_t, uint8_t* );
+void AppendDescriptorKey( uint8_t*, uint32_t*, const void*, size_t );
+
+/* METHODS */
+void InitDescriptorAllocator( DescriptorAllocator *allocator, uint32_t frameLength ) {
+    memset( allocator, 0, sizeof( DescriptorAllocator ) );
+    allocator->frameLength = min( frameLength, DESCRIPTOR_ALLOCATOR_MAX_FRAMES );
+    allocator->poolSetCount = DESCRIPTOR_POOL_MIN_SETS;
+}
+void DestroyDescriptorAllocator( DescriptorAllocator *allocator, VkDevice device ) {
+    method( "DestroyDescriptorAllocator" );
+
+    for ( uint32_t i = 0; i < allocator->frameLength; i++ ) {
+        DescriptorPoolList *list = &allocator->frames[ i ];
+        for ( uint32_t j = 0; j < list->poolLength; j++ ) vkDestroyDescriptorPool( device, list->pools[ j ], NULL );
+        free( list->pools );
+    }
+    for ( uint32_t i = 0; i < allocator->staticPools.poolLength; i++ ) {
+        vkDestroyDescriptorPool( device, allocator->staticPools.pools[ i ], NULL );
+    }
+    for ( uint32_t i = 0; i < allocator->cacheLength; i++ ) {
+        free( allocator->cache[ i ]->key );
+        free( allocator->cache[ i ] );
+    }
+
+    free( allocator->staticPools.pools );
+    free( allocator->cache );
+    memset( allocator, 0, sizeof( DescriptorAllocator ) );
+
+    ok_method( "DestroyDescriptorAllocator" );
+}
+void BeginDescriptorFrame( DescriptorAllocator *allocator, VkDevice device, uint32_t frameIndex ) {
+    allocator->frameIndex = frameIndex % allocator->frameLength;
+
+    // The frame's fence signaled, every set it allocated is released at once
+    DescriptorPoolList *list = &allocator->frames[ allocator->frameIndex ];
+    for ( uint32_t i = 0; i < list->poolLength && i <= list->activePool; i++ ) {
+        vkResetDescriptorPool( device, list->pools[ i ], 0 );
+        allocator->stats.resetLength++;
+    }
+    list->activePool = 0;
+}
+VkResult AllocateDescriptorSet(
+    DescriptorAllocator *allocator,
+    VkDevice device,
+    VkDescriptorSetLayout layout,
+    VkDescriptorSet *set
+) {
+    DescriptorPoolList *list = &allocator->frames[ allocator->frameIndex ];
+    return AllocateFromPoolList( allocator, device, list, layout, set );
+}
+VkResult GetStaticDescriptorSet(
+    DescriptorAllocator *allocator,
+    VkDevice device,
+    VkDescriptorSetLayout layout,
+    const VkWriteDescriptorSet *writes,
+    uint32_t writeLength,
+    VkDescriptorSet *set
+) {
+    // Sets are never modified after creation, equal layout and writes share one set
+    uint32_t keyLength = WriteDescriptorKey( layout, writes, writeLength, NULL );
+    uint8_t *key = malloc( keyLength );
+    WriteDescriptorKey( layout, writes, writeLength, key );
+
+    uint64_t hash = HashBytes( key, keyLength, UTILS_HASH_SEED );
+    for ( uint32_t i = 0; i < allocator->cacheLength; i++ ) {
+        CachedDescriptorSet *entry = allocator->cache[ i ];
+        if ( entry->hash == hash && entry->layout == layout &&
+             entry->keyLength == keyLength && memcmp( entry->key, key, keyLength ) == 0 ) {
+            allocator->stats.cacheHitLength++;
+            *set = entry->set;
+            free( key );
+            return VK_SUCCESS;
+        }
+    }
+    allocator->stats.cacheMissLength++;
+
+    CachedDescriptorSet *entry = calloc( 1, sizeof( CachedDescriptorSet ) );
+    entry->hash = hash;
+    entry->key = key;
+    entry->keyLength = keyLength;
+    entry->layout = layout;
+
+    VkResult result = AllocateFromPoolList( allocator, device, &allocator->staticPools, layout, &entry->set );
+    if ( result != VK_SUCCESS ) {
+        free( entry->key );
+        free( entry );
+        return result;
+    }
+
+    if ( writeLength != 0 ) {
+        VkWriteDescriptorSet setWrites[ writeLength ];
+        for ( uint32_t i = 0; i < writeLength; i++ ) {
+            setWrites[ i ] = writes[ i ];
+            setWrites[ i ].dstSet = entry->set;
+        }
+        vkUpdateDescriptorSets( device, writeLength, setWrites, 0, NULL );
+    }
+
+    allocator->cache = realloc( allocator->cache, ( allocator->cacheLength + 1 ) * sizeof( CachedDescriptorSet* ) );
+    allocator->cache[ allocator->cacheLength++ ] = entry;
+    *set = entry->set;
+    return VK_SUCCESS;
+}
+
+/* HELPERS */
+VkResult AcquireDescriptorPool( DescriptorAllocator *allocator, VkDevice device, VkDescriptorPool *pool ) {
+    VkDescriptorPoolSize poolSizes[ DESCRIPTOR_POOL_RATIO_COUNT ];
+    for ( uint32_t i = 0; i < DESCRIPTOR_POOL_RATIO_COUNT; i++ ) {
+        poolSizes[ i ].type = DESCRIPTOR_POOL_RATIOS[ i ].type;
+        poolSizes[ i ].descriptorCount = ( uint32_t )( DESCRIPTOR_POOL_RATIOS[ i ].ratio * allocator->poolSetCount );
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .maxSets = allocator->poolSetCount,
+        .poolSizeCount = DESCRIPTOR_POOL_RATIO_COUNT,
+        .pPoolSizes = poolSizes
+    };
+
+    VkResult result = vkCreateDescriptorPool( device, &poolInfo, NULL, pool );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "AcquireDescriptorPool", "failed to create descriptor pool.\nError code: %d\n", result );
+        return result;
+    }
+
+    // Every new pool is bigger than the last, a busy frame settles on a few pools quickly
+    allocator->poolSetCount = min( allocator->poolSetCount * 2, DESCRIPTOR_POOL_MAX_SETS );
+    allocator->stats.poolLength++;
+    return VK_SUCCESS;
+}
+VkResult AllocateFromPoolList(
+    DescriptorAllocator *allocator,
+    VkDevice device,
+    DescriptorPoolList *list,
+    VkDescriptorSetLayout layout,
+    VkDescriptorSet *set
+) {
+    VkDescriptorSetAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = NULL,
+        .descriptorPool = VK_NULL_HANDLE,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &layout
+    };
+
+    while ( true ) {
+        bool isNewPool = list->activePool == list->poolLength;
+        if ( isNewPool ) {
+            VkDescriptorPool pool;
+            VkResult result = AcquireDescriptorPool( allocator, device, &pool );
+            if ( result != VK_SUCCESS ) return result;
+
+            list->pools = realloc( list->pools, ( list->poolLength + 1 ) * sizeof( VkDescriptorPool ) );
+            list->pools[ list->poolLength++ ] = pool;
+        }
+
+        allocInfo.descriptorPool = list->pools[ list->activePool ];
+        VkResult result = vkAllocateDescriptorSets( device, &allocInfo, set );
+        if ( result == VK_SUCCESS ) {
+            allocator->stats.allocationLength++;
+            return VK_SUCCESS;
+        }
+
+        // An empty pool that can not hold the set never will
+        if ( isNewPool || ( result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL ) ) {
+            fail_method( "AllocateDescriptorSet", "failed to allocate descriptor set.\nError code: %d\n", result );
+            return result;
+        }
+        list->activePool++;
+    }
+}
+// Flattens the layout and writes into a canonical key, with a NULL key it only measures it
+uint32_t WriteDescriptorKey( VkDescriptorSetLayout layout, const VkWriteDescriptorSet *writes, uint32_t writeLength, uint8_t *key ) {
+    uint32_t keyLength = 0;
+    AppendDescriptorKey( key, &keyLength, &layout, sizeof( VkDescriptorSetLayout ) );
+
+    for ( uint32_t i = 0; i < writeLength; i++ ) {
+        const VkWriteDescriptorSet *write = &writes[ i ];
+        uint32_t header[] = {
+            write->dstBinding,
+            write->dstArrayElement,
+            write->descriptorCount,
+            ( uint32_t )write->descriptorType
+        };
+        AppendDescriptorKey( key, &keyLength, header, sizeof( header ) );
+
+        // Image infos are keyed per field, the struct has padding
+        for ( uint32_t j = 0; j < write->descriptorCount; j++ ) {
+            if ( write->pBufferInfo != NULL ) {
+                AppendDescriptorKey( key, &keyLength, &write->pBufferInfo[ j ], sizeof( VkDescriptorBufferInfo ) );
+            } else if ( write->pImageInfo != NULL ) {
+                const VkDescriptorImageInfo *image = &write->pImageInfo[ j ];
+                AppendDescriptorKey( key, &keyLength, &image->sampler, sizeof( VkSampler ) );
+                AppendDescriptorKey( key, &keyLength, &image->imageView, sizeof( VkImageView ) );
+                AppendDescriptorKey( key, &keyLength, &image->imageLayout, sizeof( VkImageLayout ) );
+            } else if ( write->pTexelBufferView != NULL ) {
+                AppendDescriptorKey( key, &keyLength, &write->pTexelBufferView[ j ], sizeof( VkBufferView ) );
+            }
+        }
+    }
+
+    return keyLength;
+}
+void AppendDescriptorKey( uint8_t *key, uint32_t *keyLength, const void *data, size_t size ) {
+    if ( key != NULL ) memcpy( key + *keyLength, data, size );
+    *keyLength += ( uint32_t )size;
+}
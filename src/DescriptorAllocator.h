@@ -0,0 +1,58 @@
+#ifndef __DESCRIPTOR_ALLOCATOR__
+#define __DESCRIPTOR_ALLOCATOR__
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+#define DESCRIPTOR_ALLOCATOR_MAX_FRAMES 4
+#define DESCRIPTOR_POOL_MIN_SETS 64
+#define DESCRIPTOR_POOL_MAX_SETS 4096
+
+typedef struct {
+    VkDescriptorPool *pools;
+    uint32_t poolLength;
+    uint32_t activePool;
+} DescriptorPoolList;
+
+typedef struct {
+    uint64_t hash;
+    uint8_t *key;
+    uint32_t keyLength;
+    VkDescriptorSetLayout layout;
+    VkDescriptorSet set;
+} CachedDescriptorSet;
+
+typedef struct {
+    uint64_t allocationLength;
+    uint64_t resetLength;
+    uint64_t cacheHitLength;
+    uint64_t cacheMissLength;
+    uint32_t poolLength;
+} DescriptorStats;
+
+/*
+ * Transient sets come from per-frame pools that are reset in bulk once the frame's fence
+ * has signaled. Immutable sets are allocated once from static pools and looked up by their
+ * layout and writes, hashed first and then compared in full.
+ */
+typedef struct {
+    DescriptorPoolList frames[ DESCRIPTOR_ALLOCATOR_MAX_FRAMES ];
+    uint32_t frameLength;
+    uint32_t frameIndex;
+
+    DescriptorPoolList staticPools;
+    uint32_t poolSetCount;
+
+    CachedDescriptorSet **cache;
+    uint32_t cacheLength;
+
+    DescriptorStats stats;
+} DescriptorAllocator;
+
+void InitDescriptorAllocator( DescriptorAllocator*, uint32_t );
+void DestroyDescriptorAllocator( DescriptorAllocator*, VkDevice );
+void BeginDescriptorFrame( DescriptorAllocator*, VkDevice, uint32_t );
+VkResult AllocateDescriptorSet( DescriptorAllocator*, VkDevice, VkDescriptorSetLayout, VkDescriptorSet* );
+VkResult GetStaticDescriptorSet( DescriptorAllocator*, VkDevice, VkDescriptorSetLayout, const VkWriteDescriptorSet*, uint32_t, VkDescriptorSet* );
+
+#endif
@@ -0,0 +1,90 @@
+#include "HelloTriangleApplication.h"
+
+/* METHODS */
+uint32_t FindMemoryType( VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties ) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties( physicalDevice, &memoryProperties );
+
+    for ( uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++ ) {
+        if ( ( typeFilter & ( 1u << i ) ) &&
+             ( memoryProperties.memoryTypes[ i ].propertyFlags & properties ) == properties ) {
+            return i;
+        }
+    }
+
+    return GPU_MEMORY_TYPE_NOT_FOUND;
+}
+VkResult CreateGpuBuffer(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    GpuBuffer *buffer
+) {
+    method( "CreateGpuBuffer" );
+
+    memset( buffer, 0, sizeof( GpuBuffer ) );
+    buffer->size = size;
+
+    VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .size = size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = NULL
+    };
+
+    VkResult result = vkCreateBuffer( device, &bufferInfo, NULL, &buffer->buffer );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateGpuBuffer", "failed to create buffer.\nError code: %d\n", result );
+        return result;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements( device, buffer->buffer, &requirements );
+
+    uint32_t memoryType = FindMemoryType( physicalDevice, requirements.memoryTypeBits, properties );
+    if ( memoryType == GPU_MEMORY_TYPE_NOT_FOUND ) {
+        fail_method( "CreateGpuBuffer", "no memory type with properties 0x%x!\n", properties );
+        DestroyGpuBuffer( device, buffer );
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    VkMemoryAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = NULL,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = memoryType
+    };
+
+    result = vkAllocateMemory( device, &allocInfo, NULL, &buffer->memory );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateGpuBuffer", "failed to allocate buffer memory.\nError code: %d\n", result );
+        DestroyGpuBuffer( device, buffer );
+        return result;
+    }
+    vkBindBufferMemory( device, buffer->buffer, buffer->memory, 0 );
+
+    // Host visible buffers stay mapped for their whole lifetime
+    if ( properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) {
+        result = vkMapMemory( device, buffer->memory, 0, size, 0, &buffer->mapped );
+        if ( result != VK_SUCCESS ) {
+            fail_method( "CreateGpuBuffer", "failed to map buffer memory.\nError code: %d\n", result );
+            DestroyGpuBuffer( device, buffer );
+            return result;
+        }
+    }
+
+    ok_method( "CreateGpuBuffer" );
+    return VK_SUCCESS;
+}
+void DestroyGpuBuffer( VkDevice device, GpuBuffer *buffer ) {
+    if ( buffer->mapped ) vkUnmapMemory( device, buffer->memory );
+    if ( buffer->buffer ) vkDestroyBuffer( device, buffer->buffer, NULL );
+    if ( buffer->memory ) vkFreeMemory( device, buffer->memory, NULL );
+    memset( buffer, 0, sizeof( GpuBuffer ) );
+}
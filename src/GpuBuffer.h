@@ -0,0 +1,20 @@
+#ifndef __GPU_BUFFER__
+#define __GPU_BUFFER__
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+#define GPU_MEMORY_TYPE_NOT_FOUND UINT32_MAX
+
+typedef struct {
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    void *mapped;
+} GpuBuffer;
+
+uint32_t FindMemoryType( VkPhysicalDevice, uint32_t, VkMemoryPropertyFlags );
+VkResult CreateGpuBuffer( VkDevice, VkPhysicalDevice, VkDeviceSize, VkBufferUsageFlags, VkMemoryPropertyFlags, GpuBuffer* );
+void DestroyGpuBuffer( VkDevice, GpuBuffer* );
+
+#endif
@@ -0,0 +1,133 @@
+#include "HelloTriangleApplication.h"
+
+/* METHODS */
+VkResult CreateGpuImage(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levelLength,
+    VkFormat format,
+    VkImageUsageFlags usage,
+    VkImageAspectFlags aspect,
+    GpuImage *image
+) {
+    method( "CreateGpuImage" );
+
+    VkResult result = CreateUnboundGpuImage( device, width, height, levelLength, format, usage, aspect, image );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateGpuImage", "failed to create image.\nError code: %d\n", result );
+        return result;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements( device, image->image, &requirements );
+
+    uint32_t memoryType = FindMemoryType( physicalDevice, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+    if ( memoryType == GPU_MEMORY_TYPE_NOT_FOUND ) {
+        fail_method( "CreateGpuImage", "no device local memory type for image!\n", NULL );
+        DestroyGpuImage( device, image );
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    VkMemoryAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = NULL,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = memoryType
+    };
+
+    VkDeviceMemory memory;
+    result = vkAllocateMemory( device, &allocInfo, NULL, &memory );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateGpuImage", "failed to allocate image memory.\nError code: %d\n", result );
+        DestroyGpuImage( device, image );
+        return result;
+    }
+
+    result = BindGpuImageMemory( device, image, memory, 0 );
+    image->memory = memory;
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateGpuImage", "failed to create image view.\nError code: %d\n", result );
+        DestroyGpuImage( device, image );
+        return result;
+    }
+
+    ok_method( "CreateGpuImage" );
+    return VK_SUCCESS;
+}
+VkResult CreateUnboundGpuImage(
+    VkDevice device,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levelLength,
+    VkFormat format,
+    VkImageUsageFlags usage,
+    VkImageAspectFlags aspect,
+    GpuImage *image
+) {
+    memset( image, 0, sizeof( GpuImage ) );
+    image->format = format;
+    image->aspect = aspect;
+    image->width = width;
+    image->height = height;
+    image->levelLength = levelLength;
+
+    VkImageCreateInfo imageInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = format,
+        .extent = { width, height, 1 },
+        .mipLevels = levelLength,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = NULL,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    return vkCreateImage( device, &imageInfo, NULL, &image->image );
+}
+VkResult BindGpuImageMemory( VkDevice device, GpuImage *image, VkDeviceMemory memory, VkDeviceSize offset ) {
+    // The memory stays with the caller, several images may share it
+    VkResult result = vkBindImageMemory( device, image->image, memory, offset );
+    if ( result != VK_SUCCESS ) return result;
+
+    return CreateGpuImageView( device, image, 0, image->levelLength, &image->view );
+}
+VkResult CreateGpuImageView( VkDevice device, const GpuImage *image, uint32_t baseLevel, uint32_t levelLength, VkImageView *view ) {
+    VkImageViewCreateInfo viewInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .image = image->image,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = image->format,
+        .components = {
+            .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .a = VK_COMPONENT_SWIZZLE_IDENTITY
+        },
+        .subresourceRange = {
+            .aspectMask = image->aspect,
+            .baseMipLevel = baseLevel,
+            .levelCount = levelLength,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+
+    return vkCreateImageView( device, &viewInfo, NULL, view );
+}
+void DestroyGpuImage( VkDevice device, GpuImage *image ) {
+    if ( image->view ) vkDestroyImageView( device, image->view, NULL );
+    if ( image->image ) vkDestroyImage( device, image->image, NULL );
+    if ( image->memory ) vkFreeMemory( device, image->memory, NULL );
+    memset( image, 0, sizeof( GpuImage ) );
+}
@@ -0,0 +1,24 @@
+#ifndef __GPU_IMAGE__
+#define __GPU_IMAGE__
+
+#include <vulkan/vulkan.h>
+
+// Device local 2D image with a view over all of its mip levels, memory is NULL when someone else owns it
+typedef struct {
+    VkImage image;
+    VkDeviceMemory memory;
+    VkImageView view;
+    VkFormat format;
+    VkImageAspectFlags aspect;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelLength;
+} GpuImage;
+
+VkResult CreateGpuImage( VkDevice, VkPhysicalDevice, uint32_t, uint32_t, uint32_t, VkFormat, VkImageUsageFlags, VkImageAspectFlags, GpuImage* );
+VkResult CreateUnboundGpuImage( VkDevice, uint32_t, uint32_t, uint32_t, VkFormat, VkImageUsageFlags, VkImageAspectFlags, GpuImage* );
+VkResult BindGpuImageMemory( VkDevice, GpuImage*, VkDeviceMemory, VkDeviceSize );
+VkResult CreateGpuImageView( VkDevice, const GpuImage*, uint32_t, uint32_t, VkImageView* );
+void DestroyGpuImage( VkDevice, GpuImage* );
+
+#endif
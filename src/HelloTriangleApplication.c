@@ -2,7 +2,10 @@
 
 /* PRIVATE VISIBILITY */
 void Run( int argc, char *argv[] );
+void ParseArguments( void );
 void InitWindow( void );
+void OpenAssets( void );
+void InitScene( void );
 void MainLoop( void );
 VkResult DrawFrame( void );
 void Cleanup( void );
@@ -12,16 +15,37 @@ VkResult CreateSurface( void );
 VkResult PickPhysicalDevice( void );
 VkResult CreateLogicalDevice( void );
 VkResult CreateSwapChain( void );
+void SelectDrawPath( void );
+VkResult CreateBindlessResources( void );
 VkResult CreateGraphicsPipeline( void );
+VkResult CreateIndirectDrawResources( void );
+VkResult CreateComputePipeline( const char*, const VkDescriptorSetLayout*, VkPipeline*, const CachedPipelineLayout** );
+VkResult CreateRenderGraph( void );
 VkResult CreateRenderPass( void );
 VkResult CreateFramebuffers( void );
 VkResult CreateCommandPool( void );
 VkResult CreateCommandBuffers( void );
-VkResult CreateSemaphores( void );
+VkResult CreateSyncObjects( void );
+VkResult CreateStagingBuffers( void );
+VkResult CreateDescriptorAllocator( void );
+VkResult CreateStatisticsQueries( void );
+VkResult UpdateUniforms( uint32_t );
+void ComputeObjectModel( uint32_t, float, mat4 );
+void ComputeCulledObjectModels( float, mat4*, vec4* );
+VkResult RecordCommandBuffer( VkCommandBuffer, uint32_t );
+VkResult RecordDepthPyramidPass( VkCommandBuffer, void* );
+VkResult RecordDrawCommandPass( VkCommandBuffer, void* );
+VkResult RecordScenePass( VkCommandBuffer, void* );
+VkResult RecordSceneDraws( VkCommandBuffer, bool );
+void UpdateStats( double );
 void ClearFeatures( VkPhysicalDeviceFeatures* );
 void GetDriverVersion( char*, uint32_t, uint32_t );
-bool IsDeviceSuitable( VkPhysicalDevice );
+uint32_t RateDeviceSuitability( VkPhysicalDevice );
 bool CheckDeviceExtensionSupport( VkPhysicalDevice );
+bool IsDeviceExtensionSupported( VkPhysicalDevice, const char* );
+bool IsInstanceExtensionSupported( const char* );
+bool CheckBindlessSupport( VkPhysicalDevice );
+bool CheckDynamicRenderingSupport( VkPhysicalDevice );
 bool CheckValidationLayerSupport( void );
 QueueFamilyIndices FindQueueFamilies( VkPhysicalDevice );
 SwapChainSupportDetails QuerySwapChainSupport( VkPhysicalDevice );
@@ -29,8 +53,14 @@ VkSurfaceFormatKHR ChooseSwapSurfaceFormat( const VkSurfaceFormatKHR*, uint32_t
 VkPresentModeKHR ChooseSwapPresentMode( const VkPresentModeKHR*, uint32_t );
 VkExtent2D ChooseSwapExtent( const VkSurfaceCapabilitiesKHR );
 VkResult CreateImageViews( void );
-VkShaderModule CreateShaderModule( uint8_t*, uint32_t );
+VkShaderModule CreateShaderModule( const uint8_t*, uint32_t );
 uint8_t *LoadFile( const char*, uint32_t* );
+const uint8_t *LoadAsset( const char*, uint32_t* );
+void FreeAsset( const uint8_t* );
+void StreamAsset( const char*, int );
+void OnAssetStreamed( AssetRequest*, void* );
+StreamedAsset *FindStreamedAsset( const char* );
+const char *GetVertexShaderPath( DrawPath );
 
 /* APP */
 AppProperties app = { 
@@ -55,6 +85,10 @@ AppProperties app = {
 
     .graphicsPipeline = NULL,
 
+    .objectLength = 1,
+    .sceneLayerLength = 1,
+    .objects = NULL,
+
     .Run = Run
 };
 
@@ -66,7 +100,11 @@ void Run( int argc, char *argv[] ) {
     app.argv = argv;
     for ( int i = 0; i < argc; i++ ) printf( "argv[%d]: \"%s\"\n", i, argv[ i ] );
 
+    ParseArguments();
+    printf( "Math kernels: %s\n", glmd_isa_name( glmd_init() ) );
     InitWindow();
+    OpenAssets();
+    InitScene();
 
     VkResult result = InitVulkan();
     if ( result != VK_SUCCESS ) {
@@ -78,6 +116,45 @@ void Run( int argc, char *argv[] ) {
 
     Cleanup();
 }
+void ParseArguments() {
+    entry( "ParseArguments" );
+
+    for ( int i = 1; i < app.argc; i++ ) {
+        if ( strcmp( app.argv[ i ], "--objects" ) == 0 && i + 1 < app.argc ) {
+            long objectLength = strtol( app.argv[ ++i ], NULL, 10 );
+            app.objectLength = ( uint32_t )clamp( objectLength, 1, 1000000 );
+        } else if ( strcmp( app.argv[ i ], "--bindless" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_BINDLESS;
+        } else if ( strcmp( app.argv[ i ], "--push-constants" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_PUSH_CONSTANTS;
+        } else if ( strcmp( app.argv[ i ], "--dynamic-uniforms" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_DYNAMIC_UNIFORMS;
+        } else if ( strcmp( app.argv[ i ], "--instanced" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_INSTANCED;
+        } else if ( strcmp( app.argv[ i ], "--indirect" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_INDIRECT;
+        } else if ( strcmp( app.argv[ i ], "--per-object-sets" ) == 0 ) {
+            app.requestedDrawPath = DRAW_PATH_PER_OBJECT_SETS;
+        } else if ( strcmp( app.argv[ i ], "--no-cull" ) == 0 ) {
+            app.isCullingDisabled = true;
+        } else if ( strcmp( app.argv[ i ], "--no-occlusion" ) == 0 ) {
+            app.isOcclusionDisabled = true;
+        } else if ( strcmp( app.argv[ i ], "--depth-prepass" ) == 0 ) {
+            app.isDepthPrepass = true;
+        } else if ( strcmp( app.argv[ i ], "--dynamic-rendering" ) == 0 ) {
+            app.isDynamicRenderingRequested = true;
+        } else if ( strcmp( app.argv[ i ], "--layers" ) == 0 && i + 1 < app.argc ) {
+            long layerLength = strtol( app.argv[ ++i ], NULL, 10 );
+            app.sceneLayerLength = ( uint32_t )clamp( layerLength, 1, 1024 );
+        } else {
+            printf( "Unknown argument \"%s\"\n", app.argv[ i ] );
+        }
+    }
+
+    app.sceneLayerLength = min( app.sceneLayerLength, app.objectLength );
+    printf( "Objects: %u in %u layers\n", app.objectLength, app.sceneLayerLength );
+    ok( "ParseArguments" );
+}
 void InitWindow() {
     entry( "InitWindow" );
 
@@ -90,43 +167,164 @@ void InitWindow() {
 
     ok( "InitWindow" );
 }
+void OpenAssets() {
+    entry( "OpenAssets" );
+
+    char *archivePath = GetRelativePath( app.argv[ 0 ], ASSET_ARCHIVE_NAME, NULL );
+    if ( !OpenAssetArchive( archivePath, &app.assets ) ) {
+        puts( "No asset archive found, falling back to loose files" );
+    }
+    free( archivePath );
+
+    app.hasStreamer = StartAssetStreamer( &app.streamer );
+    if ( !app.hasStreamer ) {
+        fail( "OpenAssets", "failed to start asset streamer!\n", NULL );
+        return;
+    }
+
+    // Loose shaders are read on the streamer while the scene and the device are set up,
+    // the ones needed first get the higher priority
+    if ( app.assets.data == NULL ) {
+        StreamAsset( GetVertexShaderPath( app.requestedDrawPath ), ASSET_PRIORITY_HIGH );
+        StreamAsset( FRAG_SHADER_PATH, ASSET_PRIORITY_HIGH );
+        if ( app.requestedDrawPath == DRAW_PATH_INDIRECT ) {
+            StreamAsset( DRAW_COMMANDS_SHADER_PATH, ASSET_PRIORITY_NORMAL );
+            if ( !app.isCullingDisabled && !app.isOcclusionDisabled ) StreamAsset( DEPTH_PYRAMID_SHADER_PATH, ASSET_PRIORITY_LOW );
+        }
+    }
+
+    ok( "OpenAssets" );
+}
+void InitScene() {
+    entry( "InitScene" );
+
+    // Objects are laid out on square grids facing the camera, w holds a rotation phase
+    // Stacked layers are packed tighter so the front layers hide most of the ones behind them
+    uint32_t layerObjectLength = ( app.objectLength + app.sceneLayerLength - 1 ) / app.sceneLayerLength;
+    uint32_t side = ( uint32_t )ceilf( sqrtf( ( float )layerObjectLength ) );
+    float spacing = app.sceneLayerLength > 1 ? 0.5f : 1.25f;
+    float layerSpacing = 1.0f;
+    float origin = -0.5f * spacing * ( float )( side - 1 );
+
+    app.sceneRadius = 0.5f * spacing * ( float )side;
+    app.sceneDepth = layerSpacing * ( float )( app.sceneLayerLength - 1 );
+    app.objects = calloc( app.objectLength, sizeof( vec4 ) );
+    app.objectColors = calloc( app.objectLength, sizeof( vec4 ) );
+    for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+        uint32_t layer = i / layerObjectLength;
+        uint32_t cell = i % layerObjectLength;
+        app.objects[ i ][ 0 ] = origin + spacing * ( float )( cell % side );
+        app.objects[ i ][ 1 ] = origin + spacing * ( float )( cell / side );
+        app.objects[ i ][ 2 ] = -layerSpacing * ( float )layer;
+        app.objects[ i ][ 3 ] = ( float )i * 0.37f;
+
+        // Tint fades across the grid so individual instances stay distinguishable
+        float u = ( float )( cell % side ) / ( float )side;
+        float v = ( float )( cell / side ) / ( float )side;
+        glm_vec4_copy( ( vec4 ){ 0.5f + 0.5f * u, 0.5f + 0.5f * v, 1.0f - 0.5f * u, 1.0f }, app.objectColors[ i ] );
+    }
+
+    ok( "InitScene" );
+}
 void MainLoop() {
     entry( "MainLoop" );
 
+    app.stats.reportTime = app.stats.lastFrameTime = glfwGetTime();
     while ( !glfwWindowShouldClose( app.window ) ) {
         glfwPollEvents();
+        if ( app.hasStreamer ) PollAssetStreamer( &app.streamer );
         if ( DrawFrame() != VK_SUCCESS ) break;
+        UpdateStats( glfwGetTime() );
     }
+    vkDeviceWaitIdle( app.vkDevice );
 
     ok( "MainLoop" );
 }
 VkResult DrawFrame() {
+    uint32_t frame = app.currentFrame;
+    vkWaitForFences( app.vkDevice, 1, &app.inFlightFences[ frame ], VK_TRUE, UINT64_MAX );
+
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(
+    VkResult result = vkAcquireNextImageKHR(
         app.vkDevice,
         app.vkSwapchainKHR,
         UINT64_MAX,
-        app.imageAvailableSemaphore,
+        app.imageAvailableSemaphores[ frame ],
         VK_NULL_HANDLE,
         &imageIndex
     );
+    if ( result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR ) {
+        fail( "DrawFrame", "failed to acquire swap chain image.\nError code: %d\n", result );
+        return result;
+    }
 
-    VkSemaphore waitSemaphores[] = { app.imageAvailableSemaphore };
+    // A previous frame may still be rendering to this image
+    if ( app.imagesInFlight[ imageIndex ] != VK_NULL_HANDLE ) {
+        vkWaitForFences( app.vkDevice, 1, &app.imagesInFlight[ imageIndex ], VK_TRUE, UINT64_MAX );
+    }
+    app.imagesInFlight[ imageIndex ] = app.inFlightFences[ frame ];
+
+    // The frame's fence signaled, its staging region can be reused and its culling results read
+    IndirectDrawStats cullStats;
+    if ( app.drawPath == DRAW_PATH_INDIRECT && ReadIndirectDrawStats( &app.indirectDraws, app.vkDevice, frame, &cullStats ) ) {
+        app.stats.visibleLength += cullStats.visibleLength;
+        app.stats.culledLength += cullStats.culledLength;
+        app.stats.occludedLength += cullStats.occludedLength;
+        app.stats.cullSampleLength++;
+        if ( cullStats.gpuTime >= 0.0 ) {
+            app.stats.cullTime += cullStats.gpuTime;
+            app.stats.cullTimeSampleLength++;
+        }
+    }
+
+    // Without a wait flag the result is only missing when the frame never reached the query
+    if ( app.isStatisticsPending[ frame ] ) {
+        uint64_t fragmentInvocations;
+        VkResult queryResult = vkGetQueryPoolResults(
+            app.vkDevice,
+            app.statisticsQueryPool,
+            frame, 1,
+            sizeof( uint64_t ), &fragmentInvocations, sizeof( uint64_t ),
+            VK_QUERY_RESULT_64_BIT
+        );
+        if ( queryResult == VK_SUCCESS ) {
+            app.stats.fragmentInvocationLength += fragmentInvocations;
+            app.stats.fragmentSampleLength++;
+        }
+        app.isStatisticsPending[ frame ] = false;
+    }
+
+    BeginStagingFrame( &app.stagingRing, frame );
+    BeginDescriptorFrame( &app.descriptorAllocator, app.vkDevice, frame );
+
+    double updateStart = glfwGetTime();
+    result = UpdateUniforms( frame );
+    app.stats.updateTime += glfwGetTime() - updateStart;
+    if ( result != VK_SUCCESS ) return result;
+
+    vkResetCommandBuffer( app.commandBuffers[ frame ], 0 );
+    double recordStart = glfwGetTime();
+    result = RecordCommandBuffer( app.commandBuffers[ frame ], imageIndex );
+    app.stats.recordTime += glfwGetTime() - recordStart;
+    if ( result != VK_SUCCESS ) return result;
+
+    VkSemaphore waitSemaphores[] = { app.imageAvailableSemaphores[ frame ] };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    VkSemaphore signalSemaphores[] = { app.renderFinishedSemaphore };
+    VkSemaphore signalSemaphores[] = { app.renderFinishedSemaphores[ frame ] };
     VkSubmitInfo submitInfo = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .pNext = NULL,
         .pWaitDstStageMask = waitStages,
         .commandBufferCount = 1,
-        .pCommandBuffers = &app.commandBuffers[ imageIndex ],
+        .pCommandBuffers = &app.commandBuffers[ frame ],
         .waitSemaphoreCount = 1,
         .pWaitSemaphores = waitSemaphores,
         .signalSemaphoreCount = 1,
         .pSignalSemaphores = signalSemaphores
     };
 
-    VkResult result = vkQueueSubmit( app.vkGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE );
+    vkResetFences( app.vkDevice, 1, &app.inFlightFences[ frame ] );
+    result = vkQueueSubmit( app.vkGraphicsQueue, 1, &submitInfo, app.inFlightFences[ frame ] );
     if ( result != VK_SUCCESS ) {
         fail( "DrawFrame", "failed to queue submit.\nError code: %d\n", result );
         return result;
@@ -146,15 +344,35 @@ VkResult DrawFrame() {
     };
 
     vkQueuePresentKHR( app.vkPresentationQueue, &presentInfo );
+    app.currentFrame = ( frame + 1 ) % MAX_FRAMES_IN_FLIGHT;
 
     return VK_SUCCESS;
 }
 void Cleanup() {
     entry( "Cleanup" );
 
-    puts( "Destroying semaphores" );
-    if ( app.renderFinishedSemaphore ) vkDestroySemaphore( app.vkDevice, app.renderFinishedSemaphore, NULL );
-    if ( app.imageAvailableSemaphore ) vkDestroySemaphore( app.vkDevice, app.imageAvailableSemaphore, NULL );
+    puts( "Destroying semaphores and fences" );
+    for ( uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++ ) {
+        if ( app.renderFinishedSemaphores[ i ] ) vkDestroySemaphore( app.vkDevice, app.renderFinishedSemaphores[ i ], NULL );
+        if ( app.imageAvailableSemaphores[ i ] ) vkDestroySemaphore( app.vkDevice, app.imageAvailableSemaphores[ i ], NULL );
+        if ( app.inFlightFences[ i ] ) vkDestroyFence( app.vkDevice, app.inFlightFences[ i ], NULL );
+    }
+    if ( app.imagesInFlight ) free( app.imagesInFlight );
+
+    puts( "Destroying descriptor allocator" );
+    if ( app.descriptorAllocator.frameLength ) DestroyDescriptorAllocator( &app.descriptorAllocator, app.vkDevice );
+
+    puts( "Destroying indirect draws" );
+    if ( app.indirectDraws.frameLength ) DestroyIndirectDraws( &app.indirectDraws, app.vkDevice );
+    if ( app.depthPyramid.image.image ) DestroyDepthPyramid( &app.depthPyramid, app.vkDevice );
+
+    puts( "Destroying bindless heap" );
+    if ( app.bindlessHeap.setLayout ) DestroyBindlessHeap( &app.bindlessHeap, app.vkDevice );
+    if ( app.objectDescriptorSets ) free( app.objectDescriptorSets );
+    if ( app.drawDataOffsets ) free( app.drawDataOffsets );
+
+    puts( "Destroying staging ring" );
+    if ( app.stagingRing.frameLength ) DestroyStagingRing( &app.stagingRing, app.vkDevice );
 
     puts( "Destroying command pool" );
     if ( app.commandPool ) vkDestroyCommandPool( app.vkDevice, app.commandPool, NULL );
@@ -171,13 +389,20 @@ void Cleanup() {
 
     puts( "Destroying vk graphics pipeline..." );
     if ( app.graphicsPipeline ) vkDestroyPipeline( app.vkDevice, app.graphicsPipeline, NULL );
+    if ( app.depthPrepassPipeline ) vkDestroyPipeline( app.vkDevice, app.depthPrepassPipeline, NULL );
 
-    puts( "Destroying vk pipeline layout..." );
-    if ( app.pipelineLayout ) vkDestroyPipelineLayout( app.vkDevice, app.pipelineLayout, NULL );
+    puts( "Destroying statistics queries..." );
+    if ( app.statisticsQueryPool ) vkDestroyQueryPool( app.vkDevice, app.statisticsQueryPool, NULL );
+
+    puts( "Destroying vk pipeline and descriptor set layouts..." );
+    if ( app.vkDevice ) DestroyLayoutCache( &app.layoutCache, app.vkDevice );
 
     puts( "Destroying vk render pass..." );
     if ( app.renderPass ) vkDestroyRenderPass( app.vkDevice, app.renderPass, NULL );
 
+    puts( "Destroying render graph..." );
+    if ( app.renderGraph.resourceLength ) DestroyRenderGraph( &app.renderGraph, app.vkDevice );
+
     puts( "Cleaning Swap chain image views..." );
     if ( app.swapChainImageViews ) {
         for ( int i = 0; i < app.swapChainImageLength; i++ ) {
@@ -189,8 +414,17 @@ void Cleanup() {
     puts( "Cleaning Swap chain images..." );
     if ( app.swapChainImages ) free( app.swapChainImages );
 
-    puts( "Cleaning command buffers..." );
-    if ( app.commandBuffers ) free( app.commandBuffers );
+    puts( "Cleaning scene..." );
+    if ( app.objects ) free( app.objects );
+    if ( app.objectColors ) free( app.objectColors );
+    if ( app.objectLocalBounds ) free( app.objectLocalBounds );
+
+    puts( "Stopping asset streamer..." );
+    if ( app.hasStreamer ) StopAssetStreamer( &app.streamer );
+    for ( uint32_t i = 0; i < app.streamedAssetLength; i++ ) free( app.streamedAssets[ i ].data );
+
+    puts( "Closing asset archive..." );
+    if ( app.assets.data ) CloseAssetArchive( &app.assets );
 
     puts( "Cleaning Vulkan and glfw..." );
     if ( app.vkSwapchainKHR ) vkDestroySwapchainKHR( app.vkDevice, app.vkSwapchainKHR, NULL );
@@ -216,6 +450,8 @@ VkResult InitVulkan() {
     result = PickPhysicalDevice();
     if ( result != VK_SUCCESS ) return result;
 
+    SelectDrawPath();
+
     result = CreateLogicalDevice();
     if ( result != VK_SUCCESS ) return result;
 
@@ -225,12 +461,21 @@ VkResult InitVulkan() {
     result = CreateImageViews();
     if ( result != VK_SUCCESS ) return result;
 
+    result = CreateRenderGraph();
+    if ( result != VK_SUCCESS ) return result;
+
     result = CreateRenderPass();
     if ( result != VK_SUCCESS ) return result;
 
+    result = CreateBindlessResources();
+    if ( result != VK_SUCCESS ) return result;
+
     result = CreateGraphicsPipeline();
     if ( result != VK_SUCCESS ) return result;
 
+    result = CreateIndirectDrawResources();
+    if ( result != VK_SUCCESS ) return result;
+
     result = CreateFramebuffers();
     if ( result != VK_SUCCESS ) return result;
 
@@ -240,7 +485,16 @@ VkResult InitVulkan() {
     result = CreateCommandBuffers();
     if ( result != VK_SUCCESS ) return result;
 
-    result = CreateSemaphores();
+    result = CreateSyncObjects();
+    if ( result != VK_SUCCESS ) return result;
+
+    result = CreateStagingBuffers();
+    if ( result != VK_SUCCESS ) return result;
+
+    result = CreateDescriptorAllocator();
+    if ( result != VK_SUCCESS ) return result;
+
+    result = CreateStatisticsQueries();
     if ( result != VK_SUCCESS ) return result;
 
     ok( "InitVulkan" );
@@ -280,12 +534,21 @@ VkResult CreateVulkanInstance() {
     uint32_t glfwExtensionCount = 0;
     const char **glfwExtensions;
     glfwExtensions = glfwGetRequiredInstanceExtensions( &glfwExtensionCount );
-    createInfo.enabledExtensionCount = glfwExtensionCount;
-    createInfo.ppEnabledExtensionNames = glfwExtensions;
     puts( "glfwExtensions:" );
     for ( int i = 0; i < glfwExtensionCount; i++ )
         printf( "\t\"%s\"\n", glfwExtensions[ i ] );
 
+    // Feature queries of optional device extensions go through properties2
+    const char *instanceExtensions[ MAX_INSTANCE_EXTENSION_COUNT ];
+    uint32_t instanceExtensionLength = min( glfwExtensionCount, MAX_INSTANCE_EXTENSION_COUNT - 1 );
+    memcpy( instanceExtensions, glfwExtensions, instanceExtensionLength * sizeof( const char* ) );
+    if ( IsInstanceExtensionSupported( VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME ) ) {
+        instanceExtensions[ instanceExtensionLength++ ] = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
+        app.hasPhysicalDeviceProperties2 = true;
+    }
+    createInfo.enabledExtensionCount = instanceExtensionLength;
+    createInfo.ppEnabledExtensionNames = instanceExtensions;
+
     uint32_t vkExtCount = 0;
     vkEnumerateInstanceExtensionProperties( NULL, &vkExtCount, NULL );
     VkExtensionProperties vkExtensions[ vkExtCount ];
@@ -327,16 +590,17 @@ VkResult PickPhysicalDevice() {
     vkEnumeratePhysicalDevices( app.vkInstance, &deviceCount, devices );
     puts( "devices:" );
 
-    bool isNotSupported = true;
-    for ( int i = 0; i < deviceCount; i++ ) {
-        bool isSupported = IsDeviceSuitable( devices[ i ] );
-        if ( isSupported ) {
+    // Any device that can present works, lavapipe included, faster device types win
+    uint32_t bestScore = 0;
+    for ( uint32_t i = 0; i < deviceCount; i++ ) {
+        uint32_t score = RateDeviceSuitability( devices[ i ] );
+        if ( score > bestScore ) {
             app.vkPhysicalDevice = devices[ i ];
-            isNotSupported = false;
+            bestScore = score;
         }
     }
 
-    if ( isNotSupported ) {
+    if ( bestScore == 0 ) {
         fail( "PickPhysicalDevice", "no supported Graphical Devices was found!\n", NULL );
         return VK_ERROR_DEVICE_LOST;
     }
@@ -381,15 +645,76 @@ VkResult CreateLogicalDevice() {
     
     VkPhysicalDeviceFeatures deviceFeatures;
     ClearFeatures( &deviceFeatures );
-    
+
+    // Fragment invocation counts are only reported, devices without pipeline statistics still run
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures( app.vkPhysicalDevice, &supportedFeatures );
+    app.hasPipelineStatistics = supportedFeatures.pipelineStatisticsQuery;
+    deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+
+    app.enabledDeviceExtensionLength = 0;
+    for ( uint32_t i = 0; i < DEVICE_EXTENSION_COUNT; i++ ) {
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = app.deviceExtensions[ i ];
+    }
+
+    void *featureChain = NULL;
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+        .pNext = NULL,
+        .runtimeDescriptorArray = VK_TRUE,
+        .descriptorBindingPartiallyBound = VK_TRUE,
+        .descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+        .descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+        .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE
+    };
+    if ( app.drawPath == DRAW_PATH_BINDLESS ) {
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_MAINTENANCE3_EXTENSION_NAME;
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME;
+        indexingFeatures.pNext = featureChain;
+        featureChain = &indexingFeatures;
+    }
+
+    bool hasDrawIndirectCount = false;
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+        deviceFeatures.multiDrawIndirect = app.indirectDraws.hasMultiDraw;
+        // A count draw is capped at one command without multi draw, compacted draws past the first would be lost
+        hasDrawIndirectCount = (
+            app.indirectDraws.hasMultiDraw &&
+            IsDeviceExtensionSupported( app.vkPhysicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME )
+        );
+        if ( hasDrawIndirectCount ) {
+            app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+        } else {
+            puts( "Draw indirect count is not usable, culled draws will be kept with zero instances" );
+        }
+    }
+
+    // Dynamic rendering depends on depth stencil resolve and everything that one depends on in Vulkan 1.0
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+        .pNext = NULL,
+        .dynamicRendering = VK_TRUE
+    };
+    if ( app.isDynamicRendering ) {
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_MULTIVIEW_EXTENSION_NAME;
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_MAINTENANCE2_EXTENSION_NAME;
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME;
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME;
+        app.enabledDeviceExtensions[ app.enabledDeviceExtensionLength++ ] = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+        dynamicRenderingFeatures.pNext = featureChain;
+        featureChain = &dynamicRenderingFeatures;
+    }
+
     VkDeviceCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pNext = NULL,
+        .pNext = featureChain,
         .pEnabledFeatures = &deviceFeatures,
         .queueCreateInfoCount = queueCount,
         .pQueueCreateInfos = queueCreateInfos,
-        .enabledExtensionCount = DEVICE_EXTENSION_COUNT,
-        .ppEnabledExtensionNames = app.deviceExtensions,
+        .enabledExtensionCount = app.enabledDeviceExtensionLength,
+        .ppEnabledExtensionNames = app.enabledDeviceExtensions,
         .enabledLayerCount = 0,
         .ppEnabledLayerNames = NULL
     };
@@ -403,6 +728,22 @@ VkResult CreateLogicalDevice() {
     vkGetDeviceQueue( app.vkDevice, indices.graphicsFamily.value, 0, &app.vkGraphicsQueue );
     vkGetDeviceQueue( app.vkDevice, indices.presentationFamily.value, 0, &app.vkPresentationQueue );
 
+    if ( hasDrawIndirectCount ) {
+        app.indirectDraws.vkCmdDrawIndexedIndirectCount = ( PFN_vkCmdDrawIndexedIndirectCountKHR )vkGetDeviceProcAddr(
+            app.vkDevice,
+            "vkCmdDrawIndexedIndirectCountKHR"
+        );
+    }
+
+    if ( app.isDynamicRendering ) {
+        app.vkCmdBeginRenderingKHR = ( PFN_vkCmdBeginRenderingKHR )vkGetDeviceProcAddr( app.vkDevice, "vkCmdBeginRenderingKHR" );
+        app.vkCmdEndRenderingKHR = ( PFN_vkCmdEndRenderingKHR )vkGetDeviceProcAddr( app.vkDevice, "vkCmdEndRenderingKHR" );
+        if ( app.vkCmdBeginRenderingKHR == NULL || app.vkCmdEndRenderingKHR == NULL ) {
+            fail( "CreateLogicalDevice", "failed to load dynamic rendering commands %d\n", VK_ERROR_EXTENSION_NOT_PRESENT );
+            return VK_ERROR_EXTENSION_NOT_PRESENT;
+        }
+    }
+
     ok( "CreateLogicalDevice" );
     return VK_SUCCESS;
 }
@@ -505,38 +846,140 @@ VkResult CreateImageViews() {
     ok( "CreateImageViews" );
     return VK_SUCCESS;
 }
+void SelectDrawPath() {
+    entry( "SelectDrawPath" );
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties( app.vkPhysicalDevice, &properties );
+
+    app.drawPath = app.requestedDrawPath;
+    if ( app.drawPath == DRAW_PATH_BINDLESS && !CheckBindlessSupport( app.vkPhysicalDevice ) ) {
+        puts( "Descriptor indexing is not supported, falling back to bound descriptor sets" );
+        app.drawPath = DRAW_PATH_BOUND_SETS;
+    }
+
+    // Per-draw data too big for push constants goes through a ring buffered uniform with dynamic offsets
+    if ( app.drawPath == DRAW_PATH_PUSH_CONSTANTS && sizeof( DrawData ) > properties.limits.maxPushConstantsSize ) {
+        printf( "Draw data (%u bytes) exceeds maxPushConstantsSize (%u bytes), falling back to dynamic uniforms\n",
+            ( uint32_t )sizeof( DrawData ),
+            properties.limits.maxPushConstantsSize
+        );
+        app.drawPath = DRAW_PATH_DYNAMIC_UNIFORMS;
+    }
+
+    // Indirect draws address objects through firstInstance, multi draw only saves API calls
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        VkPhysicalDeviceFeatures features;
+        vkGetPhysicalDeviceFeatures( app.vkPhysicalDevice, &features );
+        if ( !features.drawIndirectFirstInstance ) {
+            puts( "drawIndirectFirstInstance is not supported, falling back to bound descriptor sets" );
+            app.drawPath = DRAW_PATH_BOUND_SETS;
+        } else {
+            app.indirectDraws.hasMultiDraw = features.multiDrawIndirect;
+            app.indirectDraws.maxDrawCount = features.multiDrawIndirect ? properties.limits.maxDrawIndirectCount : 1;
+        }
+    }
+
+    // Without dynamic rendering the scene pass keeps its render pass and per image framebuffers
+    app.isDynamicRendering = app.isDynamicRenderingRequested;
+    if ( app.isDynamicRendering && !CheckDynamicRenderingSupport( app.vkPhysicalDevice ) ) {
+        puts( "Dynamic rendering is not supported, falling back to render pass objects" );
+        app.isDynamicRendering = false;
+    }
+
+    ok( "SelectDrawPath" );
+}
+VkResult CreateBindlessResources() {
+    entry( "CreateBindlessResources" );
+
+    if ( app.drawPath != DRAW_PATH_BINDLESS ) {
+        ok( "CreateBindlessResources (disabled)" );
+        return VK_SUCCESS;
+    }
+
+    PFN_vkGetPhysicalDeviceProperties2KHR getProperties2 = ( PFN_vkGetPhysicalDeviceProperties2KHR )vkGetInstanceProcAddr(
+        app.vkInstance,
+        "vkGetPhysicalDeviceProperties2KHR"
+    );
+    if ( getProperties2 == NULL ) {
+        fail( "CreateBindlessResources", "vkGetPhysicalDeviceProperties2KHR is not available!\n", NULL );
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT,
+        .pNext = NULL
+    };
+    VkPhysicalDeviceProperties2KHR properties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR,
+        .pNext = &indexingProperties
+    };
+    getProperties2( app.vkPhysicalDevice, &properties );
+
+    // Update after bind descriptors have their own limits, a combined image sampler counts as an image and a sampler
+    uint32_t bufferCapacity = BINDLESS_MAX_BUFFERS;
+    bufferCapacity = min( bufferCapacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers );
+    bufferCapacity = min( bufferCapacity, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers );
+    bufferCapacity = min( bufferCapacity, indexingProperties.maxPerStageUpdateAfterBindResources );
+
+    uint32_t textureCapacity = BINDLESS_MAX_TEXTURES;
+    textureCapacity = min( textureCapacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages );
+    textureCapacity = min( textureCapacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers );
+    textureCapacity = min( textureCapacity, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages );
+    textureCapacity = min( textureCapacity, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers );
+    textureCapacity = min( textureCapacity, indexingProperties.maxPerStageUpdateAfterBindResources - bufferCapacity );
+
+    // Every frame in flight registers its own object buffer
+    if ( bufferCapacity < MAX_FRAMES_IN_FLIGHT ) {
+        fail( "CreateBindlessResources", "update after bind storage buffer limit is too low!\n", NULL );
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    VkResult result = CreateBindlessHeap( &app.bindlessHeap, app.vkDevice, bufferCapacity, textureCapacity );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateBindlessResources", "failed to create bindless heap.\nError code: %d\n", result );
+        return result;
+    }
+
+    ok( "CreateBindlessResources" );
+    return VK_SUCCESS;
+}
 VkResult CreateGraphicsPipeline() {
     entry( "CreateGraphicsPipeline" );
 
-    const char VERT_PATH[] = "shaders/vert.spv";
-    const char FRAG_PATH[] = "shaders/frag.spv";
-    char *vertPath, *fragPath;
-    uint8_t *vertProgram, *fragProgram;
+    const char *VERT_PATH = GetVertexShaderPath( app.drawPath );
+    const char FRAG_PATH[] = FRAG_SHADER_PATH;
+    const uint8_t *vertProgram, *fragProgram;
     uint32_t vertProgramLength, fragProgramLength;
 
-    vertPath = GetRelativePath( app.argv[ 0 ], VERT_PATH, NULL );
-    fragPath = GetRelativePath( app.argv[ 0 ], FRAG_PATH, NULL );
     puts( "Loading vertex shader..." );
-    vertProgram = LoadFile( vertPath, &vertProgramLength );
+    vertProgram = LoadAsset( VERT_PATH, &vertProgramLength );
     puts( "Loading fragment shader..." );
-    fragProgram = LoadFile( fragPath, &fragProgramLength );
-    free( vertPath );
-    free( fragPath );
+    fragProgram = LoadAsset( FRAG_PATH, &fragProgramLength );
 
     if ( vertProgram == NULL || fragProgram == NULL ) {
         if ( vertProgram == NULL )
             fail( "CreateGraphicsPipeline", "failed to load vertex shader \"%s\"!\n", VERT_PATH );
         if ( fragProgram == NULL )
             fail( "CreateGraphicsPipeline", "failed to load fragment shader \"%s\"!\n", FRAG_PATH );
-        if ( vertProgram != NULL ) free( vertProgram );
-        if ( fragProgram != NULL ) free( fragProgram );
+        FreeAsset( vertProgram );
+        FreeAsset( fragProgram );
+        return VK_ERROR_UNKNOWN;
+    }
+
+    ShaderReflection reflections[ 2 ];
+    if ( !ReflectShader( vertProgram, vertProgramLength, &reflections[ 0 ] ) ||
+         !ReflectShader( fragProgram, fragProgramLength, &reflections[ 1 ] ) ) {
+        fail( "CreateGraphicsPipeline", "failed to reflect shaders!\n", NULL );
+        FreeAsset( vertProgram );
+        FreeAsset( fragProgram );
         return VK_ERROR_UNKNOWN;
     }
 
     VkShaderModule vertShaderModule = CreateShaderModule( vertProgram, vertProgramLength );
     VkShaderModule fragShaderModule = CreateShaderModule( fragProgram, fragProgramLength );
-    free( vertProgram );
-    free( fragProgram );
+    FreeAsset( vertProgram );
+    FreeAsset( fragProgram );
     if ( vertShaderModule == NULL || fragShaderModule == NULL ) {
         if ( vertShaderModule == NULL )
             fail( "CreateGraphicsPipeline", "failed to create vertex shader module!\n", NULL );
@@ -567,13 +1010,16 @@ VkResult CreateGraphicsPipeline() {
         fragShaderStageInfo
     };
 
+    VertexInputLayout vertexInputLayout;
+    BuildVertexInputLayout( &reflections[ 0 ], &vertexInputLayout );
+
     VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
         .pNext = NULL,
-        .vertexAttributeDescriptionCount = 0,
-        .pVertexAttributeDescriptions = NULL,
-        .vertexBindingDescriptionCount = 0,
-        .pVertexBindingDescriptions = NULL
+        .vertexAttributeDescriptionCount = vertexInputLayout.attributeLength,
+        .pVertexAttributeDescriptions = vertexInputLayout.attributes,
+        .vertexBindingDescriptionCount = vertexInputLayout.bindingLength,
+        .pVertexBindingDescriptions = vertexInputLayout.bindings
     };
 
     VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
@@ -621,6 +1067,21 @@ VkResult CreateGraphicsPipeline() {
         .depthBiasSlopeFactor = 0.0f
     };
 
+    VkPipelineDepthStencilStateCreateInfo depthStencil = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .depthTestEnable = VK_TRUE,
+        .depthWriteEnable = !app.isDepthPrepass,
+        .depthCompareOp = app.isDepthPrepass ? VK_COMPARE_OP_LESS_OR_EQUAL : VK_COMPARE_OP_LESS,
+        .depthBoundsTestEnable = VK_FALSE,
+        .stencilTestEnable = VK_FALSE,
+        .front = { 0 },
+        .back = { 0 },
+        .minDepthBounds = 0.0f,
+        .maxDepthBounds = 1.0f
+    };
+
     VkPipelineMultisampleStateCreateInfo multisampling = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
         .pNext = NULL,
@@ -658,32 +1119,48 @@ VkResult CreateGraphicsPipeline() {
         .blendConstants = { 0.0f, 0.0f, 0.0f, 0.0f }
     };
 
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .pNext = NULL,
-        .setLayoutCount = 0,
-        .pSetLayouts = NULL,
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = NULL
-    };
-
-    VkResult result = vkCreatePipelineLayout(
-        app.vkDevice,
-        &pipelineLayoutInfo,
-        NULL,
-        &app.pipelineLayout
-    );
+    const CachedPipelineLayout *pipelineLayout;
+    // Set 1 is either the bindless heap or the dynamic draw data uniform, reflection can not tell either
+    VkDescriptorSetLayout setLayoutOverrides[ LAYOUT_CACHE_MAX_SETS ] = { VK_NULL_HANDLE };
+    VkResult result = VK_SUCCESS;
+    if ( app.drawPath == DRAW_PATH_BINDLESS ) {
+        setLayoutOverrides[ 1 ] = app.bindlessHeap.setLayout;
+    } else if ( app.drawPath == DRAW_PATH_DYNAMIC_UNIFORMS ) {
+        VkDescriptorSetLayoutBinding drawDataBinding = {
+            .binding = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .pImmutableSamplers = NULL
+        };
+        result = GetSetLayout( &app.layoutCache, app.vkDevice, &drawDataBinding, 1, &app.drawDataSetLayout );
+        setLayoutOverrides[ 1 ] = app.drawDataSetLayout;
+    }
+    if ( result == VK_SUCCESS ) result = GetPipelineLayout( &app.layoutCache, app.vkDevice, reflections, 2, setLayoutOverrides, &pipelineLayout );
     if ( result != VK_SUCCESS ) {
         vkDestroyShaderModule( app.vkDevice, vertShaderModule, NULL );
         vkDestroyShaderModule( app.vkDevice, fragShaderModule, NULL );
         fail( "CreateGraphicsPipeline", "failed to create graphics pipeline.\nError code: %d\n", result );
         return result;
     }
+    app.pipelineLayout = pipelineLayout->pipelineLayout;
+    app.descriptorSetLayout = pipelineLayout->setLayoutLength ? pipelineLayout->setLayouts[ 0 ] : VK_NULL_HANDLE;
     puts( "Pipeline layout created!" );
 
+    // Dynamic rendering pipelines name their attachment formats instead of a compatible render pass
+    VkPipelineRenderingCreateInfoKHR renderingInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+        .pNext = NULL,
+        .viewMask = 0,
+        .colorAttachmentCount = 1,
+        .pColorAttachmentFormats = &app.swapChainImageFormat,
+        .depthAttachmentFormat = app.depthImage->format,
+        .stencilAttachmentFormat = VK_FORMAT_UNDEFINED
+    };
+
     VkGraphicsPipelineCreateInfo pipelineInfo = {
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext = NULL,
+        .pNext = app.isDynamicRendering ? &renderingInfo : NULL,
         .stageCount = 2,
         .pStages = shaderStages,
         .pVertexInputState = &vertexInputInfo,
@@ -691,7 +1168,7 @@ VkResult CreateGraphicsPipeline() {
         .pViewportState = &viewportState,
         .pRasterizationState = &rasterizer,
         .pMultisampleState = &multisampling,
-        .pDepthStencilState = NULL,
+        .pDepthStencilState = &depthStencil,
         .pColorBlendState = &colorBlending,
         .pDynamicState = NULL,
         .pTessellationState = NULL,
@@ -727,14 +1204,279 @@ VkResult CreateGraphicsPipeline() {
     }
     puts( "Pipeline created!" );
 
+    // The prepass runs the same vertex stage without a fragment shader, the color pass then only shades visible fragments
+    if ( app.isDepthPrepass ) {
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+        colorBlendAttachment.colorWriteMask = 0;
+        pipelineInfo.stageCount = 1;
+
+        result = vkCreateGraphicsPipelines( app.vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &app.depthPrepassPipeline );
+        if ( result != VK_SUCCESS ) {
+            fail( "CreateGraphicsPipeline", "failed to create depth prepass pipeline.\nError code: %d\n", result );
+            vkDestroyShaderModule( app.vkDevice, vertShaderModule, NULL );
+            vkDestroyShaderModule( app.vkDevice, fragShaderModule, NULL );
+            return result;
+        }
+        puts( "Depth prepass pipeline created!" );
+    }
+
     vkDestroyShaderModule( app.vkDevice, vertShaderModule, NULL );
     vkDestroyShaderModule( app.vkDevice, fragShaderModule, NULL );
     ok( "CreateGraphicsPipeline" );
     return VK_SUCCESS;
 }
+VkResult CreateIndirectDrawResources() {
+    entry( "CreateIndirectDrawResources" );
+
+    if ( app.drawPath != DRAW_PATH_INDIRECT ) {
+        ok( "CreateIndirectDrawResources (disabled)" );
+        return VK_SUCCESS;
+    }
+
+    // The triangle goes through an index buffer so draws are VkDrawIndexedIndirectCommands
+    const uint16_t TRIANGLE_INDICES[] = { 0, 1, 2 };
+    app.objectLocalBounds = malloc( app.objectLength * sizeof( vec4 ) );
+    for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+        glm_vec4( GLM_VEC3_ZERO, OBJECT_BOUNDING_RADIUS, app.objectLocalBounds[ i ] );
+    }
+    app.indirectDraws.isCulling = !app.isCullingDisabled;
+
+    VkResult result = CreateIndirectDraws(
+        &app.indirectDraws,
+        app.vkDevice,
+        app.vkPhysicalDevice,
+        app.objectLength,
+        MAX_FRAMES_IN_FLIGHT,
+        TRIANGLE_INDICES,
+        sizeof( TRIANGLE_INDICES ) / sizeof( uint16_t )
+    );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateIndirectDrawResources", "failed to create indirect draw buffers.\nError code: %d\n", result );
+        return result;
+    }
+
+    // The camera and pyramid bindings are filled by the frame sets, declared here so the layout matches them
+    VkDescriptorSetLayoutBinding cullBindings[] = {
+        { INDIRECT_DRAWS_COUNT_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL },
+        { INDIRECT_DRAWS_COMMAND_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL },
+        { INDIRECT_DRAWS_BOUNDS_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL },
+        { INDIRECT_DRAWS_CAMERA_BINDING, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL },
+        { INDIRECT_DRAWS_PYRAMID_BINDING, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL }
+    };
+    VkDescriptorSetLayout cullSetLayout;
+    result = GetSetLayout( &app.layoutCache, app.vkDevice, cullBindings, sizeof( cullBindings ) / sizeof( cullBindings[ 0 ] ), &cullSetLayout );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateIndirectDrawResources", "failed to create draw command set layout.\nError code: %d\n", result );
+        return result;
+    }
+
+    const CachedPipelineLayout *pipelineLayout;
+    result = CreateComputePipeline( DRAW_COMMANDS_SHADER_PATH, &cullSetLayout, &app.indirectDraws.pipeline, &pipelineLayout );
+    if ( result != VK_SUCCESS ) return result;
+    app.indirectDraws.pipelineLayout = pipelineLayout->pipelineLayout;
+    app.indirectDraws.setLayout = pipelineLayout->setLayouts[ 0 ];
+
+    // Occlusion reuses the depth of the previous frame so it only runs alongside the frustum test,
+    // the pyramid still exists without it since the culling set always binds it
+    app.indirectDraws.isOcclusionCulling = app.indirectDraws.isCulling && !app.isOcclusionDisabled;
+    const GpuImage *pyramidImage = GetRenderGraphImage( &app.renderGraph, app.graphDepthPyramid );
+    result = CreateDepthPyramid( &app.depthPyramid, app.vkDevice, pyramidImage, app.depthImage->width, app.depthImage->height );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateIndirectDrawResources", "failed to create depth pyramid.\nError code: %d\n", result );
+        return result;
+    }
+    if ( app.indirectDraws.isOcclusionCulling ) {
+        result = CreateComputePipeline( DEPTH_PYRAMID_SHADER_PATH, NULL, &app.depthPyramid.pipeline, &pipelineLayout );
+        if ( result != VK_SUCCESS ) return result;
+        app.depthPyramid.pipelineLayout = pipelineLayout->pipelineLayout;
+        app.depthPyramid.setLayout = pipelineLayout->setLayouts[ 0 ];
+    }
+
+    printf( "Indirect draws: %s, %s, %s, %s\n",
+        app.indirectDraws.vkCmdDrawIndexedIndirectCount ? "GPU draw count" : "CPU draw count",
+        app.indirectDraws.hasMultiDraw ? "multi draw" : "single draw per call",
+        app.indirectDraws.isOcclusionCulling ? "frustum and occlusion culling" : app.indirectDraws.isCulling ? "frustum culling" : "no culling",
+        app.indirectDraws.queryPool ? "timestamps" : "no timestamps"
+    );
+
+    ok( "CreateIndirectDrawResources" );
+    return VK_SUCCESS;
+}
+VkResult CreateComputePipeline( const char *path, const VkDescriptorSetLayout *setLayoutOverrides, VkPipeline *pPipeline, const CachedPipelineLayout **ppPipelineLayout ) {
+    uint32_t compProgramLength;
+    const uint8_t *compProgram = LoadAsset( path, &compProgramLength );
+    if ( compProgram == NULL ) {
+        fail( "CreateComputePipeline", "failed to load compute shader \"%s\"!\n", path );
+        return VK_ERROR_UNKNOWN;
+    }
+
+    ShaderReflection reflection;
+    if ( !ReflectShader( compProgram, compProgramLength, &reflection ) ) {
+        fail( "CreateComputePipeline", "failed to reflect compute shader \"%s\"!\n", path );
+        FreeAsset( compProgram );
+        return VK_ERROR_UNKNOWN;
+    }
+
+    VkShaderModule compShaderModule = CreateShaderModule( compProgram, compProgramLength );
+    FreeAsset( compProgram );
+    if ( compShaderModule == NULL ) {
+        fail( "CreateComputePipeline", "failed to create compute shader module!\n", NULL );
+        return VK_ERROR_UNKNOWN;
+    }
+
+    VkResult result = GetPipelineLayout( &app.layoutCache, app.vkDevice, &reflection, 1, setLayoutOverrides, ppPipelineLayout );
+    if ( result != VK_SUCCESS ) {
+        vkDestroyShaderModule( app.vkDevice, compShaderModule, NULL );
+        fail( "CreateComputePipeline", "failed to create compute pipeline layout.\nError code: %d\n", result );
+        return result;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .stage = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .pNext = NULL,
+            .flags = 0,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = compShaderModule,
+            .pName = "main",
+            .pSpecializationInfo = NULL
+        },
+        .layout = ( *ppPipelineLayout )->pipelineLayout,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = 0
+    };
+
+    result = vkCreateComputePipelines( app.vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, pPipeline );
+    vkDestroyShaderModule( app.vkDevice, compShaderModule, NULL );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateComputePipeline", "failed to create compute pipeline.\nError code: %d\n", result );
+        return result;
+    }
+
+    return VK_SUCCESS;
+}
+VkResult CreateRenderGraph() {
+    entry( "CreateRenderGraph" );
+
+    // Only the occlusion pyramid reads depth after the pass, otherwise it never leaves the attachment
+    bool isIndirectCulling = app.drawPath == DRAW_PATH_INDIRECT && !app.isCullingDisabled;
+    app.isDepthSampled = isIndirectCulling && !app.isOcclusionDisabled;
+
+    // Formats without stencil keep depth compression simple, sampling also needs sampled image support
+    const VkFormat CANDIDATES[] = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM };
+    const VkFormatFeatureFlags FEATURES = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT |
+        ( app.isDepthSampled ? VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT : 0 );
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    for ( uint32_t i = 0; i < sizeof( CANDIDATES ) / sizeof( CANDIDATES[ 0 ] ); i++ ) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties( app.vkPhysicalDevice, CANDIDATES[ i ], &properties );
+        if ( ( properties.optimalTilingFeatures & FEATURES ) == FEATURES ) {
+            format = CANDIDATES[ i ];
+            break;
+        }
+    }
+    if ( format == VK_FORMAT_UNDEFINED ) {
+        fail( "CreateRenderGraph", "no supported depth format!\n", NULL );
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+
+    // Sampled depth has to survive into the next frame, otherwise it is transient and may share memory
+    RenderGraph *graph = &app.renderGraph;
+    uint32_t width = app.swapChainExtent.width;
+    uint32_t height = app.swapChainExtent.height;
+    app.graphSwapChainImage = ImportRenderGraphImage( graph, "swap chain image", VK_IMAGE_ASPECT_COLOR_BIT, 1, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR );
+    app.graphDepthImage = AddRenderGraphImage(
+        graph, "depth", width, height, 1, format,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | ( app.isDepthSampled ? VK_IMAGE_USAGE_SAMPLED_BIT : VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT ),
+        VK_IMAGE_ASPECT_DEPTH_BIT,
+        app.isDepthSampled
+    );
+
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        app.graphDrawCommands = ImportRenderGraphBuffer( graph, "draw commands" );
+        app.graphDrawCount = ImportRenderGraphBuffer( graph, "draw count" );
+    }
+
+    // The culling set always binds the pyramid, only occlusion culling fills it from the previous frame's depth.
+    // Without culling the shader still declares it, a 1x1 pyramid fills the binding
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        uint32_t pyramidWidth = 1, pyramidHeight = 1, pyramidLevelLength = 1;
+        if ( isIndirectCulling ) GetDepthPyramidExtent( width, height, &pyramidWidth, &pyramidHeight, &pyramidLevelLength );
+        app.graphDepthPyramid = AddRenderGraphImage(
+            graph, "depth pyramid", pyramidWidth, pyramidHeight, pyramidLevelLength,
+            VK_FORMAT_R32_SFLOAT,
+            VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            false
+        );
+    }
+
+    if ( app.isDepthSampled ) {
+        uint32_t pass = AddRenderGraphPass( graph, "depth pyramid", RecordDepthPyramidPass, NULL );
+        UseRenderGraphResource( graph, pass, app.graphDepthImage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        UseRenderGraphResource( graph, pass, app.graphDepthPyramid, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL );
+    }
+
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        uint32_t pass = AddRenderGraphPass( graph, "draw commands", RecordDrawCommandPass, NULL );
+        UseRenderGraphResource( graph, pass, app.graphDrawCommands, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED );
+        UseRenderGraphResource(
+            graph, pass, app.graphDrawCount,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED
+        );
+        UseRenderGraphResource( graph, pass, app.graphDepthPyramid, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL );
+    }
+
+    uint32_t scenePass = AddRenderGraphPass( graph, "scene", RecordScenePass, NULL );
+    UseRenderGraphResource(
+        graph, scenePass, app.graphSwapChainImage,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+    );
+    UseRenderGraphResource(
+        graph, scenePass, app.graphDepthImage,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+    );
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        UseRenderGraphResource( graph, scenePass, app.graphDrawCommands, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED );
+        UseRenderGraphResource( graph, scenePass, app.graphDrawCount, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED );
+    }
+
+    VkResult result = CompileRenderGraph( graph, app.vkDevice, app.vkPhysicalDevice );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateRenderGraph", "failed to compile render graph.\nError code: %d\n", result );
+        return result;
+    }
+    app.depthImage = GetRenderGraphImage( graph, app.graphDepthImage );
+
+    printf( "Depth buffer: %ux%u, format %d, %s, %s\n",
+        app.depthImage->width,
+        app.depthImage->height,
+        format,
+        app.isDepthSampled ? "stored" : "transient",
+        app.isDepthPrepass ? "depth prepass" : "no depth prepass"
+    );
+
+    ok( "CreateRenderGraph" );
+    return VK_SUCCESS;
+}
 VkResult CreateRenderPass() {
     entry( "CreateRenderPass" );
 
+    if ( app.isDynamicRendering ) {
+        ok( "CreateRenderPass (dynamic rendering)" );
+        return VK_SUCCESS;
+    }
+
     VkAttachmentDescription colorAttachment = {
         .format = app.swapChainImageFormat,
         .samples = VK_SAMPLE_COUNT_1_BIT,
@@ -742,45 +1484,54 @@ VkResult CreateRenderPass() {
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
         .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
         .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+        .initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+    };
+
+    // Depth is only written back when the next frame builds its occlusion pyramid from it
+    VkAttachmentDescription depthAttachment = {
+        .format = app.depthImage->format,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = app.isDepthSampled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
     };
+    VkAttachmentDescription attachments[] = { colorAttachment, depthAttachment };
 
     VkAttachmentReference colorAttachmentRef = {
         .attachment = 0,
         .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
     };
 
+    VkAttachmentReference depthAttachmentRef = {
+        .attachment = 1,
+        .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+    };
+
     VkSubpassDescription subpass = {
         .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
         .colorAttachmentCount = 1,
         .pColorAttachments = &colorAttachmentRef,
         .pResolveAttachments = NULL,
-        .pDepthStencilAttachment = NULL,
+        .pDepthStencilAttachment = &depthAttachmentRef,
         .inputAttachmentCount = 0,
         .pInputAttachments = NULL,
         .preserveAttachmentCount = 0,
         .pPreserveAttachments = NULL
     };
 
-    VkSubpassDependency dependency = {
-        .srcSubpass = VK_SUBPASS_EXTERNAL,
-        .dstSubpass = 0,
-        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        .srcAccessMask = 0,
-        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
-    };
-
     VkRenderPassCreateInfo renderPassInfo = {
         .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
         .pNext = NULL,
-        .attachmentCount = 1,
-        .pAttachments = &colorAttachment,
+        .attachmentCount = 2,
+        .pAttachments = attachments,
         .subpassCount = 1,
         .pSubpasses = &subpass,
-        .dependencyCount = 1,
-        .pDependencies = &dependency
+        .dependencyCount = 0,
+        .pDependencies = NULL
     };
 
     VkResult result = vkCreateRenderPass(
@@ -800,16 +1551,22 @@ VkResult CreateRenderPass() {
 VkResult CreateFramebuffers() {
     entry( "CreateFramebuffers" );
 
+    // Dynamic rendering records against the image views directly, nothing to rebuild per swap chain image
+    if ( app.isDynamicRendering ) {
+        ok( "CreateFramebuffers (dynamic rendering)" );
+        return VK_SUCCESS;
+    }
+
     app.swapChainFramebuffers = calloc( app.swapChainImageLength, sizeof( VkFramebuffer ) );
 
     for ( uint32_t i = 0; i < app.swapChainImageLength; i++ ) {
-        VkImageView attachments[] = { app.swapChainImageViews[ i ] };
+        VkImageView attachments[] = { app.swapChainImageViews[ i ], app.depthImage->view };
 
         VkFramebufferCreateInfo framebufferInfo = {
             .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
             .pNext = NULL,
             .renderPass = app.renderPass,
-            .attachmentCount = 1,
+            .attachmentCount = 2,
             .pAttachments = attachments,
             .width = app.swapChainExtent.width,
             .height = app.swapChainExtent.height,
@@ -836,7 +1593,7 @@ VkResult CreateCommandPool() {
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .pNext = NULL,
         .queueFamilyIndex = queueFamilyIndices.graphicsFamily.value,
-        .flags = 0
+        .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
     };
 
     VkResult result = vkCreateCommandPool( app.vkDevice, &poolInfo, NULL, &app.commandPool );
@@ -851,14 +1608,13 @@ VkResult CreateCommandPool() {
 VkResult CreateCommandBuffers() {
     entry( "CreateCommandBuffers" );
 
-    app.commandBuffers = calloc( app.swapChainImageLength, sizeof( VkCommandBuffer ) );
-
+    // One command buffer per frame in flight, re-recorded every frame
     VkCommandBufferAllocateInfo allocInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         .pNext = NULL,
         .commandPool = app.commandPool,
         .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandBufferCount = ( uint32_t )app.swapChainImageLength
+        .commandBufferCount = MAX_FRAMES_IN_FLIGHT
     };
 
     VkResult result = vkAllocateCommandBuffers( app.vkDevice, &allocInfo, app.commandBuffers );
@@ -867,75 +1623,751 @@ VkResult CreateCommandBuffers() {
         return result;
     }
 
-    for ( int i = 0; i < app.swapChainImageLength; i++ ) {
-        VkCommandBufferBeginInfo beginInfo = {
-            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    ok( "CreateCommandBuffers" );
+    return VK_SUCCESS;
+}
+VkResult CreateSyncObjects() {
+    entry( "CreateSyncObjects" );
+
+    VkSemaphoreCreateInfo semaphoreInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = NULL
+    };
+
+    // Fences start signaled so the first wait on each frame returns immediately
+    VkFenceCreateInfo fenceInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    };
+
+    for ( uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++ ) {
+        VkResult result = vkCreateSemaphore( app.vkDevice, &semaphoreInfo, NULL, &app.imageAvailableSemaphores[ i ] );
+        if ( result != VK_SUCCESS ) {
+            fail( "CreateSyncObjects", "failed to create imageAvailable semaphore!\nError code: %d\n", result );
+            return result;
+        }
+
+        result = vkCreateSemaphore( app.vkDevice, &semaphoreInfo, NULL, &app.renderFinishedSemaphores[ i ] );
+        if ( result != VK_SUCCESS ) {
+            fail( "CreateSyncObjects", "failed to create renderFinished semaphore!\nError code: %d\n", result );
+            return result;
+        }
+
+        result = vkCreateFence( app.vkDevice, &fenceInfo, NULL, &app.inFlightFences[ i ] );
+        if ( result != VK_SUCCESS ) {
+            fail( "CreateSyncObjects", "failed to create inFlight fence!\nError code: %d\n", result );
+            return result;
+        }
+    }
+
+    app.imagesInFlight = calloc( app.swapChainImageLength, sizeof( VkFence ) );
+
+    ok( "CreateSyncObjects" );
+    return VK_SUCCESS;
+}
+VkResult CreateStagingBuffers() {
+    entry( "CreateStagingBuffers" );
+
+    // Every frame uploads the camera and one model matrix per object, padded when each is bound on its own
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties( app.vkPhysicalDevice, &properties );
+    VkDeviceSize objectSize = sizeof( mat4 );
+    if ( app.drawPath == DRAW_PATH_PUSH_CONSTANTS ) {
+        objectSize = 0;
+    } else if ( app.drawPath == DRAW_PATH_INSTANCED ) {
+        objectSize = sizeof( InstanceData );
+    } else if ( app.drawPath == DRAW_PATH_PER_OBJECT_SETS || app.drawPath == DRAW_PATH_DYNAMIC_UNIFORMS ) {
+        objectSize = max( objectSize, properties.limits.minUniformBufferOffsetAlignment );
+        objectSize = max( objectSize, properties.limits.minStorageBufferOffsetAlignment );
+    }
+    VkDeviceSize frameSize = STAGING_RING_FRAME_SIZE + ( VkDeviceSize )app.objectLength * objectSize;
+    VkResult result = CreateStagingRing(
+        &app.stagingRing,
+        app.vkDevice,
+        app.vkPhysicalDevice,
+        frameSize,
+        MAX_FRAMES_IN_FLIGHT
+    );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateStagingBuffers", "failed to create staging ring.\nError code: %d\n", result );
+        return result;
+    }
+
+    // Every frame region of the ring is its own bindless buffer, objects are addressed by their matrix index in it
+    if ( app.drawPath == DRAW_PATH_BINDLESS ) {
+        app.objectBufferRange = min( app.stagingRing.frameSize, properties.limits.maxStorageBufferRange );
+        for ( uint32_t i = 0; i < app.stagingRing.frameLength; i++ ) {
+            app.objectBufferIndices[ i ] = RegisterBindlessBuffer(
+                &app.bindlessHeap,
+                app.vkDevice,
+                app.stagingRing.buffer.buffer,
+                ( VkDeviceSize )i * app.stagingRing.frameSize,
+                app.objectBufferRange
+            );
+            if ( app.objectBufferIndices[ i ] == BINDLESS_INVALID_INDEX ) {
+                fail( "CreateStagingBuffers", "bindless heap is full!\n", NULL );
+                return VK_ERROR_OUT_OF_POOL_MEMORY;
+            }
+        }
+    } else if ( app.drawPath == DRAW_PATH_PER_OBJECT_SETS ) {
+        app.objectDescriptorSets = calloc( app.objectLength, sizeof( VkDescriptorSet ) );
+    }
+
+    ok( "CreateStagingBuffers" );
+    return VK_SUCCESS;
+}
+VkResult CreateDescriptorAllocator() {
+    entry( "CreateDescriptorAllocator" );
+
+    if ( app.descriptorSetLayout == VK_NULL_HANDLE ) {
+        fail( "CreateDescriptorAllocator", "pipeline has no descriptor set layout!\n", NULL );
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    InitDescriptorAllocator( &app.descriptorAllocator, MAX_FRAMES_IN_FLIGHT );
+
+    // The dynamic draw data set covers one DrawData, draws move it over the ring with their offset
+    if ( app.drawPath == DRAW_PATH_DYNAMIC_UNIFORMS ) {
+        VkDescriptorBufferInfo bufferInfo = { app.stagingRing.buffer.buffer, 0, sizeof( DrawData ) };
+        VkWriteDescriptorSet write = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .pNext = NULL,
-            .flags = 0,
-            .pInheritanceInfo = NULL
+            .dstSet = VK_NULL_HANDLE,
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            .pImageInfo = NULL,
+            .pBufferInfo = &bufferInfo,
+            .pTexelBufferView = NULL
         };
 
-        result = vkBeginCommandBuffer( app.commandBuffers[ i ], &beginInfo );
+        VkResult result = GetStaticDescriptorSet(
+            &app.descriptorAllocator,
+            app.vkDevice,
+            app.drawDataSetLayout,
+            &write, 1,
+            &app.drawDataSet
+        );
         if ( result != VK_SUCCESS ) {
-            fail( "CreateCommandBuffers", "failed to begin command buffer.\nError code: %d\n", result );
+            fail( "CreateDescriptorAllocator", "failed to create draw data set.\nError code: %d\n", result );
             return result;
         }
+        app.drawDataOffsets = calloc( app.objectLength, sizeof( uint32_t ) );
+    }
 
-        VkClearValue clearColor = {{{ 0.0f, 0.0f, 0.0f, 1.0f }}};
+    // Draw command buffers never move, each frame's compute set is created once.
+    // The camera follows the ring through its dynamic offset and the pyramid is read in GENERAL layout
+    VkDescriptorImageInfo pyramidInfo = { app.depthPyramid.sampler, app.depthPyramid.image.view, VK_IMAGE_LAYOUT_GENERAL };
+    for ( uint32_t i = 0; i < app.indirectDraws.frameLength; i++ ) {
+        IndirectDrawFrame *drawFrame = &app.indirectDraws.frames[ i ];
+        VkDescriptorBufferInfo bufferInfos[] = {
+            { drawFrame->count.buffer, 0, VK_WHOLE_SIZE },
+            { drawFrame->commands.buffer, 0, VK_WHOLE_SIZE },
+            { drawFrame->bounds.buffer, 0, VK_WHOLE_SIZE },
+            { app.stagingRing.buffer.buffer, 0, sizeof( CameraUniforms ) }
+        };
+        const uint32_t BINDINGS[] = {
+            INDIRECT_DRAWS_COUNT_BINDING,
+            INDIRECT_DRAWS_COMMAND_BINDING,
+            INDIRECT_DRAWS_BOUNDS_BINDING,
+            INDIRECT_DRAWS_CAMERA_BINDING,
+            INDIRECT_DRAWS_PYRAMID_BINDING
+        };
+        const VkDescriptorType TYPES[] = {
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+        };
 
-        VkRenderPassBeginInfo renderPassInfo = {
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = NULL,
-            .renderPass = app.renderPass,
-            .framebuffer = app.swapChainFramebuffers[ i ],
-            .renderArea = {
-                .offset = { 0, 0 },
-                .extent = app.swapChainExtent
+        // Every binding is written even without culling, the shader declares all of them
+        VkWriteDescriptorSet writes[ 5 ];
+        for ( uint32_t w = 0; w < 5; w++ ) {
+            bool isImage = TYPES[ w ] == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            VkWriteDescriptorSet write = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = NULL,
+                .dstSet = VK_NULL_HANDLE,
+                .dstBinding = BINDINGS[ w ],
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = TYPES[ w ],
+                .pImageInfo = isImage ? &pyramidInfo : NULL,
+                .pBufferInfo = isImage ? NULL : &bufferInfos[ w ],
+                .pTexelBufferView = NULL
+            };
+            writes[ w ] = write;
+        }
+
+        VkResult result = GetStaticDescriptorSet(
+            &app.descriptorAllocator,
+            app.vkDevice,
+            app.indirectDraws.setLayout,
+            writes, 5,
+            &drawFrame->set
+        );
+        if ( result != VK_SUCCESS ) {
+            fail( "CreateDescriptorAllocator", "failed to create draw command set.\nError code: %d\n", result );
+            return result;
+        }
+    }
+
+    // Each pyramid level reads the one above it, the first reads the depth buffer itself
+    uint32_t pyramidSetLength = app.indirectDraws.isOcclusionCulling ? app.depthPyramid.image.levelLength : 0;
+    for ( uint32_t i = 0; i < pyramidSetLength; i++ ) {
+        VkDescriptorImageInfo imageInfos[] = {
+            {
+                app.depthPyramid.sampler,
+                i == 0 ? app.depthImage->view : app.depthPyramid.levelViews[ i - 1 ],
+                i == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL
             },
-            .clearValueCount = 1,
-            .pClearValues = &clearColor
+            { VK_NULL_HANDLE, app.depthPyramid.levelViews[ i ], VK_IMAGE_LAYOUT_GENERAL }
+        };
+        VkWriteDescriptorSet writes[] = {
+            {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = NULL,
+                .dstSet = VK_NULL_HANDLE,
+                .dstBinding = DEPTH_PYRAMID_INPUT_BINDING,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .pImageInfo = &imageInfos[ 0 ],
+                .pBufferInfo = NULL,
+                .pTexelBufferView = NULL
+            },
+            {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = NULL,
+                .dstSet = VK_NULL_HANDLE,
+                .dstBinding = DEPTH_PYRAMID_OUTPUT_BINDING,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .pImageInfo = &imageInfos[ 1 ],
+                .pBufferInfo = NULL,
+                .pTexelBufferView = NULL
+            }
         };
 
-        vkCmdBeginRenderPass( app.commandBuffers[ i ], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE );
-        vkCmdBindPipeline( app.commandBuffers[ i ], VK_PIPELINE_BIND_POINT_GRAPHICS, app.graphicsPipeline );
-        vkCmdDraw( app.commandBuffers[ i ], 3, 1, 0, 0 );
-        vkCmdEndRenderPass( app.commandBuffers[ i ] );
-
-        result = vkEndCommandBuffer( app.commandBuffers[ i ] );
+        VkResult result = GetStaticDescriptorSet(
+            &app.descriptorAllocator,
+            app.vkDevice,
+            app.depthPyramid.setLayout,
+            writes, 2,
+            &app.depthPyramid.sets[ i ]
+        );
         if ( result != VK_SUCCESS ) {
-            fail( "CreateCommandBuffers", "failed to end up command buffer.\nError code: %d\n", result );
+            fail( "CreateDescriptorAllocator", "failed to create depth pyramid set.\nError code: %d\n", result );
             return result;
         }
     }
 
-    ok( "CreateCommandBuffers" );
+    ok( "CreateDescriptorAllocator" );
     return VK_SUCCESS;
 }
-VkResult CreateSemaphores() {
-    entry( "CreateSemaphores" );
+VkResult CreateStatisticsQueries() {
+    entry( "CreateStatisticsQueries" );
 
-    VkSemaphoreCreateInfo semaphoreInfo = {
-        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
-        .pNext = NULL
+    if ( !app.hasPipelineStatistics ) {
+        ok( "CreateStatisticsQueries (not supported)" );
+        return VK_SUCCESS;
+    }
+
+    VkQueryPoolCreateInfo queryPoolInfo = {
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+        .queryCount = MAX_FRAMES_IN_FLIGHT,
+        .pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
     };
 
-    VkResult result = vkCreateSemaphore( app.vkDevice, &semaphoreInfo, NULL, &app.imageAvailableSemaphore );
+    VkResult result = vkCreateQueryPool( app.vkDevice, &queryPoolInfo, NULL, &app.statisticsQueryPool );
+    if ( result != VK_SUCCESS ) {
+        fail( "CreateStatisticsQueries", "failed to create statistics query pool.\nError code: %d\n", result );
+        return result;
+    }
+
+    ok( "CreateStatisticsQueries" );
+    return VK_SUCCESS;
+}
+VkResult UpdateUniforms( uint32_t frame ) {
+    StagingAllocation cameraAllocation;
+    if ( !AllocateStaging( &app.stagingRing, sizeof( CameraUniforms ), sizeof( mat4 ), &cameraAllocation ) ) {
+        fail( "UpdateUniforms", "staging ring is out of memory!\n", NULL );
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    // Matrices are written straight into the mapped ring, the upload is the store itself
+    CameraUniforms *camera = cameraAllocation.data;
+    float distance = 2.0f + 2.0f * app.sceneRadius;
+    float aspect = ( float )app.swapChainExtent.width / ( float )app.swapChainExtent.height;
+    vec3 eye = { 0.0f, 0.0f, distance };
+    vec3 center = { 0.0f, 0.0f, 0.0f };
+    vec3 up = { 0.0f, 1.0f, 0.0f };
+
+    glm_lookat( eye, center, up, camera->view );
+    glm_perspective( glm_rad( 45.0f ), aspect, 0.1f, ( distance + app.sceneDepth ) * 2.0f, camera->proj );
+    camera->proj[ 1 ][ 1 ] *= -1.0f; // Vulkan clip space has Y pointing down
+    glm_mat4_mul( camera->proj, camera->view, camera->viewProj );
+
+    // cglm builds an OpenGL style near plane, with 0..1 depth it only keeps a little extra behind the camera
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) glm_frustum_planes( camera->viewProj, camera->frustumPlanes );
+    app.cameraOffset = cameraAllocation.offset;
+
+    VkDescriptorBufferInfo cameraInfo = { cameraAllocation.buffer, cameraAllocation.offset, cameraAllocation.size };
+    VkWriteDescriptorSet writes[ 2 ] = {
+        {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext = NULL,
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            .pImageInfo = NULL,
+            .pBufferInfo = &cameraInfo,
+            .pTexelBufferView = NULL
+        },
+        {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext = NULL,
+            .dstBinding = 1,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pImageInfo = NULL,
+            .pBufferInfo = NULL,
+            .pTexelBufferView = NULL
+        }
+    };
+
+    float time = ( float )glfwGetTime();
+    app.sceneTime = time;
+
+    if ( app.drawPath == DRAW_PATH_PER_OBJECT_SETS ) {
+        // Slow baseline, every object gets its own uniform range and descriptor set
+        for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+            StagingAllocation objectAllocation;
+            if ( !AllocateStaging( &app.stagingRing, sizeof( mat4 ), sizeof( mat4 ), &objectAllocation ) ) {
+                fail( "UpdateUniforms", "staging ring is out of memory!\n", NULL );
+                return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+            }
+            ComputeObjectModel( i, time, objectAllocation.data );
+
+            VkResult result = AllocateDescriptorSet( &app.descriptorAllocator, app.vkDevice, app.descriptorSetLayout, &app.objectDescriptorSets[ i ] );
+            if ( result != VK_SUCCESS ) {
+                fail( "UpdateUniforms", "failed to allocate object descriptor set.\nError code: %d\n", result );
+                return result;
+            }
+
+            VkDescriptorBufferInfo objectInfo = { objectAllocation.buffer, objectAllocation.offset, objectAllocation.size };
+            writes[ 0 ].dstSet = app.objectDescriptorSets[ i ];
+            writes[ 1 ].dstSet = app.objectDescriptorSets[ i ];
+            writes[ 1 ].pBufferInfo = &objectInfo;
+            vkUpdateDescriptorSets( app.vkDevice, 2, writes, 0, NULL );
+        }
+
+        return VK_SUCCESS;
+    }
+
+    // The other paths share one camera set per frame and never update descriptors per draw
+    VkResult result = AllocateDescriptorSet( &app.descriptorAllocator, app.vkDevice, app.descriptorSetLayout, &app.descriptorSets[ frame ] );
+    if ( result != VK_SUCCESS ) {
+        fail( "UpdateUniforms", "failed to allocate frame descriptor set.\nError code: %d\n", result );
+        return result;
+    }
+    writes[ 0 ].dstSet = app.descriptorSets[ frame ];
+    vkUpdateDescriptorSets( app.vkDevice, 1, writes, 0, NULL );
+
+    if ( app.drawPath == DRAW_PATH_BOUND_SETS || app.drawPath == DRAW_PATH_BINDLESS || app.drawPath == DRAW_PATH_INDIRECT ) {
+        // Models are packed in the ring, draws find theirs by matrix index
+        StagingAllocation objectAllocation;
+        if ( !AllocateStaging( &app.stagingRing, app.objectLength * sizeof( mat4 ), sizeof( mat4 ), &objectAllocation ) ) {
+            fail( "UpdateUniforms", "staging ring is out of memory!\n", NULL );
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+
+        mat4 *models = objectAllocation.data;
+        if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+            ComputeCulledObjectModels( time, models, app.indirectDraws.frames[ frame ].bounds.mapped );
+        } else {
+            for ( uint32_t i = 0; i < app.objectLength; i++ ) ComputeObjectModel( i, time, models[ i ] );
+        }
+
+        if ( app.drawPath == DRAW_PATH_BINDLESS ) {
+            // The shader only sees the frame's registered region, matrices past it would be read out of bounds
+            uint32_t ringFrame = app.stagingRing.frameIndex;
+            VkDeviceSize regionOffset = objectAllocation.offset - ( VkDeviceSize )ringFrame * app.stagingRing.frameSize;
+            if ( regionOffset + objectAllocation.size > app.objectBufferRange ) {
+                fail( "UpdateUniforms", "object matrices do not fit the registered bindless range!\n", NULL );
+                return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+            }
+            app.objectBufferIndex = app.objectBufferIndices[ ringFrame ];
+            app.objectBaseIndex = ( uint32_t )( regionOffset / sizeof( mat4 ) );
+        } else {
+            // Bound sets index the frame's model range with the instance index, indirect draws with the firstInstance the compute pass wrote
+            VkDescriptorBufferInfo objectInfo = { objectAllocation.buffer, objectAllocation.offset, objectAllocation.size };
+            writes[ 1 ].dstSet = app.descriptorSets[ frame ];
+            writes[ 1 ].pBufferInfo = &objectInfo;
+            vkUpdateDescriptorSets( app.vkDevice, 1, &writes[ 1 ], 0, NULL );
+        }
+    } else if ( app.drawPath == DRAW_PATH_INSTANCED ) {
+        // The whole instance stream is written straight into the ring and read as a vertex buffer
+        StagingAllocation instanceAllocation;
+        if ( !AllocateStaging( &app.stagingRing, app.objectLength * sizeof( InstanceData ), sizeof( vec4 ), &instanceAllocation ) ) {
+            fail( "UpdateUniforms", "staging ring is out of memory!\n", NULL );
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+
+        InstanceData *instances = instanceAllocation.data;
+        for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+            ComputeObjectModel( i, time, instances[ i ].model );
+            glm_vec4_copy( app.objectColors[ i ], instances[ i ].color );
+        }
+        app.instanceOffset = instanceAllocation.offset;
+    }
+
+    // Push constant and dynamic uniform draw data is produced while recording
+    return VK_SUCCESS;
+}
+void ComputeObjectModel( uint32_t objectIndex, float time, mat4 model ) {
+    glm_translate_make( model, app.objects[ objectIndex ] );
+    glm_rotate_z( model, time + app.objects[ objectIndex ][ 3 ], model );
+}
+void ComputeCulledObjectModels( float time, mat4 *models, vec4 *bounds ) {
+    // The ring is write-combined device memory, so each batch is built and bounded in cached memory and then copied over
+    mat4 batch[ OBJECT_MODEL_BATCH ];
+    for ( uint32_t first = 0; first < app.objectLength; first += OBJECT_MODEL_BATCH ) {
+        uint32_t batchLength = min( app.objectLength - first, OBJECT_MODEL_BATCH );
+        for ( uint32_t i = 0; i < batchLength; i++ ) ComputeObjectModel( first + i, time, batch[ i ] );
+
+        glmd_sphere_transform_array( &app.objectLocalBounds[ first ], batch, batchLength, &bounds[ first ] );
+        memcpy( &models[ first ], batch, batchLength * sizeof( mat4 ) );
+    }
+}
+VkResult RecordCommandBuffer( VkCommandBuffer commandBuffer, uint32_t imageIndex ) {
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = NULL,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .pInheritanceInfo = NULL
+    };
+
+    VkResult result = vkBeginCommandBuffer( commandBuffer, &beginInfo );
+    if ( result != VK_SUCCESS ) {
+        fail( "RecordCommandBuffer", "failed to begin command buffer.\nError code: %d\n", result );
+        return result;
+    }
+
+    // The acquired image holds nothing worth keeping, its first use waits on the acquire semaphore's stage
+    RenderGraphState acquiredState = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED };
+    BindRenderGraphImage( &app.renderGraph, app.graphSwapChainImage, app.swapChainImages[ imageIndex ], &acquiredState );
+    if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        BindRenderGraphBuffer( &app.renderGraph, app.graphDrawCommands, app.indirectDraws.frames[ app.currentFrame ].commands.buffer );
+        BindRenderGraphBuffer( &app.renderGraph, app.graphDrawCount, app.indirectDraws.frames[ app.currentFrame ].count.buffer );
+    }
+    app.imageIndex = imageIndex;
+
+    result = ExecuteRenderGraph( &app.renderGraph, commandBuffer );
     if ( result != VK_SUCCESS ) {
-        fail( "CreateSemaphores", "failed to create imageAvailable semaphore!\nError code: %d\n", result );
+        vkEndCommandBuffer( commandBuffer );
         return result;
     }
+    app.hasDepthHistory = true;
+    app.stats.barrierLength += app.renderGraph.barrierLength;
+    app.stats.skippedBarrierLength += app.renderGraph.skippedBarrierLength;
 
-    result = vkCreateSemaphore( app.vkDevice, &semaphoreInfo, NULL, &app.renderFinishedSemaphore );
+    result = vkEndCommandBuffer( commandBuffer );
     if ( result != VK_SUCCESS ) {
-        fail( "CreateSemaphores", "failed to create renderFinished semaphore!\nError code: %d\n", result );
+        fail( "RecordCommandBuffer", "failed to end up command buffer.\nError code: %d\n", result );
         return result;
     }
 
-    ok( "CreateSemaphores" );
+    return VK_SUCCESS;
+}
+VkResult RecordDepthPyramidPass( VkCommandBuffer commandBuffer, void *userData ) {
+    // The first frame has no depth to reduce yet
+    if ( app.hasDepthHistory ) RecordDepthPyramid( &app.depthPyramid, commandBuffer );
+    return VK_SUCCESS;
+}
+VkResult RecordDrawCommandPass( VkCommandBuffer commandBuffer, void *userData ) {
+    const DepthPyramid *pyramid = app.indirectDraws.isOcclusionCulling && app.hasDepthHistory ? &app.depthPyramid : NULL;
+    RecordDrawCommandGeneration( &app.indirectDraws, commandBuffer, app.currentFrame, app.objectLength, ( uint32_t )app.cameraOffset, pyramid );
+    return VK_SUCCESS;
+}
+VkResult RecordScenePass( VkCommandBuffer commandBuffer, void *userData ) {
+    VkClearValue clearValues[] = {
+        { .color = {{ 0.0f, 0.0f, 0.0f, 1.0f }} },
+        { .depthStencil = { 1.0f, 0 } }
+    };
+    VkRect2D renderArea = { { 0, 0 }, app.swapChainExtent };
+
+    // Counts every fragment shader invocation of the pass, prepass draws have no fragment stage
+    if ( app.statisticsQueryPool ) {
+        vkCmdResetQueryPool( commandBuffer, app.statisticsQueryPool, app.currentFrame, 1 );
+        vkCmdBeginQuery( commandBuffer, app.statisticsQueryPool, app.currentFrame, 0 );
+        app.isStatisticsPending[ app.currentFrame ] = true;
+    }
+
+    if ( app.isDynamicRendering ) {
+        // The render graph has already moved both attachments into their attachment layouts
+        VkRenderingAttachmentInfoKHR colorAttachment = {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+            .pNext = NULL,
+            .imageView = app.swapChainImageViews[ app.imageIndex ],
+            .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .resolveMode = VK_RESOLVE_MODE_NONE,
+            .resolveImageView = VK_NULL_HANDLE,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .clearValue = clearValues[ 0 ]
+        };
+        VkRenderingAttachmentInfoKHR depthAttachment = {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+            .pNext = NULL,
+            .imageView = app.depthImage->view,
+            .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            .resolveMode = VK_RESOLVE_MODE_NONE,
+            .resolveImageView = VK_NULL_HANDLE,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .storeOp = app.isDepthSampled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .clearValue = clearValues[ 1 ]
+        };
+        VkRenderingInfoKHR renderingInfo = {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+            .pNext = NULL,
+            .flags = 0,
+            .renderArea = renderArea,
+            .layerCount = 1,
+            .viewMask = 0,
+            .colorAttachmentCount = 1,
+            .pColorAttachments = &colorAttachment,
+            .pDepthAttachment = &depthAttachment,
+            .pStencilAttachment = NULL
+        };
+        app.vkCmdBeginRenderingKHR( commandBuffer, &renderingInfo );
+    } else {
+        // Framebuffers only exist without dynamic rendering
+        VkRenderPassBeginInfo renderPassInfo = {
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .pNext = NULL,
+            .renderPass = app.renderPass,
+            .framebuffer = app.swapChainFramebuffers[ app.imageIndex ],
+            .renderArea = renderArea,
+            .clearValueCount = 2,
+            .pClearValues = clearValues
+        };
+        vkCmdBeginRenderPass( commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE );
+    }
+    app.drawCallLength = 0;
+
+    VkResult result = VK_SUCCESS;
+    if ( app.isDepthPrepass ) {
+        vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, app.depthPrepassPipeline );
+        result = RecordSceneDraws( commandBuffer, true );
+    }
+    if ( result == VK_SUCCESS ) {
+        vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, app.graphicsPipeline );
+        result = RecordSceneDraws( commandBuffer, false );
+    }
+
+    if ( app.isDynamicRendering ) {
+        app.vkCmdEndRenderingKHR( commandBuffer );
+    } else {
+        vkCmdEndRenderPass( commandBuffer );
+    }
+    if ( app.statisticsQueryPool ) vkCmdEndQuery( commandBuffer, app.statisticsQueryPool, app.currentFrame );
+    return result;
+}
+VkResult RecordSceneDraws( VkCommandBuffer commandBuffer, bool isDepthPrepass ) {
+    uint32_t drawCallLength = app.objectLength;
+
+    if ( app.drawPath == DRAW_PATH_BOUND_SETS ) {
+        // The frame set holds every model, one instanced draw covers the scene
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            app.pipelineLayout,
+            0, 1, &app.descriptorSets[ app.currentFrame ],
+            0, NULL
+        );
+        vkCmdDraw( commandBuffer, 3, app.objectLength, 0, 0 );
+        drawCallLength = 1;
+    } else if ( app.drawPath == DRAW_PATH_PER_OBJECT_SETS ) {
+        for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+            vkCmdBindDescriptorSets(
+                commandBuffer,
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                app.pipelineLayout,
+                0, 1, &app.objectDescriptorSets[ i ],
+                0, NULL
+            );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+        }
+    } else if ( app.drawPath == DRAW_PATH_BINDLESS ) {
+        // Both sets and the frame's buffer index are bound once, a draw only changes its 4 byte object index
+        VkDescriptorSet descriptorSets[] = { app.descriptorSets[ app.currentFrame ], app.bindlessHeap.set };
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            app.pipelineLayout,
+            0, 2, descriptorSets,
+            0, NULL
+        );
+        vkCmdPushConstants( commandBuffer, app.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof( uint32_t ), &app.objectBufferIndex );
+        for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+            uint32_t objectIndex = app.objectBaseIndex + i;
+            vkCmdPushConstants( commandBuffer, app.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof( uint32_t ), sizeof( uint32_t ), &objectIndex );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+        }
+    } else if ( app.drawPath == DRAW_PATH_INSTANCED ) {
+        // One draw for the whole scene, the instance binding steps through the ring once per copy
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            app.pipelineLayout,
+            0, 1, &app.descriptorSets[ app.currentFrame ],
+            0, NULL
+        );
+        vkCmdBindVertexBuffers( commandBuffer, VERTEX_BINDING_PER_INSTANCE, 1, &app.stagingRing.buffer.buffer, &app.instanceOffset );
+        vkCmdDraw( commandBuffer, 3, app.objectLength, 0, 0 );
+        drawCallLength = 1;
+    } else if ( app.drawPath == DRAW_PATH_INDIRECT ) {
+        // Recording cost no longer depends on the object count, the compute pass wrote every draw
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            app.pipelineLayout,
+            0, 1, &app.descriptorSets[ app.currentFrame ],
+            0, NULL
+        );
+        drawCallLength = RecordIndirectDraws( &app.indirectDraws, commandBuffer, app.currentFrame, app.objectLength );
+    } else {
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            app.pipelineLayout,
+            0, 1, &app.descriptorSets[ app.currentFrame ],
+            0, NULL
+        );
+        for ( uint32_t i = 0; i < app.objectLength; i++ ) {
+            DrawData drawData;
+            ComputeObjectModel( i, app.sceneTime, drawData.model );
+
+            if ( app.drawPath == DRAW_PATH_PUSH_CONSTANTS ) {
+                vkCmdPushConstants( commandBuffer, app.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof( DrawData ), &drawData );
+            } else {
+                // The color pass reuses the draw data the prepass already pushed
+                if ( isDepthPrepass || !app.isDepthPrepass ) {
+                    StagingAllocation drawAllocation;
+                    if ( !PushStaging( &app.stagingRing, &drawData, sizeof( DrawData ), 0, &drawAllocation ) ) {
+                        fail( "RecordSceneDraws", "staging ring is out of memory!\n", NULL );
+                        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+                    }
+                    app.drawDataOffsets[ i ] = ( uint32_t )drawAllocation.offset;
+                }
+                vkCmdBindDescriptorSets(
+                    commandBuffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    app.pipelineLayout,
+                    1, 1, &app.drawDataSet,
+                    1, &app.drawDataOffsets[ i ]
+                );
+            }
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+        }
+    }
+
+    app.drawCallLength += drawCallLength;
     return VK_SUCCESS;
 }
 
 /* METHODS */
+void UpdateStats( double now ) {
+    app.stats.frameLength++;
+    app.stats.reportFrameLength++;
+    app.stats.frameTime += now - app.stats.lastFrameTime;
+    app.stats.lastFrameTime = now;
+
+    if ( now - app.stats.reportTime < STATS_REPORT_INTERVAL ) return;
+
+    double frames = ( double )app.stats.reportFrameLength;
+    const DescriptorStats *descriptors = &app.descriptorAllocator.stats;
+    const char *DRAW_PATH_NAMES[] = { "bound sets", "bindless", "push constants", "dynamic uniforms", "instanced", "indirect", "per-object sets" };
+    double fps = frames / ( now - app.stats.reportTime );
+    printf( "[Stats] %u objects (%s), %.1f fps, %.2fM instances/s, %u draw calls, frame %.3f ms, matrix update + upload %.3f ms, record %.3f ms, staging %llu/%llu bytes\n",
+        app.objectLength,
+        DRAW_PATH_NAMES[ app.drawPath ],
+        fps,
+        fps * ( double )app.objectLength / 1e6,
+        app.drawCallLength,
+        1000.0 * app.stats.frameTime / frames,
+        1000.0 * app.stats.updateTime / frames,
+        1000.0 * app.stats.recordTime / frames,
+        ( unsigned long long )app.stagingRing.frameUsed,
+        ( unsigned long long )app.stagingRing.frameSize
+    );
+    printf( "[Stats] descriptors: %.1f sets/frame, %u pools, %llu resets, static cache %llu hits / %llu misses\n",
+        ( double )( descriptors->allocationLength - app.stats.reportDescriptorAllocations ) / frames,
+        descriptors->poolLength,
+        ( unsigned long long )descriptors->resetLength,
+        ( unsigned long long )descriptors->cacheHitLength,
+        ( unsigned long long )descriptors->cacheMissLength
+    );
+    printf( "[Stats] render graph: %u passes (%u culled), %.1f barriers / %.1f skipped per frame, transient memory %llu KiB in %llu KiB\n",
+        app.renderGraph.passLength - app.renderGraph.culledPassLength,
+        app.renderGraph.culledPassLength,
+        ( double )app.stats.barrierLength / frames,
+        ( double )app.stats.skippedBarrierLength / frames,
+        ( unsigned long long )( app.renderGraph.requestedMemorySize / 1024 ),
+        ( unsigned long long )( app.renderGraph.allocatedMemorySize / 1024 )
+    );
+
+    if ( app.stats.cullSampleLength ) {
+        double samples = ( double )app.stats.cullSampleLength;
+        double occluded = ( double )app.stats.occludedLength / samples;
+        printf( "[Stats] culling: %.0f visible / %.0f culled / %.0f occluded (%.1f%%) per frame, draw generation %.3f ms\n",
+            ( double )app.stats.visibleLength / samples,
+            ( double )app.stats.culledLength / samples,
+            occluded,
+            100.0 * occluded / ( double )app.objectLength,
+            app.stats.cullTimeSampleLength ? app.stats.cullTime / ( double )app.stats.cullTimeSampleLength : 0.0
+        );
+    }
+
+    if ( app.stats.fragmentSampleLength ) {
+        double fragments = ( double )app.stats.fragmentInvocationLength / ( double )app.stats.fragmentSampleLength;
+        double pixels = ( double )app.swapChainExtent.width * ( double )app.swapChainExtent.height;
+        printf( "[Stats] fragments: %.0f shaded per frame, %.2f per pixel, %s\n",
+            fragments,
+            fragments / pixels,
+            app.isDepthPrepass ? "depth prepass" : "no depth prepass"
+        );
+    }
+
+    app.stats.reportTime = now;
+    app.stats.reportFrameLength = 0;
+    app.stats.frameTime = 0.0;
+    app.stats.updateTime = 0.0;
+    app.stats.recordTime = 0.0;
+    app.stats.reportDescriptorAllocations = descriptors->allocationLength;
+    app.stats.visibleLength = 0;
+    app.stats.culledLength = 0;
+    app.stats.occludedLength = 0;
+    app.stats.cullSampleLength = 0;
+    app.stats.fragmentInvocationLength = 0;
+    app.stats.barrierLength = 0;
+    app.stats.skippedBarrierLength = 0;
+    app.stats.fragmentSampleLength = 0;
+    app.stats.cullTime = 0.0;
+    app.stats.cullTimeSampleLength = 0;
+}
 void ClearFeatures( VkPhysicalDeviceFeatures *pFeatures ) {
     method( "ClearFeatures" );
 
@@ -977,49 +2409,56 @@ void GetDriverVersion( char *output_str, uint32_t vendor_id, uint32_t driver_ver
     );
     ok_method( "GetDriverVersion" );
 }
-bool IsDeviceSuitable( VkPhysicalDevice device ) {
-    method( "IsDeviceSuitable" );
+// 0 when the device can not run the app, otherwise higher for device types that are usually faster
+uint32_t RateDeviceSuitability( VkPhysicalDevice device ) {
+    method( "RateDeviceSuitability" );
 
-    bool isSupported = false;
     bool isExtensionsSupported = CheckDeviceExtensionSupport( device );
     bool isSwapChainAdequate = false;
 
     QueueFamilyIndices indices = FindQueueFamilies( device );
     VkPhysicalDeviceProperties deviceProperties;
-    VkPhysicalDeviceFeatures deviceFeatures;
     vkGetPhysicalDeviceProperties( device, &deviceProperties );
-    vkGetPhysicalDeviceFeatures( device, &deviceFeatures );
 
     if ( isExtensionsSupported ) {
         SwapChainSupportDetails details = QuerySwapChainSupport( device );
         isSwapChainAdequate = details.formatsLength != 0 && details.presentModesLength != 0;
     }
 
-    isSupported = (
-        deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && deviceFeatures.geometryShader &&
+    bool isSupported = (
         !indices.error && indices.graphicsFamily.isSet && indices.presentationFamily.isSet &&
         isExtensionsSupported &&
         isSwapChainAdequate
     );
 
+    const char *typeName = "Other";
+    uint32_t score = 1;
+    switch ( deviceProperties.deviceType ) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: typeName = "Discrete GPU"; score = 4; break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: typeName = "Integrated GPU"; score = 3; break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: typeName = "Virtual GPU"; score = 2; break;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: typeName = "CPU"; score = 1; break;
+        default: break;
+    }
+    if ( !isSupported ) score = 0;
+
     char driverVersion[ 64 ];
     GetDriverVersion( driverVersion, deviceProperties.vendorID, deviceProperties.driverVersion );
     printf( 
         "%s\n"
         "\t%s (Device ID: %u) (Driver version: %s)\n"
-        "\tDiscrete: %s\n"
-        "\tGeometry Shader support: %s\n",
+        "\tType: %s (score %u)\n",
         isSupported ? "[ OK ]" : "[ ERROR ]",
         deviceProperties.deviceName,
         deviceProperties.deviceID,
         driverVersion,
-        deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU ? "Yes" : "No",
-        deviceFeatures.geometryShader ? "Yes" : "No"
+        typeName,
+        score
     );
 
-    ok_method( "IsDeviceSuitable" );
+    ok_method( "RateDeviceSuitability" );
 
-    return isSupported;
+    return score;
 }
 bool CheckDeviceExtensionSupport( VkPhysicalDevice device ) {
     method( "CheckDeviceExtensionSupport" );
@@ -1048,6 +2487,116 @@ bool CheckDeviceExtensionSupport( VkPhysicalDevice device ) {
     fail_method( "CheckDeviceExtensionSupport", "your gpu not supported required extensions!\n", NULL );
     return false;
 }
+bool IsDeviceExtensionSupported( VkPhysicalDevice device, const char *extensionName ) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties( device, NULL, &extensionCount, NULL );
+    VkExtensionProperties availableExtensions[ extensionCount ];
+    vkEnumerateDeviceExtensionProperties( device, NULL, &extensionCount, availableExtensions );
+
+    for ( uint32_t i = 0; i < extensionCount; i++ ) {
+        if ( strcmp( availableExtensions[ i ].extensionName, extensionName ) == 0 ) return true;
+    }
+
+    return false;
+}
+bool IsInstanceExtensionSupported( const char *extensionName ) {
+    uint32_t extensionCount;
+    vkEnumerateInstanceExtensionProperties( NULL, &extensionCount, NULL );
+    VkExtensionProperties availableExtensions[ extensionCount ];
+    vkEnumerateInstanceExtensionProperties( NULL, &extensionCount, availableExtensions );
+
+    for ( uint32_t i = 0; i < extensionCount; i++ ) {
+        if ( strcmp( availableExtensions[ i ].extensionName, extensionName ) == 0 ) return true;
+    }
+
+    return false;
+}
+bool CheckBindlessSupport( VkPhysicalDevice device ) {
+    method( "CheckBindlessSupport" );
+
+    if ( !app.hasPhysicalDeviceProperties2 ||
+         !IsDeviceExtensionSupported( device, VK_KHR_MAINTENANCE3_EXTENSION_NAME ) ||
+         !IsDeviceExtensionSupported( device, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME ) ) {
+        fail_method( "CheckBindlessSupport", "descriptor indexing extensions are not available!\n", NULL );
+        return false;
+    }
+
+    PFN_vkGetPhysicalDeviceFeatures2KHR getFeatures2 = ( PFN_vkGetPhysicalDeviceFeatures2KHR )vkGetInstanceProcAddr(
+        app.vkInstance,
+        "vkGetPhysicalDeviceFeatures2KHR"
+    );
+    if ( getFeatures2 == NULL ) {
+        fail_method( "CheckBindlessSupport", "vkGetPhysicalDeviceFeatures2KHR is not available!\n", NULL );
+        return false;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+        .pNext = NULL
+    };
+    VkPhysicalDeviceFeatures2KHR features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+        .pNext = &indexingFeatures
+    };
+    getFeatures2( device, &features );
+
+    bool isSupported = (
+        indexingFeatures.runtimeDescriptorArray &&
+        indexingFeatures.descriptorBindingPartiallyBound &&
+        indexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+        indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind
+    );
+
+    printf( "\t\tDescriptor indexing: %s\n", isSupported ? "Yes" : "No" );
+    ok_method( "CheckBindlessSupport" );
+    return isSupported;
+}
+bool CheckDynamicRenderingSupport( VkPhysicalDevice device ) {
+    method( "CheckDynamicRenderingSupport" );
+
+    const char *REQUIRED_EXTENSIONS[] = {
+        VK_KHR_MULTIVIEW_EXTENSION_NAME,
+        VK_KHR_MAINTENANCE2_EXTENSION_NAME,
+        VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+        VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
+        VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME
+    };
+    if ( !app.hasPhysicalDeviceProperties2 ) {
+        fail_method( "CheckDynamicRenderingSupport", "physical device properties2 is not available!\n", NULL );
+        return false;
+    }
+    for ( uint32_t i = 0; i < sizeof( REQUIRED_EXTENSIONS ) / sizeof( REQUIRED_EXTENSIONS[ 0 ] ); i++ ) {
+        if ( !IsDeviceExtensionSupported( device, REQUIRED_EXTENSIONS[ i ] ) ) {
+            fail_method( "CheckDynamicRenderingSupport", "%s is not available!\n", REQUIRED_EXTENSIONS[ i ] );
+            return false;
+        }
+    }
+
+    PFN_vkGetPhysicalDeviceFeatures2KHR getFeatures2 = ( PFN_vkGetPhysicalDeviceFeatures2KHR )vkGetInstanceProcAddr(
+        app.vkInstance,
+        "vkGetPhysicalDeviceFeatures2KHR"
+    );
+    if ( getFeatures2 == NULL ) {
+        fail_method( "CheckDynamicRenderingSupport", "vkGetPhysicalDeviceFeatures2KHR is not available!\n", NULL );
+        return false;
+    }
+
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+        .pNext = NULL
+    };
+    VkPhysicalDeviceFeatures2KHR features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+        .pNext = &dynamicRenderingFeatures
+    };
+    getFeatures2( device, &features );
+
+    bool isSupported = dynamicRenderingFeatures.dynamicRendering;
+    printf( "\t\tDynamic rendering: %s\n", isSupported ? "Yes" : "No" );
+    ok_method( "CheckDynamicRenderingSupport" );
+    return isSupported;
+}
 bool CheckValidationLayerSupport() {
     method( "CheckValidationLayerSupport" );
 
@@ -1210,13 +2759,13 @@ VkExtent2D ChooseSwapExtent( const VkSurfaceCapabilitiesKHR capabilities ) {
     ok_method( "ChooseSwapExtent" );
     return actualExtent;
 }
-VkShaderModule CreateShaderModule( uint8_t *shaderCode, uint32_t shaderCodeSize ) {
+VkShaderModule CreateShaderModule( const uint8_t *shaderCode, uint32_t shaderCodeSize ) {
     method( "CreateShaderModule" );
 
     VkShaderModuleCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
         .pNext = NULL,
-        .pCode = ( uint32_t* )shaderCode,
+        .pCode = ( const uint32_t* )shaderCode,
         .codeSize = shaderCodeSize
     };
 
@@ -1259,3 +2808,76 @@ uint8_t *LoadFile( const char *filename, uint32_t *size ) {
     ok_method( "LoadFile" );
     return fileBuffer;
 }
+const uint8_t *LoadAsset( const char *name, uint32_t *size ) {
+    method( "LoadAsset" );
+
+    // Archived assets are returned straight from the mapping
+    const uint8_t *data = GetAssetData( &app.assets, name, size );
+    if ( data != NULL ) {
+        ok_method( "LoadAsset (archive)" );
+        return data;
+    }
+
+    // Assets read ahead by OpenAssets are waited for, failed reads fall back to loading the file here
+    StreamedAsset *streamed = FindStreamedAsset( name );
+    if ( streamed != NULL ) {
+        while ( !streamed->isDone ) WaitAssetStreamer( &app.streamer );
+        if ( streamed->data != NULL ) {
+            data = streamed->data;
+            *size = streamed->size;
+            streamed->data = NULL;
+            ok_method( "LoadAsset (streamed)" );
+            return data;
+        }
+    }
+
+    char *path = GetRelativePath( app.argv[ 0 ], name, NULL );
+    data = LoadFile( path, size );
+    free( path );
+
+    ok_method( "LoadAsset" );
+    return data;
+}
+void FreeAsset( const uint8_t *data ) {
+    if ( data == NULL || IsArchiveData( &app.assets, data ) ) return;
+    free( ( void* )data );
+}
+void StreamAsset( const char *name, int priority ) {
+    if ( !app.hasStreamer || app.streamedAssetLength == MAX_STREAMED_ASSETS || FindStreamedAsset( name ) != NULL ) return;
+
+    StreamedAsset *streamed = &app.streamedAssets[ app.streamedAssetLength ];
+    memset( streamed, 0, sizeof( StreamedAsset ) );
+    streamed->name = name;
+
+    char *path = GetRelativePath( app.argv[ 0 ], name, NULL );
+    if ( RequestAsset( &app.streamer, path, priority, OnAssetStreamed, streamed ) != NULL ) app.streamedAssetLength++;
+    free( path );
+}
+void OnAssetStreamed( AssetRequest *request, void *userData ) {
+    StreamedAsset *streamed = ( StreamedAsset* )userData;
+    streamed->isDone = true;
+    if ( request->state != ASSET_REQUEST_DONE ) return;
+
+    // Keep the buffer, LoadAsset hands it out and FreeAsset releases it
+    streamed->data = request->data;
+    streamed->size = ( uint32_t )request->size;
+    request->data = NULL;
+}
+StreamedAsset *FindStreamedAsset( const char *name ) {
+    for ( uint32_t i = 0; i < app.streamedAssetLength; i++ ) {
+        if ( strcmp( app.streamedAssets[ i ].name, name ) == 0 ) return &app.streamedAssets[ i ];
+    }
+    return NULL;
+}
+const char *GetVertexShaderPath( DrawPath drawPath ) {
+    const char *VERT_PATHS[] = {
+        [ DRAW_PATH_BOUND_SETS ] = "shaders/vert.spv",
+        [ DRAW_PATH_BINDLESS ] = "shaders/vert_bindless.spv",
+        [ DRAW_PATH_PUSH_CONSTANTS ] = "shaders/vert_push.spv",
+        [ DRAW_PATH_DYNAMIC_UNIFORMS ] = "shaders/vert_draw_ubo.spv",
+        [ DRAW_PATH_INSTANCED ] = "shaders/vert_instanced.spv",
+        [ DRAW_PATH_INDIRECT ] = "shaders/vert.spv",
+        [ DRAW_PATH_PER_OBJECT_SETS ] = "shaders/vert.spv"
+    };
+    return VERT_PATHS[ drawPath ];
+}
@@ -6,16 +6,25 @@
 
 #include <GLFW/glfw3native.h>
 
+#define CGLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <cglm/cglm.h>
+#include <cglm/dispatch.h>
+
 #include <stdio.h>
 #include <stdbool.h>
 #include "utils.h"
-
-#define entry(x) puts("[Entry] "x)
-#define ok(x) puts("~ "x)
-#define fail(x,err,params) printf("[Error] "err"\n~ "x, params)
-#define method(x) puts("\t[Method] "x)
-#define ok_method(x) puts("\t~ "x)
-#define fail_method(x,err,params) printf("\t[Error] "err"\n~ "x, params)
+#include "SpirvReflect.h"
+#include "LayoutCache.h"
+#include "AssetArchive.h"
+#include "AssetStreamer.h"
+#include "GpuBuffer.h"
+#include "StagingRing.h"
+#include "DescriptorAllocator.h"
+#include "BindlessHeap.h"
+#include "GpuImage.h"
+#include "DepthPyramid.h"
+#include "RenderGraph.h"
+#include "IndirectDraws.h"
 
 typedef struct {
     bool isSet;
@@ -37,8 +46,76 @@ typedef struct {
 } SwapChainSupportDetails;
 
 #define DEVICE_EXTENSION_COUNT 1
+#define MAX_DEVICE_EXTENSION_COUNT 12
+#define MAX_INSTANCE_EXTENSION_COUNT 16
 #define VALIDATION_LAYER_COUNT 1
 #define FILE_CHUNK_SIZE 8192
+#define MAX_FRAMES_IN_FLIGHT 2
+#define STATS_REPORT_INTERVAL 1.0
+#define OBJECT_BOUNDING_RADIUS 0.71f // Triangle corners are at most sqrt( 0.5 ) from the model origin
+#define OBJECT_MODEL_BATCH 256
+#define ASSET_ARCHIVE_NAME "assets.pak"
+#define MAX_STREAMED_ASSETS 4
+#define FRAG_SHADER_PATH "shaders/frag.spv"
+#define DRAW_COMMANDS_SHADER_PATH "shaders/comp_draw_commands.spv"
+#define DEPTH_PYRAMID_SHADER_PATH "shaders/comp_depth_pyramid.spv"
+
+typedef struct {
+    mat4 view;
+    mat4 proj;
+    mat4 viewProj;
+    vec4 frustumPlanes[ 6 ];
+} CameraUniforms;
+
+// How per-object data reaches the vertex shader
+typedef enum {
+    DRAW_PATH_BOUND_SETS,
+    DRAW_PATH_BINDLESS,
+    DRAW_PATH_PUSH_CONSTANTS,
+    DRAW_PATH_DYNAMIC_UNIFORMS,
+    DRAW_PATH_INSTANCED,
+    DRAW_PATH_INDIRECT,
+    DRAW_PATH_PER_OBJECT_SETS
+} DrawPath;
+
+typedef struct {
+    mat4 model;
+} DrawData;
+
+// A loose asset read ahead on the streamer, LoadAsset takes its data once it has landed
+typedef struct {
+    const char *name;
+    uint8_t *data;
+    uint32_t size;
+    bool isDone;
+} StreamedAsset;
+
+// Per-instance vertex stream, matches the inInstance attributes of shader_instanced.vert
+typedef struct {
+    mat4 model;
+    vec4 color;
+} InstanceData;
+
+typedef struct {
+    uint64_t frameLength;
+    double reportTime;
+    uint32_t reportFrameLength;
+    double updateTime;
+    double frameTime;
+    double lastFrameTime;
+    double recordTime;
+    uint64_t reportDescriptorAllocations;
+    uint64_t visibleLength;
+    uint64_t culledLength;
+    uint64_t occludedLength;
+    uint32_t cullSampleLength;
+    double cullTime;
+    uint32_t cullTimeSampleLength;
+    uint64_t fragmentInvocationLength;
+    uint32_t fragmentSampleLength;
+    uint64_t barrierLength;
+    uint64_t skippedBarrierLength;
+} AppStats;
 
 #ifdef NDEBUG
     #define ENABLE_VALIDATION_LAYERS false
@@ -58,6 +135,21 @@ typedef struct {
 
     const char *deviceExtensions[ DEVICE_EXTENSION_COUNT ];
     const char *validationLayers[ VALIDATION_LAYER_COUNT ];
+    const char *enabledDeviceExtensions[ MAX_DEVICE_EXTENSION_COUNT ];
+    uint32_t enabledDeviceExtensionLength;
+    bool hasPhysicalDeviceProperties2;
+    bool hasPipelineStatistics;
+    bool isDynamicRenderingRequested;
+    bool isDynamicRendering;
+    PFN_vkCmdBeginRenderingKHR vkCmdBeginRenderingKHR;
+    PFN_vkCmdEndRenderingKHR vkCmdEndRenderingKHR;
+    DrawPath requestedDrawPath;
+    DrawPath drawPath;
+    AssetArchive assets;
+    AssetStreamer streamer;
+    bool hasStreamer;
+    StreamedAsset streamedAssets[ MAX_STREAMED_ASSETS ];
+    uint32_t streamedAssetLength;
     GLFWwindow *window;
     VkInstance vkInstance;
     VkPhysicalDevice vkPhysicalDevice;
@@ -73,16 +165,66 @@ typedef struct {
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
 
+    RenderGraph renderGraph;
+    uint32_t graphSwapChainImage;
+    uint32_t graphDepthImage;
+    uint32_t graphDepthPyramid;
+    uint32_t graphDrawCommands;
+    uint32_t graphDrawCount;
+    const GpuImage *depthImage;
+    bool isDepthSampled;
+    bool isDepthPrepass;
+
     VkRenderPass renderPass;
+    LayoutCache layoutCache;
     VkPipelineLayout pipelineLayout;
+    VkDescriptorSetLayout descriptorSetLayout;
     VkPipeline graphicsPipeline;
+    VkPipeline depthPrepassPipeline;
+    VkQueryPool statisticsQueryPool;
+    bool isStatisticsPending[ MAX_FRAMES_IN_FLIGHT ];
 
     VkFramebuffer *swapChainFramebuffers;
     VkCommandPool commandPool;
-    VkCommandBuffer *commandBuffers;
-
-    VkSemaphore imageAvailableSemaphore;
-    VkSemaphore renderFinishedSemaphore;
+    VkCommandBuffer commandBuffers[ MAX_FRAMES_IN_FLIGHT ];
+
+    VkSemaphore imageAvailableSemaphores[ MAX_FRAMES_IN_FLIGHT ];
+    VkSemaphore renderFinishedSemaphores[ MAX_FRAMES_IN_FLIGHT ];
+    VkFence inFlightFences[ MAX_FRAMES_IN_FLIGHT ];
+    VkFence *imagesInFlight;
+    uint32_t currentFrame;
+    uint32_t imageIndex;
+
+    StagingRing stagingRing;
+    DescriptorAllocator descriptorAllocator;
+    VkDescriptorSet descriptorSets[ MAX_FRAMES_IN_FLIGHT ];
+    VkDescriptorSet *objectDescriptorSets;
+    BindlessHeap bindlessHeap;
+    uint32_t objectBufferIndices[ MAX_FRAMES_IN_FLIGHT ];
+    uint32_t objectBufferIndex;
+    VkDeviceSize objectBufferRange;
+    uint32_t objectBaseIndex;
+    float sceneTime;
+    VkDeviceSize instanceOffset;
+    VkDescriptorSetLayout drawDataSetLayout;
+    VkDescriptorSet drawDataSet;
+    uint32_t *drawDataOffsets;
+    IndirectDraws indirectDraws;
+    bool isCullingDisabled;
+    bool isOcclusionDisabled;
+    VkDeviceSize cameraOffset;
+    DepthPyramid depthPyramid;
+    bool hasDepthHistory;
+    uint32_t drawCallLength;
+
+    uint32_t objectLength;
+    uint32_t sceneLayerLength;
+    float sceneRadius;
+    float sceneDepth;
+    vec4 *objects;
+    vec4 *objectColors;
+    vec4 *objectLocalBounds; // Model space bounding spheres, moved to world space with the model matrices every frame
+    AppStats stats;
 
     void ( *Run )( int, char** );
 } AppProperties;
@@ -0,0 +1,268 @@
+#include "HelloTriangleApplication.h"
+
+/* METHODS */
+VkResult CreateIndirectDraws(
+    IndirectDraws *draws,
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    uint32_t capacity,
+    uint32_t frameLength,
+    const uint16_t *indices,
+    uint32_t indexLength
+) {
+    method( "CreateIndirectDraws" );
+
+    // Pipeline, feature flags and the draw count entry point are filled in by the caller
+    draws->frameLength = min( frameLength, INDIRECT_DRAWS_MAX_FRAMES );
+    draws->capacity = capacity;
+    draws->indexLength = indexLength;
+
+    VkResult result = CreateGpuBuffer(
+        device, physicalDevice, indexLength * sizeof( uint16_t ),
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        &draws->indices
+    );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateIndirectDraws", "failed to create index buffer.\nError code: %d\n", result );
+        return result;
+    }
+    memcpy( draws->indices.mapped, indices, indexLength * sizeof( uint16_t ) );
+
+    // Each frame in flight owns its commands and bounds so the next frame can not race a pending compute pass or draw
+    for ( uint32_t i = 0; i < draws->frameLength; i++ ) {
+        result = CreateGpuBuffer(
+            device, physicalDevice, ( VkDeviceSize )capacity * sizeof( VkDrawIndexedIndirectCommand ),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            &draws->frames[ i ].commands
+        );
+        if ( result == VK_SUCCESS ) result = CreateGpuBuffer(
+            device, physicalDevice, sizeof( DrawCounts ),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            &draws->frames[ i ].count
+        );
+        if ( result == VK_SUCCESS ) result = CreateGpuBuffer(
+            device, physicalDevice, sizeof( DrawCounts ),
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            &draws->frames[ i ].readback
+        );
+        if ( result == VK_SUCCESS ) result = CreateGpuBuffer(
+            device, physicalDevice, ( VkDeviceSize )capacity * 4 * sizeof( float ),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            &draws->frames[ i ].bounds
+        );
+        if ( result != VK_SUCCESS ) {
+            fail_method( "CreateIndirectDraws", "failed to create draw command buffers.\nError code: %d\n", result );
+            DestroyIndirectDraws( draws, device );
+            return result;
+        }
+    }
+
+    // Two timestamps per frame bracket the compute pass when every queue can write them
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties( physicalDevice, &properties );
+    if ( properties.limits.timestampComputeAndGraphics && properties.limits.timestampPeriod > 0.0f ) {
+        VkQueryPoolCreateInfo queryPoolInfo = {
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .pNext = NULL,
+            .flags = 0,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = draws->frameLength * INDIRECT_DRAWS_QUERIES_PER_FRAME,
+            .pipelineStatistics = 0
+        };
+        result = vkCreateQueryPool( device, &queryPoolInfo, NULL, &draws->queryPool );
+        if ( result != VK_SUCCESS ) {
+            fail_method( "CreateIndirectDraws", "failed to create timestamp query pool.\nError code: %d\n", result );
+            DestroyIndirectDraws( draws, device );
+            return result;
+        }
+        draws->timestampPeriod = properties.limits.timestampPeriod;
+    }
+
+    ok_method( "CreateIndirectDraws" );
+    return VK_SUCCESS;
+}
+void DestroyIndirectDraws( IndirectDraws *draws, VkDevice device ) {
+    method( "DestroyIndirectDraws" );
+
+    for ( uint32_t i = 0; i < draws->frameLength; i++ ) {
+        DestroyGpuBuffer( device, &draws->frames[ i ].commands );
+        DestroyGpuBuffer( device, &draws->frames[ i ].count );
+        DestroyGpuBuffer( device, &draws->frames[ i ].readback );
+        DestroyGpuBuffer( device, &draws->frames[ i ].bounds );
+    }
+    DestroyGpuBuffer( device, &draws->indices );
+    if ( draws->queryPool ) vkDestroyQueryPool( device, draws->queryPool, NULL );
+    if ( draws->pipeline ) vkDestroyPipeline( device, draws->pipeline, NULL );
+
+    // The pipeline and set layouts belong to the layout cache
+    memset( draws, 0, sizeof( IndirectDraws ) );
+
+    ok_method( "DestroyIndirectDraws" );
+}
+void RecordDrawCommandGeneration(
+    IndirectDraws *draws,
+    VkCommandBuffer commandBuffer,
+    uint32_t frame,
+    uint32_t objectLength,
+    uint32_t cameraOffset,
+    const DepthPyramid *pyramid
+) {
+    // Without a pyramid, for example on the first frame, only the frustum test runs
+    IndirectDrawFrame *drawFrame = &draws->frames[ frame ];
+    DrawCommandParams params = {
+        .objectCount = min( objectLength, draws->capacity ),
+        .indexCount = draws->indexLength,
+        .isCompacted = draws->vkCmdDrawIndexedIndirectCount != NULL,
+        .isCulling = draws->isCulling,
+        .isOcclusionCulling = draws->isCulling && pyramid != NULL,
+        .pyramidWidth = pyramid ? pyramid->image.width : 0,
+        .pyramidHeight = pyramid ? pyramid->image.height : 0,
+        .pyramidLevelLength = pyramid ? pyramid->image.levelLength : 0
+    };
+
+    uint32_t firstQuery = frame * INDIRECT_DRAWS_QUERIES_PER_FRAME;
+    if ( draws->queryPool ) {
+        vkCmdResetQueryPool( commandBuffer, draws->queryPool, firstQuery, INDIRECT_DRAWS_QUERIES_PER_FRAME );
+        vkCmdWriteTimestamp( commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, draws->queryPool, firstQuery );
+    }
+
+    vkCmdFillBuffer( commandBuffer, drawFrame->count.buffer, 0, sizeof( DrawCounts ), 0 );
+
+    VkBufferMemoryBarrier clearBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = NULL,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = drawFrame->count.buffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, NULL, 1, &clearBarrier, 0, NULL
+    );
+
+    vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, draws->pipeline );
+    vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, draws->pipelineLayout, 0, 1, &drawFrame->set, 1, &cameraOffset );
+    vkCmdPushConstants( commandBuffer, draws->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( DrawCommandParams ), &params );
+    vkCmdDispatch( commandBuffer, ( params.objectCount + INDIRECT_DRAWS_WORKGROUP_SIZE - 1 ) / INDIRECT_DRAWS_WORKGROUP_SIZE, 1, 1 );
+
+    if ( draws->queryPool ) {
+        vkCmdWriteTimestamp( commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, draws->queryPool, firstQuery + 1 );
+    }
+
+    // The graph orders the draws after this pass, only the stats copy below reads the count in here
+    VkBufferMemoryBarrier countBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = NULL,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = drawFrame->count.buffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, NULL, 1, &countBarrier, 0, NULL
+    );
+
+    // The visible count is copied out for the stats once the frame's fence signals
+    VkBufferCopy countCopy = { 0, 0, sizeof( DrawCounts ) };
+    vkCmdCopyBuffer( commandBuffer, drawFrame->count.buffer, drawFrame->readback.buffer, 1, &countCopy );
+
+    VkBufferMemoryBarrier readbackBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = NULL,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = drawFrame->readback.buffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0, 0, NULL, 1, &readbackBarrier, 0, NULL
+    );
+
+    drawFrame->isPending = true;
+}
+uint32_t RecordIndirectDraws( const IndirectDraws *draws, VkCommandBuffer commandBuffer, uint32_t frame, uint32_t objectLength ) {
+    const IndirectDrawFrame *drawFrame = &draws->frames[ frame ];
+    uint32_t drawLength = min( objectLength, draws->capacity );
+    VkDeviceSize stride = sizeof( VkDrawIndexedIndirectCommand );
+
+    vkCmdBindIndexBuffer( commandBuffer, draws->indices.buffer, 0, VK_INDEX_TYPE_UINT16 );
+
+    // Returns the number of draw calls recorded, which stays constant as the scene grows
+    if ( draws->vkCmdDrawIndexedIndirectCount != NULL ) {
+        draws->vkCmdDrawIndexedIndirectCount(
+            commandBuffer,
+            drawFrame->commands.buffer, 0,
+            drawFrame->count.buffer, 0,
+            min( drawLength, draws->maxDrawCount ),
+            ( uint32_t )stride
+        );
+        return 1;
+    }
+
+    if ( !draws->hasMultiDraw ) {
+        for ( uint32_t i = 0; i < drawLength; i++ ) {
+            vkCmdDrawIndexedIndirect( commandBuffer, drawFrame->commands.buffer, i * stride, 1, ( uint32_t )stride );
+        }
+        return drawLength;
+    }
+
+    uint32_t callLength = 0;
+    for ( uint32_t first = 0; first < drawLength; first += draws->maxDrawCount ) {
+        uint32_t batchLength = min( drawLength - first, draws->maxDrawCount );
+        vkCmdDrawIndexedIndirect( commandBuffer, drawFrame->commands.buffer, first * stride, batchLength, ( uint32_t )stride );
+        callLength++;
+    }
+    return callLength;
+}
+bool ReadIndirectDrawStats( IndirectDraws *draws, VkDevice device, uint32_t frame, IndirectDrawStats *stats ) {
+    // Only valid once the frame's fence has signaled
+    IndirectDrawFrame *drawFrame = &draws->frames[ frame ];
+    if ( !drawFrame->isPending ) return false;
+    drawFrame->isPending = false;
+
+    const DrawCounts *counts = drawFrame->readback.mapped;
+    stats->visibleLength = min( counts->drawCount, draws->capacity );
+    stats->occludedLength = min( counts->occludedCount, draws->capacity - stats->visibleLength );
+    stats->culledLength = draws->capacity - stats->visibleLength - stats->occludedLength;
+    stats->gpuTime = -1.0;
+
+    uint64_t timestamps[ INDIRECT_DRAWS_QUERIES_PER_FRAME ];
+    if ( draws->queryPool && vkGetQueryPoolResults(
+        device,
+        draws->queryPool,
+        frame * INDIRECT_DRAWS_QUERIES_PER_FRAME,
+        INDIRECT_DRAWS_QUERIES_PER_FRAME,
+        sizeof( timestamps ),
+        timestamps,
+        sizeof( uint64_t ),
+        VK_QUERY_RESULT_64_BIT
+    ) == VK_SUCCESS ) {
+        stats->gpuTime = ( double )( timestamps[ 1 ] - timestamps[ 0 ] ) * draws->timestampPeriod * 1e-6;
+    }
+
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef __INDIRECT_DRAWS__
+#define __INDIRECT_DRAWS__
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+#include "GpuBuffer.h"
+#include "DepthPyramid.h"
+
+#define INDIRECT_DRAWS_MAX_FRAMES 4
+#define INDIRECT_DRAWS_WORKGROUP_SIZE 64
+#define INDIRECT_DRAWS_COUNT_BINDING 0
+#define INDIRECT_DRAWS_COMMAND_BINDING 1
+#define INDIRECT_DRAWS_BOUNDS_BINDING 2
+#define INDIRECT_DRAWS_CAMERA_BINDING 3
+#define INDIRECT_DRAWS_PYRAMID_BINDING 4
+#define INDIRECT_DRAWS_QUERIES_PER_FRAME 2
+
+// Matches the push constant block of shader_draw_commands.comp
+typedef struct {
+    uint32_t objectCount;
+    uint32_t indexCount;
+    uint32_t isCompacted;
+    uint32_t isCulling;
+    uint32_t isOcclusionCulling;
+    uint32_t pyramidWidth;
+    uint32_t pyramidHeight;
+    uint32_t pyramidLevelLength;
+} DrawCommandParams;
+
+// Layout of the count buffer, the draw count comes first so the GPU can read it directly
+typedef struct {
+    uint32_t drawCount;
+    uint32_t occludedCount;
+} DrawCounts;
+
+typedef struct {
+    GpuBuffer commands;
+    GpuBuffer count;
+    GpuBuffer bounds; // World space spheres as center xyz and radius, written by the host every frame
+    GpuBuffer readback;
+    VkDescriptorSet set;
+    bool isPending;
+} IndirectDrawFrame;
+
+typedef struct {
+    uint32_t visibleLength;
+    uint32_t culledLength;
+    uint32_t occludedLength;
+    double gpuTime; // Milliseconds spent generating draws, negative without timestamp support
+} IndirectDrawStats;
+
+/*
+ * Draw commands written by a compute pass that culls each object's bounding sphere against the frustum,
+ * then tests its bounding box against the depth pyramid built from the previous frame.
+ * With VK_KHR_draw_indirect_count and multiDrawIndirect the pass compacts visible draws and the GPU reads the count,
+ * otherwise every object keeps its slot and culled ones get an instance count of zero.
+ */
+typedef struct {
+    IndirectDrawFrame frames[ INDIRECT_DRAWS_MAX_FRAMES ];
+    uint32_t frameLength;
+    uint32_t capacity;
+
+    GpuBuffer indices;
+    uint32_t indexLength;
+    bool isCulling;
+    bool isOcclusionCulling;
+
+    VkQueryPool queryPool;
+    float timestampPeriod;
+
+    VkPipeline pipeline;
+    VkPipelineLayout pipelineLayout;
+    VkDescriptorSetLayout setLayout;
+
+    bool hasMultiDraw;
+    uint32_t maxDrawCount;
+    PFN_vkCmdDrawIndexedIndirectCountKHR vkCmdDrawIndexedIndirectCount;
+} IndirectDraws;
+
+VkResult CreateIndirectDraws( IndirectDraws*, VkDevice, VkPhysicalDevice, uint32_t, uint32_t, const uint16_t*, uint32_t );
+void DestroyIndirectDraws( IndirectDraws*, VkDevice );
+void RecordDrawCommandGeneration( IndirectDraws*, VkCommandBuffer, uint32_t, uint32_t, uint32_t, const DepthPyramid* );
+uint32_t RecordIndirectDraws( const IndirectDraws*, VkCommandBuffer, uint32_t, uint32_t );
+bool ReadIndirectDrawStats( IndirectDraws*, VkDevice, uint32_t, IndirectDrawStats* );
+
+#endif
@@ -0,0 +1,255 @@
+#include "HelloTriangleApplication.h"
+
+/* PRIVATE VISIBILITY */
+uint64_t HashSetLayoutBindings( const VkDescriptorSetLayoutBinding*, uint32_t );
+bool CompareSetLayoutBindings( const CachedSetLayout*, const VkDescriptorSetLayoutBinding*, uint32_t );
+void SortSetLayoutBindings( VkDescriptorSetLayoutBinding*, uint32_t );
+
+/* METHODS */
+VkResult GetSetLayout(
+    LayoutCache *cache,
+    VkDevice device,
+    const VkDescriptorSetLayoutBinding *bindings,
+    uint32_t bindingLength,
+    VkDescriptorSetLayout *setLayout
+) {
+    method( "GetSetLayout" );
+
+    uint64_t hash = HashSetLayoutBindings( bindings, bindingLength );
+    for ( uint32_t i = 0; i < cache->setLayoutLength; i++ ) {
+        CachedSetLayout *entry = cache->setLayouts[ i ];
+        if ( entry->hash == hash && CompareSetLayoutBindings( entry, bindings, bindingLength ) ) {
+            *setLayout = entry->setLayout;
+            ok_method( "GetSetLayout (cached)" );
+            return VK_SUCCESS;
+        }
+    }
+
+    CachedSetLayout *entry = calloc( 1, sizeof( CachedSetLayout ) );
+    entry->hash = hash;
+    entry->bindingLength = bindingLength;
+    memcpy( entry->bindings, bindings, bindingLength * sizeof( VkDescriptorSetLayoutBinding ) );
+
+    VkDescriptorSetLayoutCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .bindingCount = bindingLength,
+        .pBindings = entry->bindings
+    };
+
+    VkResult result = vkCreateDescriptorSetLayout( device, &createInfo, NULL, &entry->setLayout );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "GetSetLayout", "failed to create descriptor set layout.\nError code: %d\n", result );
+        free( entry );
+        return result;
+    }
+
+    cache->setLayouts = realloc( cache->setLayouts, ( cache->setLayoutLength + 1 ) * sizeof( CachedSetLayout* ) );
+    cache->setLayouts[ cache->setLayoutLength++ ] = entry;
+    *setLayout = entry->setLayout;
+
+    ok_method( "GetSetLayout" );
+    return VK_SUCCESS;
+}
+VkResult GetPipelineLayout(
+    LayoutCache *cache,
+    VkDevice device,
+    const ShaderReflection *stages,
+    uint32_t stageLength,
+    const VkDescriptorSetLayout *setLayoutOverrides,
+    const CachedPipelineLayout **pipelineLayout
+) {
+    method( "GetPipelineLayout" );
+
+    VkDescriptorSetLayoutBinding setBindings[ LAYOUT_CACHE_MAX_SETS ][ SHADER_MAX_BINDINGS ];
+    uint32_t setBindingLengths[ LAYOUT_CACHE_MAX_SETS ] = { 0 };
+    uint32_t setLength = 0;
+
+    VkPushConstantRange pushConstantRange = { 0, UINT32_MAX, 0 };
+    uint32_t pushConstantEnd = 0;
+
+    // Overridden sets use a layout built by the caller (e.g. a bindless heap) instead of the reflected one
+    if ( setLayoutOverrides != NULL ) {
+        for ( uint32_t i = 0; i < LAYOUT_CACHE_MAX_SETS; i++ ) {
+            if ( setLayoutOverrides[ i ] != VK_NULL_HANDLE ) setLength = i + 1;
+        }
+    }
+
+    // Merge bindings of every stage, shared bindings are visible to all stages using them
+    for ( uint32_t s = 0; s < stageLength; s++ ) {
+        const ShaderReflection *stage = &stages[ s ];
+
+        for ( uint32_t b = 0; b < stage->bindingLength; b++ ) {
+            const ShaderBinding *binding = &stage->bindings[ b ];
+            if ( binding->set >= LAYOUT_CACHE_MAX_SETS ) {
+                fail_method( "GetPipelineLayout", "descriptor set %u is out of range!\n", binding->set );
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+
+            setLength = max( setLength, binding->set + 1 );
+            if ( setLayoutOverrides != NULL && setLayoutOverrides[ binding->set ] != VK_NULL_HANDLE ) continue;
+
+            VkDescriptorSetLayoutBinding *bindings = setBindings[ binding->set ];
+            uint32_t *bindingLength = &setBindingLengths[ binding->set ];
+            bool isMerged = false;
+            for ( uint32_t i = 0; i < *bindingLength; i++ ) {
+                if ( bindings[ i ].binding != binding->binding ) continue;
+                if ( bindings[ i ].descriptorType != binding->descriptorType ) {
+                    fail_method( "GetPipelineLayout", "binding %u is declared with different types across stages!\n", binding->binding );
+                    return VK_ERROR_INITIALIZATION_FAILED;
+                }
+                bindings[ i ].stageFlags |= stage->stage;
+                bindings[ i ].descriptorCount = max( bindings[ i ].descriptorCount, binding->descriptorCount );
+                isMerged = true;
+                break;
+            }
+
+            if ( !isMerged && *bindingLength < SHADER_MAX_BINDINGS ) {
+                VkDescriptorSetLayoutBinding layoutBinding = {
+                    .binding = binding->binding,
+                    .descriptorType = binding->descriptorType,
+                    .descriptorCount = binding->descriptorCount,
+                    .stageFlags = stage->stage,
+                    .pImmutableSamplers = NULL
+                };
+                bindings[ ( *bindingLength )++ ] = layoutBinding;
+            }
+        }
+
+        if ( stage->pushConstantSize != 0 ) {
+            pushConstantRange.stageFlags |= stage->stage;
+            pushConstantRange.offset = min( pushConstantRange.offset, stage->pushConstantOffset );
+            pushConstantEnd = max( pushConstantEnd, stage->pushConstantOffset + stage->pushConstantSize );
+        }
+    }
+
+    uint32_t pushConstantRangeLength = pushConstantRange.stageFlags != 0 ? 1 : 0;
+    if ( pushConstantRangeLength != 0 ) {
+        pushConstantRange.size = pushConstantEnd - pushConstantRange.offset;
+    } else {
+        pushConstantRange.offset = 0;
+    }
+
+    VkDescriptorSetLayout setLayouts[ LAYOUT_CACHE_MAX_SETS ];
+    for ( uint32_t i = 0; i < setLength; i++ ) {
+        if ( setLayoutOverrides != NULL && setLayoutOverrides[ i ] != VK_NULL_HANDLE ) {
+            setLayouts[ i ] = setLayoutOverrides[ i ];
+            continue;
+        }
+        SortSetLayoutBindings( setBindings[ i ], setBindingLengths[ i ] );
+        VkResult result = GetSetLayout( cache, device, setBindings[ i ], setBindingLengths[ i ], &setLayouts[ i ] );
+        if ( result != VK_SUCCESS ) return result;
+    }
+
+    // Set layouts are deduplicated, so their handles identify the pipeline layout
+    uint64_t hash = HashBytes( setLayouts, setLength * sizeof( VkDescriptorSetLayout ), UTILS_HASH_SEED );
+    hash = HashBytes( &pushConstantRange, sizeof( VkPushConstantRange ), hash );
+    for ( uint32_t i = 0; i < cache->pipelineLayoutLength; i++ ) {
+        CachedPipelineLayout *entry = cache->pipelineLayouts[ i ];
+        if ( entry->hash == hash &&
+             entry->setLayoutLength == setLength &&
+             entry->pushConstantRangeLength == pushConstantRangeLength &&
+             memcmp( entry->setLayouts, setLayouts, setLength * sizeof( VkDescriptorSetLayout ) ) == 0 &&
+             memcmp( &entry->pushConstantRange, &pushConstantRange, sizeof( VkPushConstantRange ) ) == 0 ) {
+            *pipelineLayout = entry;
+            ok_method( "GetPipelineLayout (cached)" );
+            return VK_SUCCESS;
+        }
+    }
+
+    CachedPipelineLayout *entry = calloc( 1, sizeof( CachedPipelineLayout ) );
+    entry->hash = hash;
+    entry->setLayoutLength = setLength;
+    memcpy( entry->setLayouts, setLayouts, setLength * sizeof( VkDescriptorSetLayout ) );
+    entry->pushConstantRange = pushConstantRange;
+    entry->pushConstantRangeLength = pushConstantRangeLength;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .pNext = NULL,
+        .setLayoutCount = entry->setLayoutLength,
+        .pSetLayouts = entry->setLayouts,
+        .pushConstantRangeCount = entry->pushConstantRangeLength,
+        .pPushConstantRanges = &entry->pushConstantRange
+    };
+
+    VkResult result = vkCreatePipelineLayout( device, &pipelineLayoutInfo, NULL, &entry->pipelineLayout );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "GetPipelineLayout", "failed to create pipeline layout.\nError code: %d\n", result );
+        free( entry );
+        return result;
+    }
+
+    cache->pipelineLayouts = realloc( cache->pipelineLayouts, ( cache->pipelineLayoutLength + 1 ) * sizeof( CachedPipelineLayout* ) );
+    cache->pipelineLayouts[ cache->pipelineLayoutLength++ ] = entry;
+    *pipelineLayout = entry;
+
+    printf( "\t\tPipeline layout: %u sets, %u push constant bytes\n", setLength, pushConstantRangeLength ? pushConstantRange.size : 0 );
+    ok_method( "GetPipelineLayout" );
+    return VK_SUCCESS;
+}
+void DestroyLayoutCache( LayoutCache *cache, VkDevice device ) {
+    method( "DestroyLayoutCache" );
+
+    for ( uint32_t i = 0; i < cache->pipelineLayoutLength; i++ ) {
+        vkDestroyPipelineLayout( device, cache->pipelineLayouts[ i ]->pipelineLayout, NULL );
+        free( cache->pipelineLayouts[ i ] );
+    }
+    for ( uint32_t i = 0; i < cache->setLayoutLength; i++ ) {
+        vkDestroyDescriptorSetLayout( device, cache->setLayouts[ i ]->setLayout, NULL );
+        free( cache->setLayouts[ i ] );
+    }
+    free( cache->pipelineLayouts );
+    free( cache->setLayouts );
+
+    cache->pipelineLayouts = NULL;
+    cache->pipelineLayoutLength = 0;
+    cache->setLayouts = NULL;
+    cache->setLayoutLength = 0;
+
+    ok_method( "DestroyLayoutCache" );
+}
+
+/* HELPERS */
+uint64_t HashSetLayoutBindings( const VkDescriptorSetLayoutBinding *bindings, uint32_t bindingLength ) {
+    uint64_t hash = UTILS_HASH_SEED;
+    for ( uint32_t i = 0; i < bindingLength; i++ ) {
+        uint32_t key[] = {
+            bindings[ i ].binding,
+            ( uint32_t )bindings[ i ].descriptorType,
+            bindings[ i ].descriptorCount,
+            bindings[ i ].stageFlags
+        };
+        hash = HashBytes( key, sizeof( key ), hash );
+    }
+
+    return hash;
+}
+bool CompareSetLayoutBindings( const CachedSetLayout *entry, const VkDescriptorSetLayoutBinding *bindings, uint32_t bindingLength ) {
+    if ( entry->bindingLength != bindingLength ) return false;
+
+    for ( uint32_t i = 0; i < bindingLength; i++ ) {
+        const VkDescriptorSetLayoutBinding *a = &entry->bindings[ i ];
+        const VkDescriptorSetLayoutBinding *b = &bindings[ i ];
+        if ( a->binding != b->binding ||
+             a->descriptorType != b->descriptorType ||
+             a->descriptorCount != b->descriptorCount ||
+             a->stageFlags != b->stageFlags ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+void SortSetLayoutBindings( VkDescriptorSetLayoutBinding *bindings, uint32_t bindingLength ) {
+    for ( uint32_t i = 1; i < bindingLength; i++ ) {
+        VkDescriptorSetLayoutBinding binding = bindings[ i ];
+        uint32_t j = i;
+        while ( j > 0 && bindings[ j - 1 ].binding > binding.binding ) {
+            bindings[ j ] = bindings[ j - 1 ];
+            j--;
+        }
+        bindings[ j ] = binding;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef __LAYOUT_CACHE__
+#define __LAYOUT_CACHE__
+
+#include <vulkan/vulkan.h>
+
+#include "SpirvReflect.h"
+
+#define LAYOUT_CACHE_MAX_SETS 4
+
+typedef struct {
+    uint64_t hash;
+    VkDescriptorSetLayoutBinding bindings[ SHADER_MAX_BINDINGS ];
+    uint32_t bindingLength;
+    VkDescriptorSetLayout setLayout;
+} CachedSetLayout;
+
+typedef struct {
+    uint64_t hash;
+    VkDescriptorSetLayout setLayouts[ LAYOUT_CACHE_MAX_SETS ];
+    uint32_t setLayoutLength;
+    VkPushConstantRange pushConstantRange;
+    uint32_t pushConstantRangeLength;
+    VkPipelineLayout pipelineLayout;
+} CachedPipelineLayout;
+
+typedef struct {
+    CachedSetLayout **setLayouts;
+    uint32_t setLayoutLength;
+    CachedPipelineLayout **pipelineLayouts;
+    uint32_t pipelineLayoutLength;
+} LayoutCache;
+
+VkResult GetSetLayout( LayoutCache*, VkDevice, const VkDescriptorSetLayoutBinding*, uint32_t, VkDescriptorSetLayout* );
+VkResult GetPipelineLayout( LayoutCache*, VkDevice, const ShaderReflection*, uint32_t, const VkDescriptorSetLayout*, const CachedPipelineLayout** );
+void DestroyLayoutCache( LayoutCache*, VkDevice );
+
+#endif
@@ -0,0 +1,2 @@
+// cglm runtime dispatch: cpuid selection and the baseline kernels, see cglm/dispatch.h
+#include <cglm/dispatch/impl.h>
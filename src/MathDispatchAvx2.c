@@ -0,0 +1,3 @@
+// AVX2 + FMA kernels of the cglm dispatch layer, nothing may be included before the ISA is switched
+#define CGLM_DISPATCH_AVX2
+#include <cglm/dispatch/isa.h>
@@ -0,0 +1,3 @@
+// AVX-512 kernels of the cglm dispatch layer, nothing may be included before the ISA is switched
+#define CGLM_DISPATCH_AVX512
+#include <cglm/dispatch/isa.h>
@@ -0,0 +1,499 @@
+#include "HelloTriangleApplication.h"
+
+#define RENDER_GRAPH_WRITE_ACCESS ( \
+    VK_ACCESS_SHADER_WRITE_BIT | \
+    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | \
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | \
+    VK_ACCESS_TRANSFER_WRITE_BIT | \
+    VK_ACCESS_HOST_WRITE_BIT | \
+    VK_ACCESS_MEMORY_WRITE_BIT \
+)
+
+/* PRIVATE VISIBILITY */
+uint32_t AddRenderGraphResource( RenderGraph*, const char*, RenderGraphResourceType );
+bool IsRenderGraphTransient( const RenderGraphResource* );
+bool IsRenderGraphWrite( VkAccessFlags );
+bool IsRenderGraphRead( VkAccessFlags );
+void CullRenderGraphPasses( RenderGraph* );
+VkResult CreateRenderGraphImages( RenderGraph*, VkDevice, VkPhysicalDevice );
+
+/* METHODS */
+uint32_t AddRenderGraphImage(
+    RenderGraph *graph,
+    const char *name,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levelLength,
+    VkFormat format,
+    VkImageUsageFlags usage,
+    VkImageAspectFlags aspect,
+    bool isPersistent
+) {
+    uint32_t handle = AddRenderGraphResource( graph, name, RENDER_GRAPH_IMAGE );
+    if ( handle == RENDER_GRAPH_INVALID ) return handle;
+
+    // The image itself is created once the graph knows which passes use it
+    RenderGraphResource *resource = &graph->resources[ handle ];
+    resource->isPersistent = isPersistent;
+    resource->image.format = format;
+    resource->image.aspect = aspect;
+    resource->image.width = width;
+    resource->image.height = height;
+    resource->image.levelLength = levelLength;
+    resource->usage = usage;
+    return handle;
+}
+uint32_t ImportRenderGraphImage( RenderGraph *graph, const char *name, VkImageAspectFlags aspect, uint32_t levelLength, VkImageLayout finalLayout ) {
+    uint32_t handle = AddRenderGraphResource( graph, name, RENDER_GRAPH_IMAGE );
+    if ( handle == RENDER_GRAPH_INVALID ) return handle;
+
+    RenderGraphResource *resource = &graph->resources[ handle ];
+    resource->isImported = true;
+    resource->image.aspect = aspect;
+    resource->image.levelLength = levelLength;
+    resource->finalLayout = finalLayout;
+    return handle;
+}
+uint32_t ImportRenderGraphBuffer( RenderGraph *graph, const char *name ) {
+    uint32_t handle = AddRenderGraphResource( graph, name, RENDER_GRAPH_BUFFER );
+    if ( handle == RENDER_GRAPH_INVALID ) return handle;
+
+    graph->resources[ handle ].isImported = true;
+    return handle;
+}
+uint32_t AddRenderGraphPass( RenderGraph *graph, const char *name, RenderGraphRecord record, void *userData ) {
+    if ( graph->isCompiled || graph->passLength == RENDER_GRAPH_MAX_PASSES ) {
+        fail_method( "AddRenderGraphPass", "can not add pass \"%s\"!\n", name );
+        return RENDER_GRAPH_INVALID;
+    }
+
+    RenderGraphPass *pass = &graph->passes[ graph->passLength ];
+    memset( pass, 0, sizeof( RenderGraphPass ) );
+    pass->name = name;
+    pass->record = record;
+    pass->userData = userData;
+    return graph->passLength++;
+}
+void UseRenderGraphResource(
+    RenderGraph *graph,
+    uint32_t passHandle,
+    uint32_t resourceHandle,
+    VkPipelineStageFlags stage,
+    VkAccessFlags access,
+    VkImageLayout layout
+) {
+    if ( passHandle >= graph->passLength || resourceHandle >= graph->resourceLength ) return;
+    RenderGraphPass *pass = &graph->passes[ passHandle ];
+
+    // A pass touches each resource once, repeated uses are folded into a single state
+    for ( uint32_t i = 0; i < pass->accessLength; i++ ) {
+        RenderGraphAccess *existing = &pass->accesses[ i ];
+        if ( existing->resource != resourceHandle ) continue;
+
+        existing->state.stage |= stage;
+        existing->state.access |= access;
+        if ( existing->state.layout != layout ) existing->state.layout = VK_IMAGE_LAYOUT_GENERAL;
+        return;
+    }
+
+    if ( pass->accessLength == RENDER_GRAPH_MAX_ACCESSES ) {
+        fail_method( "UseRenderGraphResource", "too many resources in pass \"%s\"!\n", pass->name );
+        return;
+    }
+
+    RenderGraphAccess *use = &pass->accesses[ pass->accessLength++ ];
+    use->resource = resourceHandle;
+    use->state.stage = stage;
+    use->state.access = access;
+    use->state.layout = graph->resources[ resourceHandle ].type == RENDER_GRAPH_IMAGE ? layout : VK_IMAGE_LAYOUT_UNDEFINED;
+}
+VkResult CompileRenderGraph( RenderGraph *graph, VkDevice device, VkPhysicalDevice physicalDevice ) {
+    method( "CompileRenderGraph" );
+
+    CullRenderGraphPasses( graph );
+
+    // Lifetimes only count the passes that survived culling
+    for ( uint32_t i = 0; i < graph->passLength; i++ ) {
+        const RenderGraphPass *pass = &graph->passes[ i ];
+        if ( pass->isCulled ) continue;
+
+        for ( uint32_t a = 0; a < pass->accessLength; a++ ) {
+            RenderGraphResource *resource = &graph->resources[ pass->accesses[ a ].resource ];
+            if ( resource->firstPass == RENDER_GRAPH_INVALID ) resource->firstPass = i;
+            resource->lastPass = i;
+        }
+    }
+
+    VkResult result = CreateRenderGraphImages( graph, device, physicalDevice );
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CompileRenderGraph", "failed to create graph images.\nError code: %d\n", result );
+        return result;
+    }
+    graph->isCompiled = true;
+
+    printf( "\tRender graph: %u passes (%u culled), %u memory blocks, %llu KiB requested, %llu KiB allocated\n",
+        graph->passLength - graph->culledPassLength,
+        graph->culledPassLength,
+        graph->blockLength,
+        ( unsigned long long )( graph->requestedMemorySize / 1024 ),
+        ( unsigned long long )( graph->allocatedMemorySize / 1024 )
+    );
+
+    ok_method( "CompileRenderGraph" );
+    return VK_SUCCESS;
+}
+void BindRenderGraphImage( RenderGraph *graph, uint32_t handle, VkImage image, const RenderGraphState *state ) {
+    // Without a state the image continues from wherever the previous frame left it
+    RenderGraphResource *resource = &graph->resources[ handle ];
+    resource->image.image = image;
+    if ( state == NULL ) return;
+
+    // An external state is treated as the last write, every following access orders against it
+    memset( &resource->sync, 0, sizeof( RenderGraphSync ) );
+    resource->sync.writeStage = state->stage;
+    resource->sync.writeAccess = state->access & RENDER_GRAPH_WRITE_ACCESS;
+    resource->sync.layout = state->layout;
+}
+void BindRenderGraphBuffer( RenderGraph *graph, uint32_t handle, VkBuffer buffer ) {
+    // Per frame buffers were last used behind the frame's fence, a new one starts without pending accesses
+    RenderGraphResource *resource = &graph->resources[ handle ];
+    if ( resource->buffer == buffer ) return;
+    resource->buffer = buffer;
+    memset( &resource->sync, 0, sizeof( RenderGraphSync ) );
+}
+const GpuImage *GetRenderGraphImage( const RenderGraph *graph, uint32_t handle ) {
+    if ( handle >= graph->resourceLength || graph->resources[ handle ].image.image == VK_NULL_HANDLE ) return NULL;
+    return &graph->resources[ handle ].image;
+}
+VkResult ExecuteRenderGraph( RenderGraph *graph, VkCommandBuffer commandBuffer ) {
+    graph->barrierLength = 0;
+    graph->skippedBarrierLength = 0;
+
+    for ( uint32_t i = 0; i < graph->passLength; i++ ) {
+        RenderGraphPass *pass = &graph->passes[ i ];
+        if ( pass->isCulled ) continue;
+
+        VkImageMemoryBarrier imageBarriers[ RENDER_GRAPH_MAX_ACCESSES ];
+        VkBufferMemoryBarrier bufferBarriers[ RENDER_GRAPH_MAX_ACCESSES ];
+        uint32_t imageBarrierLength = 0;
+        uint32_t bufferBarrierLength = 0;
+        VkPipelineStageFlags srcStage = 0;
+        VkPipelineStageFlags dstStage = 0;
+
+        for ( uint32_t a = 0; a < pass->accessLength; a++ ) {
+            const RenderGraphAccess *use = &pass->accesses[ a ];
+            RenderGraphResource *resource = &graph->resources[ use->resource ];
+            RenderGraphBlock *block = IsRenderGraphTransient( resource ) ? &graph->blocks[ resource->block ] : NULL;
+
+            // Transient contents never survive, the first use only waits for whatever used the memory last
+            RenderGraphSync previous = resource->sync;
+            if ( block != NULL && resource->firstPass == i ) {
+                previous = block->sync;
+                previous.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            }
+
+            // Writes and layout changes wait for the last write and every read since, a read only waits for
+            // the last write and only when no earlier read already made it visible to its stage and access
+            bool isLayoutChange = resource->type == RENDER_GRAPH_IMAGE && previous.layout != use->state.layout;
+            bool isWrite = IsRenderGraphWrite( use->state.access );
+            bool isCovered = ( use->state.stage & ~previous.readStage ) == 0 && ( use->state.access & ~previous.readAccess ) == 0;
+            VkPipelineStageFlags waitStage = 0;
+            bool isBarrier = false;
+            if ( isLayoutChange || isWrite ) {
+                waitStage = previous.writeStage | previous.readStage;
+                isBarrier = isLayoutChange || waitStage != 0;
+            } else if ( previous.writeStage != 0 && !isCovered ) {
+                waitStage = previous.writeStage;
+                isBarrier = true;
+            }
+
+            if ( isBarrier ) {
+                srcStage |= waitStage;
+                dstStage |= use->state.stage;
+
+                if ( resource->type == RENDER_GRAPH_IMAGE ) {
+                    VkImageMemoryBarrier barrier = {
+                        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                        .pNext = NULL,
+                        .srcAccessMask = previous.writeAccess,
+                        .dstAccessMask = use->state.access,
+                        .oldLayout = previous.layout,
+                        .newLayout = use->state.layout,
+                        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .image = resource->image.image,
+                        .subresourceRange = { resource->image.aspect, 0, resource->image.levelLength, 0, 1 }
+                    };
+                    imageBarriers[ imageBarrierLength++ ] = barrier;
+                } else {
+                    VkBufferMemoryBarrier barrier = {
+                        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                        .pNext = NULL,
+                        .srcAccessMask = previous.writeAccess,
+                        .dstAccessMask = use->state.access,
+                        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .buffer = resource->buffer,
+                        .offset = 0,
+                        .size = VK_WHOLE_SIZE
+                    };
+                    bufferBarriers[ bufferBarrierLength++ ] = barrier;
+                }
+            } else if ( previous.writeStage != 0 || previous.readStage != 0 ) {
+                graph->skippedBarrierLength++;
+            }
+
+            // A layout change acts as a write the reader that caused it already waited for
+            RenderGraphSync next = previous;
+            if ( isWrite || isLayoutChange ) {
+                next.writeStage = use->state.stage;
+                next.writeAccess = use->state.access & RENDER_GRAPH_WRITE_ACCESS;
+                next.readStage = 0;
+                next.readAccess = 0;
+            }
+            if ( !isWrite ) {
+                next.readStage |= use->state.stage;
+                next.readAccess |= use->state.access;
+            }
+            next.layout = use->state.layout;
+
+            resource->sync = next;
+            if ( block != NULL ) block->sync = next;
+        }
+
+        // All of a pass' transitions go out in one batch
+        if ( imageBarrierLength + bufferBarrierLength > 0 ) {
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                srcStage ? srcStage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                dstStage,
+                0, 0, NULL,
+                bufferBarrierLength, bufferBarriers,
+                imageBarrierLength, imageBarriers
+            );
+            graph->barrierLength += imageBarrierLength + bufferBarrierLength;
+        }
+
+        if ( pass->record != NULL ) {
+            VkResult result = pass->record( commandBuffer, pass->userData );
+            if ( result != VK_SUCCESS ) return result;
+        }
+    }
+
+    // Imported images leaving the frame in a fixed layout, the swap chain image for presentation
+    VkImageMemoryBarrier finalBarriers[ RENDER_GRAPH_MAX_RESOURCES ];
+    uint32_t finalBarrierLength = 0;
+    VkPipelineStageFlags finalStage = 0;
+    for ( uint32_t i = 0; i < graph->resourceLength; i++ ) {
+        RenderGraphResource *resource = &graph->resources[ i ];
+        if ( !resource->isImported || resource->type != RENDER_GRAPH_IMAGE ) continue;
+        if ( resource->finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource->sync.layout == resource->finalLayout ) continue;
+        if ( resource->image.image == VK_NULL_HANDLE || resource->firstPass == RENDER_GRAPH_INVALID ) continue;
+
+        VkImageMemoryBarrier barrier = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = NULL,
+            .srcAccessMask = resource->sync.writeAccess,
+            .dstAccessMask = 0,
+            .oldLayout = resource->sync.layout,
+            .newLayout = resource->finalLayout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = resource->image.image,
+            .subresourceRange = { resource->image.aspect, 0, resource->image.levelLength, 0, 1 }
+        };
+        finalBarriers[ finalBarrierLength++ ] = barrier;
+        finalStage |= resource->sync.writeStage | resource->sync.readStage;
+
+        memset( &resource->sync, 0, sizeof( RenderGraphSync ) );
+        resource->sync.writeStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        resource->sync.layout = resource->finalLayout;
+    }
+    if ( finalBarrierLength > 0 ) {
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            finalStage ? finalStage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, NULL, 0, NULL,
+            finalBarrierLength, finalBarriers
+        );
+        graph->barrierLength += finalBarrierLength;
+    }
+
+    return VK_SUCCESS;
+}
+void DestroyRenderGraph( RenderGraph *graph, VkDevice device ) {
+    method( "DestroyRenderGraph" );
+
+    // Graph images never own their memory, the blocks do
+    for ( uint32_t i = 0; i < graph->resourceLength; i++ ) {
+        RenderGraphResource *resource = &graph->resources[ i ];
+        if ( !resource->isImported ) DestroyGpuImage( device, &resource->image );
+    }
+    for ( uint32_t i = 0; i < graph->blockLength; i++ ) {
+        if ( graph->blocks[ i ].memory ) vkFreeMemory( device, graph->blocks[ i ].memory, NULL );
+    }
+    memset( graph, 0, sizeof( RenderGraph ) );
+
+    ok_method( "DestroyRenderGraph" );
+}
+
+/* HELPERS */
+uint32_t AddRenderGraphResource( RenderGraph *graph, const char *name, RenderGraphResourceType type ) {
+    if ( graph->isCompiled || graph->resourceLength == RENDER_GRAPH_MAX_RESOURCES ) {
+        fail_method( "AddRenderGraphResource", "can not add resource \"%s\"!\n", name );
+        return RENDER_GRAPH_INVALID;
+    }
+
+    RenderGraphResource *resource = &graph->resources[ graph->resourceLength ];
+    memset( resource, 0, sizeof( RenderGraphResource ) );
+    resource->name = name;
+    resource->type = type;
+    resource->sync.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource->finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource->firstPass = RENDER_GRAPH_INVALID;
+    resource->lastPass = RENDER_GRAPH_INVALID;
+    resource->block = RENDER_GRAPH_INVALID;
+    return graph->resourceLength++;
+}
+bool IsRenderGraphTransient( const RenderGraphResource *resource ) {
+    return !resource->isImported && !resource->isPersistent;
+}
+bool IsRenderGraphWrite( VkAccessFlags access ) {
+    return ( access & RENDER_GRAPH_WRITE_ACCESS ) != 0;
+}
+bool IsRenderGraphRead( VkAccessFlags access ) {
+    return ( access & ~RENDER_GRAPH_WRITE_ACCESS ) != 0;
+}
+void CullRenderGraphPasses( RenderGraph *graph ) {
+    // Walking back from the last pass, a pass lives when it writes something kept past the frame
+    // or something a later live pass reads
+    bool isRead[ RENDER_GRAPH_MAX_RESOURCES ] = { false };
+    graph->culledPassLength = 0;
+
+    for ( uint32_t i = graph->passLength; i-- > 0; ) {
+        RenderGraphPass *pass = &graph->passes[ i ];
+        bool isLive = pass->hasSideEffects;
+        for ( uint32_t a = 0; a < pass->accessLength && !isLive; a++ ) {
+            const RenderGraphAccess *use = &pass->accesses[ a ];
+            const RenderGraphResource *resource = &graph->resources[ use->resource ];
+            if ( !IsRenderGraphWrite( use->state.access ) ) continue;
+            isLive = resource->isImported || resource->isPersistent || isRead[ use->resource ];
+        }
+
+        pass->isCulled = !isLive;
+        if ( !isLive ) {
+            printf( "\tCulling render graph pass \"%s\"\n", pass->name );
+            graph->culledPassLength++;
+            continue;
+        }
+
+        for ( uint32_t a = 0; a < pass->accessLength; a++ ) {
+            const RenderGraphAccess *use = &pass->accesses[ a ];
+            if ( IsRenderGraphRead( use->state.access ) ) isRead[ use->resource ] = true;
+        }
+    }
+}
+VkResult CreateRenderGraphImages( RenderGraph *graph, VkDevice device, VkPhysicalDevice physicalDevice ) {
+    VkMemoryRequirements requirements[ RENDER_GRAPH_MAX_RESOURCES ];
+    uint32_t memoryTypes[ RENDER_GRAPH_MAX_RESOURCES ];
+    bool isPlaced[ RENDER_GRAPH_MAX_RESOURCES ] = { false };
+
+    // Images no live pass touches are never created
+    for ( uint32_t i = 0; i < graph->resourceLength; i++ ) {
+        RenderGraphResource *resource = &graph->resources[ i ];
+        if ( resource->isImported || resource->firstPass == RENDER_GRAPH_INVALID ) {
+            isPlaced[ i ] = true;
+            continue;
+        }
+
+        VkResult result = CreateUnboundGpuImage(
+            device,
+            resource->image.width,
+            resource->image.height,
+            resource->image.levelLength,
+            resource->image.format,
+            resource->usage,
+            resource->image.aspect,
+            &resource->image
+        );
+        if ( result != VK_SUCCESS ) return result;
+
+        // Attachment only images can live in lazily allocated memory where the device has it
+        vkGetImageMemoryRequirements( device, resource->image.image, &requirements[ i ] );
+        memoryTypes[ i ] = GPU_MEMORY_TYPE_NOT_FOUND;
+        if ( resource->usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT ) {
+            memoryTypes[ i ] = FindMemoryType(
+                physicalDevice,
+                requirements[ i ].memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+            );
+        }
+        if ( memoryTypes[ i ] == GPU_MEMORY_TYPE_NOT_FOUND ) {
+            memoryTypes[ i ] = FindMemoryType( physicalDevice, requirements[ i ].memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+        }
+        if ( memoryTypes[ i ] == GPU_MEMORY_TYPE_NOT_FOUND ) return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        graph->requestedMemorySize += requirements[ i ].size;
+    }
+
+    // Largest images are placed first, each joins the first block of its memory type whose images it never overlaps
+    for ( ;; ) {
+        uint32_t next = RENDER_GRAPH_INVALID;
+        for ( uint32_t i = 0; i < graph->resourceLength; i++ ) {
+            if ( isPlaced[ i ] ) continue;
+            if ( next == RENDER_GRAPH_INVALID || requirements[ i ].size > requirements[ next ].size ) next = i;
+        }
+        if ( next == RENDER_GRAPH_INVALID ) break;
+
+        RenderGraphResource *resource = &graph->resources[ next ];
+        for ( uint32_t b = 0; b < graph->blockLength && IsRenderGraphTransient( resource ); b++ ) {
+            if ( graph->blocks[ b ].memoryType != memoryTypes[ next ] ) continue;
+
+            bool isFree = true;
+            for ( uint32_t j = 0; j < graph->resourceLength && isFree; j++ ) {
+                const RenderGraphResource *other = &graph->resources[ j ];
+                if ( j == next || other->block != b ) continue;
+                isFree = IsRenderGraphTransient( other ) &&
+                    ( other->lastPass < resource->firstPass || resource->lastPass < other->firstPass );
+            }
+            if ( isFree ) {
+                resource->block = b;
+                break;
+            }
+        }
+
+        if ( resource->block == RENDER_GRAPH_INVALID ) {
+            RenderGraphBlock *block = &graph->blocks[ graph->blockLength ];
+            memset( block, 0, sizeof( RenderGraphBlock ) );
+            block->memoryType = memoryTypes[ next ];
+            block->sync.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            resource->block = graph->blockLength++;
+        }
+        RenderGraphBlock *block = &graph->blocks[ resource->block ];
+        block->size = max( block->size, requirements[ next ].size );
+        isPlaced[ next ] = true;
+    }
+
+    for ( uint32_t b = 0; b < graph->blockLength; b++ ) {
+        VkMemoryAllocateInfo allocInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = NULL,
+            .allocationSize = graph->blocks[ b ].size,
+            .memoryTypeIndex = graph->blocks[ b ].memoryType
+        };
+
+        VkResult result = vkAllocateMemory( device, &allocInfo, NULL, &graph->blocks[ b ].memory );
+        if ( result != VK_SUCCESS ) return result;
+        graph->allocatedMemorySize += graph->blocks[ b ].size;
+    }
+
+    for ( uint32_t i = 0; i < graph->resourceLength; i++ ) {
+        RenderGraphResource *resource = &graph->resources[ i ];
+        if ( resource->block == RENDER_GRAPH_INVALID ) continue;
+
+        VkResult result = BindGpuImageMemory( device, &resource->image, graph->blocks[ resource->block ].memory, 0 );
+        if ( result != VK_SUCCESS ) return result;
+    }
+
+    return VK_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#ifndef __RENDER_GRAPH__
+#define __RENDER_GRAPH__
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+#include "GpuImage.h"
+
+#define RENDER_GRAPH_MAX_RESOURCES 16
+#define RENDER_GRAPH_MAX_PASSES 8
+#define RENDER_GRAPH_MAX_ACCESSES 8
+#define RENDER_GRAPH_INVALID UINT32_MAX
+
+typedef enum {
+    RENDER_GRAPH_IMAGE,
+    RENDER_GRAPH_BUFFER
+} RenderGraphResourceType;
+
+// How a pass touches a resource
+typedef struct {
+    VkPipelineStageFlags stage;
+    VkAccessFlags access;
+    VkImageLayout layout;
+} RenderGraphState;
+
+// The last write to a resource and every read since, merged reads are already ordered after the write
+typedef struct {
+    VkPipelineStageFlags writeStage;
+    VkAccessFlags writeAccess;
+    VkPipelineStageFlags readStage;
+    VkAccessFlags readAccess;
+    VkImageLayout layout;
+} RenderGraphSync;
+
+/*
+ * Imported resources belong to the caller and are bound every frame, the graph only tracks their state.
+ * Graph images are created by CompileRenderGraph, transient ones lose their contents between frames
+ * and share memory with any other transient image whose passes do not overlap.
+ */
+typedef struct {
+    const char *name;
+    RenderGraphResourceType type;
+    bool isImported;
+    bool isPersistent;
+
+    GpuImage image;
+    VkImageUsageFlags usage;
+    VkBuffer buffer;
+    RenderGraphSync sync;
+    VkImageLayout finalLayout; // Imported images are moved here after the last pass, UNDEFINED leaves them as they are
+
+    uint32_t firstPass;
+    uint32_t lastPass;
+    uint32_t block;
+} RenderGraphResource;
+
+typedef struct {
+    uint32_t resource;
+    RenderGraphState state;
+} RenderGraphAccess;
+
+// Recording callbacks run between the barriers of their pass and the next one
+typedef VkResult ( *RenderGraphRecord )( VkCommandBuffer, void* );
+
+typedef struct {
+    const char *name;
+    RenderGraphAccess accesses[ RENDER_GRAPH_MAX_ACCESSES ];
+    uint32_t accessLength;
+    RenderGraphRecord record;
+    void *userData;
+    bool hasSideEffects;
+    bool isCulled;
+} RenderGraphPass;
+
+// Memory shared by transient images, the sync covers the accesses made through any of them
+typedef struct {
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    uint32_t memoryType;
+    RenderGraphSync sync;
+} RenderGraphBlock;
+
+typedef struct {
+    RenderGraphResource resources[ RENDER_GRAPH_MAX_RESOURCES ];
+    uint32_t resourceLength;
+    RenderGraphPass passes[ RENDER_GRAPH_MAX_PASSES ];
+    uint32_t passLength;
+    RenderGraphBlock blocks[ RENDER_GRAPH_MAX_RESOURCES ];
+    uint32_t blockLength;
+    bool isCompiled;
+
+    uint32_t culledPassLength;
+    VkDeviceSize requestedMemorySize;
+    VkDeviceSize allocatedMemorySize;
+    uint32_t barrierLength;
+    uint32_t skippedBarrierLength;
+} RenderGraph;
+
+uint32_t AddRenderGraphImage( RenderGraph*, const char*, uint32_t, uint32_t, uint32_t, VkFormat, VkImageUsageFlags, VkImageAspectFlags, bool );
+uint32_t ImportRenderGraphImage( RenderGraph*, const char*, VkImageAspectFlags, uint32_t, VkImageLayout );
+uint32_t ImportRenderGraphBuffer( RenderGraph*, const char* );
+uint32_t AddRenderGraphPass( RenderGraph*, const char*, RenderGraphRecord, void* );
+void UseRenderGraphResource( RenderGraph*, uint32_t, uint32_t, VkPipelineStageFlags, VkAccessFlags, VkImageLayout );
+VkResult CompileRenderGraph( RenderGraph*, VkDevice, VkPhysicalDevice );
+void BindRenderGraphImage( RenderGraph*, uint32_t, VkImage, const RenderGraphState* );
+void BindRenderGraphBuffer( RenderGraph*, uint32_t, VkBuffer );
+const GpuImage *GetRenderGraphImage( const RenderGraph*, uint32_t );
+VkResult ExecuteRenderGraph( RenderGraph*, VkCommandBuffer );
+void DestroyRenderGraph( RenderGraph*, VkDevice );
+
+#endif
@@ -0,0 +1,401 @@
+#include "HelloTriangleApplication.h"
+
+#define SPV_MAGIC 0x07230203
+#define SPV_HEADER_LENGTH 5
+
+#define SPV_OP_NAME 5
+#define SPV_OP_ENTRY_POINT 15
+#define SPV_OP_TYPE_INT 21
+#define SPV_OP_TYPE_FLOAT 22
+#define SPV_OP_TYPE_VECTOR 23
+#define SPV_OP_TYPE_MATRIX 24
+#define SPV_OP_TYPE_IMAGE 25
+#define SPV_OP_TYPE_SAMPLER 26
+#define SPV_OP_TYPE_SAMPLED_IMAGE 27
+#define SPV_OP_TYPE_ARRAY 28
+#define SPV_OP_TYPE_RUNTIME_ARRAY 29
+#define SPV_OP_TYPE_STRUCT 30
+#define SPV_OP_TYPE_POINTER 32
+#define SPV_OP_CONSTANT 43
+#define SPV_OP_VARIABLE 59
+#define SPV_OP_DECORATE 71
+#define SPV_OP_MEMBER_DECORATE 72
+
+#define SPV_DECORATION_BLOCK 2
+#define SPV_DECORATION_BUFFER_BLOCK 3
+#define SPV_DECORATION_ARRAY_STRIDE 6
+#define SPV_DECORATION_MATRIX_STRIDE 7
+#define SPV_DECORATION_BUILT_IN 11
+#define SPV_DECORATION_LOCATION 30
+#define SPV_DECORATION_BINDING 33
+#define SPV_DECORATION_DESCRIPTOR_SET 34
+#define SPV_DECORATION_OFFSET 35
+
+#define SPV_STORAGE_UNIFORM_CONSTANT 0
+#define SPV_STORAGE_INPUT 1
+#define SPV_STORAGE_UNIFORM 2
+#define SPV_STORAGE_PUSH_CONSTANT 9
+#define SPV_STORAGE_STORAGE_BUFFER 12
+
+#define SPV_EXECUTION_VERTEX 0
+#define SPV_EXECUTION_GEOMETRY 3
+#define SPV_EXECUTION_FRAGMENT 4
+#define SPV_EXECUTION_GL_COMPUTE 5
+
+#define SPV_DIM_BUFFER 5
+#define SPV_DIM_SUBPASS_DATA 6
+
+typedef struct {
+    const uint32_t *instruction;
+    uint32_t location;
+    uint32_t set;
+    uint32_t binding;
+    uint32_t arrayStride;
+    bool hasLocation;
+    bool hasBinding;
+    bool isBuiltIn;
+    bool isBufferBlock;
+    const char *name;
+} SpvId;
+
+typedef struct {
+    const uint32_t *code;
+    uint32_t length;
+    SpvId *ids;
+    uint32_t bound;
+} SpvContext;
+
+/* PRIVATE VISIBILITY */
+const uint32_t *SpvType( const SpvContext*, uint32_t );
+uint32_t SpvMemberDecoration( const SpvContext*, uint32_t, uint32_t, uint32_t, uint32_t );
+uint32_t SpvTypeSize( const SpvContext*, uint32_t, uint32_t );
+uint32_t SpvArrayLength( const SpvContext*, const uint32_t* );
+VkFormat SpvFormat( const SpvContext*, uint32_t, uint32_t* );
+bool SpvDescriptorType( const SpvContext*, uint32_t, uint32_t, VkDescriptorType* );
+void ReflectVariable( const SpvContext*, const uint32_t*, ShaderReflection* );
+
+/* METHODS */
+bool ReflectShader( const uint8_t *program, uint32_t programLength, ShaderReflection *reflection ) {
+    method( "ReflectShader" );
+
+    memset( reflection, 0, sizeof( ShaderReflection ) );
+
+    const uint32_t *code = ( const uint32_t* )program;
+    uint32_t length = programLength / sizeof( uint32_t );
+    if ( length < SPV_HEADER_LENGTH || code[ 0 ] != SPV_MAGIC ) {
+        fail_method( "ReflectShader", "not a SPIR-V module (%u bytes)\n", programLength );
+        return false;
+    }
+
+    SpvContext ctx = {
+        .code = code,
+        .length = length,
+        .ids = calloc( code[ 3 ], sizeof( SpvId ) ),
+        .bound = code[ 3 ]
+    };
+
+    // First pass: index result ids and their decorations
+    for ( uint32_t i = SPV_HEADER_LENGTH; i < length; ) {
+        const uint32_t *ins = &code[ i ];
+        uint32_t wordCount = ins[ 0 ] >> 16;
+        uint32_t opcode = ins[ 0 ] & 0xFFFF;
+        if ( wordCount == 0 || i + wordCount > length ) {
+            fail_method( "ReflectShader", "malformed instruction at word %u\n", i );
+            free( ctx.ids );
+            return false;
+        }
+
+        switch ( opcode ) {
+            case SPV_OP_NAME:
+                if ( ins[ 1 ] < ctx.bound ) ctx.ids[ ins[ 1 ] ].name = ( const char* )&ins[ 2 ];
+                break;
+            case SPV_OP_ENTRY_POINT:
+                switch ( ins[ 1 ] ) {
+                    case SPV_EXECUTION_VERTEX: reflection->stage = VK_SHADER_STAGE_VERTEX_BIT; break;
+                    case SPV_EXECUTION_GEOMETRY: reflection->stage = VK_SHADER_STAGE_GEOMETRY_BIT; break;
+                    case SPV_EXECUTION_FRAGMENT: reflection->stage = VK_SHADER_STAGE_FRAGMENT_BIT; break;
+                    case SPV_EXECUTION_GL_COMPUTE: reflection->stage = VK_SHADER_STAGE_COMPUTE_BIT; break;
+                }
+                break;
+            case SPV_OP_DECORATE: {
+                if ( ins[ 1 ] >= ctx.bound ) break;
+                SpvId *id = &ctx.ids[ ins[ 1 ] ];
+                switch ( ins[ 2 ] ) {
+                    case SPV_DECORATION_LOCATION: id->location = ins[ 3 ]; id->hasLocation = true; break;
+                    case SPV_DECORATION_BINDING: id->binding = ins[ 3 ]; id->hasBinding = true; break;
+                    case SPV_DECORATION_DESCRIPTOR_SET: id->set = ins[ 3 ]; break;
+                    case SPV_DECORATION_ARRAY_STRIDE: id->arrayStride = ins[ 3 ]; break;
+                    case SPV_DECORATION_BUILT_IN: id->isBuiltIn = true; break;
+                    case SPV_DECORATION_BUFFER_BLOCK: id->isBufferBlock = true; break;
+                }
+                break;
+            }
+            case SPV_OP_TYPE_INT:
+            case SPV_OP_TYPE_FLOAT:
+            case SPV_OP_TYPE_VECTOR:
+            case SPV_OP_TYPE_MATRIX:
+            case SPV_OP_TYPE_IMAGE:
+            case SPV_OP_TYPE_SAMPLER:
+            case SPV_OP_TYPE_SAMPLED_IMAGE:
+            case SPV_OP_TYPE_ARRAY:
+            case SPV_OP_TYPE_RUNTIME_ARRAY:
+            case SPV_OP_TYPE_STRUCT:
+            case SPV_OP_TYPE_POINTER:
+                if ( ins[ 1 ] < ctx.bound ) ctx.ids[ ins[ 1 ] ].instruction = ins;
+                break;
+            case SPV_OP_CONSTANT:
+            case SPV_OP_VARIABLE:
+                if ( ins[ 2 ] < ctx.bound ) ctx.ids[ ins[ 2 ] ].instruction = ins;
+                break;
+        }
+
+        i += wordCount;
+    }
+
+    // Second pass: resolve interface variables
+    for ( uint32_t i = 0; i < ctx.bound; i++ ) {
+        const uint32_t *ins = ctx.ids[ i ].instruction;
+        if ( ins != NULL && ( ins[ 0 ] & 0xFFFF ) == SPV_OP_VARIABLE ) ReflectVariable( &ctx, ins, reflection );
+    }
+
+    free( ctx.ids );
+
+    printf( "\t\tStage 0x%x: %u inputs, %u bindings, %u bytes of push constants\n",
+        reflection->stage,
+        reflection->inputLength,
+        reflection->bindingLength,
+        reflection->pushConstantSize
+    );
+    ok_method( "ReflectShader" );
+    return true;
+}
+void BuildVertexInputLayout( const ShaderReflection *reflection, VertexInputLayout *layout ) {
+    method( "BuildVertexInputLayout" );
+
+    memset( layout, 0, sizeof( VertexInputLayout ) );
+
+    // Attributes are packed tightly in location order, per-instance ones into their own binding
+    uint32_t strides[ 2 ] = { 0, 0 };
+    for ( uint32_t location = 0; layout->attributeLength < reflection->inputLength; location++ ) {
+        for ( uint32_t i = 0; i < reflection->inputLength; i++ ) {
+            const ShaderInput *input = &reflection->inputs[ i ];
+            if ( input->location != location ) continue;
+
+            bool isInstanced = strncmp( input->name, SHADER_INSTANCE_INPUT_PREFIX, strlen( SHADER_INSTANCE_INPUT_PREFIX ) ) == 0;
+            uint32_t binding = isInstanced ? VERTEX_BINDING_PER_INSTANCE : VERTEX_BINDING_PER_VERTEX;
+            VkVertexInputAttributeDescription attribute = {
+                .location = input->location,
+                .binding = binding,
+                .format = input->format,
+                .offset = strides[ binding ]
+            };
+            layout->attributes[ layout->attributeLength++ ] = attribute;
+            strides[ binding ] += input->size;
+        }
+    }
+
+    for ( uint32_t binding = 0; binding < 2; binding++ ) {
+        if ( strides[ binding ] == 0 ) continue;
+
+        VkVertexInputBindingDescription description = {
+            .binding = binding,
+            .stride = strides[ binding ],
+            .inputRate = binding == VERTEX_BINDING_PER_INSTANCE ?
+                VK_VERTEX_INPUT_RATE_INSTANCE :
+                VK_VERTEX_INPUT_RATE_VERTEX
+        };
+        layout->bindings[ layout->bindingLength++ ] = description;
+    }
+
+    ok_method( "BuildVertexInputLayout" );
+}
+
+/* SPIR-V HELPERS */
+const uint32_t *SpvType( const SpvContext *ctx, uint32_t typeId ) {
+    if ( typeId >= ctx->bound ) return NULL;
+    return ctx->ids[ typeId ].instruction;
+}
+uint32_t SpvMemberDecoration( const SpvContext *ctx, uint32_t structId, uint32_t member, uint32_t decoration, uint32_t fallback ) {
+    for ( uint32_t i = SPV_HEADER_LENGTH; i < ctx->length; i += ctx->code[ i ] >> 16 ) {
+        const uint32_t *ins = &ctx->code[ i ];
+        if ( ( ins[ 0 ] & 0xFFFF ) == SPV_OP_MEMBER_DECORATE &&
+             ins[ 1 ] == structId && ins[ 2 ] == member && ins[ 3 ] == decoration ) {
+            return ins[ 4 ];
+        }
+    }
+
+    return fallback;
+}
+uint32_t SpvArrayLength( const SpvContext *ctx, const uint32_t *array ) {
+    const uint32_t *constant = SpvType( ctx, array[ 3 ] );
+    if ( constant == NULL || ( constant[ 0 ] & 0xFFFF ) != SPV_OP_CONSTANT ) return 1;
+    return constant[ 3 ];
+}
+uint32_t SpvTypeSize( const SpvContext *ctx, uint32_t typeId, uint32_t matrixStride ) {
+    const uint32_t *type = SpvType( ctx, typeId );
+    if ( type == NULL ) return 0;
+
+    switch ( type[ 0 ] & 0xFFFF ) {
+        case SPV_OP_TYPE_INT:
+        case SPV_OP_TYPE_FLOAT:
+            return type[ 2 ] / 8;
+        case SPV_OP_TYPE_VECTOR:
+            return SpvTypeSize( ctx, type[ 2 ], 0 ) * type[ 3 ];
+        case SPV_OP_TYPE_MATRIX:
+            if ( matrixStride != 0 ) return matrixStride * type[ 3 ];
+            return SpvTypeSize( ctx, type[ 2 ], 0 ) * type[ 3 ];
+        case SPV_OP_TYPE_ARRAY: {
+            uint32_t stride = ctx->ids[ typeId ].arrayStride;
+            if ( stride == 0 ) stride = SpvTypeSize( ctx, type[ 2 ], matrixStride );
+            return stride * SpvArrayLength( ctx, type );
+        }
+        case SPV_OP_TYPE_STRUCT: {
+            uint32_t size = 0;
+            uint32_t memberLength = ( type[ 0 ] >> 16 ) - 2;
+            for ( uint32_t m = 0; m < memberLength; m++ ) {
+                uint32_t offset = SpvMemberDecoration( ctx, typeId, m, SPV_DECORATION_OFFSET, size );
+                uint32_t stride = SpvMemberDecoration( ctx, typeId, m, SPV_DECORATION_MATRIX_STRIDE, 0 );
+                size = max( size, offset + SpvTypeSize( ctx, type[ 2 + m ], stride ) );
+            }
+            return size;
+        }
+    }
+
+    return 0;
+}
+VkFormat SpvFormat( const SpvContext *ctx, uint32_t typeId, uint32_t *size ) {
+    static const VkFormat floatFormats[] = {
+        VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT
+    };
+    static const VkFormat intFormats[] = {
+        VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT
+    };
+    static const VkFormat uintFormats[] = {
+        VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT
+    };
+
+    const uint32_t *type = SpvType( ctx, typeId );
+    if ( type == NULL ) return VK_FORMAT_UNDEFINED;
+
+    uint32_t componentCount = 1;
+    if ( ( type[ 0 ] & 0xFFFF ) == SPV_OP_TYPE_VECTOR ) {
+        componentCount = type[ 3 ];
+        type = SpvType( ctx, type[ 2 ] );
+        if ( type == NULL ) return VK_FORMAT_UNDEFINED;
+    }
+    if ( componentCount < 1 || componentCount > 4 || type[ 2 ] != 32 ) return VK_FORMAT_UNDEFINED;
+
+    *size = componentCount * sizeof( uint32_t );
+    switch ( type[ 0 ] & 0xFFFF ) {
+        case SPV_OP_TYPE_FLOAT: return floatFormats[ componentCount - 1 ];
+        case SPV_OP_TYPE_INT: return type[ 3 ] ? intFormats[ componentCount - 1 ] : uintFormats[ componentCount - 1 ];
+    }
+
+    return VK_FORMAT_UNDEFINED;
+}
+bool SpvDescriptorType( const SpvContext *ctx, uint32_t typeId, uint32_t storageClass, VkDescriptorType *descriptorType ) {
+    const uint32_t *type = SpvType( ctx, typeId );
+    if ( type == NULL ) return false;
+
+    switch ( storageClass ) {
+        case SPV_STORAGE_UNIFORM:
+            *descriptorType = ctx->ids[ typeId ].isBufferBlock ?
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            return true;
+        case SPV_STORAGE_STORAGE_BUFFER:
+            *descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            return true;
+        case SPV_STORAGE_UNIFORM_CONSTANT:
+            switch ( type[ 0 ] & 0xFFFF ) {
+                case SPV_OP_TYPE_SAMPLER:
+                    *descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                    return true;
+                case SPV_OP_TYPE_SAMPLED_IMAGE:
+                    *descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    return true;
+                case SPV_OP_TYPE_IMAGE: {
+                    uint32_t dim = type[ 3 ];
+                    bool isStorage = type[ 7 ] == 2;
+                    if ( dim == SPV_DIM_BUFFER ) {
+                        *descriptorType = isStorage ?
+                            VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER :
+                            VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    } else if ( dim == SPV_DIM_SUBPASS_DATA ) {
+                        *descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    } else {
+                        *descriptorType = isStorage ?
+                            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE :
+                            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                    }
+                    return true;
+                }
+            }
+            break;
+    }
+
+    return false;
+}
+void ReflectVariable( const SpvContext *ctx, const uint32_t *variable, ShaderReflection *reflection ) {
+    const SpvId *id = &ctx->ids[ variable[ 2 ] ];
+    uint32_t storageClass = variable[ 3 ];
+    const uint32_t *pointer = SpvType( ctx, variable[ 1 ] );
+    if ( pointer == NULL || ( pointer[ 0 ] & 0xFFFF ) != SPV_OP_TYPE_POINTER ) return;
+    uint32_t typeId = pointer[ 3 ];
+
+    if ( storageClass == SPV_STORAGE_INPUT ) {
+        if ( reflection->stage != VK_SHADER_STAGE_VERTEX_BIT || id->isBuiltIn || !id->hasLocation ) return;
+
+        // Matrices take one location per column
+        uint32_t columnLength = 1;
+        const uint32_t *type = SpvType( ctx, typeId );
+        if ( type != NULL && ( type[ 0 ] & 0xFFFF ) == SPV_OP_TYPE_MATRIX ) {
+            columnLength = type[ 3 ];
+            typeId = type[ 2 ];
+        }
+
+        for ( uint32_t c = 0; c < columnLength && reflection->inputLength < SHADER_MAX_INPUTS; c++ ) {
+            ShaderInput *input = &reflection->inputs[ reflection->inputLength++ ];
+            input->location = id->location + c;
+            input->format = SpvFormat( ctx, typeId, &input->size );
+            if ( id->name != NULL ) strncpy( input->name, id->name, SHADER_MAX_NAME_SIZE - 1 );
+        }
+        return;
+    }
+
+    if ( storageClass == SPV_STORAGE_PUSH_CONSTANT ) {
+        const uint32_t *type = SpvType( ctx, typeId );
+        if ( type == NULL || ( type[ 0 ] & 0xFFFF ) != SPV_OP_TYPE_STRUCT ) return;
+
+        uint32_t offset = UINT32_MAX;
+        uint32_t memberLength = ( type[ 0 ] >> 16 ) - 2;
+        for ( uint32_t m = 0; m < memberLength; m++ ) {
+            offset = min( offset, SpvMemberDecoration( ctx, typeId, m, SPV_DECORATION_OFFSET, 0 ) );
+        }
+        if ( offset == UINT32_MAX ) offset = 0;
+
+        reflection->pushConstantOffset = offset;
+        reflection->pushConstantSize = SpvTypeSize( ctx, typeId, 0 ) - offset;
+        return;
+    }
+
+    if ( !id->hasBinding || reflection->bindingLength >= SHADER_MAX_BINDINGS ) return;
+
+    // Descriptor arrays, runtime arrays are reported as a single descriptor
+    uint32_t descriptorCount = 1;
+    const uint32_t *type = SpvType( ctx, typeId );
+    while ( type != NULL && ( ( type[ 0 ] & 0xFFFF ) == SPV_OP_TYPE_ARRAY || ( type[ 0 ] & 0xFFFF ) == SPV_OP_TYPE_RUNTIME_ARRAY ) ) {
+        if ( ( type[ 0 ] & 0xFFFF ) == SPV_OP_TYPE_ARRAY ) descriptorCount *= SpvArrayLength( ctx, type );
+        typeId = type[ 2 ];
+        type = SpvType( ctx, typeId );
+    }
+
+    VkDescriptorType descriptorType;
+    if ( !SpvDescriptorType( ctx, typeId, storageClass, &descriptorType ) ) return;
+
+    ShaderBinding *binding = &reflection->bindings[ reflection->bindingLength++ ];
+    binding->set = id->set;
+    binding->binding = id->binding;
+    binding->descriptorType = descriptorType;
+    binding->descriptorCount = descriptorCount;
+}
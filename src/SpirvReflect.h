@@ -0,0 +1,55 @@
+#ifndef __SPIRV_REFLECT__
+#define __SPIRV_REFLECT__
+
+#include <vulkan/vulkan.h>
+
+#include <stdbool.h>
+#include "utils.h"
+
+#define SHADER_MAX_INPUTS 16
+#define SHADER_MAX_BINDINGS 16
+#define SHADER_MAX_NAME_SIZE 64
+
+// Vertex inputs named with this prefix advance once per instance from their own binding
+#define SHADER_INSTANCE_INPUT_PREFIX "inInstance"
+#define VERTEX_BINDING_PER_VERTEX 0
+#define VERTEX_BINDING_PER_INSTANCE 1
+
+typedef struct {
+    uint32_t location;
+    VkFormat format;
+    uint32_t size;
+    char name[ SHADER_MAX_NAME_SIZE ];
+} ShaderInput;
+
+typedef struct {
+    uint32_t set;
+    uint32_t binding;
+    VkDescriptorType descriptorType;
+    uint32_t descriptorCount;
+} ShaderBinding;
+
+typedef struct {
+    VkShaderStageFlagBits stage;
+
+    ShaderInput inputs[ SHADER_MAX_INPUTS ];
+    uint32_t inputLength;
+
+    ShaderBinding bindings[ SHADER_MAX_BINDINGS ];
+    uint32_t bindingLength;
+
+    uint32_t pushConstantOffset;
+    uint32_t pushConstantSize;
+} ShaderReflection;
+
+typedef struct {
+    VkVertexInputBindingDescription bindings[ 2 ];
+    uint32_t bindingLength;
+    VkVertexInputAttributeDescription attributes[ SHADER_MAX_INPUTS ];
+    uint32_t attributeLength;
+} VertexInputLayout;
+
+bool ReflectShader( const uint8_t*, uint32_t, ShaderReflection* );
+void BuildVertexInputLayout( const ShaderReflection*, VertexInputLayout* );
+
+#endif
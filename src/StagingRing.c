@@ -0,0 +1,109 @@
+#include "HelloTriangleApplication.h"
+
+#define STAGING_RING_USAGE ( \
+    VK_BUFFER_USAGE_TRANSFER_SRC_BIT | \
+    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | \
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | \
+    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | \
+    VK_BUFFER_USAGE_INDEX_BUFFER_BIT | \
+    VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT \
+)
+
+/* METHODS */
+VkResult CreateStagingRing(
+    StagingRing *ring,
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    VkDeviceSize frameSize,
+    uint32_t frameLength
+) {
+    method( "CreateStagingRing" );
+
+    if ( frameLength == 0 || frameLength > STAGING_RING_MAX_FRAMES ) {
+        fail_method( "CreateStagingRing", "frame count %u is out of range!\n", frameLength );
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties( physicalDevice, &properties );
+
+    // Every allocation may be bound as a uniform or storage buffer range
+    VkDeviceSize minAlignment = max(
+        properties.limits.minUniformBufferOffsetAlignment,
+        properties.limits.minStorageBufferOffsetAlignment
+    );
+    minAlignment = max( minAlignment, 16 );
+    frameSize = ( frameSize + minAlignment - 1 ) & ~( minAlignment - 1 );
+
+    memset( ring, 0, sizeof( StagingRing ) );
+    ring->frameSize = frameSize;
+    ring->frameLength = frameLength;
+    ring->minAlignment = minAlignment;
+    atomic_init( &ring->head, 0 );
+    atomic_init( &ring->failedLength, 0 );
+
+    // Prefer device local host visible memory (resizable BAR), writes then skip a copy
+    VkResult result = CreateGpuBuffer(
+        device, physicalDevice, frameSize * frameLength, STAGING_RING_USAGE,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        &ring->buffer
+    );
+    if ( result != VK_SUCCESS ) {
+        result = CreateGpuBuffer(
+            device, physicalDevice, frameSize * frameLength, STAGING_RING_USAGE,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            &ring->buffer
+        );
+    }
+    if ( result != VK_SUCCESS ) {
+        fail_method( "CreateStagingRing", "failed to create staging buffer.\nError code: %d\n", result );
+        return result;
+    }
+
+    printf( "\t\tStaging ring: %u frames x %llu bytes, alignment %llu\n",
+        frameLength,
+        ( unsigned long long )frameSize,
+        ( unsigned long long )minAlignment
+    );
+    ok_method( "CreateStagingRing" );
+    return VK_SUCCESS;
+}
+void DestroyStagingRing( StagingRing *ring, VkDevice device ) {
+    DestroyGpuBuffer( device, &ring->buffer );
+    ring->frameLength = 0;
+}
+void BeginStagingFrame( StagingRing *ring, uint32_t frameIndex ) {
+    // The caller waited for this frame's fence, the GPU no longer reads its region
+    ring->frameUsed = atomic_load_explicit( &ring->head, memory_order_relaxed );
+    ring->peakUsed = max( ring->peakUsed, ring->frameUsed );
+    ring->frameIndex = frameIndex % ring->frameLength;
+    atomic_store_explicit( &ring->head, 0, memory_order_relaxed );
+}
+bool AllocateStaging( StagingRing *ring, VkDeviceSize size, VkDeviceSize alignment, StagingAllocation *allocation ) {
+    alignment = max( alignment, ring->minAlignment );
+
+    uint_fast64_t head = atomic_load_explicit( &ring->head, memory_order_relaxed );
+    uint_fast64_t offset;
+    do {
+        offset = ( head + alignment - 1 ) & ~( alignment - 1 );
+        if ( offset + size > ring->frameSize ) {
+            atomic_fetch_add_explicit( &ring->failedLength, 1, memory_order_relaxed );
+            return false;
+        }
+    } while ( !atomic_compare_exchange_weak_explicit(
+        &ring->head, &head, offset + size, memory_order_relaxed, memory_order_relaxed
+    ) );
+
+    VkDeviceSize frameOffset = ( VkDeviceSize )ring->frameIndex * ring->frameSize;
+    allocation->buffer = ring->buffer.buffer;
+    allocation->offset = frameOffset + offset;
+    allocation->size = size;
+    allocation->data = ( uint8_t* )ring->buffer.mapped + frameOffset + offset;
+    return true;
+}
+bool PushStaging( StagingRing *ring, const void *data, VkDeviceSize size, VkDeviceSize alignment, StagingAllocation *allocation ) {
+    if ( !AllocateStaging( ring, size, alignment, allocation ) ) return false;
+
+    memcpy( allocation->data, data, size );
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef __STAGING_RING__
+#define __STAGING_RING__
+
+#include <vulkan/vulkan.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "GpuBuffer.h"
+
+#define STAGING_RING_FRAME_SIZE ( 4 * 1024 * 1024 )
+#define STAGING_RING_MAX_FRAMES 4
+
+typedef struct {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void *data;
+} StagingAllocation;
+
+/*
+ * One persistently mapped, host coherent buffer split in a region per frame in flight.
+ * Allocations bump the head of the current region, the region is reclaimed as a whole
+ * once the fence of the frame that used it has signaled.
+ */
+typedef struct {
+    GpuBuffer buffer;
+    VkDeviceSize frameSize;
+    uint32_t frameLength;
+    uint32_t frameIndex;
+    VkDeviceSize minAlignment;
+    atomic_uint_fast64_t head;
+
+    VkDeviceSize frameUsed;
+    VkDeviceSize peakUsed;
+    atomic_uint failedLength;
+} StagingRing;
+
+VkResult CreateStagingRing( StagingRing*, VkDevice, VkPhysicalDevice, VkDeviceSize, uint32_t );
+void DestroyStagingRing( StagingRing*, VkDevice );
+void BeginStagingFrame( StagingRing*, uint32_t );
+bool AllocateStaging( StagingRing*, VkDeviceSize, VkDeviceSize, StagingAllocation* );
+bool PushStaging( StagingRing*, const void*, VkDeviceSize, VkDeviceSize, StagingAllocation* );
+
+#endif
@@ -1,11 +1,21 @@
 #version 450
 
+layout( set = 0, binding = 0 ) uniform CameraBuffer {
+    mat4 view;
+    mat4 proj;
+    mat4 viewProj;
+} camera;
+
+layout( std430, set = 0, binding = 1 ) readonly buffer ObjectBuffer {
+    mat4 models[];
+} objects;
+
 layout( location = 0 ) out vec3 fragColor;
 
 vec2 positions[ 3 ] = vec2[] (
-    vec2(  0.0, -0.5 ),
-    vec2(  0.5,  0.5 ),
-    vec2( -0.5,  0.5 )
+    vec2(  0.0,  0.5 ),
+    vec2(  0.5, -0.5 ),
+    vec2( -0.5, -0.5 )
 );
 
 vec3 colors[ 3 ] = vec3[] (
@@ -15,6 +25,7 @@ vec3 colors[ 3 ] = vec3[] (
 );
 
 void main() {
-    gl_Position = vec4( positions[ gl_VertexIndex ], 0.0, 1.0 );
+    mat4 model = objects.models[ gl_InstanceIndex ];
+    gl_Position = camera.viewProj * model * vec4( positions[ gl_VertexIndex ], 0.0, 1.0 );
     fragColor = colors[ gl_VertexIndex ];
 }
@@ -0,0 +1,38 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout( set = 0, binding = 0 ) uniform CameraBuffer {
+    mat4 view;
+    mat4 proj;
+    mat4 viewProj;
+} camera;
+
+// Bindless heap, every frame region of the staging ring holding the model matrices is its own buffer
+layout( std430, set = 1, binding = 0 ) readonly buffer ObjectBuffer {
+    mat4 models[];
+} buffers[];
+
+layout( push_constant ) uniform DrawData {
+    uint bufferIndex;
+    uint objectIndex;
+} draw;
+
+layout( location = 0 ) out vec3 fragColor;
+
+vec2 positions[ 3 ] = vec2[] (
+    vec2(  0.0,  0.5 ),
+    vec2(  0.5, -0.5 ),
+    vec2( -0.5, -0.5 )
+);
+
+vec3 colors[ 3 ] = vec3[] (
+    vec3( 1.0, 0.0, 0.0 ),
+    vec3( 0.0, 1.0, 0.0 ),
+    vec3( 0.0, 0.0, 1.0 )
+);
+
+void main() {
+    mat4 model = buffers[ draw.bufferIndex ].models[ draw.objectIndex ];
+    gl_Position = camera.viewProj * model * vec4( positions[ gl_VertexIndex ], 0.0, 1.0 );
+    fragColor = colors[ gl_VertexIndex ];
+}
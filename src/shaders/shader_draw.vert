@@ -0,0 +1,41 @@
+#version 450
+
+layout( set = 0, binding = 0 ) uniform CameraBuffer {
+    mat4 view;
+    mat4 proj;
+    mat4 viewProj;
+} camera;
+
+struct DrawData {
+    mat4 model;
+};
+
+// The same shader feeds both per-draw paths, only the source of the draw data changes
+#ifdef DRAW_DATA_UBO
+layout( set = 1, binding = 0 ) uniform DrawBuffer {
+    DrawData data;
+} draw;
+#else
+layout( push_constant ) uniform DrawBuffer {
+    DrawData data;
+} draw;
+#endif
+
+layout( location = 0 ) out vec3 fragColor;
+
+vec2 positions[ 3 ] = vec2[] (
+    vec2(  0.0,  0.5 ),
+    vec2(  0.5, -0.5 ),
+    vec2( -0.5, -0.5 )
+);
+
+vec3 colors[ 3 ] = vec3[] (
+    vec3( 1.0, 0.0, 0.0 ),
+    vec3( 0.0, 1.0, 0.0 ),
+    vec3( 0.0, 0.0, 1.0 )
+);
+
+void main() {
+    gl_Position = camera.viewProj * draw.data.model * vec4( positions[ gl_VertexIndex ], 0.0, 1.0 );
+    fragColor = colors[ gl_VertexIndex ];
+}
@@ -0,0 +1,30 @@
+#version 450
+
+layout( set = 0, binding = 0 ) uniform CameraBuffer {
+    mat4 view;
+    mat4 proj;
+    mat4 viewProj;
+} camera;
+
+// Per-instance stream, the inInstance prefix moves these into the instance rate binding
+layout( location = 0 ) in mat4 inInstanceModel;
+layout( location = 4 ) in vec4 inInstanceColor;
+
+layout( location = 0 ) out vec3 fragColor;
+
+vec2 positions[ 3 ] = vec2[] (
+    vec2(  0.0,  0.5 ),
+    vec2(  0.5, -0.5 ),
+    vec2( -0.5, -0.5 )
+);
+
+vec3 colors[ 3 ] = vec3[] (
+    vec3( 1.0, 0.0, 0.0 ),
+    vec3( 0.0, 1.0, 0.0 ),
+    vec3( 0.0, 0.0, 1.0 )
+);
+
+void main() {
+    gl_Position = camera.viewProj * inInstanceModel * vec4( positions[ gl_VertexIndex ], 0.0, 1.0 );
+    fragColor = colors[ gl_VertexIndex ] * inInstanceColor.rgb;
+}
@@ -29,3 +29,14 @@ char *GetRelativePath( const char* path, const char *filename, uint32_t *size )
     if ( size != NULL ) *size = exePathLength + filenameLength + 1;
     return exePath;
 }
+
+// FNV-1a, pass UTILS_HASH_SEED or a previous hash to chain blocks
+uint64_t HashBytes( const void *data, size_t size, uint64_t hash ) {
+    const uint8_t *bytes = ( const uint8_t* )data;
+    for ( size_t i = 0; i < size; i++ ) {
+        hash ^= bytes[ i ];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
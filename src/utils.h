@@ -18,9 +18,18 @@
     #define clamp( value, min_value, max_value ) ( min( max( value, min_value ), max_value ) )
 #endif
 
+#define entry(x) puts("[Entry] "x)
+#define ok(x) puts("~ "x)
+#define fail(x,err,params) printf("[Error] "err"\n~ "x, params)
+#define method(x) puts("\t[Method] "x)
+#define ok_method(x) puts("\t~ "x)
+#define fail_method(x,err,params) printf("\t[Error] "err"\n~ "x, params)
+
 #define UTILS_MAX_PATH_SIZE 512
+#define UTILS_HASH_SEED 0xCBF29CE484222325ULL
 
 char *GetExePath( const char*, uint32_t* );
 char *GetRelativePath( const char*, const char*, uint32_t* );
+uint64_t HashBytes( const void*, size_t, uint64_t );
 
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef __CGLM_BENCH__
+#define __CGLM_BENCH__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Only pointers and plain values, cglm's vector alignment differs between the kernel builds
+typedef struct {
+    float *streams[ 12 ];
+    float *inputs[ 2 ];
+    float *output;
+    float *planes;
+    uint32_t *mask;
+    void *scene;
+    float t;
+    size_t count;
+} BenchData;
+
+typedef enum {
+    BENCH_AABB_FRUSTUM_LOOP,
+    BENCH_AABB_FRUSTUM_SOA,
+    BENCH_MAT4_MUL_LOOP,
+    BENCH_MAT4_MUL_ARRAY,
+    BENCH_MAT4_MULV_LOOP,
+    BENCH_MAT4_MULV_ARRAY,
+    BENCH_MAT4_MULV3_ARRAY,
+    BENCH_MAT4_MULV3_SOA,
+    BENCH_MAT4_INV,
+    BENCH_MAT3_MUL,
+    BENCH_QUAT_MUL,
+    BENCH_QUAT_MAT4,
+    BENCH_QUAT_SLERP_LOOP,
+    BENCH_QUAT_SLERP_SOA,
+    BENCH_QUAT_NLERP_LOOP,
+    BENCH_QUAT_NLERP_SOA,
+    BENCH_SPHERE_TRANSFORM_LOOP,
+    BENCH_SPHERE_TRANSFORM_ARRAY,
+    BENCH_SPHERE_MERGE_ARRAY,
+    BENCH_FRUSTUM_CASCADES,
+    BENCH_FRUSTUM_CASCADES_LOOP,
+    BENCH_PACK_HALF_LOOP,
+    BENCH_PACK_HALF_ARRAY,
+    BENCH_UNPACK_HALF_LOOP,
+    BENCH_UNPACK_HALF_ARRAY,
+    BENCH_PACK_UNORM8_LOOP,
+    BENCH_PACK_UNORM8_ARRAY,
+    BENCH_PACK_SNORM16_ARRAY,
+    BENCH_UNPACK_SNORM16_ARRAY,
+    BENCH_PACK_OCT_LOOP,
+    BENCH_PACK_OCT_ARRAY,
+    BENCH_PACK_UNORM1010102_LOOP,
+    BENCH_PACK_UNORM1010102_ARRAY,
+    BENCH_BVH_BUILD,
+    BENCH_BVH_RAY_RANDOM,
+    BENCH_BVH_RAY_COHERENT,
+    BENCH_KERNEL_COUNT
+} BenchKernelId;
+
+typedef void ( *BenchKernel )( BenchData* );
+
+// cglm_bench_kernels.c built once per instruction set, see the bench target
+extern const BenchKernel BenchKernelsScalar[ BENCH_KERNEL_COUNT ];
+extern const BenchKernel BenchKernelsSse2[ BENCH_KERNEL_COUNT ];
+extern const BenchKernel BenchKernelsAvx2[ BENCH_KERNEL_COUNT ];
+extern const BenchKernel BenchKernelsAvx512[ BENCH_KERNEL_COUNT ];
+
+#endif
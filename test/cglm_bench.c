@@ -0,0 +1,441 @@
+// Measures cglm's batch kernels against per-element loops on every instruction set this CPU has, items per second
+// Usage: cglm-bench [case name filter]
+#define _POSIX_C_SOURCE 199309L
+#include "bench.h"
+#include <cglm/cglm.h>
+#include <float.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_VARIANTS 4
+#define BENCH_MAX_ALLOCATIONS 32
+#define BENCH_ROUNDS 5
+#define BENCH_ROUND_SECONDS 0.04
+#define BENCH_TERRAIN_WIDTH 1000
+#define BENCH_TERRAIN_DEPTH 500
+#define BENCH_TERRAIN_TRIANGLES ( BENCH_TERRAIN_WIDTH * BENCH_TERRAIN_DEPTH * 2 )
+
+typedef struct {
+    BenchKernelId id;
+    const char *name;
+} BenchVariant;
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    size_t count;
+    void ( *Setup )( BenchData*, size_t );
+    BenchVariant variants[ BENCH_MAX_VARIANTS ];
+} BenchCase;
+
+/* PRIVATE VISIBILITY */
+void SetupAabbFrustum( BenchData*, size_t );
+void SetupMat4MulArray( BenchData*, size_t );
+void SetupMat4Mulv( BenchData*, size_t );
+void SetupSingleCalls( BenchData*, size_t );
+void SetupQuatInterpolation( BenchData*, size_t );
+void SetupSphereBounds( BenchData*, size_t );
+void SetupFrustumCascades( BenchData*, size_t );
+void SetupPack( BenchData*, size_t );
+void SetupBvhBuild( BenchData*, size_t );
+void SetupBvhRays( BenchData*, size_t );
+void SetupBvhTerrain( BenchData* );
+
+double TimeKernel( BenchKernel, BenchData* );
+bool IsIsaSupported( uint32_t );
+void *AllocBench( size_t );
+void FreeBenchAllocations( void );
+float RandomFloat( float, float );
+double GetSeconds( void );
+
+static const BenchCase BENCH_CASES[] = {
+    { "aabb frustum", "boxes", 1000000, SetupAabbFrustum, {
+        { BENCH_AABB_FRUSTUM_LOOP, "glm_aabb_frustum" },
+        { BENCH_AABB_FRUSTUM_SOA, "glm_aabb_frustum_soa" }
+    } },
+    // Fits in L1 and L2, then streams from memory
+    { "mat4 mul array", "matrices", 512, SetupMat4MulArray, {
+        { BENCH_MAT4_MUL_LOOP, "glm_mat4_mul" },
+        { BENCH_MAT4_MUL_ARRAY, "glm_mat4_mul_array" }
+    } },
+    { "mat4 mul array", "matrices", 100000, SetupMat4MulArray, {
+        { BENCH_MAT4_MUL_LOOP, "glm_mat4_mul" },
+        { BENCH_MAT4_MUL_ARRAY, "glm_mat4_mul_array" }
+    } },
+    // One transform over a vertex batch in L1, then over 64 MB, where the array kernels switch to streaming stores
+    { "mat4 mulv array", "vectors", 4096, SetupMat4Mulv, {
+        { BENCH_MAT4_MULV_LOOP, "glm_mat4_mulv" },
+        { BENCH_MAT4_MULV_ARRAY, "glm_mat4_mulv_array" },
+        { BENCH_MAT4_MULV3_ARRAY, "glm_mat4_mulv3_array" },
+        { BENCH_MAT4_MULV3_SOA, "glm_mat4_mulv3_soa" }
+    } },
+    { "mat4 mulv array", "vectors", 1 << 22, SetupMat4Mulv, {
+        { BENCH_MAT4_MULV_LOOP, "glm_mat4_mulv" },
+        { BENCH_MAT4_MULV_ARRAY, "glm_mat4_mulv_array" },
+        { BENCH_MAT4_MULV3_ARRAY, "glm_mat4_mulv3_array" },
+        { BENCH_MAT4_MULV3_SOA, "glm_mat4_mulv3_soa" }
+    } },
+    // Independent calls over arrays that stay in L1, so the rows compare the instruction sets
+    { "single calls", "calls", 1024, SetupSingleCalls, {
+        { BENCH_MAT4_INV, "glm_mat4_inv" },
+        { BENCH_MAT3_MUL, "glm_mat3_mul" },
+        { BENCH_QUAT_MUL, "glm_quat_mul" },
+        { BENCH_QUAT_MAT4, "glm_quat_mat4" }
+    } },
+    // One pose blend of 10k skeletons with 64 bones each
+    { "quat interpolation", "bones", 10000 * 64, SetupQuatInterpolation, {
+        { BENCH_QUAT_SLERP_LOOP, "glm_quat_slerp" },
+        { BENCH_QUAT_SLERP_SOA, "glm_quat_slerp_soa" },
+        { BENCH_QUAT_NLERP_LOOP, "glm_quat_nlerp" },
+        { BENCH_QUAT_NLERP_SOA, "glm_quat_nlerp_soa" }
+    } },
+    // Per frame culling bounds of a scene, as the app builds them for its indirect draws
+    { "sphere bounds", "spheres", 100000, SetupSphereBounds, {
+        { BENCH_SPHERE_TRANSFORM_LOOP, "glm_sphere_transform" },
+        { BENCH_SPHERE_TRANSFORM_ARRAY, "glm_sphere_transform_array" },
+        { BENCH_SPHERE_MERGE_ARRAY, "glm_sphere_merge_array" }
+    } },
+    // Shadow cascades of many cameras, e.g. one per view of a split screen or per cube face
+    { "frustum cascades", "cameras", 1024, SetupFrustumCascades, {
+        { BENCH_FRUSTUM_CASCADES, "glm_frustum_cascades" },
+        { BENCH_FRUSTUM_CASCADES_LOOP, "glm_frustum_box loop" }
+    } },
+    // Vertex attributes of a 64K vertex mesh, scalars for the component wise formats and vectors for the others
+    { "half pack", "floats", 65536, SetupPack, {
+        { BENCH_PACK_HALF_LOOP, "glm_pack_half" },
+        { BENCH_PACK_HALF_ARRAY, "glm_pack_half_array" },
+        { BENCH_UNPACK_HALF_LOOP, "glm_unpack_half" },
+        { BENCH_UNPACK_HALF_ARRAY, "glm_unpack_half_array" }
+    } },
+    { "norm pack", "floats", 65536, SetupPack, {
+        { BENCH_PACK_UNORM8_LOOP, "glm_pack_unorm8" },
+        { BENCH_PACK_UNORM8_ARRAY, "glm_pack_unorm8_array" },
+        { BENCH_PACK_SNORM16_ARRAY, "glm_pack_snorm16_array" },
+        { BENCH_UNPACK_SNORM16_ARRAY, "glm_unpack_snorm16_array" }
+    } },
+    { "vector pack", "vectors", 65536, SetupPack, {
+        { BENCH_PACK_OCT_LOOP, "glm_pack_oct" },
+        { BENCH_PACK_OCT_ARRAY, "glm_pack_oct_array" },
+        { BENCH_PACK_UNORM1010102_LOOP, "glm_pack_unorm1010102" },
+        { BENCH_PACK_UNORM1010102_ARRAY, "glm_pack_unorm1010102_array" }
+    } },
+    // Picking against a 1M triangle terrain, scattered rays and a camera's worth of neighbouring ones
+    { "bvh build", "triangles", BENCH_TERRAIN_TRIANGLES, SetupBvhBuild, {
+        { BENCH_BVH_BUILD, "glm_bvh_build" }
+    } },
+    { "bvh rays", "rays", 256 * 256, SetupBvhRays, {
+        { BENCH_BVH_RAY_RANDOM, "glm_bvh_ray random" },
+        { BENCH_BVH_RAY_COHERENT, "glm_bvh_ray coherent" }
+    } }
+};
+#define BENCH_CASE_COUNT ( sizeof( BENCH_CASES ) / sizeof( BENCH_CASES[ 0 ] ) )
+
+static const struct {
+    const char *name;
+    const BenchKernel *kernels;
+} BENCH_ISAS[] = {
+    { "scalar", BenchKernelsScalar },
+    { "sse2", BenchKernelsSse2 },
+    { "avx2", BenchKernelsAvx2 },
+    { "avx512", BenchKernelsAvx512 }
+};
+#define BENCH_ISA_COUNT ( sizeof( BENCH_ISAS ) / sizeof( BENCH_ISAS[ 0 ] ) )
+
+static void *allocations[ BENCH_MAX_ALLOCATIONS ];
+static uint32_t allocationLength = 0;
+
+/* METHODS */
+int main( int argc, char **argv ) {
+    srand( 1 );
+
+    const char *filter = argc > 1 ? argv[ 1 ] : NULL;
+    for ( uint32_t c = 0; c < BENCH_CASE_COUNT; c++ ) {
+        const BenchCase *benchCase = &BENCH_CASES[ c ];
+        if ( filter != NULL && strstr( benchCase->name, filter ) == NULL ) continue;
+
+        BenchData data;
+        memset( &data, 0, sizeof( BenchData ) );
+        benchCase->Setup( &data, benchCase->count );
+
+        printf( "%s, %zu %s (M%s/s)\n%-8s", benchCase->name, benchCase->count, benchCase->unit, benchCase->unit, "" );
+        for ( uint32_t v = 0; v < BENCH_MAX_VARIANTS && benchCase->variants[ v ].name != NULL; v++ ) {
+            printf( " %24s", benchCase->variants[ v ].name );
+        }
+        putchar( '\n' );
+
+        for ( uint32_t isa = 0; isa < BENCH_ISA_COUNT; isa++ ) {
+            if ( !IsIsaSupported( isa ) ) {
+                printf( "%-8s %24s\n", BENCH_ISAS[ isa ].name, "not supported" );
+                continue;
+            }
+
+            printf( "%-8s", BENCH_ISAS[ isa ].name );
+            for ( uint32_t v = 0; v < BENCH_MAX_VARIANTS && benchCase->variants[ v ].name != NULL; v++ ) {
+                double seconds = TimeKernel( BENCH_ISAS[ isa ].kernels[ benchCase->variants[ v ].id ], &data );
+                printf( " %24.1f", ( double )benchCase->count / seconds * 1e-6 );
+            }
+            putchar( '\n' );
+        }
+        putchar( '\n' );
+
+        FreeBenchAllocations();
+    }
+
+    return 0;
+}
+void SetupAabbFrustum( BenchData *data, size_t count ) {
+    // Boxes spread around the view, roughly a third of them visible
+    mat4 proj, view, viewProj;
+    glm_perspective( glm_rad( 60.0f ), 1.5f, 0.1f, 100.0f, proj );
+    glm_lookat( ( vec3 ){ 3.0f, 2.0f, 10.0f }, ( vec3 ){ 0.0f, 0.0f, 0.0f }, ( vec3 ){ 0.0f, 1.0f, 0.0f }, view );
+    glm_mat4_mul( proj, view, viewProj );
+
+    data->planes = AllocBench( 6 * sizeof( vec4 ) );
+    glm_frustum_planes( viewProj, ( vec4* )data->planes );
+
+    for ( uint32_t k = 0; k < 6; k++ ) data->streams[ k ] = AllocBench( count * sizeof( float ) );
+    for ( size_t i = 0; i < count; i++ ) {
+        vec3 center = { RandomFloat( -60.0f, 60.0f ), RandomFloat( -60.0f, 60.0f ), RandomFloat( -120.0f, 20.0f ) };
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            float extent = RandomFloat( 0.0f, 5.0f );
+            data->streams[ k ][ i ] = center[ k ] - extent;
+            data->streams[ k + 3 ][ i ] = center[ k ] + extent;
+        }
+    }
+
+    data->mask = AllocBench( ( count + 31 ) / 32 * sizeof( uint32_t ) );
+    data->count = count;
+}
+void SetupMat4MulArray( BenchData *data, size_t count ) {
+    for ( uint32_t k = 0; k < 2; k++ ) {
+        data->inputs[ k ] = AllocBench( count * sizeof( mat4 ) );
+        for ( size_t i = 0; i < count * 16; i++ ) data->inputs[ k ][ i ] = RandomFloat( -1.0f, 1.0f );
+    }
+
+    data->output = AllocBench( count * sizeof( mat4 ) );
+    data->count = count;
+}
+void SetupMat4Mulv( BenchData *data, size_t count ) {
+    // The vec4 arrays also hold the vec3 ones, the SoA kernel reads streams 0 to 2 and writes 3 to 5
+    data->inputs[ 0 ] = AllocBench( sizeof( mat4 ) );
+    glm_translate_make( ( vec4* )data->inputs[ 0 ], ( vec3 ){ 1.0f, 2.0f, 3.0f } );
+    glm_rotate( ( vec4* )data->inputs[ 0 ], 0.5f, ( vec3 ){ 0.0f, 1.0f, 0.0f } );
+
+    data->inputs[ 1 ] = AllocBench( count * sizeof( vec4 ) );
+    data->output = AllocBench( count * sizeof( vec4 ) );
+    for ( size_t i = 0; i < count * 4; i++ ) data->inputs[ 1 ][ i ] = RandomFloat( -1.0f, 1.0f );
+    for ( uint32_t k = 0; k < 6; k++ ) {
+        data->streams[ k ] = AllocBench( count * sizeof( float ) );
+        for ( size_t i = 0; k < 3 && i < count; i++ ) data->streams[ k ][ i ] = data->inputs[ 1 ][ i * 4 + k ];
+    }
+
+    data->count = count;
+}
+void SetupSingleCalls( BenchData *data, size_t count ) {
+    // Diagonally dominant, so every matrix has an inverse, the same floats serve as mat3s and quaternions
+    SetupMat4MulArray( data, count );
+    for ( uint32_t k = 0; k < 2; k++ ) {
+        for ( size_t i = 0; i < count; i++ ) {
+            for ( uint32_t c = 0; c < 4; c++ ) data->inputs[ k ][ i * 16 + c * 5 ] += c % 2 == 0 ? 5.0f : -5.0f;
+        }
+    }
+}
+void SetupQuatInterpolation( BenchData *data, size_t count ) {
+    // The same unit quaternions as versor arrays for the loops and as x y z w streams for the SoA kernels
+    data->inputs[ 0 ] = AllocBench( count * sizeof( versor ) );
+    data->inputs[ 1 ] = AllocBench( count * sizeof( versor ) );
+    data->output = AllocBench( count * sizeof( versor ) );
+    for ( uint32_t k = 0; k < 12; k++ ) data->streams[ k ] = AllocBench( count * sizeof( float ) );
+
+    for ( size_t i = 0; i < count; i++ ) {
+        for ( uint32_t j = 0; j < 2; j++ ) {
+            float *q = &data->inputs[ j ][ i * 4 ];
+            for ( uint32_t k = 0; k < 4; k++ ) q[ k ] = RandomFloat( -1.0f, 1.0f );
+            glm_quat_normalize( q );
+            for ( uint32_t k = 0; k < 4; k++ ) data->streams[ j * 4 + k ][ i ] = q[ k ];
+        }
+    }
+
+    data->t = 0.3f;
+    data->count = count;
+}
+void SetupSphereBounds( BenchData *data, size_t count ) {
+    data->inputs[ 0 ] = AllocBench( count * sizeof( vec4 ) );
+    data->inputs[ 1 ] = AllocBench( count * sizeof( mat4 ) );
+    data->output = AllocBench( count * sizeof( vec4 ) );
+    data->planes = AllocBench( sizeof( vec4 ) );
+
+    vec4 *spheres = ( vec4* )data->inputs[ 0 ];
+    mat4 *transforms = ( mat4* )data->inputs[ 1 ];
+    for ( size_t i = 0; i < count; i++ ) {
+        glm_vec4_copy( ( vec4 ){ RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( 0.1f, 2.0f ) }, spheres[ i ] );
+        glm_translate_make( transforms[ i ], ( vec3 ){ RandomFloat( -50.0f, 50.0f ), RandomFloat( -50.0f, 50.0f ), RandomFloat( -50.0f, 50.0f ) } );
+        glm_rotate_z( transforms[ i ], RandomFloat( -GLM_PIf, GLM_PIf ), transforms[ i ] );
+    }
+
+    data->count = count;
+}
+void SetupFrustumCascades( BenchData *data, size_t count ) {
+    // Cameras around the origin looking anywhere, one light, the light view and near, far go to planes
+    data->inputs[ 0 ] = AllocBench( count * 8 * sizeof( vec4 ) );
+    data->output = AllocBench( count * 4 * sizeof( mat4 ) );
+    data->planes = AllocBench( sizeof( mat4 ) + 2 * sizeof( float ) );
+    data->planes[ 16 ] = 0.1f;
+    data->planes[ 17 ] = 200.0f;
+    glm_look_anyup( GLM_VEC3_ZERO, ( vec3 ){ 0.3f, -1.0f, 0.2f }, ( vec4* )data->planes );
+
+    mat4 proj;
+    glm_perspective( glm_rad( 60.0f ), 1.5f, data->planes[ 16 ], data->planes[ 17 ], proj );
+    for ( size_t i = 0; i < count; i++ ) {
+        mat4 view, viewProj;
+        vec3 eye = { RandomFloat( -50.0f, 50.0f ), RandomFloat( 1.0f, 20.0f ), RandomFloat( -50.0f, 50.0f ) };
+        vec3 target = { RandomFloat( -50.0f, 50.0f ), 0.0f, RandomFloat( -50.0f, 50.0f ) };
+        glm_lookat( eye, target, GLM_YUP, view );
+        glm_mat4_mul( proj, view, viewProj );
+        glm_mat4_inv( viewProj, viewProj );
+        glm_frustum_corners( viewProj, ( vec4* )&data->inputs[ 0 ][ i * 32 ] );
+    }
+
+    data->t = 0.75f;
+    data->count = count;
+}
+void SetupPack( BenchData *data, size_t count ) {
+    // Room for count vec4 on every side, a few values out of range so the clamps see work
+    data->inputs[ 0 ] = AllocBench( count * sizeof( vec4 ) );
+    data->inputs[ 1 ] = AllocBench( count * sizeof( vec3 ) );
+    data->output = AllocBench( count * sizeof( vec4 ) );
+    data->mask = AllocBench( count * sizeof( vec4 ) );
+    for ( size_t i = 0; i < count * 4; i++ ) data->inputs[ 0 ][ i ] = RandomFloat( -1.1f, 1.1f );
+    for ( size_t i = 0; i < count; i++ ) {
+        float *n = &data->inputs[ 1 ][ i * 3 ];
+        glm_vec3_copy( ( vec3 ){ RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ) }, n );
+        glm_vec3_normalize( n );
+    }
+
+    // Halves and snorm16 share the 16 bit inputs, either decodes to a finite value
+    uint16_t *packed = ( uint16_t* )data->mask;
+    for ( size_t i = 0; i < count; i++ ) packed[ i ] = glm_pack_half( data->inputs[ 0 ][ i ] );
+
+    data->count = count;
+}
+void SetupBvhBuild( BenchData *data, size_t count ) {
+    SetupBvhTerrain( data );
+    data->count = count;
+}
+void SetupBvhRays( BenchData *data, size_t count ) {
+    SetupBvhTerrain( data );
+    glm_bvh_build( ( glm_bvh* )data->scene, ( vec3* )data->streams[ 0 ], BENCH_TERRAIN_TRIANGLES );
+
+    // Random rays start anywhere above the terrain and point at any of it, coherent ones fan out of one camera
+    data->inputs[ 0 ] = AllocBench( count * 6 * sizeof( float ) );
+    data->inputs[ 1 ] = AllocBench( count * 6 * sizeof( float ) );
+    data->output = AllocBench( count * sizeof( float ) );
+
+    uint32_t side = ( uint32_t )sqrt( ( double )count );
+    vec3 eye = { BENCH_TERRAIN_WIDTH * 0.5f, 60.0f, -20.0f };
+    for ( size_t i = 0; i < count; i++ ) {
+        float *random = &data->inputs[ 0 ][ i * 6 ], *coherent = &data->inputs[ 1 ][ i * 6 ];
+
+        glm_vec3_copy( ( vec3 ){ RandomFloat( 0.0f, BENCH_TERRAIN_WIDTH ), RandomFloat( 20.0f, 100.0f ), RandomFloat( 0.0f, BENCH_TERRAIN_DEPTH ) }, random );
+        vec3 target = { RandomFloat( 0.0f, BENCH_TERRAIN_WIDTH ), 0.0f, RandomFloat( 0.0f, BENCH_TERRAIN_DEPTH ) };
+        glm_vec3_sub( target, random, &random[ 3 ] );
+        glm_vec3_normalize( &random[ 3 ] );
+
+        float x = ( float )( i % side ) / ( float )side - 0.5f, y = ( float )( i / side ) / ( float )side - 0.5f;
+        glm_vec3_copy( eye, coherent );
+        glm_vec3_copy( ( vec3 ){ x, y * 0.5f - 0.35f, 1.0f }, &coherent[ 3 ] );
+        glm_vec3_normalize( &coherent[ 3 ] );
+    }
+
+    data->count = count;
+}
+// Rolling hills with a little noise hashed from the grid position, so neighbouring cells share their corners
+void SetupBvhTerrain( BenchData *data ) {
+    vec3 *verts = AllocBench( BENCH_TERRAIN_TRIANGLES * 3 * sizeof( vec3 ) );
+    data->streams[ 0 ] = verts[ 0 ];
+
+    glm_bvh *bvh = AllocBench( sizeof( glm_bvh ) );
+    bvh->nodes = AllocBench( ( 2 * BENCH_TERRAIN_TRIANGLES - 1 ) * sizeof( glm_bvh_node ) );
+    bvh->index = AllocBench( BENCH_TERRAIN_TRIANGLES * sizeof( uint32_t ) );
+    for ( uint32_t k = 0; k < 9; k++ ) bvh->tri[ k ] = AllocBench( BENCH_TERRAIN_TRIANGLES * sizeof( float ) );
+    data->scene = bvh;
+
+    vec3 *v = verts;
+    for ( uint32_t z = 0; z < BENCH_TERRAIN_DEPTH; z++ ) {
+        for ( uint32_t x = 0; x < BENCH_TERRAIN_WIDTH; x++ ) {
+            vec3 corners[ 4 ];
+            for ( uint32_t c = 0; c < 4; c++ ) {
+                float cx = ( float )( x + c % 2 ), cz = ( float )( z + c / 2 );
+                corners[ c ][ 0 ] = cx;
+                float noise = sinf( cx * 12.9898f + cz * 78.233f ) * 43758.547f;
+                corners[ c ][ 1 ] = 8.0f * sinf( cx * 0.05f ) * cosf( cz * 0.07f ) + 0.3f * ( noise - floorf( noise ) );
+                corners[ c ][ 2 ] = cz;
+            }
+
+            glm_vec3_copy( corners[ 0 ], v[ 0 ] );
+            glm_vec3_copy( corners[ 2 ], v[ 1 ] );
+            glm_vec3_copy( corners[ 1 ], v[ 2 ] );
+            glm_vec3_copy( corners[ 1 ], v[ 3 ] );
+            glm_vec3_copy( corners[ 2 ], v[ 4 ] );
+            glm_vec3_copy( corners[ 3 ], v[ 5 ] );
+            v += 6;
+        }
+    }
+}
+
+/* HELPERS */
+// Best of a few rounds, each round long enough to hide the clock resolution
+double TimeKernel( BenchKernel kernel, BenchData *data ) {
+    uint32_t calls = 1;
+    kernel( data );
+    for ( ;; ) {
+        double start = GetSeconds();
+        for ( uint32_t i = 0; i < calls; i++ ) kernel( data );
+        if ( GetSeconds() - start >= BENCH_ROUND_SECONDS ) break;
+        calls *= 2;
+    }
+
+    double best = DBL_MAX;
+    for ( uint32_t round = 0; round < BENCH_ROUNDS; round++ ) {
+        double start = GetSeconds();
+        for ( uint32_t i = 0; i < calls; i++ ) kernel( data );
+        best = glm_min( best, ( GetSeconds() - start ) / calls );
+    }
+    return best;
+}
+bool IsIsaSupported( uint32_t isa ) {
+    __builtin_cpu_init();
+    switch ( isa ) {
+        case 2:
+            return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) && __builtin_cpu_supports( "f16c" );
+        case 3:
+            return IsIsaSupported( 2 ) && __builtin_cpu_supports( "avx512f" );
+        default:
+            return true;
+    }
+}
+void *AllocBench( size_t size ) {
+    // Cache line aligned so every instruction set sees the same layout
+    void *memory = aligned_alloc( 64, ( size + 63 ) & ~( size_t )63 );
+    if ( memory == NULL || allocationLength == BENCH_MAX_ALLOCATIONS ) {
+        puts( "Failed to allocate bench memory!" );
+        exit( 1 );
+    }
+
+    allocations[ allocationLength++ ] = memory;
+    return memory;
+}
+void FreeBenchAllocations() {
+    while ( allocationLength > 0 ) free( allocations[ --allocationLength ] );
+}
+float RandomFloat( float min, float max ) {
+    return min + ( max - min ) * ( ( float )rand() / ( float )RAND_MAX );
+}
+double GetSeconds() {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( double )now.tv_sec + ( double )now.tv_nsec * 1e-9;
+}
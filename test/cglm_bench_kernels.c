@@ -0,0 +1,275 @@
+// Bench kernels, the bench target builds this file once per instruction set and names the table with BENCH_KERNELS
+#include "bench.h"
+#include <cglm/cglm.h>
+#include <string.h>
+
+#ifndef BENCH_KERNELS
+    #error "BENCH_KERNELS must name the kernel table, see the bench target"
+#endif
+
+/* PRIVATE VISIBILITY */
+// Static, every instruction set build links its own copy
+static void AabbFrustumLoop( BenchData* );
+static void AabbFrustumSoa( BenchData* );
+static void Mat4MulLoop( BenchData* );
+static void Mat4MulArray( BenchData* );
+static void Mat4MulvLoop( BenchData* );
+static void Mat4MulvArray( BenchData* );
+static void Mat4Mulv3Array( BenchData* );
+static void Mat4Mulv3Soa( BenchData* );
+static void Mat4Inv( BenchData* );
+static void Mat3Mul( BenchData* );
+static void QuatMul( BenchData* );
+static void QuatMat4( BenchData* );
+static void QuatSlerpLoop( BenchData* );
+static void QuatSlerpSoa( BenchData* );
+static void QuatNlerpLoop( BenchData* );
+static void QuatNlerpSoa( BenchData* );
+static void SphereTransformLoop( BenchData* );
+static void SphereTransformArray( BenchData* );
+static void SphereMergeArray( BenchData* );
+static void FrustumCascades( BenchData* );
+static void FrustumCascadesLoop( BenchData* );
+static void PackHalfLoop( BenchData* );
+static void PackHalfArray( BenchData* );
+static void UnpackHalfLoop( BenchData* );
+static void UnpackHalfArray( BenchData* );
+static void PackUnorm8Loop( BenchData* );
+static void PackUnorm8Array( BenchData* );
+static void PackSnorm16Array( BenchData* );
+static void UnpackSnorm16Array( BenchData* );
+static void PackOctLoop( BenchData* );
+static void PackOctArray( BenchData* );
+static void PackUnorm1010102Loop( BenchData* );
+static void PackUnorm1010102Array( BenchData* );
+static void BvhBuild( BenchData* );
+static void BvhRayRandom( BenchData* );
+static void BvhRayCoherent( BenchData* );
+static void TraceBvhRays( BenchData*, const float* );
+
+const BenchKernel BENCH_KERNELS[ BENCH_KERNEL_COUNT ] = {
+    [ BENCH_AABB_FRUSTUM_LOOP ] = AabbFrustumLoop,
+    [ BENCH_AABB_FRUSTUM_SOA ] = AabbFrustumSoa,
+    [ BENCH_MAT4_MUL_LOOP ] = Mat4MulLoop,
+    [ BENCH_MAT4_MUL_ARRAY ] = Mat4MulArray,
+    [ BENCH_MAT4_MULV_LOOP ] = Mat4MulvLoop,
+    [ BENCH_MAT4_MULV_ARRAY ] = Mat4MulvArray,
+    [ BENCH_MAT4_MULV3_ARRAY ] = Mat4Mulv3Array,
+    [ BENCH_MAT4_MULV3_SOA ] = Mat4Mulv3Soa,
+    [ BENCH_MAT4_INV ] = Mat4Inv,
+    [ BENCH_MAT3_MUL ] = Mat3Mul,
+    [ BENCH_QUAT_MUL ] = QuatMul,
+    [ BENCH_QUAT_MAT4 ] = QuatMat4,
+    [ BENCH_QUAT_SLERP_LOOP ] = QuatSlerpLoop,
+    [ BENCH_QUAT_SLERP_SOA ] = QuatSlerpSoa,
+    [ BENCH_QUAT_NLERP_LOOP ] = QuatNlerpLoop,
+    [ BENCH_QUAT_NLERP_SOA ] = QuatNlerpSoa,
+    [ BENCH_SPHERE_TRANSFORM_LOOP ] = SphereTransformLoop,
+    [ BENCH_SPHERE_TRANSFORM_ARRAY ] = SphereTransformArray,
+    [ BENCH_SPHERE_MERGE_ARRAY ] = SphereMergeArray,
+    [ BENCH_FRUSTUM_CASCADES ] = FrustumCascades,
+    [ BENCH_FRUSTUM_CASCADES_LOOP ] = FrustumCascadesLoop,
+    [ BENCH_PACK_HALF_LOOP ] = PackHalfLoop,
+    [ BENCH_PACK_HALF_ARRAY ] = PackHalfArray,
+    [ BENCH_UNPACK_HALF_LOOP ] = UnpackHalfLoop,
+    [ BENCH_UNPACK_HALF_ARRAY ] = UnpackHalfArray,
+    [ BENCH_PACK_UNORM8_LOOP ] = PackUnorm8Loop,
+    [ BENCH_PACK_UNORM8_ARRAY ] = PackUnorm8Array,
+    [ BENCH_PACK_SNORM16_ARRAY ] = PackSnorm16Array,
+    [ BENCH_UNPACK_SNORM16_ARRAY ] = UnpackSnorm16Array,
+    [ BENCH_PACK_OCT_LOOP ] = PackOctLoop,
+    [ BENCH_PACK_OCT_ARRAY ] = PackOctArray,
+    [ BENCH_PACK_UNORM1010102_LOOP ] = PackUnorm1010102Loop,
+    [ BENCH_PACK_UNORM1010102_ARRAY ] = PackUnorm1010102Array,
+    [ BENCH_BVH_BUILD ] = BvhBuild,
+    [ BENCH_BVH_RAY_RANDOM ] = BvhRayRandom,
+    [ BENCH_BVH_RAY_COHERENT ] = BvhRayCoherent
+};
+
+/* METHODS */
+static void AabbFrustumLoop( BenchData *data ) {
+    // One glm_aabb_frustum call per box, the way callers tested boxes before the SoA kernels
+    vec4 *planes = ( vec4* )data->planes;
+    for ( size_t i = 0; i < data->count; i++ ) {
+        vec3 box[ 2 ] = {
+            { data->streams[ 0 ][ i ], data->streams[ 1 ][ i ], data->streams[ 2 ][ i ] },
+            { data->streams[ 3 ][ i ], data->streams[ 4 ][ i ], data->streams[ 5 ][ i ] }
+        };
+
+        if ( ( i & 31 ) == 0 ) data->mask[ i >> 5 ] = 0;
+        data->mask[ i >> 5 ] |= ( uint32_t )glm_aabb_frustum( box, planes ) << ( i & 31 );
+    }
+}
+static void AabbFrustumSoa( BenchData *data ) {
+    float *min[ 3 ] = { data->streams[ 0 ], data->streams[ 1 ], data->streams[ 2 ] };
+    float *max[ 3 ] = { data->streams[ 3 ], data->streams[ 4 ], data->streams[ 5 ] };
+    glm_aabb_frustum_soa( min, max, data->count, ( vec4* )data->planes, data->mask );
+}
+static void Mat4MulLoop( BenchData *data ) {
+    mat4 *m1 = ( mat4* )data->inputs[ 0 ], *m2 = ( mat4* )data->inputs[ 1 ], *dest = ( mat4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_mat4_mul( m1[ i ], m2[ i ], dest[ i ] );
+}
+static void Mat4MulArray( BenchData *data ) {
+    glm_mat4_mul_array( ( mat4* )data->inputs[ 0 ], ( mat4* )data->inputs[ 1 ], data->count, ( mat4* )data->output );
+}
+static void Mat4MulvLoop( BenchData *data ) {
+    vec4 *v = ( vec4* )data->inputs[ 1 ], *dest = ( vec4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_mat4_mulv( ( vec4* )data->inputs[ 0 ], v[ i ], dest[ i ] );
+}
+static void Mat4MulvArray( BenchData *data ) {
+    glm_mat4_mulv_array( ( vec4* )data->inputs[ 0 ], ( vec4* )data->inputs[ 1 ], data->count, ( vec4* )data->output );
+}
+static void Mat4Mulv3Array( BenchData *data ) {
+    glm_mat4_mulv3_array( ( vec4* )data->inputs[ 0 ], ( vec3* )data->inputs[ 1 ], 1.0f, data->count, ( vec3* )data->output );
+}
+static void Mat4Mulv3Soa( BenchData *data ) {
+    glm_mat4_mulv3_soa( ( vec4* )data->inputs[ 0 ], &data->streams[ 0 ], 1.0f, data->count, &data->streams[ 3 ] );
+}
+static void Mat4Inv( BenchData *data ) {
+    mat4 *m = ( mat4* )data->inputs[ 0 ], *dest = ( mat4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_mat4_inv( m[ i ], dest[ i ] );
+}
+static void Mat3Mul( BenchData *data ) {
+    mat3 *m1 = ( mat3* )data->inputs[ 0 ], *m2 = ( mat3* )data->inputs[ 1 ], *dest = ( mat3* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_mat3_mul( m1[ i ], m2[ i ], dest[ i ] );
+}
+static void QuatMul( BenchData *data ) {
+    versor *p = ( versor* )data->inputs[ 0 ], *q = ( versor* )data->inputs[ 1 ], *dest = ( versor* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_quat_mul( p[ i ], q[ i ], dest[ i ] );
+}
+static void QuatMat4( BenchData *data ) {
+    versor *q = ( versor* )data->inputs[ 0 ];
+    mat4 *dest = ( mat4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_quat_mat4( q[ i ], dest[ i ] );
+}
+static void QuatSlerpLoop( BenchData *data ) {
+    versor *from = ( versor* )data->inputs[ 0 ], *to = ( versor* )data->inputs[ 1 ], *dest = ( versor* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_quat_slerp( from[ i ], to[ i ], data->t, dest[ i ] );
+}
+static void QuatSlerpSoa( BenchData *data ) {
+    glm_quat_slerp_soa( &data->streams[ 0 ], &data->streams[ 4 ], data->t, data->count, &data->streams[ 8 ] );
+}
+static void QuatNlerpLoop( BenchData *data ) {
+    versor *from = ( versor* )data->inputs[ 0 ], *to = ( versor* )data->inputs[ 1 ], *dest = ( versor* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) glm_quat_nlerp( from[ i ], to[ i ], data->t, dest[ i ] );
+}
+static void QuatNlerpSoa( BenchData *data ) {
+    glm_quat_nlerp_soa( &data->streams[ 0 ], &data->streams[ 4 ], data->t, data->count, &data->streams[ 8 ] );
+}
+static void SphereTransformLoop( BenchData *data ) {
+    // glm_sphere_transform keeps the radius, so the loop scales it the way the array kernel does
+    vec4 *s = ( vec4* )data->inputs[ 0 ], *dest = ( vec4* )data->output;
+    mat4 *m = ( mat4* )data->inputs[ 1 ];
+    for ( size_t i = 0; i < data->count; i++ ) {
+        float scale = glm_max( glm_vec3_norm2( m[ i ][ 0 ] ), glm_max( glm_vec3_norm2( m[ i ][ 1 ] ), glm_vec3_norm2( m[ i ][ 2 ] ) ) );
+        glm_sphere_transform( s[ i ], m[ i ], dest[ i ] );
+        dest[ i ][ 3 ] *= sqrtf( scale );
+    }
+}
+static void SphereTransformArray( BenchData *data ) {
+    glm_sphere_transform_array( ( vec4* )data->inputs[ 0 ], ( mat4* )data->inputs[ 1 ], data->count, ( vec4* )data->output );
+}
+static void SphereMergeArray( BenchData *data ) {
+    glm_sphere_merge_array( ( vec4* )data->inputs[ 0 ], data->count, data->planes );
+}
+static void FrustumCascades( BenchData *data ) {
+    // Splits and 4 stabilized cascades per camera, corners are 8 vec4 per camera and near, far follow in planes
+    vec4 *corners = ( vec4* )data->inputs[ 0 ], *lightView = ( vec4* )data->planes;
+    mat4 *proj = ( mat4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) {
+        float splits[ 5 ];
+        vec4 planeCorners[ 5 ][ 4 ];
+        vec3 boxes[ 4 ][ 2 ];
+        glm_frustum_splits( data->planes[ 16 ], data->planes[ 17 ], data->t, 4, splits );
+        glm_frustum_cascades( &corners[ i * 8 ], data->planes[ 16 ], data->planes[ 17 ], splits, 4, lightView, 2048.0f,
+                              planeCorners, boxes, &proj[ i * 4 ] );
+    }
+}
+static void FrustumCascadesLoop( BenchData *data ) {
+    // The same splits with glm_frustum_corners_at, glm_frustum_box and glm_ortho_aabb per cascade, not stabilized
+    vec4 *corners = ( vec4* )data->inputs[ 0 ], *lightView = ( vec4* )data->planes;
+    mat4 *proj = ( mat4* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) {
+        float splits[ 5 ];
+        vec4 cascade[ 8 ], plane[ 4 ];
+        vec3 box[ 2 ];
+        glm_frustum_splits( data->planes[ 16 ], data->planes[ 17 ], data->t, 4, splits );
+        memcpy( cascade, &corners[ i * 8 ], sizeof( plane ) );
+        for ( uint32_t c = 0; c < 4; c++ ) {
+            glm_frustum_corners_at( &corners[ i * 8 ], splits[ c + 1 ], data->planes[ 17 ], plane );
+            memcpy( &cascade[ 4 ], plane, sizeof( plane ) );
+            glm_frustum_box( cascade, lightView, box );
+            glm_ortho_aabb( box, proj[ i * 4 + c ] );
+            memcpy( cascade, plane, sizeof( plane ) );
+        }
+    }
+}
+static void PackHalfLoop( BenchData *data ) {
+    // Floats come from inputs 0, packed values go to output, packed inputs of the unpack kernels are in mask
+    uint16_t *dest = ( uint16_t* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) dest[ i ] = glm_pack_half( data->inputs[ 0 ][ i ] );
+}
+static void PackHalfArray( BenchData *data ) {
+    glm_pack_half_array( data->inputs[ 0 ], data->count, ( uint16_t* )data->output );
+}
+static void UnpackHalfLoop( BenchData *data ) {
+    uint16_t *v = ( uint16_t* )data->mask;
+    for ( size_t i = 0; i < data->count; i++ ) data->output[ i ] = glm_unpack_half( v[ i ] );
+}
+static void UnpackHalfArray( BenchData *data ) {
+    glm_unpack_half_array( ( uint16_t* )data->mask, data->count, data->output );
+}
+static void PackUnorm8Loop( BenchData *data ) {
+    uint8_t *dest = ( uint8_t* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) dest[ i ] = glm_pack_unorm8( data->inputs[ 0 ][ i ] );
+}
+static void PackUnorm8Array( BenchData *data ) {
+    glm_pack_unorm8_array( data->inputs[ 0 ], data->count, ( uint8_t* )data->output );
+}
+static void PackSnorm16Array( BenchData *data ) {
+    glm_pack_snorm16_array( data->inputs[ 0 ], data->count, ( int16_t* )data->output );
+}
+static void UnpackSnorm16Array( BenchData *data ) {
+    glm_unpack_snorm16_array( ( int16_t* )data->mask, data->count, data->output );
+}
+static void PackOctLoop( BenchData *data ) {
+    // Unit normals in inputs 1, vec4 colors in inputs 0
+    vec3 *n = ( vec3* )data->inputs[ 1 ];
+    uint32_t *dest = ( uint32_t* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) dest[ i ] = glm_pack_oct( n[ i ] );
+}
+static void PackOctArray( BenchData *data ) {
+    glm_pack_oct_array( ( vec3* )data->inputs[ 1 ], data->count, ( uint32_t* )data->output );
+}
+static void PackUnorm1010102Loop( BenchData *data ) {
+    vec4 *v = ( vec4* )data->inputs[ 0 ];
+    uint32_t *dest = ( uint32_t* )data->output;
+    for ( size_t i = 0; i < data->count; i++ ) dest[ i ] = glm_pack_unorm1010102( v[ i ] );
+}
+static void PackUnorm1010102Array( BenchData *data ) {
+    glm_pack_unorm1010102_array( ( vec4* )data->inputs[ 0 ], data->count, ( uint32_t* )data->output );
+}
+static void BvhBuild( BenchData *data ) {
+    // Rebuilds the scene's BVH in place, the result is the same every time
+    glm_bvh_build( ( glm_bvh* )data->scene, ( vec3* )data->streams[ 0 ], data->count );
+}
+static void BvhRayRandom( BenchData *data ) {
+    TraceBvhRays( data, data->inputs[ 0 ] );
+}
+static void BvhRayCoherent( BenchData *data ) {
+    TraceBvhRays( data, data->inputs[ 1 ] );
+}
+
+/* HELPERS */
+// Rays are origin and direction, 6 floats each, the nearest distance of each goes to output
+static void TraceBvhRays( BenchData *data, const float *rays ) {
+    glm_bvh *bvh = ( glm_bvh* )data->scene;
+    for ( size_t i = 0; i < data->count; i++ ) {
+        vec3 origin = { rays[ i * 6 ], rays[ i * 6 + 1 ], rays[ i * 6 + 2 ] };
+        vec3 direction = { rays[ i * 6 + 3 ], rays[ i * 6 + 4 ], rays[ i * 6 + 5 ] };
+        float d = FLT_MAX;
+        size_t tri;
+        glm_bvh_ray( bvh, origin, direction, &d, &tri );
+        data->output[ i ] = d;
+    }
+}
@@ -0,0 +1,50 @@
+// Built with the SSE macros undefined, every cglm call here takes the plain C path
+#include "test.h"
+
+#ifdef CGLM_SIMD_x86
+    #error "cglm_scalar.c must be built without SIMD, see the test target"
+#endif
+
+void ScalarMat4Inv( mat4 mat, mat4 dest ) {
+    glm_mat4_inv( mat, dest );
+}
+void ScalarMat4Mul( mat4 m1, mat4 m2, mat4 dest ) {
+    glm_mat4_mul( m1, m2, dest );
+}
+void ScalarMat4Mulv( mat4 m, vec4 v, vec4 dest ) {
+    glm_mat4_mulv( m, v, dest );
+}
+void ScalarMat4Mulv3( mat4 m, vec3 v, float last, vec3 dest ) {
+    glm_mat4_mulv3( m, v, last, dest );
+}
+void ScalarMat3Mul( mat3 m1, mat3 m2, mat3 dest ) {
+    glm_mat3_mul( m1, m2, dest );
+}
+void ScalarQuatMat4( versor q, mat4 dest ) {
+    glm_quat_mat4( q, dest );
+}
+void ScalarQuatMul( versor p, versor q, versor dest ) {
+    glm_quat_mul( p, q, dest );
+}
+void ScalarQuatSlerpSoa( float *from[ 4 ], float *to[ 4 ], float t, size_t count, float *dest[ 4 ] ) {
+    glm_quat_slerp_soa( from, to, t, count, dest );
+}
+void ScalarQuatNlerpSoa( float *from[ 4 ], float *to[ 4 ], float t, size_t count, float *dest[ 4 ] ) {
+    glm_quat_nlerp_soa( from, to, t, count, dest );
+}
+void ScalarAabbFrustumSoa( float *min[ 3 ], float *max[ 3 ], size_t count, vec4 planes[ 6 ], uint32_t *visible ) {
+    glm_aabb_frustum_soa( min, max, count, planes, visible );
+}
+bool ScalarRayTriangleSoa( vec3 origin, vec3 direction, float *tri[ 9 ], size_t count, float *d, size_t *index ) {
+    return glm_ray_triangle_soa( origin, direction, tri, count, d, index );
+}
+void ScalarFrustumCascades( vec4 corners[ 8 ], float nearZ, float farZ, float *splits, size_t count, mat4 lightView, float size,
+                            vec4 planeCorners[][ 4 ], vec3 boxes[][ 2 ], mat4 *proj ) {
+    glm_frustum_cascades( corners, nearZ, farZ, splits, count, lightView, size, planeCorners, boxes, proj );
+}
+void ScalarSphereTransformArray( vec4 *s, mat4 *m, size_t count, vec4 *dest ) {
+    glm_sphere_transform_array( s, m, count, dest );
+}
+void ScalarSphereMergeArray( vec4 *s, size_t count, vec4 dest ) {
+    glm_sphere_merge_array( s, count, dest );
+}
@@ -0,0 +1,1330 @@
+// Compares the SIMD paths of cglm against its scalar code and checks a few regressions, exits non-zero on any failure
+#include "test.h"
+#include <cglm/dispatch.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef CGLM_AVX2_FP
+    #error "cglm_test.c must be built with AVX2 and FMA, see the test target"
+#endif
+
+// The test target also builds this file for AVX-512, the glm_* calls then take the AVX-512 paths
+#ifdef CGLM_AVX512_FP
+    #define TEST_BUILD_NAME "AVX-512"
+#else
+    #define TEST_BUILD_NAME "AVX2"
+#endif
+
+#define TEST_ITERATIONS 100000
+#define AABB_TEST_LENGTH 100003
+#define MAT4_ARRAY_LENGTH 64
+#define MULV_ARRAY_MAX_COUNT 40
+#define MULV_ARRAY_LENGTH ( ( 1 << 19 ) + 8 ) // Past CGLM_STREAM_MIN_BYTES for every layout, so the streaming stores run too
+#define MULV_TOLERANCE 2e-6f
+#define QUAT_SOA_LENGTH 4096
+#define QUAT_SOA_MAX_COUNT 40
+#define SPHERE_ARRAY_LENGTH 1024
+#define RAY_SOA_LENGTH 1024
+#define RAY_SOA_MAX_COUNT 40
+#define CASCADE_TEST_CAMERAS 20000
+#define CASCADE_MAX_COUNT 8
+#define DISPATCH_LENGTH 1003
+#define BVH_TEST_SCENES 6
+#define BVH_TEST_TRIANGLES 3000
+#define BVH_TEST_CLUSTER 400
+#define BVH_TEST_RAYS 2000
+#define SPHERE_ARRAY_MAX_COUNT 40
+#define PACK_ARRAY_ROUNDS 100
+#define PACK_ARRAY_MAX_COUNT 40
+#define PACK_ARRAY_LENGTH ( PACK_ARRAY_MAX_COUNT + 4 )
+
+// Inputs of every glmd_* function, and what one kernel set made of them
+typedef struct {
+    mat4 m1[ DISPATCH_LENGTH ], m2[ DISPATCH_LENGTH ];
+    vec4 v4[ DISPATCH_LENGTH ], spheres[ DISPATCH_LENGTH ];
+    vec3 v3[ DISPATCH_LENGTH ];
+    mat3 m3[ 2 ];
+    float streams[ 9 ][ DISPATCH_LENGTH ], boxes[ 6 ][ DISPATCH_LENGTH ];
+    vec3 triangles[ DISPATCH_LENGTH * 3 ];
+    vec3 rays[ 64 ][ 2 ];
+    vec4 planes[ 6 ];
+    glm_bvh_node nodes[ 2 * DISPATCH_LENGTH - 1 ];
+    uint32_t index[ DISPATCH_LENGTH ];
+    float tri[ 9 ][ DISPATCH_LENGTH ];
+    glm_bvh bvh;
+    uint16_t halves[ DISPATCH_LENGTH ];
+} DispatchInputs;
+
+typedef struct {
+    mat4 mat4Mul, mat4Inv, mat4InvFast, mat4Transpose, quatMat4;
+    mat4 mat4MulArray[ DISPATCH_LENGTH ];
+    vec4 mat4Mulv, quatMul, sphereMerge;
+    vec4 mulvArray[ DISPATCH_LENGTH ], sphereTransform[ DISPATCH_LENGTH ];
+    vec3 mulv3Array[ DISPATCH_LENGTH ];
+    float mulv3Soa[ 3 ][ DISPATCH_LENGTH ], slerpSoa[ 4 ][ DISPATCH_LENGTH ], nlerpSoa[ 4 ][ DISPATCH_LENGTH ];
+    mat3 mat3Mul;
+    uint32_t visible[ ( DISPATCH_LENGTH + 31 ) / 32 ];
+    float rayDistance[ 64 ], bvhDistance[ 64 ];
+    size_t rayIndex[ 64 ], bvhIndex[ 64 ];
+    uint16_t packed[ DISPATCH_LENGTH ];
+    float unpacked[ DISPATCH_LENGTH ];
+} DispatchResults;
+
+// Largest round trip error of each format, half a step plus float rounding
+static const struct {
+    const char *name;
+    float maxError;
+} PACK_FORMATS[] = {
+    { "glm_pack_unorm8", 0.5f / 255.0f + 1e-6f },
+    { "glm_pack_snorm8", 0.5f / 127.0f + 1e-6f },
+    { "glm_pack_unorm16", 0.5f / 65535.0f + 1e-7f },
+    { "glm_pack_snorm16", 0.5f / 32767.0f + 1e-7f },
+    { "glm_pack_half (relative)", 0.5f / 1024.0f },
+    { "glm_pack_unorm1010102", 0.5f / 1023.0f + 1e-6f },
+    { "glm_pack_snorm1010102", 0.5f / 511.0f + 1e-6f },
+    { "glm_pack_oct (degrees)", 0.005f }
+};
+#define PACK_FORMAT_COUNT ( sizeof( PACK_FORMATS ) / sizeof( PACK_FORMATS[ 0 ] ) )
+
+// Runs an array kernel at every count from each of the first four elements, the untouched tail must stay zero
+#define CHECK_PACK_ARRAY( name, Type, arrayCall, elementCall ) \
+    for ( uint32_t offset = 0; offset < 4; offset++ ) { \
+        for ( uint32_t count = 0; count <= PACK_ARRAY_MAX_COUNT; count++ ) { \
+            Type actual[ PACK_ARRAY_LENGTH ], expected[ PACK_ARRAY_LENGTH ]; \
+            memset( actual, 0, sizeof( actual ) ); \
+            memset( expected, 0, sizeof( expected ) ); \
+            arrayCall; \
+            for ( uint32_t i = 0; i < count; i++ ) elementCall; \
+            if ( memcmp( actual, expected, sizeof( actual ) ) != 0 && failedLength++ < 8 ) { \
+                printf( "\t%s: mismatch at count %u, offset %u\n", name, count, offset ); \
+            } \
+        } \
+    }
+
+/* PRIVATE VISIBILITY */
+float RandomFloat( float, float );
+bool CompareFloats( const char*, const float*, const float*, uint32_t, float, uint32_t* );
+bool CompareMasks( const char*, const uint32_t*, const uint32_t*, size_t, uint32_t* );
+void GetTestFrustumPlanes( vec4[ 6 ] );
+void FillQuatPairs( float*[ 4 ], float*[ 4 ], size_t );
+float GetQuatDistance( versor, versor );
+void SlerpExact( versor, versor, float, versor );
+void FillSphereTransforms( vec4*, mat4*, size_t );
+void FillDispatchInputs( DispatchInputs* );
+void RunDispatch( DispatchInputs*, DispatchResults* );
+void CompareDispatch( const char*, DispatchResults*, DispatchResults*, uint32_t* );
+void FillBvhScene( vec3*, vec3 );
+void GetTestRay( vec3*, size_t, vec3, vec3, vec3 );
+void CheckQuatSoaCounts( const char*, void ( * )( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] ),
+                         void ( * )( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] ), float*[ 4 ][ 4 ], uint32_t* );
+bool TestMat4Inv( void );
+bool TestMat4MulArray( void );
+bool TestMat4MulvArray( void );
+bool TestMat4Mulv3Array( void );
+bool TestMat4Mulv3Soa( void );
+bool TestMat3Mul( void );
+bool TestQuatMat4( void );
+bool TestQuatMul( void );
+bool TestQuatSlerpSoa( void );
+bool TestQuatNlerpSoa( void );
+bool TestDispatch( void );
+bool TestBvhSmallLeaf( void );
+bool TestBvhRay( void );
+bool TestRayTriangleSoa( void );
+bool TestHalfRoundTrip( void );
+bool TestPackArrays( void );
+bool TestPackError( void );
+bool TestAabbFrustumSoa( void );
+bool TestFrustumCascades( void );
+bool TestSphereTransformArray( void );
+bool TestSphereMergeArray( void );
+
+/* METHODS */
+int main() {
+    srand( 1 );
+    puts( "cglm tests, " TEST_BUILD_NAME " build" );
+
+    bool isPassed = true;
+    isPassed &= TestMat4Inv();
+    isPassed &= TestMat4MulArray();
+    isPassed &= TestMat4MulvArray();
+    isPassed &= TestMat4Mulv3Array();
+    isPassed &= TestMat4Mulv3Soa();
+    isPassed &= TestMat3Mul();
+    isPassed &= TestQuatMat4();
+    isPassed &= TestQuatMul();
+    isPassed &= TestQuatSlerpSoa();
+    isPassed &= TestQuatNlerpSoa();
+    isPassed &= TestDispatch();
+    isPassed &= TestBvhSmallLeaf();
+    isPassed &= TestBvhRay();
+    isPassed &= TestRayTriangleSoa();
+    isPassed &= TestHalfRoundTrip();
+    isPassed &= TestPackArrays();
+    isPassed &= TestPackError();
+    isPassed &= TestAabbFrustumSoa();
+    isPassed &= TestFrustumCascades();
+    isPassed &= TestSphereTransformArray();
+    isPassed &= TestSphereMergeArray();
+
+    puts( isPassed ? "All cglm tests passed" : "cglm tests FAILED" );
+    return isPassed ? 0 : 1;
+}
+bool TestMat4Inv() {
+    // Diagonally dominant matrices stay well conditioned, the inverse error is then bounded by rounding alone
+    uint32_t failedLength = 0;
+    for ( uint32_t i = 0; i < TEST_ITERATIONS; i++ ) {
+        mat4 m, expected, actual;
+        for ( uint32_t c = 0; c < 4; c++ ) {
+            for ( uint32_t r = 0; r < 4; r++ ) m[ c ][ r ] = RandomFloat( -1.0f, 1.0f );
+            m[ c ][ c ] += c % 2 == 0 ? 5.0f : -5.0f;
+        }
+
+        ScalarMat4Inv( m, expected );
+        glm_mat4_inv_avx( m, actual );
+        CompareFloats( "glm_mat4_inv_avx", expected[ 0 ], actual[ 0 ], 16, 1e-5f, &failedLength );
+        glm_mat4_inv( m, actual );
+        CompareFloats( "glm_mat4_inv", expected[ 0 ], actual[ 0 ], 16, 1e-5f, &failedLength );
+#ifdef CGLM_AVX512_FP
+        glm_mat4_inv_avx512( m, actual );
+        CompareFloats( "glm_mat4_inv_avx512", expected[ 0 ], actual[ 0 ], 16, 1e-5f, &failedLength );
+#endif
+    }
+
+    printf( "glm_mat4_inv: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestMat4MulArray() {
+    // Every count up to the array length against per-matrix products, in place on either operand too
+    static mat4 m1[ MAT4_ARRAY_LENGTH ], m2[ MAT4_ARRAY_LENGTH ], expected[ MAT4_ARRAY_LENGTH ], actual[ MAT4_ARRAY_LENGTH + 1 ];
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 20; round++ ) {
+        float *m1Floats = m1[ 0 ][ 0 ], *m2Floats = m2[ 0 ][ 0 ];
+        for ( uint32_t i = 0; i < MAT4_ARRAY_LENGTH * 16; i++ ) {
+            m1Floats[ i ] = RandomFloat( -10.0f, 10.0f );
+            m2Floats[ i ] = RandomFloat( -10.0f, 10.0f );
+        }
+        for ( uint32_t i = 0; i < MAT4_ARRAY_LENGTH; i++ ) ScalarMat4Mul( m1[ i ], m2[ i ], expected[ i ] );
+
+        for ( uint32_t count = 0; count <= MAT4_ARRAY_LENGTH; count++ ) {
+            // The matrix after the last one must stay untouched
+            glm_mat4_zero( actual[ count ] );
+            glm_mat4_mul_array( m1, m2, count, actual );
+            CompareFloats( "glm_mat4_mul_array", expected[ 0 ][ 0 ], actual[ 0 ][ 0 ], count * 16, 1e-6f, &failedLength );
+            CompareFloats( "glm_mat4_mul_array (past count)", GLM_MAT4_ZERO[ 0 ], actual[ count ][ 0 ], 16, 0.0f, &failedLength );
+
+            memcpy( actual, m1, count * sizeof( mat4 ) );
+            glm_mat4_mul_array( actual, m2, count, actual );
+            CompareFloats( "glm_mat4_mul_array (dest is m1)", expected[ 0 ][ 0 ], actual[ 0 ][ 0 ], count * 16, 1e-6f, &failedLength );
+
+            memcpy( actual, m2, count * sizeof( mat4 ) );
+            glm_mat4_mul_array( m1, actual, count, actual );
+            CompareFloats( "glm_mat4_mul_array (dest is m2)", expected[ 0 ][ 0 ], actual[ 0 ][ 0 ], count * 16, 1e-6f, &failedLength );
+        }
+    }
+
+    printf( "glm_mat4_mul_array: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestMat4MulvArray() {
+    // Against per-vector glm_mat4_mulv of the scalar build, at every short count from each of the first four vectors,
+    // in place, and over a streamed run with dest on and off the store alignment. Inputs stay within one, so sums that
+    // cancel can not hide the few roundings FMA saves
+    vec4 *v = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec4 ) );
+    vec4 *expected = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec4 ) );
+    vec4 *actual = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec4 ) );
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 4; round++ ) {
+        mat4 m;
+        for ( uint32_t k = 0; k < 16; k++ ) m[ k / 4 ][ k % 4 ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t i = 0; i < MULV_ARRAY_LENGTH * 4; i++ ) v[ 0 ][ i ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t i = 0; i < MULV_ARRAY_LENGTH; i++ ) ScalarMat4Mulv( m, v[ i ], expected[ i ] );
+
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            for ( uint32_t i = 0; i <= MULV_ARRAY_MAX_COUNT + 1; i++ ) {
+                size_t count = i <= MULV_ARRAY_MAX_COUNT ? i : MULV_ARRAY_LENGTH - 8;
+                glm_vec4_zero( actual[ offset + count ] );
+                glm_mat4_mulv_array( m, &v[ offset ], count, &actual[ offset ] );
+                CompareFloats( "glm_mat4_mulv_array", expected[ offset ], actual[ offset ], ( uint32_t )count * 4, MULV_TOLERANCE, &failedLength );
+                CompareFloats( "glm_mat4_mulv_array (past count)", GLM_VEC4_ZERO, actual[ offset + count ], 4, 0.0f, &failedLength );
+
+                memcpy( &actual[ offset ], &v[ offset ], count * sizeof( vec4 ) );
+                glm_mat4_mulv_array( m, &actual[ offset ], count, &actual[ offset ] );
+                CompareFloats( "glm_mat4_mulv_array (in place)", expected[ offset ], actual[ offset ], ( uint32_t )count * 4, MULV_TOLERANCE, &failedLength );
+
+                if ( i > MULV_ARRAY_MAX_COUNT ) continue;
+                size_t tested = glm_mat4_mulv_array_sse2( m, &v[ offset ], count, actual );
+                CompareFloats( "glm_mat4_mulv_array_sse2", expected[ offset ], actual[ 0 ], ( uint32_t )tested * 4, MULV_TOLERANCE, &failedLength );
+            }
+        }
+    }
+    free( v );
+    free( expected );
+    free( actual );
+
+    printf( "glm_mat4_mulv_array (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestMat4Mulv3Array() {
+    // Same as above with per-vector glm_mat4_mulv3, for points and directions
+    vec3 *v = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec3 ) );
+    vec3 *expected = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec3 ) );
+    vec3 *actual = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( vec3 ) );
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 4; round++ ) {
+        mat4 m;
+        float last = ( float )( round % 2 );
+        for ( uint32_t k = 0; k < 16; k++ ) m[ k / 4 ][ k % 4 ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t i = 0; i < MULV_ARRAY_LENGTH * 3; i++ ) v[ 0 ][ i ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t i = 0; i < MULV_ARRAY_LENGTH; i++ ) ScalarMat4Mulv3( m, v[ i ], last, expected[ i ] );
+
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            for ( uint32_t i = 0; i <= MULV_ARRAY_MAX_COUNT + 1; i++ ) {
+                size_t count = i <= MULV_ARRAY_MAX_COUNT ? i : MULV_ARRAY_LENGTH - 8;
+                glm_vec3_zero( actual[ offset + count ] );
+                glm_mat4_mulv3_array( m, &v[ offset ], last, count, &actual[ offset ] );
+                CompareFloats( "glm_mat4_mulv3_array", expected[ offset ], actual[ offset ], ( uint32_t )count * 3, MULV_TOLERANCE, &failedLength );
+                CompareFloats( "glm_mat4_mulv3_array (past count)", GLM_VEC3_ZERO, actual[ offset + count ], 3, 0.0f, &failedLength );
+
+                memcpy( &actual[ offset ], &v[ offset ], count * sizeof( vec3 ) );
+                glm_mat4_mulv3_array( m, &actual[ offset ], last, count, &actual[ offset ] );
+                CompareFloats( "glm_mat4_mulv3_array (in place)", expected[ offset ], actual[ offset ], ( uint32_t )count * 3, MULV_TOLERANCE, &failedLength );
+
+                if ( i > MULV_ARRAY_MAX_COUNT ) continue;
+                size_t tested = glm_mat4_mulv3_array_sse2( m, &v[ offset ], last, count, actual );
+                CompareFloats( "glm_mat4_mulv3_array_sse2", expected[ offset ], actual[ 0 ], ( uint32_t )tested * 3, MULV_TOLERANCE, &failedLength );
+            }
+        }
+    }
+    free( v );
+    free( expected );
+    free( actual );
+
+    printf( "glm_mat4_mulv3_array (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestMat4Mulv3Soa() {
+    // Same again for x, y, z streams; the streams are 64 byte aligned, so offsets 0 and 8 take the streaming stores
+    static const uint32_t OFFSETS[] = { 0, 1, 3, 8 };
+    float *streams[ 3 ][ 3 ];
+    for ( uint32_t s = 0; s < 3; s++ ) {
+        for ( uint32_t k = 0; k < 3; k++ ) streams[ s ][ k ] = aligned_alloc( 64, MULV_ARRAY_LENGTH * sizeof( float ) );
+    }
+
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 4; round++ ) {
+        mat4 m;
+        float last = ( float )( round % 2 );
+        for ( uint32_t k = 0; k < 16; k++ ) m[ k / 4 ][ k % 4 ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t i = 0; i < MULV_ARRAY_LENGTH; i++ ) {
+            vec3 r = { RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ) };
+            for ( uint32_t k = 0; k < 3; k++ ) streams[ 0 ][ k ][ i ] = r[ k ];
+            ScalarMat4Mulv3( m, r, last, r );
+            for ( uint32_t k = 0; k < 3; k++ ) streams[ 1 ][ k ][ i ] = r[ k ];
+        }
+
+        for ( uint32_t o = 0; o < 4; o++ ) {
+            uint32_t offset = OFFSETS[ o ];
+            float *v[ 3 ], *expected[ 3 ], *actual[ 3 ];
+            for ( uint32_t k = 0; k < 3; k++ ) {
+                v[ k ] = streams[ 0 ][ k ] + offset;
+                expected[ k ] = streams[ 1 ][ k ] + offset;
+                actual[ k ] = streams[ 2 ][ k ] + offset;
+            }
+
+            for ( uint32_t i = 0; i <= MULV_ARRAY_MAX_COUNT + 1; i++ ) {
+                size_t count = i <= MULV_ARRAY_MAX_COUNT ? i : MULV_ARRAY_LENGTH - 8;
+                for ( uint32_t k = 0; k < 3; k++ ) actual[ k ][ count ] = 0.0f;
+                glm_mat4_mulv3_soa( m, v, last, count, actual );
+                for ( uint32_t k = 0; k < 3; k++ ) {
+                    CompareFloats( "glm_mat4_mulv3_soa", expected[ k ], actual[ k ], ( uint32_t )count, MULV_TOLERANCE, &failedLength );
+                    CompareFloats( "glm_mat4_mulv3_soa (past count)", GLM_VEC3_ZERO, &actual[ k ][ count ], 1, 0.0f, &failedLength );
+                }
+
+                for ( uint32_t k = 0; k < 3; k++ ) memcpy( actual[ k ], v[ k ], count * sizeof( float ) );
+                glm_mat4_mulv3_soa( m, actual, last, count, actual );
+                for ( uint32_t k = 0; k < 3; k++ ) {
+                    CompareFloats( "glm_mat4_mulv3_soa (in place)", expected[ k ], actual[ k ], ( uint32_t )count, MULV_TOLERANCE, &failedLength );
+                }
+
+                if ( i > MULV_ARRAY_MAX_COUNT ) continue;
+                size_t tested = glm_mat4_mulv3_soa_sse2( m, v, last, count, actual );
+                for ( uint32_t k = 0; k < 3; k++ ) {
+                    CompareFloats( "glm_mat4_mulv3_soa_sse2", expected[ k ], actual[ k ], ( uint32_t )tested, MULV_TOLERANCE, &failedLength );
+                }
+            }
+        }
+    }
+    for ( uint32_t s = 0; s < 3; s++ ) {
+        for ( uint32_t k = 0; k < 3; k++ ) free( streams[ s ][ k ] );
+    }
+
+    printf( "glm_mat4_mulv3_soa (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestMat3Mul() {
+    uint32_t failedLength = 0;
+    for ( uint32_t i = 0; i < TEST_ITERATIONS; i++ ) {
+        mat3 m1, m2, expected, actual;
+        for ( uint32_t c = 0; c < 3; c++ ) {
+            for ( uint32_t r = 0; r < 3; r++ ) {
+                m1[ c ][ r ] = RandomFloat( -10.0f, 10.0f );
+                m2[ c ][ r ] = RandomFloat( -10.0f, 10.0f );
+            }
+        }
+
+        ScalarMat3Mul( m1, m2, expected );
+        glm_mat3_mul_avx2( m1, m2, actual );
+        CompareFloats( "glm_mat3_mul_avx2", expected[ 0 ], actual[ 0 ], 9, 1e-6f, &failedLength );
+#ifdef CGLM_AVX512_FP
+        glm_mat3_mul_avx512( m1, m2, actual );
+        CompareFloats( "glm_mat3_mul_avx512", expected[ 0 ], actual[ 0 ], 9, 1e-6f, &failedLength );
+#endif
+
+        // dest may alias either operand
+        glm_mat3_copy( m1, actual );
+        glm_mat3_mul( actual, m2, actual );
+        CompareFloats( "glm_mat3_mul (aliased)", expected[ 0 ], actual[ 0 ], 9, 1e-6f, &failedLength );
+    }
+
+    printf( "glm_mat3_mul: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestQuatMat4() {
+    // Unnormalized and zero quaternions go through the same 2 / norm scale as the scalar code
+    uint32_t failedLength = 0;
+    for ( uint32_t i = 0; i < TEST_ITERATIONS; i++ ) {
+        versor q;
+        for ( uint32_t k = 0; k < 4; k++ ) q[ k ] = i == 0 ? 0.0f : RandomFloat( -2.0f, 2.0f );
+
+        mat4 expected, actual;
+        ScalarQuatMat4( q, expected );
+        glm_quat_mat4( q, actual );
+        CompareFloats( "glm_quat_mat4", expected[ 0 ], actual[ 0 ], 16, 1e-6f, &failedLength );
+
+        // Both x86 paths round every entry the same way
+        float norm = glm_quat_norm( q );
+        mat4 avx;
+        glm_quat_mat4_avx( q, norm > 0.0f ? 2.0f / norm : 0.0f, avx );
+        CompareFloats( "glm_quat_mat4_avx", actual[ 0 ], avx[ 0 ], 16, 0.0f, &failedLength );
+    }
+
+    printf( "glm_quat_mat4: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestQuatMul() {
+    uint32_t failedLength = 0;
+    for ( uint32_t i = 0; i < TEST_ITERATIONS; i++ ) {
+        versor p, q, expected, actual;
+        for ( uint32_t k = 0; k < 4; k++ ) {
+            p[ k ] = RandomFloat( -2.0f, 2.0f );
+            q[ k ] = RandomFloat( -2.0f, 2.0f );
+        }
+
+        ScalarQuatMul( p, q, expected );
+        glm_quat_mul( p, q, actual );
+        CompareFloats( "glm_quat_mul", expected, actual, 4, 1e-6f, &failedLength );
+        glm_quat_mul_sse2( p, q, actual );
+        CompareFloats( "glm_quat_mul_sse2", expected, actual, 4, 1e-6f, &failedLength );
+        glm_quat_mul_avx( p, q, actual );
+        CompareFloats( "glm_quat_mul_avx", expected, actual, 4, 1e-6f, &failedLength );
+
+        // dest may alias either operand
+        glm_quat_copy( p, actual );
+        glm_quat_mul( actual, q, actual );
+        CompareFloats( "glm_quat_mul (aliased)", expected, actual, 4, 1e-6f, &failedLength );
+    }
+
+    printf( "glm_quat_mul: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestQuatSlerpSoa() {
+    float *streams[ 4 ][ 4 ];
+    for ( uint32_t k = 0; k < 16; k++ ) streams[ k / 4 ][ k % 4 ] = malloc( QUAT_SOA_LENGTH * sizeof( float ) );
+    float **from = streams[ 0 ], **to = streams[ 1 ], **dest = streams[ 2 ];
+    FillQuatPairs( from, to, QUAT_SOA_LENGTH );
+
+    uint32_t failedLength = 0;
+    float exactError = 0.0f, singleError = 0.0f;
+    for ( uint32_t round = 0; round < 8; round++ ) {
+        float t = round == 0 ? 0.0f : round == 1 ? 1.0f : RandomFloat( 0.0f, 1.0f );
+        glm_quat_slerp_soa( from, to, t, QUAT_SOA_LENGTH, dest );
+
+        for ( uint32_t i = 0; i < QUAT_SOA_LENGTH; i++ ) {
+            versor f = { from[ 0 ][ i ], from[ 1 ][ i ], from[ 2 ][ i ], from[ 3 ][ i ] };
+            versor q = { to[ 0 ][ i ], to[ 1 ][ i ], to[ 2 ][ i ], to[ 3 ][ i ] };
+            versor actual = { dest[ 0 ][ i ], dest[ 1 ][ i ], dest[ 2 ][ i ], dest[ 3 ][ i ] }, expected;
+
+            // The documented bound holds against an exact slerp
+            SlerpExact( f, q, t, expected );
+            float distance = GetQuatDistance( expected, actual );
+            exactError = glm_max( exactError, distance );
+            if ( distance > 1e-6f && failedLength++ < 8 ) printf( "\tglm_quat_slerp_soa: quaternion %u at t = %g is %g from exact\n", i, t, distance );
+
+            // glm_quat_slerp lerps nearly opposite rotations without taking the shorter arc, so it gets the flipped target,
+            // and its sqrt( 1 - cos^2 ) loses most digits at small angles, so those are left to the exact reference
+            if ( glm_quat_dot( f, q ) < 0.0f ) glm_vec4_negate( q );
+            if ( glm_quat_dot( f, q ) > 0.99f ) continue;
+
+            glm_quat_slerp( f, q, t, expected );
+            distance = GetQuatDistance( expected, actual );
+            singleError = glm_max( singleError, distance );
+            if ( distance > 2e-6f && failedLength++ < 8 ) printf( "\tglm_quat_slerp_soa: quaternion %u at t = %g is %g from glm_quat_slerp\n", i, t, distance );
+        }
+    }
+
+    CheckQuatSoaCounts( "glm_quat_slerp_soa", glm_quat_slerp_soa, ScalarQuatSlerpSoa, streams, &failedLength );
+    for ( uint32_t k = 0; k < 16; k++ ) free( streams[ k / 4 ][ k % 4 ] );
+
+    printf( "glm_quat_slerp_soa: %s (max error %g against exact, %g against glm_quat_slerp)\n", failedLength == 0 ? "ok" : "FAILED",
+            exactError, singleError );
+    return failedLength == 0;
+}
+bool TestQuatNlerpSoa() {
+    float *streams[ 4 ][ 4 ];
+    for ( uint32_t k = 0; k < 16; k++ ) streams[ k / 4 ][ k % 4 ] = malloc( QUAT_SOA_LENGTH * sizeof( float ) );
+    float **from = streams[ 0 ], **to = streams[ 1 ], **dest = streams[ 2 ];
+    FillQuatPairs( from, to, QUAT_SOA_LENGTH );
+
+    uint32_t failedLength = 0;
+    float error = 0.0f;
+    for ( uint32_t round = 0; round < 8; round++ ) {
+        float t = round == 0 ? 0.0f : round == 1 ? 1.0f : RandomFloat( 0.0f, 1.0f );
+        glm_quat_nlerp_soa( from, to, t, QUAT_SOA_LENGTH, dest );
+
+        for ( uint32_t i = 0; i < QUAT_SOA_LENGTH; i++ ) {
+            versor f = { from[ 0 ][ i ], from[ 1 ][ i ], from[ 2 ][ i ], from[ 3 ][ i ] };
+            versor q = { to[ 0 ][ i ], to[ 1 ][ i ], to[ 2 ][ i ], to[ 3 ][ i ] };
+            versor actual = { dest[ 0 ][ i ], dest[ 1 ][ i ], dest[ 2 ][ i ], dest[ 3 ][ i ] }, expected;
+
+            glm_quat_nlerp( f, q, t, expected );
+            float distance = GetQuatDistance( expected, actual );
+            error = glm_max( error, distance );
+            if ( distance > 1e-6f && failedLength++ < 8 ) printf( "\tglm_quat_nlerp_soa: quaternion %u at t = %g is %g away\n", i, t, distance );
+        }
+    }
+
+    CheckQuatSoaCounts( "glm_quat_nlerp_soa", glm_quat_nlerp_soa, ScalarQuatNlerpSoa, streams, &failedLength );
+    for ( uint32_t k = 0; k < 16; k++ ) free( streams[ k / 4 ][ k % 4 ] );
+
+    printf( "glm_quat_nlerp_soa: %s (max error %g)\n", failedLength == 0 ? "ok" : "FAILED", error );
+    return failedLength == 0;
+}
+bool TestDispatch() {
+    // Every glmd_* function on each kernel set this CPU runs against the baseline set
+    static DispatchInputs inputs;
+    static DispatchResults base, results;
+    FillDispatchInputs( &inputs );
+    glmd_select( GLMD_ISA_BASE );
+    RunDispatch( &inputs, &base );
+
+    uint32_t failedLength = 0;
+    const glmd_isa ISAS[] = { GLMD_ISA_AVX2, GLMD_ISA_AVX512 };
+    for ( uint32_t i = 0; i < 2; i++ ) {
+        const char *name = glmd_isa_name( ISAS[ i ] );
+        if ( glmd_select( ISAS[ i ] ) != ISAS[ i ] ) {
+            printf( "glmd_* (%s): skipped, not supported here\n", name );
+            continue;
+        }
+
+        RunDispatch( &inputs, &results );
+        uint32_t isaFailedLength = 0;
+        CompareDispatch( name, &base, &results, &isaFailedLength );
+        printf( "glmd_* (%s against base): %s\n", name, isaFailedLength == 0 ? "ok" : "FAILED" );
+        failedLength += isaFailedLength;
+    }
+
+    glmd_init();
+    return failedLength == 0;
+}
+bool TestBvhSmallLeaf() {
+    // Fewer triangles than the leaf cost bias must stay one leaf, however far apart they are
+    vec3 verts[ 9 ] = {
+        { -100.0f, 0.0f, 0.0f }, { -99.0f, 0.0f, 0.0f }, { -100.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+        { 100.0f, 0.0f, 0.0f }, { 101.0f, 0.0f, 0.0f }, { 100.0f, 1.0f, 0.0f }
+    };
+    glm_bvh_node nodes[ 5 ];
+    uint32_t index[ 3 ];
+    float tri[ 9 ][ 3 ];
+    glm_bvh bvh = { .nodes = nodes, .index = index };
+    for ( uint32_t k = 0; k < 9; k++ ) bvh.tri[ k ] = tri[ k ];
+
+    size_t nodeLength = glm_bvh_build( &bvh, verts, 3 );
+    bool isPassed = nodeLength == 1 && nodes[ 0 ].count == 3;
+
+    printf( "glm_bvh_build small leaf: %s (%zu nodes)\n", isPassed ? "ok" : "FAILED", nodeLength );
+    return isPassed;
+}
+bool TestBvhRay() {
+    // Nearest hits match a brute force glm_ray_triangle loop, on scenes with a cluster of triangles whose bounds share one
+    // center and exact duplicates, so the builder has to fall back to splitting runs in half
+    size_t count = BVH_TEST_TRIANGLES + BVH_TEST_CLUSTER;
+    vec3 *verts = malloc( count * 3 * sizeof( vec3 ) );
+    glm_bvh bvh;
+    bvh.nodes = malloc( ( 2 * count - 1 ) * sizeof( glm_bvh_node ) );
+    bvh.index = malloc( count * sizeof( uint32_t ) );
+    for ( uint32_t k = 0; k < 9; k++ ) bvh.tri[ k ] = malloc( count * sizeof( float ) );
+
+    uint32_t failedLength = 0, hitLength = 0;
+    for ( uint32_t scene = 0; scene < BVH_TEST_SCENES; scene++ ) {
+        vec3 center;
+        FillBvhScene( verts, center );
+        glm_bvh_build( &bvh, verts, count );
+
+        for ( uint32_t r = 0; r < BVH_TEST_RAYS; r++ ) {
+            vec3 origin, direction;
+            GetTestRay( verts, count, center, origin, direction );
+
+            float expected = FLT_MAX;
+            for ( size_t i = 0; i < count; i++ ) {
+                float d;
+                if ( glm_ray_triangle( origin, direction, verts[ i * 3 ], verts[ i * 3 + 1 ], verts[ i * 3 + 2 ], &d ) ) {
+                    expected = glm_min( expected, d );
+                }
+            }
+
+            // Duplicates tie, so any triangle at the nearest distance will do
+            float actual = FLT_MAX, d = FLT_MAX;
+            size_t tri = count;
+            bool isHit = glm_bvh_ray( &bvh, origin, direction, &actual, &tri );
+            bool isTriHit = isHit && tri < count &&
+                            glm_ray_triangle( origin, direction, verts[ tri * 3 ], verts[ tri * 3 + 1 ], verts[ tri * 3 + 2 ], &d );
+            hitLength += isHit;
+            if ( isHit == ( expected != FLT_MAX ) && actual == expected && ( !isHit || ( isTriHit && d == actual ) ) ) continue;
+
+            if ( failedLength++ < 8 ) {
+                printf( "\tglm_bvh_ray: scene %u ray %u hit %d at %.9g (triangle %zu), expected %.9g\n",
+                        scene, r, isHit, actual, tri, expected );
+            }
+        }
+    }
+
+    free( verts );
+    free( bvh.nodes );
+    free( bvh.index );
+    for ( uint32_t k = 0; k < 9; k++ ) free( bvh.tri[ k ] );
+
+    printf( "glm_bvh_ray (" TEST_BUILD_NAME "): %s (%u of %u rays hit)\n", failedLength == 0 ? "ok" : "FAILED",
+            hitLength, BVH_TEST_SCENES * BVH_TEST_RAYS );
+    return failedLength == 0;
+}
+bool TestRayTriangleSoa() {
+    // Hit, distance and index match the scalar build at every count and stream alignment, and on the part each
+    // instruction set kernel handles
+    float *tri[ 9 ];
+    for ( uint32_t k = 0; k < 9; k++ ) tri[ k ] = malloc( RAY_SOA_LENGTH * sizeof( float ) );
+
+    uint32_t failedLength = 0, hitLength = 0, rayLength = 0;
+    for ( uint32_t round = 0; round < 20; round++ ) {
+        // Small triangles in a narrow column, so a ray down the column passes a few of them
+        for ( uint32_t i = 0; i < RAY_SOA_LENGTH; i++ ) {
+            vec3 v0 = { RandomFloat( -2.0f, 2.0f ), RandomFloat( -2.0f, 2.0f ), RandomFloat( -20.0f, 20.0f ) };
+            for ( uint32_t k = 0; k < 3; k++ ) {
+                tri[ k ][ i ] = v0[ k ];
+                tri[ k + 3 ][ i ] = RandomFloat( -3.0f, 3.0f );
+                tri[ k + 6 ][ i ] = RandomFloat( -3.0f, 3.0f );
+            }
+            tri[ 5 ][ i ] *= 0.1f;
+            tri[ 8 ][ i ] *= 0.1f;
+        }
+
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            for ( uint32_t i = 0; i <= RAY_SOA_MAX_COUNT + 1; i++ ) {
+                size_t count = i == RAY_SOA_MAX_COUNT + 1 ? RAY_SOA_LENGTH - offset : i;
+                float *t[ 9 ];
+                for ( uint32_t k = 0; k < 9; k++ ) t[ k ] = tri[ k ] + offset;
+
+                vec3 origin = { RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), 30.0f };
+                vec3 direction = { RandomFloat( -0.05f, 0.05f ), RandomFloat( -0.05f, 0.05f ), -1.0f };
+                float limit = rand() % 2 == 0 ? FLT_MAX : RandomFloat( 20.0f, 50.0f );
+
+                float expected = limit, actual = limit;
+                size_t expectedIndex = SIZE_MAX, actualIndex = SIZE_MAX;
+                bool isExpected = ScalarRayTriangleSoa( origin, direction, t, count, &expected, &expectedIndex );
+                bool isActual = glm_ray_triangle_soa( origin, direction, t, count, &actual, &actualIndex );
+                hitLength += isActual;
+                rayLength++;
+                if ( ( isExpected != isActual || expected != actual || expectedIndex != actualIndex ) && failedLength++ < 8 ) {
+                    printf( "\tglm_ray_triangle_soa: count %zu offset %u hit %d at %.9g (%zu), expected %d at %.9g (%zu)\n",
+                            count, offset, isActual, actual, actualIndex, isExpected, expected, expectedIndex );
+                }
+
+                // The kernels report how many triangles they tested, the scalar build runs the same prefix
+                size_t ( *KERNELS[ 2 ] )( vec3, vec3, float*[ 9 ], size_t, float*, size_t* ) = {
+                    glm_ray_triangle_soa_sse2, glm_ray_triangle_soa_avx
+                };
+                for ( uint32_t kernel = 0; kernel < 2; kernel++ ) {
+                    expected = actual = limit;
+                    expectedIndex = actualIndex = SIZE_MAX;
+                    size_t tested = KERNELS[ kernel ]( origin, direction, t, count, &actual, &actualIndex );
+                    ScalarRayTriangleSoa( origin, direction, t, tested, &expected, &expectedIndex );
+                    if ( ( expected != actual || expectedIndex != actualIndex ) && failedLength++ < 8 ) {
+                        printf( "\t%s: %zu of %zu tested, hit at %.9g (%zu), expected %.9g (%zu)\n",
+                                kernel == 0 ? "glm_ray_triangle_soa_sse2" : "glm_ray_triangle_soa_avx", tested, count,
+                                actual, actualIndex, expected, expectedIndex );
+                    }
+                }
+            }
+        }
+    }
+
+    for ( uint32_t k = 0; k < 9; k++ ) free( tri[ k ] );
+
+    printf( "glm_ray_triangle_soa (" TEST_BUILD_NAME "): %s (%u of %u rays hit)\n", failedLength == 0 ? "ok" : "FAILED",
+            hitLength, rayLength );
+    return failedLength == 0;
+}
+bool TestHalfRoundTrip() {
+    // Every half survives the trip through float, NaNs only need to stay NaN
+    uint16_t halves[ 65536 ], packed[ 65536 ];
+    float floats[ 65536 ];
+    for ( uint32_t h = 0; h < 65536; h++ ) halves[ h ] = ( uint16_t )h;
+    glm_unpack_half_array( halves, 65536, floats );
+    glm_pack_half_array( floats, 65536, packed );
+
+    uint32_t failedLength = 0;
+    for ( uint32_t h = 0; h < 65536; h++ ) {
+        float f = glm_unpack_half( ( uint16_t )h );
+        bool isNan = ( h & 0x7fffu ) > 0x7c00u;
+        bool isSame = isNan ? isnan( f ) && isnan( glm_unpack_half( glm_pack_half( f ) ) ) && isnan( floats[ h ] ) &&
+                              isnan( glm_unpack_half( packed[ h ] ) )
+                            : glm_pack_half( f ) == h && packed[ h ] == h && memcmp( &f, &floats[ h ], sizeof( float ) ) == 0;
+        if ( !isSame && failedLength++ < 8 ) printf( "\thalf 0x%04x: round trip failed\n", h );
+    }
+
+    // Values halfway between two finite halves round to the even one, in both directions of the sign
+    for ( uint32_t h = 0; h < 0x7bffu; h++ ) {
+        float midpoint[ 2 ] = { ( glm_unpack_half( ( uint16_t )h ) + glm_unpack_half( ( uint16_t )( h + 1 ) ) ) * 0.5f, 0.0f };
+        midpoint[ 1 ] = -midpoint[ 0 ];
+
+        uint16_t even = ( uint16_t )( h % 2 == 0 ? h : h + 1 );
+        uint16_t expected[ 2 ] = { even, ( uint16_t )( even | 0x8000u ) }, actual[ 2 ];
+        glm_pack_half_array( midpoint, 2, actual );
+        for ( uint32_t k = 0; k < 2; k++ ) {
+            if ( ( glm_pack_half( midpoint[ k ] ) == expected[ k ] && actual[ k ] == expected[ k ] ) || failedLength++ >= 8 ) continue;
+            printf( "\tmidpoint %.9g: packed to 0x%04x, expected 0x%04x\n", midpoint[ k ], actual[ k ], expected[ k ] );
+        }
+    }
+
+    printf( "glm_pack_half round trip: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestPackArrays() {
+    // The array kernels must match the single value functions bit for bit, across the vector body and the scalar tail
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < PACK_ARRAY_ROUNDS; round++ ) {
+        float floats[ PACK_ARRAY_LENGTH ], wideFloats[ PACK_ARRAY_LENGTH ];
+        uint16_t halves[ PACK_ARRAY_LENGTH ], unorm16s[ PACK_ARRAY_LENGTH ];
+        int16_t snorm16s[ PACK_ARRAY_LENGTH ];
+        uint8_t unorm8s[ PACK_ARRAY_LENGTH ];
+        int8_t snorm8s[ PACK_ARRAY_LENGTH ];
+        uint32_t words[ PACK_ARRAY_LENGTH ];
+        vec3 normals[ PACK_ARRAY_LENGTH ];
+        vec4 vectors[ PACK_ARRAY_LENGTH ];
+
+        for ( uint32_t i = 0; i < PACK_ARRAY_LENGTH; i++ ) {
+            // Out of range values test the clamps, the wide ones reach half denormals, overflow and infinity
+            floats[ i ] = i % 8 == 0 ? ( float )( rand() % 5 - 2 ) * 0.5f : RandomFloat( -1.5f, 1.5f );
+            wideFloats[ i ] = i % 16 == 0 ? copysignf( INFINITY, floats[ i ] ) : ldexpf( floats[ i ], rand() % 48 - 30 );
+
+            // F16C keeps NaN payloads where the scalar code makes a canonical NaN, they are covered by the round trip
+            halves[ i ] = ( uint16_t )rand();
+            if ( ( halves[ i ] & 0x7c00u ) == 0x7c00u ) halves[ i ] &= 0xfc00u;
+            unorm16s[ i ] = ( uint16_t )rand();
+            snorm16s[ i ] = ( int16_t )rand();
+            unorm8s[ i ] = ( uint8_t )rand();
+            snorm8s[ i ] = ( int8_t )rand();
+            words[ i ] = ( uint32_t )rand() ^ ( uint32_t )rand() << 16;
+
+            for ( uint32_t k = 0; k < 3; k++ ) normals[ i ][ k ] = RandomFloat( -1.0f, 1.0f );
+            for ( uint32_t k = 0; k < 4; k++ ) vectors[ i ][ k ] = RandomFloat( -1.5f, 1.5f );
+        }
+
+        CHECK_PACK_ARRAY( "glm_pack_half_array", uint16_t,
+            glm_pack_half_array( &wideFloats[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_half( wideFloats[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_half_array", float,
+            glm_unpack_half_array( &halves[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_unpack_half( halves[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_unorm8_array", uint8_t,
+            glm_pack_unorm8_array( &floats[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_unorm8( floats[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_unorm8_array", float,
+            glm_unpack_unorm8_array( &unorm8s[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_unpack_unorm8( unorm8s[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_snorm8_array", int8_t,
+            glm_pack_snorm8_array( &floats[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_snorm8( floats[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_snorm8_array", float,
+            glm_unpack_snorm8_array( &snorm8s[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_unpack_snorm8( snorm8s[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_unorm16_array", uint16_t,
+            glm_pack_unorm16_array( &floats[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_unorm16( floats[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_unorm16_array", float,
+            glm_unpack_unorm16_array( &unorm16s[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_unpack_unorm16( unorm16s[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_snorm16_array", int16_t,
+            glm_pack_snorm16_array( &floats[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_snorm16( floats[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_snorm16_array", float,
+            glm_unpack_snorm16_array( &snorm16s[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_unpack_snorm16( snorm16s[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_oct_array", uint32_t,
+            glm_pack_oct_array( &normals[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_oct( normals[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_oct_array", vec3,
+            glm_unpack_oct_array( &words[ offset ], count, &actual[ offset ] ),
+            glm_unpack_oct( words[ offset + i ], expected[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_unorm1010102_array", uint32_t,
+            glm_pack_unorm1010102_array( &vectors[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_unorm1010102( vectors[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_unorm1010102_array", vec4,
+            glm_unpack_unorm1010102_array( &words[ offset ], count, &actual[ offset ] ),
+            glm_unpack_unorm1010102( words[ offset + i ], expected[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_pack_snorm1010102_array", uint32_t,
+            glm_pack_snorm1010102_array( &vectors[ offset ], count, &actual[ offset ] ),
+            expected[ offset + i ] = glm_pack_snorm1010102( vectors[ offset + i ] ) );
+        CHECK_PACK_ARRAY( "glm_unpack_snorm1010102_array", vec4,
+            glm_unpack_snorm1010102_array( &words[ offset ], count, &actual[ offset ] ),
+            glm_unpack_snorm1010102( words[ offset + i ], expected[ offset + i ] ) );
+    }
+
+    printf( "glm_pack arrays: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestPackError() {
+    // In range values come back within half a step, the half error is relative and the octahedral one an angle
+    float maxErrors[ PACK_FORMAT_COUNT ] = { 0.0f };
+    for ( uint32_t i = 0; i < TEST_ITERATIONS; i++ ) {
+        float unorm = RandomFloat( 0.0f, 1.0f ), snorm = RandomFloat( -1.0f, 1.0f );
+        float wide = ldexpf( snorm < 0.0f ? -RandomFloat( 1.0f, 2.0f ) : RandomFloat( 1.0f, 2.0f ), rand() % 29 - 14 );
+
+        vec3 normal = { RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ) }, unpacked;
+        glm_normalize( normal );
+        glm_unpack_oct( glm_pack_oct( normal ), unpacked );
+
+        vec4 unorms = { unorm, unorm, unorm, 0.0f }, snorms = { snorm, snorm, snorm, 0.0f }, unpacked4;
+        glm_unpack_unorm1010102( glm_pack_unorm1010102( unorms ), unpacked4 );
+        float unorm10 = unpacked4[ 0 ];
+        glm_unpack_snorm1010102( glm_pack_snorm1010102( snorms ), unpacked4 );
+        float snorm10 = unpacked4[ 0 ];
+
+        float errors[ PACK_FORMAT_COUNT ] = {
+            fabsf( glm_unpack_unorm8( glm_pack_unorm8( unorm ) ) - unorm ),
+            fabsf( glm_unpack_snorm8( glm_pack_snorm8( snorm ) ) - snorm ),
+            fabsf( glm_unpack_unorm16( glm_pack_unorm16( unorm ) ) - unorm ),
+            fabsf( glm_unpack_snorm16( glm_pack_snorm16( snorm ) ) - snorm ),
+            fabsf( glm_unpack_half( glm_pack_half( wide ) ) - wide ) / fabsf( wide ),
+            fabsf( unorm10 - unorm ),
+            fabsf( snorm10 - snorm ),
+            glm_deg( 2.0f * asinf( 0.5f * glm_vec3_distance( normal, unpacked ) ) )
+        };
+        for ( uint32_t k = 0; k < PACK_FORMAT_COUNT; k++ ) maxErrors[ k ] = fmaxf( maxErrors[ k ], errors[ k ] );
+    }
+
+    bool isPassed = true;
+    for ( uint32_t k = 0; k < PACK_FORMAT_COUNT; k++ ) {
+        bool isFormatPassed = maxErrors[ k ] <= PACK_FORMATS[ k ].maxError;
+        printf( "%s round trip: %s (max error %g)\n", PACK_FORMATS[ k ].name, isFormatPassed ? "ok" : "FAILED", maxErrors[ k ] );
+        isPassed &= isFormatPassed;
+    }
+    return isPassed;
+}
+
+bool TestAabbFrustumSoa() {
+    // Masks match the scalar glm_aabb_frustum loop bit for bit, at every count and stream alignment
+    vec4 planes[ 6 ];
+    GetTestFrustumPlanes( planes );
+
+    // Boxes are spread around the frustum so plenty of them straddle a plane
+    float *streams[ 6 ];
+    for ( uint32_t k = 0; k < 6; k++ ) streams[ k ] = malloc( AABB_TEST_LENGTH * sizeof( float ) );
+    for ( uint32_t i = 0; i < AABB_TEST_LENGTH; i++ ) {
+        vec3 center = { RandomFloat( -60.0f, 60.0f ), RandomFloat( -60.0f, 60.0f ), RandomFloat( -120.0f, 20.0f ) };
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            float extent = RandomFloat( 0.0f, 5.0f );
+            streams[ k ][ i ] = center[ k ] - extent;
+            streams[ k + 3 ][ i ] = center[ k ] + extent;
+        }
+    }
+
+    uint32_t wordLength = ( AABB_TEST_LENGTH + 31 ) / 32;
+    uint32_t *expected = malloc( wordLength * sizeof( uint32_t ) );
+    uint32_t *actual = malloc( ( wordLength + 1 ) * sizeof( uint32_t ) );
+    uint32_t failedLength = 0;
+    for ( size_t i = 0; i <= 101; i++ ) {
+        // Every short count, then one long run that still ends in a partial word
+        size_t count = i == 101 ? AABB_TEST_LENGTH - 3 : i;
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            float *min[ 3 ] = { streams[ 0 ] + offset, streams[ 1 ] + offset, streams[ 2 ] + offset };
+            float *max[ 3 ] = { streams[ 3 ] + offset, streams[ 4 ] + offset, streams[ 5 ] + offset };
+            ScalarAabbFrustumSoa( min, max, count, planes, expected );
+
+            // Nothing past the last word of the mask is written
+            uint32_t countWords = ( uint32_t )( ( count + 31 ) / 32 );
+            actual[ countWords ] = 0xdeadbeefu;
+            glm_aabb_frustum_soa( min, max, count, planes, actual );
+            CompareMasks( "glm_aabb_frustum_soa", expected, actual, count, &failedLength );
+            if ( actual[ countWords ] != 0xdeadbeefu && failedLength++ < 8 ) puts( "\tglm_aabb_frustum_soa: wrote past the mask" );
+
+            size_t tested = glm_aabb_frustum_soa_sse2( min, max, count, planes, actual );
+            CompareMasks( "glm_aabb_frustum_soa_sse2", expected, actual, tested, &failedLength );
+        }
+    }
+
+    for ( uint32_t k = 0; k < 6; k++ ) free( streams[ k ] );
+    free( expected );
+    free( actual );
+
+    printf( "glm_aabb_frustum_soa: %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestFrustumCascades() {
+    // Split planes lie where the splits say, and each stabilized box contains glm_frustum_box of its cascade, for this
+    // build's kernel and the scalar build alike
+    uint32_t failedLength = 0;
+    for ( uint32_t camera = 0; camera < CASCADE_TEST_CAMERAS; camera++ ) {
+        float nearZ = RandomFloat( 0.05f, 1.0f ), farZ = RandomFloat( 20.0f, 1000.0f );
+        mat4 proj, view, viewProj, invViewProj, lightView;
+        glm_perspective( glm_rad( RandomFloat( 30.0f, 110.0f ) ), RandomFloat( 0.5f, 2.5f ), nearZ, farZ, proj );
+        vec3 eye = { RandomFloat( -100.0f, 100.0f ), RandomFloat( -100.0f, 100.0f ), RandomFloat( -100.0f, 100.0f ) };
+        vec3 target = { RandomFloat( -100.0f, 100.0f ), RandomFloat( -100.0f, 100.0f ), RandomFloat( -100.0f, 100.0f ) };
+        glm_lookat( eye, target, GLM_YUP, view );
+        glm_mat4_mul( proj, view, viewProj );
+        glm_mat4_inv( viewProj, invViewProj );
+
+        vec3 lightDirection = { RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, -0.1f ), RandomFloat( -1.0f, 1.0f ) };
+        glm_look_anyup( GLM_VEC3_ZERO, lightDirection, lightView );
+
+        vec4 corners[ 8 ];
+        glm_frustum_corners( invViewProj, corners );
+
+        size_t count = 1 + ( size_t )rand() % CASCADE_MAX_COUNT;
+        float size = ( float )( 256 << ( rand() % 5 ) );
+        float splits[ CASCADE_MAX_COUNT + 1 ];
+        glm_frustum_splits( nearZ, farZ, RandomFloat( 0.0f, 1.0f ), count, splits );
+
+        for ( uint32_t build = 0; build < 2; build++ ) {
+            const char *name = build == 0 ? "glm_frustum_cascades" : "glm_frustum_cascades (scalar build)";
+            vec4 planeCorners[ CASCADE_MAX_COUNT + 1 ][ 4 ];
+            vec3 boxes[ CASCADE_MAX_COUNT ][ 2 ];
+            mat4 projs[ CASCADE_MAX_COUNT ];
+            if ( build == 0 ) {
+                glm_frustum_cascades( corners, nearZ, farZ, splits, count, lightView, size, planeCorners, boxes, projs );
+            } else {
+                ScalarFrustumCascades( corners, nearZ, farZ, splits, count, lightView, size, planeCorners, boxes, projs );
+            }
+
+            // Lerped along the near to far edges in double precision
+            for ( size_t i = 0; i <= count; i++ ) {
+                double t = ( ( double )splits[ i ] - nearZ ) / ( ( double )farZ - nearZ );
+                vec4 expected[ 4 ];
+                for ( uint32_t j = 0; j < 4; j++ ) {
+                    for ( uint32_t k = 0; k < 3; k++ ) {
+                        expected[ j ][ k ] = ( float )( corners[ j ][ k ] + t * ( ( double )corners[ j + 4 ][ k ] - corners[ j ][ k ] ) );
+                    }
+                    expected[ j ][ 3 ] = 1.0f;
+                }
+                CompareFloats( name, expected[ 0 ], planeCorners[ i ][ 0 ], 16, 1e-5f, &failedLength );
+            }
+
+            // Light space depth is only as exact as the corners, so z may miss by a little relative to the scene
+            for ( size_t i = 0; i < count; i++ ) {
+                vec4 cascade[ 8 ];
+                vec3 box[ 2 ];
+                memcpy( cascade, planeCorners[ i ], sizeof( vec4[ 4 ] ) );
+                memcpy( &cascade[ 4 ], planeCorners[ i + 1 ], sizeof( vec4[ 4 ] ) );
+                glm_frustum_box( cascade, lightView, box );
+
+                float slack = 1e-5f * ( farZ + glm_vec3_norm( eye ) );
+                bool isContained = true;
+                for ( uint32_t k = 0; k < 3; k++ ) {
+                    isContained &= boxes[ i ][ 0 ][ k ] <= box[ 0 ][ k ] + slack && boxes[ i ][ 1 ][ k ] >= box[ 1 ][ k ] - slack;
+                }
+                if ( isContained || failedLength++ >= 8 ) continue;
+
+                printf( "\t%s: cascade %zu of %zu, box ( %g %g %g ) ( %g %g %g ) misses ( %g %g %g ) ( %g %g %g )\n", name, i, count,
+                        boxes[ i ][ 0 ][ 0 ], boxes[ i ][ 0 ][ 1 ], boxes[ i ][ 0 ][ 2 ], boxes[ i ][ 1 ][ 0 ], boxes[ i ][ 1 ][ 1 ], boxes[ i ][ 1 ][ 2 ],
+                        box[ 0 ][ 0 ], box[ 0 ][ 1 ], box[ 0 ][ 2 ], box[ 1 ][ 0 ], box[ 1 ][ 1 ], box[ 1 ][ 2 ] );
+            }
+        }
+    }
+
+    printf( "glm_frustum_cascades (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestSphereTransformArray() {
+    // Every count from each of the first four spheres against the scalar build, in place too,
+    // and each instruction set kernel on the part it handles
+    static vec4 spheres[ SPHERE_ARRAY_LENGTH ], expected[ SPHERE_ARRAY_LENGTH ], actual[ SPHERE_ARRAY_LENGTH + 1 ];
+    static mat4 transforms[ SPHERE_ARRAY_LENGTH ];
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 20; round++ ) {
+        FillSphereTransforms( spheres, transforms, SPHERE_ARRAY_LENGTH );
+        ScalarSphereTransformArray( spheres, transforms, SPHERE_ARRAY_LENGTH, expected );
+        glm_sphere_transform_array( spheres, transforms, SPHERE_ARRAY_LENGTH, actual );
+        CompareFloats( "glm_sphere_transform_array", expected[ 0 ], actual[ 0 ], SPHERE_ARRAY_LENGTH * 4, 1e-6f, &failedLength );
+
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            for ( uint32_t count = 0; count <= SPHERE_ARRAY_MAX_COUNT; count++ ) {
+                glm_vec4_zero( actual[ count ] );
+                glm_sphere_transform_array( &spheres[ offset ], &transforms[ offset ], count, actual );
+                CompareFloats( "glm_sphere_transform_array", expected[ offset ], actual[ 0 ], count * 4, 1e-6f, &failedLength );
+                CompareFloats( "glm_sphere_transform_array (past count)", GLM_VEC4_ZERO, actual[ count ], 4, 0.0f, &failedLength );
+
+                memcpy( actual, &spheres[ offset ], count * sizeof( vec4 ) );
+                glm_sphere_transform_array( actual, &transforms[ offset ], count, actual );
+                CompareFloats( "glm_sphere_transform_array (in place)", expected[ offset ], actual[ 0 ], count * 4, 1e-6f, &failedLength );
+
+                size_t tested = glm_sphere_transform_array_sse2( &spheres[ offset ], &transforms[ offset ], count, actual );
+                CompareFloats( "glm_sphere_transform_array_sse2", expected[ offset ], actual[ 0 ], ( uint32_t )tested * 4, 1e-6f, &failedLength );
+                tested = glm_sphere_transform_array_avx( &spheres[ offset ], &transforms[ offset ], count, actual );
+                CompareFloats( "glm_sphere_transform_array_avx", expected[ offset ], actual[ 0 ], ( uint32_t )tested * 4, 1e-6f, &failedLength );
+            }
+        }
+    }
+
+    printf( "glm_sphere_transform_array (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+bool TestSphereMergeArray() {
+    // The merged sphere encloses every input and matches the scalar build, for every count from each of the first four
+    static vec4 spheres[ SPHERE_ARRAY_LENGTH ];
+    static mat4 transforms[ SPHERE_ARRAY_LENGTH ];
+    uint32_t failedLength = 0;
+    for ( uint32_t round = 0; round < 20; round++ ) {
+        FillSphereTransforms( spheres, transforms, SPHERE_ARRAY_LENGTH );
+        glm_sphere_transform_array( spheres, transforms, SPHERE_ARRAY_LENGTH, spheres );
+
+        for ( uint32_t offset = 0; offset < 4; offset++ ) {
+            for ( uint32_t i = 0; i <= SPHERE_ARRAY_MAX_COUNT + 1; i++ ) {
+                size_t count = i == SPHERE_ARRAY_MAX_COUNT + 1 ? SPHERE_ARRAY_LENGTH - offset : i;
+                vec4 expected, actual;
+                ScalarSphereMergeArray( &spheres[ offset ], count, expected );
+                glm_sphere_merge_array( &spheres[ offset ], count, actual );
+                CompareFloats( "glm_sphere_merge_array", expected, actual, 4, 1e-6f, &failedLength );
+
+                // Relative to the merged radius, the distance and the input radius are rounded separately
+                for ( size_t j = 0; j < count; j++ ) {
+                    vec4 *s = &spheres[ offset + j ];
+                    float reach = glm_vec3_distance( *s, actual ) + ( *s )[ 3 ];
+                    if ( reach <= actual[ 3 ] * ( 1.0f + 1e-6f ) ) continue;
+
+                    if ( failedLength++ < 8 ) {
+                        printf( "\tglm_sphere_merge_array: sphere %zu of %zu reaches %.9g, merged radius %.9g\n", j, count, reach, actual[ 3 ] );
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    printf( "glm_sphere_merge_array (" TEST_BUILD_NAME "): %s\n", failedLength == 0 ? "ok" : "FAILED" );
+    return failedLength == 0;
+}
+
+/* HELPERS */
+float RandomFloat( float low, float high ) {
+    return low + ( high - low ) * ( ( float )rand() / ( float )RAND_MAX );
+}
+// Relative to the largest expected magnitude, so entries that cancel to near zero do not fail on rounding
+bool CompareFloats( const char *name, const float *expected, const float *actual, uint32_t length, float tolerance, uint32_t *failedLength ) {
+    float scale = 1.0f;
+    for ( uint32_t i = 0; i < length; i++ ) scale = fmaxf( scale, fabsf( expected[ i ] ) );
+
+    for ( uint32_t i = 0; i < length; i++ ) {
+        if ( fabsf( expected[ i ] - actual[ i ] ) <= tolerance * scale ) continue;
+
+        // Only the first few mismatches are printed, the count still covers all of them
+        if ( ( *failedLength )++ < 8 ) {
+            printf( "\t%s: element %u is %.9g, expected %.9g\n", name, i, actual[ i ], expected[ i ] );
+        }
+        return false;
+    }
+    return true;
+}
+// Only the first length bits are compared, kernels may leave the rest of the last word undefined
+bool CompareMasks( const char *name, const uint32_t *expected, const uint32_t *actual, size_t length, uint32_t *failedLength ) {
+    for ( size_t i = 0; i < length; i++ ) {
+        uint32_t bit = 1u << ( i & 31 );
+        if ( ( expected[ i >> 5 ] & bit ) == ( actual[ i >> 5 ] & bit ) ) continue;
+
+        if ( ( *failedLength )++ < 8 ) printf( "\t%s: bit %zu of %zu is wrong\n", name, i, length );
+        return false;
+    }
+    return true;
+}
+void GetTestFrustumPlanes( vec4 planes[ 6 ] ) {
+    mat4 proj, view, viewProj;
+    glm_perspective( glm_rad( 60.0f ), 1.5f, 0.1f, 100.0f, proj );
+    glm_lookat( ( vec3 ){ 3.0f, 2.0f, 10.0f }, ( vec3 ){ 0.0f, 0.0f, 0.0f }, ( vec3 ){ 0.0f, 1.0f, 0.0f }, view );
+    glm_mat4_mul( proj, view, viewProj );
+    glm_frustum_planes( viewProj, planes );
+}
+// Unit quaternion pairs, half of them close enough for the lerp fallback, and either sign of to
+void FillQuatPairs( float *from[ 4 ], float *to[ 4 ], size_t length ) {
+    for ( size_t i = 0; i < length; i++ ) {
+        versor f, q;
+        for ( uint32_t k = 0; k < 4; k++ ) f[ k ] = RandomFloat( -1.0f, 1.0f );
+        glm_quat_normalize( f );
+
+        float spread = i % 2 == 0 ? 1.0f : powf( 10.0f, RandomFloat( -4.0f, -1.0f ) );
+        for ( uint32_t k = 0; k < 4; k++ ) q[ k ] = f[ k ] + RandomFloat( -spread, spread );
+        glm_quat_normalize( q );
+        if ( rand() % 2 == 0 ) glm_vec4_negate( q );
+
+        for ( uint32_t k = 0; k < 4; k++ ) {
+            from[ k ][ i ] = f[ k ];
+            to[ k ][ i ] = q[ k ];
+        }
+    }
+}
+// q and -q are the same rotation, so the closer of the two counts
+float GetQuatDistance( versor expected, versor actual ) {
+    float same = 0.0f, flipped = 0.0f;
+    for ( uint32_t k = 0; k < 4; k++ ) {
+        same = fmaxf( same, fabsf( expected[ k ] - actual[ k ] ) );
+        flipped = fmaxf( flipped, fabsf( expected[ k ] + actual[ k ] ) );
+    }
+    return fminf( same, flipped );
+}
+// Shorter arc slerp in double precision
+void SlerpExact( versor from, versor to, float t, versor dest ) {
+    double c = 0.0, sign = 1.0;
+    for ( uint32_t k = 0; k < 4; k++ ) c += ( double )from[ k ] * ( double )to[ k ];
+    if ( c < 0.0 ) {
+        c = -c;
+        sign = -1.0;
+    }
+
+    double theta = acos( c < 1.0 ? c : 1.0 ), s = sin( theta );
+    double a = s < 1e-12 ? 1.0 - t : sin( ( 1.0 - t ) * theta ) / s;
+    double b = s < 1e-12 ? t : sin( t * theta ) / s;
+    for ( uint32_t k = 0; k < 4; k++ ) dest[ k ] = ( float )( sign * a * from[ k ] + b * to[ k ] );
+}
+// Small model space spheres under rotation, non-uniform scale and translation, the way objects are placed in a scene
+void FillSphereTransforms( vec4 *spheres, mat4 *transforms, size_t length ) {
+    for ( size_t i = 0; i < length; i++ ) {
+        glm_vec4_copy( ( vec4 ){ RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( 0.1f, 2.0f ) }, spheres[ i ] );
+
+        vec3 axis = { RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( 0.1f, 1.0f ) };
+        glm_translate_make( transforms[ i ], ( vec3 ){ RandomFloat( -50.0f, 50.0f ), RandomFloat( -50.0f, 50.0f ), RandomFloat( -50.0f, 50.0f ) } );
+        glm_rotate( transforms[ i ], RandomFloat( -GLM_PIf, GLM_PIf ), axis );
+        glm_scale( transforms[ i ], ( vec3 ){ RandomFloat( 0.2f, 3.0f ), RandomFloat( 0.2f, 3.0f ), RandomFloat( 0.2f, 3.0f ) } );
+    }
+}
+// Scattered triangles, then a cluster whose bounds are all centered on one point, every tenth an exact duplicate
+void FillBvhScene( vec3 *verts, vec3 center ) {
+    glm_vec3_copy( ( vec3 ){ RandomFloat( -5.0f, 5.0f ), RandomFloat( -5.0f, 5.0f ), RandomFloat( -5.0f, 5.0f ) }, center );
+    for ( size_t i = 0; i < BVH_TEST_TRIANGLES; i++ ) {
+        vec3 v0 = { RandomFloat( -20.0f, 20.0f ), RandomFloat( -20.0f, 20.0f ), RandomFloat( -20.0f, 20.0f ) };
+        glm_vec3_copy( v0, verts[ i * 3 ] );
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            verts[ i * 3 + 1 ][ k ] = v0[ k ] + RandomFloat( -2.0f, 2.0f );
+            verts[ i * 3 + 2 ][ k ] = v0[ k ] + RandomFloat( -2.0f, 2.0f );
+        }
+    }
+    for ( size_t i = BVH_TEST_TRIANGLES; i < BVH_TEST_TRIANGLES + BVH_TEST_CLUSTER; i++ ) {
+        if ( i % 10 == 0 ) {
+            memcpy( verts[ i * 3 ], verts[ ( i - 1 ) * 3 ], 3 * sizeof( vec3 ) );
+            continue;
+        }
+
+        // Corners span x and y, the first two span z, so the bounds are center +- ( s, s, h ) whatever the third corner
+        float s = RandomFloat( 0.1f, 3.0f ), h = RandomFloat( 0.0f, 3.0f );
+        glm_vec3_add( center, ( vec3 ){ -s, -s, -h }, verts[ i * 3 ] );
+        glm_vec3_add( center, ( vec3 ){ s, -s, h }, verts[ i * 3 + 1 ] );
+        glm_vec3_add( center, ( vec3 ){ RandomFloat( -s, s ), s, RandomFloat( -h, h ) }, verts[ i * 3 + 2 ] );
+    }
+}
+// From anywhere around the scene, aimed at a random triangle, at the cluster or nowhere in particular
+void GetTestRay( vec3 *verts, size_t count, vec3 center, vec3 origin, vec3 direction ) {
+    glm_vec3_copy( ( vec3 ){ RandomFloat( -30.0f, 30.0f ), RandomFloat( -30.0f, 30.0f ), RandomFloat( -30.0f, 30.0f ) }, origin );
+
+    vec3 target;
+    switch ( rand() % 3 ) {
+        case 0: {
+            size_t i = ( size_t )rand() % count;
+            float u = RandomFloat( 0.0f, 1.0f ), v = RandomFloat( 0.0f, 1.0f - u );
+            for ( uint32_t k = 0; k < 3; k++ ) {
+                target[ k ] = verts[ i * 3 ][ k ] + u * ( verts[ i * 3 + 1 ][ k ] - verts[ i * 3 ][ k ] ) +
+                              v * ( verts[ i * 3 + 2 ][ k ] - verts[ i * 3 ][ k ] );
+            }
+            break;
+        }
+        case 1:
+            glm_vec3_add( center, ( vec3 ){ RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ), RandomFloat( -1.0f, 1.0f ) }, target );
+            break;
+        default:
+            glm_vec3_copy( ( vec3 ){ RandomFloat( -30.0f, 30.0f ), RandomFloat( -30.0f, 30.0f ), RandomFloat( -30.0f, 30.0f ) }, target );
+            break;
+    }
+    glm_vec3_sub( target, origin, direction );
+    glm_vec3_normalize( direction );
+}
+void FillDispatchInputs( DispatchInputs *inputs ) {
+    // Diagonally dominant matrices so every inverse is well conditioned, an odd length so every kernel runs its tail
+    for ( uint32_t i = 0; i < DISPATCH_LENGTH; i++ ) {
+        for ( uint32_t k = 0; k < 16; k++ ) {
+            inputs->m1[ i ][ k / 4 ][ k % 4 ] = RandomFloat( -1.0f, 1.0f ) + ( k % 5 == 0 ? 4.0f : 0.0f );
+            inputs->m2[ i ][ k / 4 ][ k % 4 ] = RandomFloat( -1.0f, 1.0f );
+        }
+        for ( uint32_t k = 0; k < 4; k++ ) inputs->v4[ i ][ k ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t k = 0; k < 3; k++ ) inputs->v3[ i ][ k ] = RandomFloat( -1.0f, 1.0f );
+        // Any finite half, NaN never compares equal and infinity breaks the relative tolerance
+        inputs->halves[ i ] = ( uint16_t )( rand() & 0xffff );
+        if ( ( inputs->halves[ i ] & 0x7c00 ) == 0x7c00 ) inputs->halves[ i ] &= 0xbfff;
+    }
+
+    // Streams 0 to 3 and 4 to 7 are quaternion pairs
+    float *from[ 4 ], *to[ 4 ];
+    for ( uint32_t k = 0; k < 4; k++ ) {
+        from[ k ] = inputs->streams[ k ];
+        to[ k ] = inputs->streams[ k + 4 ];
+    }
+    FillQuatPairs( from, to, DISPATCH_LENGTH );
+    for ( uint32_t i = 0; i < DISPATCH_LENGTH; i++ ) {
+        inputs->streams[ 8 ][ i ] = RandomFloat( -1.0f, 1.0f );
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            inputs->boxes[ k ][ i ] = RandomFloat( -60.0f, 60.0f );
+            inputs->boxes[ k + 3 ][ i ] = inputs->boxes[ k ][ i ] + RandomFloat( 0.0f, 10.0f );
+        }
+    }
+    for ( uint32_t k = 0; k < 18; k++ ) inputs->m3[ k / 9 ][ k % 9 / 3 ][ k % 3 ] = RandomFloat( -1.0f, 1.0f );
+    GetTestFrustumPlanes( inputs->planes );
+    FillSphereTransforms( inputs->spheres, inputs->m2, DISPATCH_LENGTH );
+
+    vec3 center = { 0.0f, 0.0f, 0.0f };
+    for ( uint32_t i = 0; i < DISPATCH_LENGTH * 3; i++ ) {
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            inputs->triangles[ i ][ k ] = i % 3 == 0 ? RandomFloat( -20.0f, 20.0f ) : inputs->triangles[ i - i % 3 ][ k ] + RandomFloat( -2.0f, 2.0f );
+        }
+    }
+    for ( uint32_t i = 0; i < 64; i++ ) GetTestRay( inputs->triangles, DISPATCH_LENGTH, center, inputs->rays[ i ][ 0 ], inputs->rays[ i ][ 1 ] );
+    inputs->bvh.nodes = inputs->nodes;
+    inputs->bvh.index = inputs->index;
+    for ( uint32_t k = 0; k < 9; k++ ) inputs->bvh.tri[ k ] = inputs->tri[ k ];
+    glm_bvh_build( &inputs->bvh, inputs->triangles, DISPATCH_LENGTH );
+}
+void RunDispatch( DispatchInputs *inputs, DispatchResults *results ) {
+    // Copies first where the function writes over its input, so every kernel set sees the same inputs
+    glmd_mat4_mul( inputs->m1[ 0 ], inputs->m2[ 0 ], results->mat4Mul );
+    glmd_mat4_mul_array( inputs->m1, inputs->m2, DISPATCH_LENGTH, results->mat4MulArray );
+    glmd_mat4_mulv( inputs->m2[ 0 ], inputs->v4[ 0 ], results->mat4Mulv );
+    glmd_mat4_mulv_array( inputs->m2[ 0 ], inputs->v4, DISPATCH_LENGTH, results->mulvArray );
+    glmd_mat4_mulv3_array( inputs->m2[ 0 ], inputs->v3, 1.0f, DISPATCH_LENGTH, results->mulv3Array );
+
+    float *v[ 4 ], *dest[ 4 ];
+    for ( uint32_t k = 0; k < 3; k++ ) {
+        v[ k ] = inputs->streams[ k ];
+        dest[ k ] = results->mulv3Soa[ k ];
+    }
+    glmd_mat4_mulv3_soa( inputs->m2[ 0 ], v, 0.0f, DISPATCH_LENGTH, dest );
+
+    glmd_mat4_transpose_to( inputs->m2[ 0 ], results->mat4Transpose );
+    glmd_mat4_inv( inputs->m1[ 0 ], results->mat4Inv );
+    glmd_mat4_inv_fast( inputs->m1[ 0 ], results->mat4InvFast );
+    glmd_mat3_mul( inputs->m3[ 0 ], inputs->m3[ 1 ], results->mat3Mul );
+    glmd_quat_mul( inputs->v4[ 0 ], inputs->v4[ 1 ], results->quatMul );
+    glmd_quat_mat4( inputs->v4[ 2 ], results->quatMat4 );
+
+    float *from[ 4 ], *to[ 4 ];
+    for ( uint32_t k = 0; k < 4; k++ ) {
+        from[ k ] = inputs->streams[ k ];
+        to[ k ] = inputs->streams[ k + 4 ];
+        dest[ k ] = results->slerpSoa[ k ];
+    }
+    glmd_quat_slerp_soa( from, to, 0.3f, DISPATCH_LENGTH, dest );
+    for ( uint32_t k = 0; k < 4; k++ ) dest[ k ] = results->nlerpSoa[ k ];
+    glmd_quat_nlerp_soa( from, to, 0.3f, DISPATCH_LENGTH, dest );
+
+    float *min[ 3 ] = { inputs->boxes[ 0 ], inputs->boxes[ 1 ], inputs->boxes[ 2 ] };
+    float *max[ 3 ] = { inputs->boxes[ 3 ], inputs->boxes[ 4 ], inputs->boxes[ 5 ] };
+    memset( results->visible, 0, sizeof( results->visible ) );
+    glmd_aabb_frustum_soa( min, max, DISPATCH_LENGTH, inputs->planes, results->visible );
+
+    glmd_sphere_transform_array( inputs->spheres, inputs->m2, DISPATCH_LENGTH, results->sphereTransform );
+    glmd_sphere_merge_array( results->sphereTransform, DISPATCH_LENGTH, results->sphereMerge );
+
+    for ( uint32_t i = 0; i < 64; i++ ) {
+        results->rayDistance[ i ] = results->bvhDistance[ i ] = FLT_MAX;
+        results->rayIndex[ i ] = results->bvhIndex[ i ] = SIZE_MAX;
+        glmd_ray_triangle_soa( inputs->rays[ i ][ 0 ], inputs->rays[ i ][ 1 ], inputs->bvh.tri, DISPATCH_LENGTH,
+                               &results->rayDistance[ i ], &results->rayIndex[ i ] );
+        glmd_bvh_ray( &inputs->bvh, inputs->rays[ i ][ 0 ], inputs->rays[ i ][ 1 ], &results->bvhDistance[ i ], &results->bvhIndex[ i ] );
+    }
+
+    glmd_pack_half_array( inputs->streams[ 8 ], DISPATCH_LENGTH, results->packed );
+    glmd_unpack_half_array( inputs->halves, DISPATCH_LENGTH, results->unpacked );
+}
+// FMA only saves roundings, the kernels must otherwise agree; hits, masks and halves are exact
+void CompareDispatch( const char *name, DispatchResults *base, DispatchResults *actual, uint32_t *failedLength ) {
+    static const struct {
+        const char *name;
+        size_t offset, length;
+        float tolerance;
+    } FLOATS[] = {
+        { "glmd_mat4_mul", offsetof( DispatchResults, mat4Mul ), 16, 1e-6f },
+        { "glmd_mat4_mul_array", offsetof( DispatchResults, mat4MulArray ), DISPATCH_LENGTH * 16, 1e-6f },
+        { "glmd_mat4_mulv", offsetof( DispatchResults, mat4Mulv ), 4, 1e-6f },
+        { "glmd_mat4_mulv_array", offsetof( DispatchResults, mulvArray ), DISPATCH_LENGTH * 4, 1e-6f },
+        { "glmd_mat4_mulv3_array", offsetof( DispatchResults, mulv3Array ), DISPATCH_LENGTH * 3, 1e-6f },
+        { "glmd_mat4_mulv3_soa", offsetof( DispatchResults, mulv3Soa ), DISPATCH_LENGTH * 3, 1e-6f },
+        { "glmd_mat4_transpose_to", offsetof( DispatchResults, mat4Transpose ), 16, 0.0f },
+        { "glmd_mat4_inv", offsetof( DispatchResults, mat4Inv ), 16, 1e-5f },
+        // Reciprocal estimates differ between the instruction sets, one step of refinement is not applied
+        { "glmd_mat4_inv_fast", offsetof( DispatchResults, mat4InvFast ), 16, 1e-3f },
+        { "glmd_mat3_mul", offsetof( DispatchResults, mat3Mul ), 9, 1e-6f },
+        { "glmd_quat_mul", offsetof( DispatchResults, quatMul ), 4, 1e-6f },
+        { "glmd_quat_mat4", offsetof( DispatchResults, quatMat4 ), 16, 1e-6f },
+        { "glmd_quat_slerp_soa", offsetof( DispatchResults, slerpSoa ), DISPATCH_LENGTH * 4, 1e-6f },
+        { "glmd_quat_nlerp_soa", offsetof( DispatchResults, nlerpSoa ), DISPATCH_LENGTH * 4, 1e-6f },
+        { "glmd_sphere_transform_array", offsetof( DispatchResults, sphereTransform ), DISPATCH_LENGTH * 4, 1e-6f },
+        { "glmd_sphere_merge_array", offsetof( DispatchResults, sphereMerge ), 4, 1e-6f },
+        { "glmd_ray_triangle_soa", offsetof( DispatchResults, rayDistance ), 64, 0.0f },
+        { "glmd_bvh_ray", offsetof( DispatchResults, bvhDistance ), 64, 0.0f },
+        { "glmd_unpack_half_array", offsetof( DispatchResults, unpacked ), DISPATCH_LENGTH, 0.0f }
+    };
+
+    char label[ 64 ];
+    for ( uint32_t i = 0; i < sizeof( FLOATS ) / sizeof( FLOATS[ 0 ] ); i++ ) {
+        snprintf( label, sizeof( label ), "%s (%s)", FLOATS[ i ].name, name );
+        CompareFloats( label, ( float* )( ( char* )base + FLOATS[ i ].offset ), ( float* )( ( char* )actual + FLOATS[ i ].offset ),
+                       ( uint32_t )FLOATS[ i ].length, FLOATS[ i ].tolerance, failedLength );
+    }
+
+    snprintf( label, sizeof( label ), "glmd_aabb_frustum_soa (%s)", name );
+    CompareMasks( label, base->visible, actual->visible, DISPATCH_LENGTH, failedLength );
+
+    bool isSame = memcmp( base->rayIndex, actual->rayIndex, sizeof( base->rayIndex ) ) == 0 &&
+                  memcmp( base->bvhIndex, actual->bvhIndex, sizeof( base->bvhIndex ) ) == 0;
+    if ( !isSame && ( *failedLength )++ < 8 ) printf( "\tglmd_ray_triangle_soa, glmd_bvh_ray (%s): hit another triangle\n", name );
+    if ( memcmp( base->packed, actual->packed, sizeof( base->packed ) ) != 0 && ( *failedLength )++ < 8 ) {
+        printf( "\tglmd_pack_half_array (%s): halves differ\n", name );
+    }
+}
+// SIMD body and scalar tail against the scalar build, at every count from each of the first four elements,
+// with dest in place of from; streams are from, to, dest and scratch
+void CheckQuatSoaCounts( const char *name, void ( *Interpolate )( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] ),
+                         void ( *ScalarInterpolate )( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] ), float *streams[ 4 ][ 4 ],
+                         uint32_t *failedLength ) {
+    for ( uint32_t offset = 0; offset < 4; offset++ ) {
+        for ( uint32_t count = 0; count <= QUAT_SOA_MAX_COUNT; count++ ) {
+            float t = RandomFloat( 0.0f, 1.0f );
+            float *from[ 4 ], *to[ 4 ], *dest[ 4 ], *expected[ 4 ];
+            for ( uint32_t k = 0; k < 4; k++ ) {
+                from[ k ] = streams[ 0 ][ k ] + offset;
+                to[ k ] = streams[ 1 ][ k ] + offset;
+                dest[ k ] = streams[ 2 ][ k ] + offset;
+                expected[ k ] = streams[ 3 ][ k ] + offset;
+                memcpy( dest[ k ], from[ k ], count * sizeof( float ) );
+            }
+
+            ScalarInterpolate( from, to, t, count, expected );
+            Interpolate( dest, to, t, count, dest );
+            for ( uint32_t k = 0; k < 4; k++ ) CompareFloats( name, expected[ k ], dest[ k ], count, 1e-6f, failedLength );
+        }
+    }
+}
@@ -0,0 +1,162 @@
+// Checks the asset streamer's queue order, cancellation and delivered data, exits non-zero on any failure
+#define _DEFAULT_SOURCE
+#include "../src/AssetStreamer.h"
+#include <stdbool.h>
+#include <unistd.h>
+
+#define STREAMER_TEST_FILES 64
+#define STREAMER_TEST_FILE_SIZE 200000
+
+typedef struct {
+    uint32_t deliveredLength;
+    uint32_t failedLength;
+    bool isDelivered[ STREAMER_TEST_FILES ];
+    bool isCorrupt;
+} StreamerTestState;
+
+typedef struct {
+    StreamerTestState *state;
+    uint32_t file;
+} StreamerTestFile;
+
+/* PRIVATE VISIBILITY */
+// Queue internals of AssetStreamer.c, driven here without worker threads
+void PushRequest( AssetStreamer*, AssetRequest* );
+AssetRequest *PopRequest( AssetStreamer* );
+bool RemoveRequest( AssetStreamer*, AssetRequest* );
+
+bool TestQueueOrder( void );
+bool TestStreamFiles( void );
+void OnFileStreamed( AssetRequest*, void* );
+uint8_t FileByte( uint32_t, uint32_t );
+
+/* METHODS */
+int main() {
+    srand( 1 );
+
+    bool isPassed = true;
+    isPassed &= TestQueueOrder();
+    isPassed &= TestStreamFiles();
+
+    puts( isPassed ? "All streamer tests passed" : "streamer tests FAILED" );
+    return isPassed ? 0 : 1;
+}
+bool TestQueueOrder() {
+    // Higher priorities first, FIFO within a priority, removal keeps the heap ordered
+    AssetStreamer streamer;
+    memset( &streamer, 0, sizeof( AssetStreamer ) );
+
+    const int PRIORITIES[] = { ASSET_PRIORITY_LOW, ASSET_PRIORITY_NORMAL, ASSET_PRIORITY_HIGH };
+    AssetRequest requests[ 256 ];
+    memset( requests, 0, sizeof( requests ) );
+    for ( uint32_t i = 0; i < 256; i++ ) {
+        requests[ i ].priority = PRIORITIES[ rand() % 3 ];
+        requests[ i ].sequence = i;
+        PushRequest( &streamer, &requests[ i ] );
+    }
+
+    bool isPassed = true;
+    for ( uint32_t i = 0; i < 256; i += 5 ) isPassed &= RemoveRequest( &streamer, &requests[ i ] );
+    isPassed &= !RemoveRequest( &streamer, &requests[ 0 ] );
+
+    AssetRequest *previous = NULL, *request;
+    uint32_t poppedLength = 0;
+    while ( ( request = PopRequest( &streamer ) ) != NULL ) {
+        isPassed &= request->sequence % 5 != 0;
+        if ( previous != NULL ) {
+            isPassed &= previous->priority > request->priority ||
+                        ( previous->priority == request->priority && previous->sequence < request->sequence );
+        }
+        previous = request;
+        poppedLength++;
+    }
+    isPassed &= poppedLength == 256 - 52;
+    free( streamer.queue );
+
+    printf( "queue order: %s\n", isPassed ? "ok" : "FAILED" );
+    return isPassed;
+}
+bool TestStreamFiles() {
+    // Cancelled requests never reach their callback, everything else arrives intact or fails cleanly
+    char directory[] = "/tmp/streamer-test-XXXXXX";
+    if ( mkdtemp( directory ) == NULL ) {
+        puts( "stream files: FAILED (no temporary directory)" );
+        return false;
+    }
+
+    char paths[ STREAMER_TEST_FILES ][ UTILS_MAX_PATH_SIZE ];
+    uint8_t *contents = malloc( STREAMER_TEST_FILE_SIZE );
+    for ( uint32_t i = 0; i < STREAMER_TEST_FILES; i++ ) {
+        snprintf( paths[ i ], UTILS_MAX_PATH_SIZE, "%s/%u.bin", directory, i );
+        for ( uint32_t j = 0; j < STREAMER_TEST_FILE_SIZE; j++ ) contents[ j ] = FileByte( i, j );
+
+        FILE *file = fopen( paths[ i ], "wb" );
+        fwrite( contents, 1, STREAMER_TEST_FILE_SIZE - i, file );
+        fclose( file );
+    }
+    free( contents );
+
+    AssetStreamer streamer;
+    if ( !StartAssetStreamer( &streamer ) ) {
+        puts( "stream files: FAILED (streamer did not start)" );
+        return false;
+    }
+
+    StreamerTestState state;
+    memset( &state, 0, sizeof( StreamerTestState ) );
+    StreamerTestFile files[ STREAMER_TEST_FILES + 1 ];
+    uint32_t expectedLength = 0;
+    for ( uint32_t i = 0; i < STREAMER_TEST_FILES; i++ ) {
+        files[ i ].state = &state;
+        files[ i ].file = i;
+        AssetRequest *request = RequestAsset( &streamer, paths[ i ], ( int )( i % 3 ) * ASSET_PRIORITY_NORMAL, OnFileStreamed, &files[ i ] );
+
+        // Queued ones are retired at once, in-flight ones when their read finishes
+        if ( i % 4 == 3 ) {
+            CancelAssetRequest( &streamer, request );
+        } else {
+            expectedLength++;
+        }
+    }
+    files[ STREAMER_TEST_FILES ].state = &state;
+    files[ STREAMER_TEST_FILES ].file = STREAMER_TEST_FILES;
+    RequestAsset( &streamer, "/tmp/streamer-test-missing/asset.bin", ASSET_PRIORITY_HIGH, OnFileStreamed, &files[ STREAMER_TEST_FILES ] );
+
+    while ( state.deliveredLength + state.failedLength < expectedLength + 1 ) WaitAssetStreamer( &streamer );
+    StopAssetStreamer( &streamer );
+
+    bool isPassed = !state.isCorrupt && state.deliveredLength == expectedLength && state.failedLength == 1;
+    for ( uint32_t i = 0; i < STREAMER_TEST_FILES; i++ ) {
+        isPassed &= state.isDelivered[ i ] == ( i % 4 != 3 );
+        unlink( paths[ i ] );
+    }
+    rmdir( directory );
+
+    printf( "stream files: %s (%u delivered, %u failed)\n", isPassed ? "ok" : "FAILED", state.deliveredLength, state.failedLength );
+    return isPassed;
+}
+
+/* HELPERS */
+void OnFileStreamed( AssetRequest *request, void *userData ) {
+    StreamerTestFile *file = ( StreamerTestFile* )userData;
+    StreamerTestState *state = file->state;
+
+    if ( request->state != ASSET_REQUEST_DONE ) {
+        state->failedLength++;
+        state->isCorrupt |= file->file != STREAMER_TEST_FILES;
+        return;
+    }
+
+    state->deliveredLength++;
+    state->isCorrupt |= file->file == STREAMER_TEST_FILES || state->isDelivered[ file->file ];
+    state->isDelivered[ file->file ] = true;
+
+    // File sizes differ by one byte each, so a mixed up buffer shows in the size too
+    state->isCorrupt |= request->size != STREAMER_TEST_FILE_SIZE - file->file;
+    for ( uint64_t j = 0; j < request->size && !state->isCorrupt; j++ ) {
+        state->isCorrupt |= request->data[ j ] != FileByte( file->file, ( uint32_t )j );
+    }
+}
+uint8_t FileByte( uint32_t file, uint32_t offset ) {
+    return ( uint8_t )( file * 31u + offset * 7u + ( offset >> 11 ) );
+}
@@ -0,0 +1,24 @@
+#ifndef __CGLM_TEST__
+#define __CGLM_TEST__
+
+#include <cglm/cglm.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// Reference results from cglm built without SIMD, see cglm_scalar.c
+void ScalarMat4Inv( mat4, mat4 );
+void ScalarMat4Mul( mat4, mat4, mat4 );
+void ScalarMat4Mulv( mat4, vec4, vec4 );
+void ScalarMat4Mulv3( mat4, vec3, float, vec3 );
+void ScalarMat3Mul( mat3, mat3, mat3 );
+void ScalarQuatMat4( versor, mat4 );
+void ScalarQuatMul( versor, versor, versor );
+void ScalarQuatSlerpSoa( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] );
+void ScalarQuatNlerpSoa( float*[ 4 ], float*[ 4 ], float, size_t, float*[ 4 ] );
+void ScalarAabbFrustumSoa( float*[ 3 ], float*[ 3 ], size_t, vec4[ 6 ], uint32_t* );
+bool ScalarRayTriangleSoa( vec3, vec3, float*[ 9 ], size_t, float*, size_t* );
+void ScalarFrustumCascades( vec4[ 8 ], float, float, float*, size_t, mat4, float, vec4[][ 4 ], vec3[][ 2 ], mat4* );
+void ScalarSphereTransformArray( vec4*, mat4*, size_t, vec4* );
+void ScalarSphereMergeArray( vec4*, size_t, vec4 );
+
+#endif
@@ -0,0 +1,31 @@
+#include "../src/AssetArchive.h"
+#include "../src/utils.h"
+
+// Usage: pack <output.pak> <root> [--lz4|--zstd] <asset> [asset...]
+// Asset names are paths relative to <root>, the same names LoadAsset is called with
+int main( int argc, char *argv[] ) {
+    if ( argc < 4 ) {
+        printf( "Usage: %s <output.pak> <root> [--lz4|--zstd] <asset> [asset...]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    uint32_t compression = ASSET_COMPRESSION_NONE;
+    int first = 3;
+    if ( strcmp( argv[ first ], "--lz4" ) == 0 ) {
+        compression = ASSET_COMPRESSION_LZ4;
+        first++;
+    } else if ( strcmp( argv[ first ], "--zstd" ) == 0 ) {
+        compression = ASSET_COMPRESSION_ZSTD;
+        first++;
+    }
+
+    bool isWritten = WriteAssetArchive(
+        argv[ 1 ],
+        argv[ 2 ],
+        ( const char** )&argv[ first ],
+        ( uint32_t )( argc - first ),
+        compression
+    );
+
+    return isWritten ? 0 : 1;
+}